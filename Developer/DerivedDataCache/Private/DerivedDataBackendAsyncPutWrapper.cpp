@@ -235,6 +235,59 @@ bool FDerivedDataBackendAsyncPutWrapper::GetCachedData(const TCHAR* CacheKey, TA
 	return bSuccess;
 }
 
+TBitArray<> FDerivedDataBackendAsyncPutWrapper::GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeGet());
+
+	TBitArray<> Result;
+	if (InflightCache)
+	{
+		Result = InflightCache->GetCachedDataBatch(CacheKeys, OutData);
+		check(Result.Num() == CacheKeys.Num());
+		if (Result.CountSetBits() < CacheKeys.Num())
+		{
+			TArray<FString> RemainingKeys;
+			TArray<int32> RemainingIndices;
+			for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+			{
+				if (!Result[KeyIndex])
+				{
+					RemainingKeys.Add(CacheKeys[KeyIndex]);
+					RemainingIndices.Add(KeyIndex);
+				}
+			}
+
+			TArray<TArray<uint8>> RemainingData;
+			TBitArray<> InnerResult = InnerBackend->GetCachedDataBatch(RemainingKeys, RemainingData);
+			check(InnerResult.Num() == RemainingKeys.Num());
+			for (int32 RemainingIndex = 0; RemainingIndex < RemainingKeys.Num(); ++RemainingIndex)
+			{
+				Result[RemainingIndices[RemainingIndex]] = InnerResult[RemainingIndex];
+				OutData[RemainingIndices[RemainingIndex]] = MoveTemp(RemainingData[RemainingIndex]);
+			}
+		}
+	}
+	else
+	{
+		Result = InnerBackend->GetCachedDataBatch(CacheKeys, OutData);
+		check(Result.Num() == CacheKeys.Num());
+	}
+
+#if ENABLE_COOK_STATS
+	if (Result.CountSetBits() == CacheKeys.Num())
+	{
+		int64 BytesFound = 0;
+		for (const TArray<uint8>& Data : OutData)
+		{
+			BytesFound += Data.Num();
+		}
+		Timer.AddHit(BytesFound);
+	}
+#endif
+	UE_LOG(LogDerivedDataCache, Verbose, TEXT("%s GetCachedDataBatch found %d/%d keys"), *GetName(), Result.CountSetBits(), CacheKeys.Num());
+	return Result;
+}
+
 FDerivedDataBackendInterface::EPutStatus FDerivedDataBackendAsyncPutWrapper::PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists)
 {
 	COOK_STAT(auto Timer = PutSyncUsageStats.TimePut());
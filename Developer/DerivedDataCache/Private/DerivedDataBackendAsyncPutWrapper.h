@@ -113,6 +113,15 @@ public:
 	 */
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData) override;
 
+	/**
+	 * Synchronous retrieve of multiple cache items
+	 *
+	 * @param	CacheKeys	Alphanumeric+underscore key of the cache items
+	 * @param	OutData		Receives one buffer per key, empty for keys that were not found
+	 * @return				A bit array with bits indicating whether the data for the corresponding key was found
+	 */
+	virtual TBitArray<> GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData) override;
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
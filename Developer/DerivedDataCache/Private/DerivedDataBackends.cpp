@@ -15,6 +15,7 @@
 #include "HttpDerivedDataBackend.h"
 #include "DerivedDataBackendAsyncPutWrapper.h"
 #include "PakFileDerivedDataBackend.h"
+#include "SegmentedFileDerivedDataBackend.h"
 #include "S3DerivedDataBackend.h"
 #include "HierarchicalDerivedDataBackend.h"
 #include "DerivedDataLimitKeyLengthWrapper.h"
@@ -155,6 +156,10 @@ public:
 				{
 					ParsedNode = ParseDataCache( NodeName, *Entry );
 				}
+				else if( NodeType == TEXT("Segmented") )
+				{
+					ParsedNode = ParseSegmentedCache( NodeName, *Entry );
+				}
 				else if( NodeType == TEXT("Boot") )
 				{
 					if( BootCache == NULL )
@@ -490,16 +495,14 @@ public:
 	}
 
 	/**
-	 * Creates Filesystem data cache interface from ini settings.
+	 * Resolves the cache directory of a node from its Path and the environment, command line and editor overrides.
 	 *
 	 * @param NodeName Node name.
 	 * @param Entry Node definition.
-	 * @return Filesystem data cache backend interface instance or NULL if unsuccessfull
+	 * @return The cache path, empty if none was configured
 	 */
-	FDerivedDataBackendInterface* ParseDataCache( const TCHAR* NodeName, const TCHAR* Entry )
+	FString ParseCachePath( const TCHAR* NodeName, const TCHAR* Entry )
 	{
-		FDerivedDataBackendInterface* DataCache = NULL;
-
 		// Parse Path by default, it may be overwriten by EnvPathOverride
 		FString Path;
 		FParse::Value( Entry, TEXT("Path="), Path );
@@ -565,6 +568,22 @@ public:
 			}
 		}
 
+		return Path;
+	}
+
+	/**
+	 * Creates Filesystem data cache interface from ini settings.
+	 *
+	 * @param NodeName Node name.
+	 * @param Entry Node definition.
+	 * @return Filesystem data cache backend interface instance or NULL if unsuccessfull
+	 */
+	FDerivedDataBackendInterface* ParseDataCache( const TCHAR* NodeName, const TCHAR* Entry )
+	{
+		FDerivedDataBackendInterface* DataCache = NULL;
+
+		FString Path = ParseCachePath( NodeName, Entry );
+
 		if( !Path.Len() )
 		{
 			UE_LOG( LogDerivedDataCache, Log, TEXT("%s data cache path not found in *engine.ini, will not use an %s cache."), NodeName, NodeName );
@@ -628,6 +647,64 @@ public:
 		return DataCache;
 	}
 
+	/**
+	 * Creates a segmented local data cache interface from ini settings.
+	 *
+	 * @param NodeName Node name.
+	 * @param Entry Node definition.
+	 * @return Segmented data cache backend interface instance or NULL if unsuccessfull
+	 */
+	FDerivedDataBackendInterface* ParseSegmentedCache( const TCHAR* NodeName, const TCHAR* Entry )
+	{
+		FString Path = ParseCachePath( NodeName, Entry );
+		if( !Path.Len() )
+		{
+			UE_LOG( LogDerivedDataCache, Log, TEXT("%s data cache path not found in *engine.ini, will not use an %s cache."), NodeName, NodeName );
+			return nullptr;
+		}
+		else if( Path == TEXT("None") )
+		{
+			UE_LOG( LogDerivedDataCache, Log, TEXT("Disabling %s data cache - path set to 'None'."), NodeName );
+			return nullptr;
+		}
+
+		int32 SegmentSizeMB = 256;
+		FParse::Value( Entry, TEXT("SegmentSizeMB="), SegmentSizeMB );
+		float CompactionThreshold = 0.5f;
+		FParse::Value( Entry, TEXT("CompactionThreshold="), CompactionThreshold );
+
+		// The segments hash and verify their own contents, so this backend is not wrapped for corruption checks like FileSystem
+		FSegmentedFileDerivedDataBackend* SegmentedCache = new FSegmentedFileDerivedDataBackend( *Path, int64(SegmentSizeMB) * 1024 * 1024, CompactionThreshold );
+		if( SegmentedCache->IsLockedByAnotherProcess() )
+		{
+			// Another editor or commandlet owns the segments, e.g. a cook running next to the editor.
+			// Rather than running without a local cache, use a file system cache next to the segments.
+			delete SegmentedCache;
+
+			const FString FallbackPath = Path / TEXT("FileSystem");
+			FDerivedDataBackendInterface* InnerFileSystem = CreateFileSystemDerivedDataBackend( *FallbackPath, Entry );
+			if( !InnerFileSystem )
+			{
+				UE_LOG( LogDerivedDataCache, Warning, TEXT("%s data cache path (%s) is in use by another process and %s is unavailable so cache will be disabled."), NodeName, *Path, *FallbackPath );
+				return nullptr;
+			}
+
+			UE_LOG( LogDerivedDataCache, Warning, TEXT("%s data cache path (%s) is in use by another process, using a file system cache in %s instead."), NodeName, *Path, *FallbackPath );
+			Directories.AddUnique( FallbackPath );
+			return new FDerivedDataBackendCorruptionWrapper( InnerFileSystem );
+		}
+		if( !SegmentedCache->IsUsable() )
+		{
+			UE_LOG( LogDerivedDataCache, Warning, TEXT("%s data cache path (%s) is unavailable so cache will be disabled."), NodeName, *Path );
+			delete SegmentedCache;
+			return nullptr;
+		}
+
+		UE_LOG( LogDerivedDataCache, Log, TEXT("Using %s segmented data cache path %s"), NodeName, *Path );
+		Directories.AddUnique( Path );
+		return SegmentedCache;
+	}
+
 	/**
 	 * Creates an S3 data cache interface.
 	 */
@@ -10,6 +10,7 @@
 #include "Misc/ScopeLock.h"
 #include "Stats/StatsMisc.h"
 #include "Stats/Stats.h"
+#include "Async/Async.h"
 #include "Async/AsyncWork.h"
 #include "Async/TaskGraphInterfaces.h"
 #include "Serialization/MemoryReader.h"
@@ -511,6 +512,56 @@ public:
 		return Handle;
 	}
 
+	virtual TBitArray<> GetSynchronousBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData, FStringView DataContext) override
+	{
+		DDC_SCOPE_CYCLE_COUNTER(DDC_GetSynchronousBatch);
+		UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("GetSynchronousBatch %d keys from '%.*s'"), CacheKeys.Num(), DataContext.Len(), DataContext.GetData());
+		for (const FString& CacheKey : CacheKeys)
+		{
+			ValidateCacheKey(*CacheKey);
+		}
+		TBitArray<> Result;
+		INC_DWORD_STAT_BY(STAT_DDC_NumGets, CacheKeys.Num());
+		STAT(double ThisTime = 0);
+		{
+			SCOPE_SECONDS_COUNTER(ThisTime);
+			Result = FDerivedDataBackend::Get().GetRoot().GetCachedDataBatch(CacheKeys, OutData);
+			check(Result.Num() == CacheKeys.Num() && OutData.Num() == CacheKeys.Num());
+		}
+		INC_FLOAT_STAT_BY(STAT_DDC_SyncGetTime, (float)ThisTime);
+		return Result;
+	}
+
+	virtual void GetAsynchronousBatch(TArray<FString> CacheKeys, FStringView DataContext, TUniqueFunction<void(TBitArray<>&& bFound, TArray<TArray<uint8>>&& Data)> OnComplete) override
+	{
+		DDC_SCOPE_CYCLE_COUNTER(DDC_GetAsynchronousBatch);
+		UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("GetAsynchronousBatch %d keys from '%.*s'"), CacheKeys.Num(), DataContext.Len(), DataContext.GetData());
+		for (const FString& CacheKey : CacheKeys)
+		{
+			ValidateCacheKey(*CacheKey);
+		}
+		AddToAsyncCompletionCounter(1);
+		auto GetBatch = [this, CacheKeys = MoveTemp(CacheKeys), OnComplete = MoveTemp(OnComplete)]()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(DDC_GetBatch);
+			INC_DWORD_STAT_BY(STAT_DDC_NumGets, CacheKeys.Num());
+			TArray<TArray<uint8>> Data;
+			TBitArray<> Found = FDerivedDataBackend::Get().GetRoot().GetCachedDataBatch(CacheKeys, Data);
+			check(Found.Num() == CacheKeys.Num() && Data.Num() == CacheKeys.Num());
+			OnComplete(MoveTemp(Found), MoveTemp(Data));
+			AddToAsyncCompletionCounter(-1);
+		};
+		// Like the single key request this is I/O only, so prefer the I/O thread-pool over the worker threads.
+		if (GDDCIOThreadPool)
+		{
+			AsyncPool(*GDDCIOThreadPool, MoveTemp(GetBatch));
+		}
+		else
+		{
+			Async(EAsyncExecution::ThreadPool, MoveTemp(GetBatch));
+		}
+	}
+
 	virtual void Put(const TCHAR* CacheKey, TArrayView<const uint8> Data, FStringView DataContext, bool bPutEvenIfExists = false) override
 	{
 		DDC_SCOPE_CYCLE_COUNTER(DDC_Put);
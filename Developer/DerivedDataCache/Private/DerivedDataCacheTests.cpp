@@ -0,0 +1,165 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CoreMisc.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "DerivedDataCacheInterface.h"
+#include "MemoryDerivedDataBackend.h"
+#include "SegmentedFileDerivedDataBackend.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace DerivedDataCacheTests
+{
+	/** Random bytes do not compress, which keeps the layout of the segments predictable */
+	static TArray<uint8> MakeValue(int32 Size, int32 Seed)
+	{
+		FRandomStream Random(Seed);
+		TArray<uint8> Value;
+		Value.SetNumUninitialized(Size);
+		for (uint8& Byte : Value)
+		{
+			Byte = uint8(Random.RandHelper(256));
+		}
+		return Value;
+	}
+}
+
+/**
+ * Puts a deduplicated value, compacts the segment holding its payload, rebuilds the index from the segments alone and
+ * checks that every live key can still be read, both one at a time and batched.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSegmentedDerivedDataBackendTest, "System.DerivedDataCache.SegmentedBackend", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSegmentedDerivedDataBackendTest::RunTest(const FString& Parameters)
+{
+	using namespace DerivedDataCacheTests;
+
+	const FString CachePath = FPaths::AutomationTransientDir() / TEXT("SegmentedDDC_") + FGuid::NewGuid().ToString();
+	const int64 SegmentSize = 1024 * 1024;
+	const int32 ValueSize = 300 * 1024;
+
+	const TArray<uint8> Shared = MakeValue(ValueSize, 1);
+	const TArray<uint8> Filler = MakeValue(ValueSize, 2);
+
+	{
+		FSegmentedFileDerivedDataBackend Backend(*CachePath, SegmentSize, 0.5f);
+		if (!TestTrue(TEXT("Backend is usable"), Backend.IsUsable()))
+		{
+			return false;
+		}
+
+		// Segment 0 holds the shared payload and two values that are removed below, segment 1 the deduplicated key
+		Backend.PutCachedData(TEXT("SEGTEST_ORIGINAL"), Shared, false);
+		Backend.PutCachedData(TEXT("SEGTEST_DEAD1"), MakeValue(ValueSize, 3), false);
+		Backend.PutCachedData(TEXT("SEGTEST_DEAD2"), MakeValue(ValueSize, 4), false);
+		Backend.PutCachedData(TEXT("SEGTEST_FILLER"), Filler, false);
+		Backend.PutCachedData(TEXT("SEGTEST_DEDUP"), Shared, false);
+
+		// Leaves segment 0 mostly dead, so compaction moves the shared payload behind the deduplicated key in segment 1
+		Backend.RemoveCachedData(TEXT("SEGTEST_ORIGINAL"), false);
+		Backend.RemoveCachedData(TEXT("SEGTEST_DEAD1"), false);
+		Backend.RemoveCachedData(TEXT("SEGTEST_DEAD2"), false);
+
+		// Destruction waits for the compaction
+	}
+
+	TestFalse(TEXT("Segment 0 was compacted"), IFileManager::Get().FileExists(*(CachePath / TEXT("00000000.seg"))));
+	IFileManager::Get().Delete(*(CachePath / TEXT("Segments.idx")));
+
+	{
+		FSegmentedFileDerivedDataBackend Backend(*CachePath, SegmentSize, 0.0f);
+
+		TArray<uint8> Data;
+		TestTrue(TEXT("Deduplicated key survives compaction and a rebuild"), Backend.GetCachedData(TEXT("SEGTEST_DEDUP"), Data) && Data == Shared);
+		TestTrue(TEXT("Filler survives a rebuild"), Backend.GetCachedData(TEXT("SEGTEST_FILLER"), Data) && Data == Filler);
+		TestFalse(TEXT("Removed key stays removed"), Backend.CachedDataProbablyExists(TEXT("SEGTEST_ORIGINAL")));
+		TestFalse(TEXT("Removed key stays removed"), Backend.CachedDataProbablyExists(TEXT("SEGTEST_DEAD1")));
+
+		const TArray<FString> Keys = { TEXT("SEGTEST_FILLER"), TEXT("SEGTEST_MISSING"), TEXT("SEGTEST_DEDUP") };
+		TArray<TArray<uint8>> BatchData;
+		const TBitArray<> Found = Backend.GetCachedDataBatch(Keys, BatchData);
+		TestEqual(TEXT("Batch get returns one buffer per key"), BatchData.Num(), Keys.Num());
+		TestTrue(TEXT("Batch get finds the present keys"), Found.Num() == 3 && Found[0] && !Found[1] && Found[2]);
+		TestTrue(TEXT("Batch get returns the values of the present keys"), BatchData.Num() == 3 && BatchData[0] == Filler && BatchData[1].Num() == 0 && BatchData[2] == Shared);
+
+		const TBitArray<> Exists = Backend.CachedDataProbablyExistsBatch(Keys);
+		TestTrue(TEXT("Batch exists matches batch get"), Exists == Found);
+
+		// Puts that cannot be recorded are refused with a warning instead of asserting
+		AddExpectedError(TEXT("refused"), EAutomationExpectedErrorFlags::Contains, 2);
+		const FString LongKey = FString::ChrN(8192, TEXT('L'));
+		TestTrue(TEXT("Empty put is refused"), Backend.PutCachedData(TEXT("SEGTEST_EMPTY"), TArrayView<const uint8>(), false) == FDerivedDataBackendInterface::EPutStatus::NotCached);
+		TestTrue(TEXT("Over long key is refused"), Backend.PutCachedData(*LongKey, Filler, false) == FDerivedDataBackendInterface::EPutStatus::NotCached);
+		TestFalse(TEXT("Over long key is not found"), Backend.GetCachedData(*LongKey, Data));
+	}
+
+	IFileManager::Get().DeleteDirectory(*CachePath, false, true);
+	return true;
+}
+
+/**
+ * Checks the default batch implementations of FDerivedDataBackendInterface and the batch gets of the cache itself
+ * against the single key calls.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDerivedDataCacheBatchTest, "System.DerivedDataCache.Batch", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FDerivedDataCacheBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace DerivedDataCacheTests;
+
+	const FString Prefix = FString::Printf(TEXT("DDCBATCHTEST_%s_"), *FGuid::NewGuid().ToString());
+	const TArray<FString> Keys = { Prefix + TEXT("A"), Prefix + TEXT("MISSING"), Prefix + TEXT("B") };
+	const TArray<uint8> ValueA = MakeValue(1024, 5);
+	const TArray<uint8> ValueB = MakeValue(4096, 6);
+
+	// Backend defaults, via a backend that does not override them
+	{
+		FMemoryDerivedDataBackend Backend(TEXT("BatchTest"));
+		Backend.PutCachedData(*Keys[0], ValueA, false);
+		Backend.PutCachedData(*Keys[2], ValueB, false);
+
+		TArray<TArray<uint8>> Data;
+		const TBitArray<> Found = Backend.GetCachedDataBatch(Keys, Data);
+		TestTrue(TEXT("Default batch get finds the present keys"), Found.Num() == 3 && Found[0] && !Found[1] && Found[2]);
+		TestTrue(TEXT("Default batch get returns the values"), Data.Num() == 3 && Data[0] == ValueA && Data[1].Num() == 0 && Data[2] == ValueB);
+		TestTrue(TEXT("Default batch exists matches batch get"), Backend.CachedDataProbablyExistsBatch(Keys) == Found);
+	}
+
+	// The cache, whose puts are asynchronous but visible to gets right away
+	{
+		FDerivedDataCacheInterface& DDC = GetDerivedDataCacheRef();
+		DDC.Put(*Keys[0], ValueA, TEXT("DerivedDataCacheBatchTest"));
+		DDC.Put(*Keys[2], ValueB, TEXT("DerivedDataCacheBatchTest"));
+
+		TArray<TArray<uint8>> Data;
+		const TBitArray<> Found = DDC.GetSynchronousBatch(Keys, Data, TEXT("DerivedDataCacheBatchTest"));
+		TestTrue(TEXT("Synchronous batch finds the present keys"), Found.Num() == 3 && Found[0] && !Found[1] && Found[2]);
+		TestTrue(TEXT("Synchronous batch returns the values"), Data.Num() == 3 && Data[0] == ValueA && Data[1].Num() == 0 && Data[2] == ValueB);
+
+		FEvent* Done = FPlatformProcess::GetSynchEventFromPool(true);
+		TBitArray<> AsyncFound;
+		TArray<TArray<uint8>> AsyncData;
+		DDC.GetAsynchronousBatch(Keys, TEXT("DerivedDataCacheBatchTest"), [Done, &AsyncFound, &AsyncData](TBitArray<>&& bFound, TArray<TArray<uint8>>&& InData)
+		{
+			AsyncFound = MoveTemp(bFound);
+			AsyncData = MoveTemp(InData);
+			Done->Trigger();
+		});
+		Done->Wait();
+		FPlatformProcess::ReturnSynchEventToPool(Done);
+
+		TestTrue(TEXT("Asynchronous batch matches the synchronous batch"), AsyncFound == Found && AsyncData == Data);
+		TestFalse(TEXT("Not every key exists"), DDC.AllCachedDataProbablyExists(Keys));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
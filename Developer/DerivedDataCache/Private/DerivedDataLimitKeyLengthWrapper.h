@@ -143,31 +143,7 @@ public:
 			bOk = InnerBackend->GetCachedData(*NewKey, OutData);
 			if (bOk)
 			{
-				int32 KeyLen = FCString::Strlen(CacheKey) + 1;
-				if (OutData.Num() < KeyLen)
-				{
-					UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataLimitKeyLengthWrapper: Short file or Hash Collision, ignoring and deleting %s."), CacheKey);
-					bOk	= false;
-				}
-				else
-				{
-					int32 Compare = FCStringAnsi::Strcmp(TCHAR_TO_ANSI(CacheKey), (char*)&OutData[OutData.Num() - KeyLen]);
-					OutData.RemoveAt(OutData.Num() - KeyLen, KeyLen);
-					if (Compare == 0)
-					{
-						UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataLimitKeyLengthWrapper: cache hit, key match is ok %s"), CacheKey);
-					}
-					else
-					{
-						UE_LOG(LogDerivedDataCache, Warning, TEXT("FDerivedDataLimitKeyLengthWrapper: HASH COLLISION, ignoring and deleting %s."), CacheKey);
-						bOk	= false;
-					}
-				}
-				if (!bOk)
-				{
-					// _we_ detected corruption, so _we_ will force a flush of the corrupted data
-					InnerBackend->RemoveCachedData(*NewKey, /*bTransient=*/ false);
-				}
+				bOk = VerifyAndStripKey(CacheKey, NewKey, OutData);
 			}
 		}
 		if (!bOk)
@@ -180,6 +156,48 @@ public:
 		}
 		return bOk;
 	}
+
+	/**
+	 * Synchronous retrieve of multiple cache items
+	 *
+	 * @param	CacheKeys	Alphanumeric+underscore key of the cache items
+	 * @param	OutData		Receives one buffer per key, empty for keys that were not found
+	 * @return				A bit array with bits indicating whether the data for the corresponding key was found
+	 */
+	virtual TBitArray<> GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData) override
+	{
+		COOK_STAT(auto Timer = UsageStats.TimeGet());
+		TArray<FString> NewKeys;
+		TBitArray<> WasShortened;
+		NewKeys.Reserve(CacheKeys.Num());
+		WasShortened.Reserve(CacheKeys.Num());
+		for (const FString& CacheKey : CacheKeys)
+		{
+			WasShortened.Add(ShortenKey(*CacheKey, NewKeys.Emplace_GetRef()));
+		}
+
+		TBitArray<> Result = InnerBackend->GetCachedDataBatch(NewKeys, OutData);
+		check(Result.Num() == CacheKeys.Num() && OutData.Num() == CacheKeys.Num());
+
+		int64 BytesFound = 0;
+		for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+		{
+			if (Result[KeyIndex] && WasShortened[KeyIndex] && !VerifyAndStripKey(*CacheKeys[KeyIndex], NewKeys[KeyIndex], OutData[KeyIndex]))
+			{
+				Result[KeyIndex] = false;
+			}
+			if (!Result[KeyIndex])
+			{
+				OutData[KeyIndex].Empty();
+			}
+			BytesFound += OutData[KeyIndex].Num();
+		}
+		if (Result.CountSetBits() == CacheKeys.Num())
+		{
+			COOK_STAT(Timer.AddHit(BytesFound));
+		}
+		return Result;
+	}
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -272,6 +290,38 @@ private:
 		return true;
 	}
 
+	/** Check the full key stored at the end of data fetched with a shortened key and strip it, returns false on a collision **/
+	bool VerifyAndStripKey(const TCHAR* CacheKey, const FString& NewKey, TArray<uint8>& OutData)
+	{
+		bool bOk = true;
+		int32 KeyLen = FCString::Strlen(CacheKey) + 1;
+		if (OutData.Num() < KeyLen)
+		{
+			UE_LOG(LogDerivedDataCache, Display, TEXT("FDerivedDataLimitKeyLengthWrapper: Short file or Hash Collision, ignoring and deleting %s."), CacheKey);
+			bOk	= false;
+		}
+		else
+		{
+			int32 Compare = FCStringAnsi::Strcmp(TCHAR_TO_ANSI(CacheKey), (char*)&OutData[OutData.Num() - KeyLen]);
+			OutData.RemoveAt(OutData.Num() - KeyLen, KeyLen);
+			if (Compare == 0)
+			{
+				UE_LOG(LogDerivedDataCache, VeryVerbose, TEXT("FDerivedDataLimitKeyLengthWrapper: cache hit, key match is ok %s"), CacheKey);
+			}
+			else
+			{
+				UE_LOG(LogDerivedDataCache, Warning, TEXT("FDerivedDataLimitKeyLengthWrapper: HASH COLLISION, ignoring and deleting %s."), CacheKey);
+				bOk	= false;
+			}
+		}
+		if (!bOk)
+		{
+			// _we_ detected corruption, so _we_ will force a flush of the corrupted data
+			InnerBackend->RemoveCachedData(*NewKey, /*bTransient=*/ false);
+		}
+		return bOk;
+	}
+
 	/** Backend to use for storage, my responsibilities are about key length **/
 	FDerivedDataBackendInterface* InnerBackend;
 
@@ -292,68 +292,7 @@ public:
 			// just try and get the cached data. It's faster to try and fail than it is to check and succeed. 			
 			if (GetInterface->GetCachedData(CacheKey, OutData))
 			{
-				// if this hierarchy is writable..
-				if (bIsWritable)
-				{
-					// fill in the higher level caches (start with the highest level as that should be the biggest 
-					// !/$ if any of our puts get interrupted or fail)
-					for (int32 MissedCacheIndex = 0; MissedCacheIndex < CacheIndex; MissedCacheIndex++)
-					{
-						FDerivedDataBackendInterface* MissedCache = InnerBackends[MissedCacheIndex];
-
-						if (MissedCache->IsWritable())
-						{
-							// We want to make sure that the relationship between ProbablyExists and GetCachedData is valid but
-							// only if we have a fast cache. Mismatches are edge cases caused by failed writes or corruption. 
-							// They get handled, so can be left to eventually be rectified by a faster machine
-							bool bFastCache = MissedCache->GetSpeedClass() >= ESpeedClass::Fast;
-							bool bDidExist = bFastCache ? MissedCache->CachedDataProbablyExists(CacheKey) : false;
-							bool bForcePut = false;
-
-							// the cache failed to return data it thinks it has, so clean it up. (todo - can it just be stomped?)
-							if (bDidExist)
-							{
-								MissedCache->RemoveCachedData(CacheKey, /*bTransient=*/ false); // it apparently failed, so lets delete what is there				
-								bForcePut = true;
-							}
-
-							// use the async interface to perform the put
-							AsyncPutInnerBackends[MissedCacheIndex]->PutCachedData(CacheKey, OutData, bForcePut);
-							UE_LOG(LogDerivedDataCache, Verbose, TEXT("Forward-filling cache %s with: %s (%d bytes) (force=%d)"), *MissedCache->GetName(), CacheKey, OutData.Num(), bForcePut);
-						}
-					}
-
-					// cascade this data to any lower level back ends that may be missing the data
-					if (InnerBackends[CacheIndex]->BackfillLowerCacheLevels())
-					{
-						// fill in the lower level caches
-						for (int32 PutCacheIndex = CacheIndex + 1; PutCacheIndex < AsyncPutInnerBackends.Num(); PutCacheIndex++)
-						{
-							FDerivedDataBackendInterface* PutBackend = InnerBackends[PutCacheIndex];
-
-							// If the key is in a distributed cache (e.g. Pak or S3) then don't backfill any further. 
-							bool IsInDistributedCache = !PutBackend->IsWritable() && !PutBackend->BackfillLowerCacheLevels() && PutBackend->CachedDataProbablyExists(CacheKey);
-
-							if (!IsInDistributedCache)
-							{
-								// only backfill to fast caches (todo - need a way to put data that was created locally into the cache for other people)
-								bool bFastCache = PutBackend->GetSpeedClass() >= ESpeedClass::Fast;
-
-								// No need to validate that the cache data might exist since the check can be expensive, the async put will do the check and early out in that case
-								if (bFastCache && PutBackend->IsWritable())
-								{								
-									AsyncPutInnerBackends[PutCacheIndex]->PutCachedData(CacheKey, OutData, false); // we do not need to force a put here
-									UE_LOG(LogDerivedDataCache, Verbose, TEXT("Back-filling cache %s with: %s (%d bytes) (force=%d)"), *PutBackend->GetName(), CacheKey, OutData.Num(), false);
-								}
-							}
-							else
-							{ 
-								UE_LOG(LogDerivedDataCache, Verbose, TEXT("Item %s exists in distributed cache %s. Skipping any further backfills."), CacheKey, *PutBackend->GetName());
-								break;
-							}
-						}
-					}
-				}
+				FillCacheLevels(CacheIndex, CacheKey, OutData);
 				COOK_STAT(Timer.AddHit(OutData.Num()));
 				return true;
 			}
@@ -370,6 +309,71 @@ public:
 		}
 		return false;
 	}
+
+	/**
+	 * Synchronous retrieve of multiple cache items. Each level is asked in one batch for the keys that the faster levels missed.
+	 *
+	 * @param	CacheKeys	Alphanumeric+underscore key of the cache items
+	 * @param	OutData		Receives one buffer per key, empty for keys that were not found
+	 * @return				A bit array with bits indicating whether the data for the corresponding key was found
+	 */
+	virtual TBitArray<> GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData) override
+	{
+		COOK_STAT(auto Timer = UsageStats.TimeGet());
+
+		TBitArray<> Result(false, CacheKeys.Num());
+		OutData.Reset(CacheKeys.Num());
+		OutData.SetNum(CacheKeys.Num());
+
+		TArray<FString> RemainingKeys(CacheKeys.GetData(), CacheKeys.Num());
+		TArray<int32> RemainingIndices;
+		RemainingIndices.Reserve(CacheKeys.Num());
+		for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+		{
+			RemainingIndices.Add(KeyIndex);
+		}
+
+		for (int32 CacheIndex = 0; CacheIndex < InnerBackends.Num() && RemainingKeys.Num() > 0; CacheIndex++)
+		{
+			TArray<TArray<uint8>> LevelData;
+			TBitArray<> LevelResult = InnerBackends[CacheIndex]->GetCachedDataBatch(RemainingKeys, LevelData);
+			check(LevelResult.Num() == RemainingKeys.Num() && LevelData.Num() == RemainingKeys.Num());
+
+			int32 NumStillMissing = 0;
+			for (int32 RemainingIndex = 0; RemainingIndex < RemainingKeys.Num(); ++RemainingIndex)
+			{
+				const int32 KeyIndex = RemainingIndices[RemainingIndex];
+				if (LevelResult[RemainingIndex])
+				{
+					OutData[KeyIndex] = MoveTemp(LevelData[RemainingIndex]);
+					Result[KeyIndex] = true;
+					FillCacheLevels(CacheIndex, *CacheKeys[KeyIndex], OutData[KeyIndex]);
+				}
+				else
+				{
+					RemainingKeys[NumStillMissing] = MoveTemp(RemainingKeys[RemainingIndex]);
+					RemainingIndices[NumStillMissing] = KeyIndex;
+					++NumStillMissing;
+				}
+			}
+			RemainingKeys.SetNum(NumStillMissing, /*bAllowShrinking=*/ false);
+			RemainingIndices.SetNum(NumStillMissing, /*bAllowShrinking=*/ false);
+		}
+
+#if ENABLE_COOK_STATS
+		if (RemainingKeys.Num() == 0)
+		{
+			int64 BytesFound = 0;
+			for (const TArray<uint8>& Data : OutData)
+			{
+				BytesFound += Data.Num();
+			}
+			Timer.AddHit(BytesFound);
+		}
+#endif
+		return Result;
+	}
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
@@ -448,6 +452,79 @@ public:
 
 
 private:
+	/**
+	 * Forward-fills the levels above and back-fills the levels below the one that returned a hit
+	 *
+	 * @param	CacheIndex	Index of the inner backend that returned the data
+	 * @param	CacheKey	Alphanumeric+underscore key of this cache item
+	 * @param	Data		The data that was found
+	 */
+	void FillCacheLevels(int32 CacheIndex, const TCHAR* CacheKey, TArrayView<const uint8> Data)
+	{
+		// if this hierarchy is writable..
+		if (bIsWritable)
+		{
+			// fill in the higher level caches (start with the highest level as that should be the biggest 
+			// !/$ if any of our puts get interrupted or fail)
+			for (int32 MissedCacheIndex = 0; MissedCacheIndex < CacheIndex; MissedCacheIndex++)
+			{
+				FDerivedDataBackendInterface* MissedCache = InnerBackends[MissedCacheIndex];
+
+				if (MissedCache->IsWritable())
+				{
+					// We want to make sure that the relationship between ProbablyExists and GetCachedData is valid but
+					// only if we have a fast cache. Mismatches are edge cases caused by failed writes or corruption. 
+					// They get handled, so can be left to eventually be rectified by a faster machine
+					bool bFastCache = MissedCache->GetSpeedClass() >= ESpeedClass::Fast;
+					bool bDidExist = bFastCache ? MissedCache->CachedDataProbablyExists(CacheKey) : false;
+					bool bForcePut = false;
+
+					// the cache failed to return data it thinks it has, so clean it up. (todo - can it just be stomped?)
+					if (bDidExist)
+					{
+						MissedCache->RemoveCachedData(CacheKey, /*bTransient=*/ false); // it apparently failed, so lets delete what is there				
+						bForcePut = true;
+					}
+
+					// use the async interface to perform the put
+					AsyncPutInnerBackends[MissedCacheIndex]->PutCachedData(CacheKey, Data, bForcePut);
+					UE_LOG(LogDerivedDataCache, Verbose, TEXT("Forward-filling cache %s with: %s (%d bytes) (force=%d)"), *MissedCache->GetName(), CacheKey, Data.Num(), bForcePut);
+				}
+			}
+
+			// cascade this data to any lower level back ends that may be missing the data
+			if (InnerBackends[CacheIndex]->BackfillLowerCacheLevels())
+			{
+				// fill in the lower level caches
+				for (int32 PutCacheIndex = CacheIndex + 1; PutCacheIndex < AsyncPutInnerBackends.Num(); PutCacheIndex++)
+				{
+					FDerivedDataBackendInterface* PutBackend = InnerBackends[PutCacheIndex];
+
+					// If the key is in a distributed cache (e.g. Pak or S3) then don't backfill any further. 
+					bool IsInDistributedCache = !PutBackend->IsWritable() && !PutBackend->BackfillLowerCacheLevels() && PutBackend->CachedDataProbablyExists(CacheKey);
+
+					if (!IsInDistributedCache)
+					{
+						// only backfill to fast caches (todo - need a way to put data that was created locally into the cache for other people)
+						bool bFastCache = PutBackend->GetSpeedClass() >= ESpeedClass::Fast;
+
+						// No need to validate that the cache data might exist since the check can be expensive, the async put will do the check and early out in that case
+						if (bFastCache && PutBackend->IsWritable())
+						{								
+							AsyncPutInnerBackends[PutCacheIndex]->PutCachedData(CacheKey, Data, false); // we do not need to force a put here
+							UE_LOG(LogDerivedDataCache, Verbose, TEXT("Back-filling cache %s with: %s (%d bytes) (force=%d)"), *PutBackend->GetName(), CacheKey, Data.Num(), false);
+						}
+					}
+					else
+					{ 
+						UE_LOG(LogDerivedDataCache, Verbose, TEXT("Item %s exists in distributed cache %s. Skipping any further backfills."), CacheKey, *PutBackend->GetName());
+						break;
+					}
+				}
+			}
+		}
+	}
+
 	FDerivedDataCacheUsageStats UsageStats;
 
 	/** Array of backends forming the hierarchical cache...the first element is the fastest cache. **/
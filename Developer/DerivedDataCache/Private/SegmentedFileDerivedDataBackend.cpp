@@ -0,0 +1,1072 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "SegmentedFileDerivedDataBackend.h"
+#include "Algo/Sort.h"
+#include "Async/Async.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+/** Magic, key length, raw size, stored size and content hash, followed by the key and the stored payload */
+static constexpr int64 SegmentRecordHeaderSize = 4 * sizeof(uint32) + sizeof(FSHAHash::Hash);
+/** Keys are at most a few hundred characters, anything longer means the record is garbage */
+static constexpr uint32 SegmentMaxKeyLength = 4096;
+
+static const EName SegmentCompressionFormat = NAME_Zlib;
+static const ECompressionFlags SegmentCompressionFlags = COMPRESS_BiasMemory;
+
+FSegmentedFileDerivedDataBackend::FSegmentedFileDerivedDataBackend(const TCHAR* InCachePath, int64 InMaxSegmentSize, float InCompactionThreshold)
+	: CachePath(InCachePath)
+	, MaxSegmentSize(FMath::Max<int64>(InMaxSegmentSize, 1024 * 1024))
+	, CompactionThreshold(InCompactionThreshold)
+	, bUsable(false)
+	, bLockedByAnotherProcess(false)
+	, ActiveSegmentId(INDEX_NONE)
+	, NextSegmentId(0)
+	, bCompactionRunning(false)
+{
+	if (!IFileManager::Get().MakeDirectory(*CachePath, true))
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache could not create directory %s."), *CachePath);
+		return;
+	}
+
+	LockFileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*(CachePath / TEXT("Segments.lock"))));
+	if (!LockFileHandle)
+	{
+		// The caller decides what to use instead, see ParseSegmentedCache
+		bLockedByAnotherProcess = true;
+		return;
+	}
+
+	bUsable = true;
+	LoadIndex();
+}
+
+FSegmentedFileDerivedDataBackend::~FSegmentedFileDerivedDataBackend()
+{
+	if (CompactionTask.IsValid())
+	{
+		CompactionTask.Wait();
+	}
+
+	if (bUsable)
+	{
+		FScopeLock AppendLock(&AppendCS);
+		SealActiveSegment();
+		SaveIndex();
+	}
+
+	Segments.Empty();
+	if (LockFileHandle)
+	{
+		LockFileHandle.Reset();
+		IFileManager::Get().Delete(*(CachePath / TEXT("Segments.lock")), false, false, true);
+	}
+}
+
+bool FSegmentedFileDerivedDataBackend::CachedDataProbablyExists(const TCHAR* CacheKey)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeProbablyExists());
+	if (!bUsable)
+	{
+		return false;
+	}
+	FReadScopeLock ReadLock(IndexLock);
+	bool bResult = KeyEntries.Contains(FString(CacheKey));
+	if (bResult)
+	{
+		COOK_STAT(Timer.AddHit(0));
+	}
+	return bResult;
+}
+
+TBitArray<> FSegmentedFileDerivedDataBackend::CachedDataProbablyExistsBatch(TConstArrayView<FString> CacheKeys)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeProbablyExists());
+	TBitArray<> Result(false, CacheKeys.Num());
+	if (bUsable)
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+		{
+			Result[KeyIndex] = KeyEntries.Contains(CacheKeys[KeyIndex]);
+		}
+	}
+	if (Result.CountSetBits() == CacheKeys.Num())
+	{
+		COOK_STAT(Timer.AddHit(0));
+	}
+	return Result;
+}
+
+bool FSegmentedFileDerivedDataBackend::GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeGet());
+	if (!bUsable)
+	{
+		return false;
+	}
+
+	FSHAHash ContentHash;
+	uint32 RawSize = 0;
+	TArray<uint8> StoredData;
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		const FKeyEntry* Entry = KeyEntries.Find(FString(CacheKey));
+		const FContentLocation* Location = Entry ? ContentLocations.Find(Entry->ContentHash) : nullptr;
+		FSegment* Segment = Location ? FindSegment(Location->SegmentId) : nullptr;
+		if (!Segment)
+		{
+			UE_LOG(LogDerivedDataCache, Verbose, TEXT("FSegmentedFileDerivedDataBackend: Miss on %s"), CacheKey);
+			return false;
+		}
+
+		ContentHash = Entry->ContentHash;
+		RawSize = Location->RawSize;
+		StoredData.SetNumUninitialized(Location->StoredSize);
+		if (!ReadSegmentBytes(*Segment, Location->PayloadOffset, StoredData.GetData(), StoredData.Num()))
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s failed to read %s from %s."), *CachePath, CacheKey, *Segment->Filename);
+			return false;
+		}
+	}
+
+	if (!DecodePayload(CacheKey, ContentHash, RawSize, StoredData, OutData))
+	{
+		RemoveCachedData(CacheKey, /*bTransient=*/ false);
+		OutData.Empty();
+		return false;
+	}
+
+	UE_LOG(LogDerivedDataCache, Verbose, TEXT("FSegmentedFileDerivedDataBackend: Cache hit on %s"), CacheKey);
+	COOK_STAT(Timer.AddHit(OutData.Num()));
+	return true;
+}
+
+TBitArray<> FSegmentedFileDerivedDataBackend::GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData)
+{
+	COOK_STAT(auto Timer = UsageStats.TimeGet());
+	TBitArray<> Result(false, CacheKeys.Num());
+	OutData.Reset(CacheKeys.Num());
+	OutData.SetNum(CacheKeys.Num());
+	if (!bUsable)
+	{
+		return Result;
+	}
+
+	struct FBatchRead
+	{
+		int32 KeyIndex;
+		int32 SegmentId;
+		int64 PayloadOffset;
+		uint32 RawSize;
+		FSHAHash ContentHash;
+		TArray<uint8> StoredData;
+		bool bValid;
+	};
+	TArray<FBatchRead> Reads;
+	Reads.Reserve(CacheKeys.Num());
+
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+		{
+			const FKeyEntry* Entry = KeyEntries.Find(CacheKeys[KeyIndex]);
+			const FContentLocation* Location = Entry ? ContentLocations.Find(Entry->ContentHash) : nullptr;
+			if (Location)
+			{
+				FBatchRead& Read = Reads.AddDefaulted_GetRef();
+				Read.KeyIndex = KeyIndex;
+				Read.SegmentId = Location->SegmentId;
+				Read.PayloadOffset = Location->PayloadOffset;
+				Read.RawSize = Location->RawSize;
+				Read.ContentHash = Entry->ContentHash;
+				Read.StoredData.SetNumUninitialized(Location->StoredSize);
+				Read.bValid = false;
+			}
+		}
+
+		// Read in file order so that the whole batch walks each segment front to back once
+		Algo::Sort(Reads, [](const FBatchRead& A, const FBatchRead& B)
+		{
+			return A.SegmentId != B.SegmentId ? A.SegmentId < B.SegmentId : A.PayloadOffset < B.PayloadOffset;
+		});
+
+		FSegment* Segment = nullptr;
+		for (FBatchRead& Read : Reads)
+		{
+			if (!Segment || Segment->Id != Read.SegmentId)
+			{
+				Segment = FindSegment(Read.SegmentId);
+			}
+			Read.bValid = Segment && ReadSegmentBytes(*Segment, Read.PayloadOffset, Read.StoredData.GetData(), Read.StoredData.Num());
+		}
+	}
+
+	// Decompression and hashing dominate once the bytes are in memory, so spread them over the workers
+	ParallelFor(Reads.Num(), [this, &Reads, &OutData, CacheKeys](int32 ReadIndex)
+	{
+		FBatchRead& Read = Reads[ReadIndex];
+		if (Read.bValid)
+		{
+			Read.bValid = DecodePayload(*CacheKeys[Read.KeyIndex], Read.ContentHash, Read.RawSize, Read.StoredData, OutData[Read.KeyIndex]);
+		}
+	});
+
+	int64 BytesFound = 0;
+	for (const FBatchRead& Read : Reads)
+	{
+		if (Read.bValid)
+		{
+			Result[Read.KeyIndex] = true;
+			BytesFound += OutData[Read.KeyIndex].Num();
+		}
+		else
+		{
+			OutData[Read.KeyIndex].Empty();
+			RemoveCachedData(*CacheKeys[Read.KeyIndex], /*bTransient=*/ false);
+		}
+	}
+
+	UE_LOG(LogDerivedDataCache, Verbose, TEXT("FSegmentedFileDerivedDataBackend: Batch hit on %d/%d keys"), Result.CountSetBits(), CacheKeys.Num());
+	if (Result.CountSetBits() == CacheKeys.Num())
+	{
+		COOK_STAT(Timer.AddHit(BytesFound));
+	}
+	return Result;
+}
+
+FDerivedDataBackendInterface::EPutStatus FSegmentedFileDerivedDataBackend::PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists)
+{
+	COOK_STAT(auto Timer = UsageStats.TimePut());
+	if (!bUsable)
+	{
+		return EPutStatus::NotCached;
+	}
+	if (InData.Num() == 0)
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s refused an empty put of %s."), *CachePath, CacheKey);
+		return EPutStatus::NotCached;
+	}
+	// Keys that are too long for a record header are never stored, so lookups of them simply miss
+	if (FTCHARToUTF8(CacheKey).Length() > SegmentMaxKeyLength)
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s refused a put of %s, the key is longer than %u bytes."), *CachePath, CacheKey, SegmentMaxKeyLength);
+		return EPutStatus::NotCached;
+	}
+
+	const FString Key(CacheKey);
+	FSHAHash ContentHash;
+	FSHA1::HashBuffer(InData.GetData(), InData.Num(), ContentHash.Hash);
+
+	auto CompressData = [InData](TArray<uint8>& OutStoredData)
+	{
+		int32 CompressedSize = FCompression::CompressMemoryBound(SegmentCompressionFormat, InData.Num(), SegmentCompressionFlags);
+		OutStoredData.SetNumUninitialized(CompressedSize);
+		if (FCompression::CompressMemory(SegmentCompressionFormat, OutStoredData.GetData(), CompressedSize, InData.GetData(), InData.Num(), SegmentCompressionFlags) && CompressedSize < InData.Num())
+		{
+			OutStoredData.SetNum(CompressedSize, /*bAllowShrinking=*/ false);
+		}
+		else
+		{
+			// A stored size equal to the raw size marks the payload as uncompressed
+			OutStoredData = TArray<uint8>(InData.GetData(), InData.Num());
+		}
+	};
+
+	bool bContentExists;
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		const FKeyEntry* Entry = KeyEntries.Find(Key);
+		if (Entry && (!bPutEvenIfExists || Entry->ContentHash == ContentHash))
+		{
+			return EPutStatus::Cached;
+		}
+		bContentExists = ContentLocations.Contains(ContentHash);
+	}
+
+	// Compress outside of the append lock so that concurrent puts only serialize on the write itself
+	TArray<uint8> StoredData;
+	if (!bContentExists)
+	{
+		CompressData(StoredData);
+	}
+
+	{
+		FScopeLock AppendLock(&AppendCS);
+		{
+			FReadScopeLock ReadLock(IndexLock);
+			bContentExists = ContentLocations.Contains(ContentHash);
+		}
+		if (bContentExists)
+		{
+			StoredData.Empty();
+		}
+		else if (StoredData.Num() == 0)
+		{
+			CompressData(StoredData);
+		}
+
+		FParsedRecord Record;
+		int32 SegmentId;
+		if (!AppendRecord(false, Key, ContentHash, InData.Num(), StoredData, Record, SegmentId))
+		{
+			return EPutStatus::NotCached;
+		}
+		{
+			FWriteScopeLock WriteLock(IndexLock);
+			ApplyRecord(Record, SegmentId);
+		}
+		ConditionallyStartCompaction();
+	}
+
+	UE_LOG(LogDerivedDataCache, Verbose, TEXT("FSegmentedFileDerivedDataBackend: Put %s (%d bytes, %s)"), CacheKey, InData.Num(), bContentExists ? TEXT("deduplicated") : TEXT("stored"));
+	COOK_STAT(Timer.AddHit(InData.Num()));
+	return EPutStatus::Cached;
+}
+
+void FSegmentedFileDerivedDataBackend::RemoveCachedData(const TCHAR* CacheKey, bool bTransient)
+{
+	if (!bUsable || bTransient)
+	{
+		return;
+	}
+
+	const FString Key(CacheKey);
+	FScopeLock AppendLock(&AppendCS);
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		if (!KeyEntries.Contains(Key))
+		{
+			return;
+		}
+	}
+
+	// The removal has to be recorded in the segment, otherwise the key would come back the next time the segments are scanned
+	FParsedRecord Record;
+	int32 SegmentId;
+	if (AppendRecord(true, Key, FSHAHash(), 0, TArrayView<const uint8>(), Record, SegmentId))
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		ApplyRecord(Record, SegmentId);
+	}
+	else
+	{
+		// Still drop it for this session
+		FWriteScopeLock WriteLock(IndexLock);
+		FKeyEntry Entry;
+		if (KeyEntries.RemoveAndCopyValue(Key, Entry))
+		{
+			AddDeadBytes(Entry.SegmentId, Entry.RecordSize);
+			ReleaseContent(Entry.ContentHash);
+		}
+	}
+	ConditionallyStartCompaction();
+}
+
+void FSegmentedFileDerivedDataBackend::GatherUsageStats(TMap<FString, FDerivedDataCacheUsageStats>& UsageStatsMap, FString&& GraphPath)
+{
+	COOK_STAT(UsageStatsMap.Add(FString::Printf(TEXT("%s: %s.%s"), *GraphPath, TEXT("Segmented"), *CachePath), UsageStats));
+}
+
+void FSegmentedFileDerivedDataBackend::LoadIndex()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FString> SegmentFiles;
+	IFileManager::Get().FindFiles(SegmentFiles, *(CachePath / TEXT("*.seg")), true, false);
+
+	TMap<int32, int64> FileSizes;
+	for (const FString& SegmentFile : SegmentFiles)
+	{
+		const FString BaseName = FPaths::GetBaseFilename(SegmentFile);
+		if (BaseName.IsEmpty() || !BaseName.IsNumeric())
+		{
+			continue;
+		}
+
+		TUniquePtr<FSegment> Segment = MakeUnique<FSegment>();
+		Segment->Id = FCString::Atoi(*BaseName);
+		Segment->Filename = CachePath / SegmentFile;
+		const int64 FileSize = IFileManager::Get().FileSize(*Segment->Filename);
+		if (FileSize <= 0)
+		{
+			IFileManager::Get().Delete(*Segment->Filename, false, false, true);
+			continue;
+		}
+		OpenSegmentForReading(*Segment, FileSize);
+		FileSizes.Add(Segment->Id, FileSize);
+		NextSegmentId = FMath::Max(NextSegmentId, Segment->Id + 1);
+		Segments.Add(MoveTemp(Segment));
+	}
+	Algo::SortBy(Segments, [](const TUniquePtr<FSegment>& Segment) { return Segment->Id; });
+
+	// The snapshot records how much of each segment it covers; it is only usable if every segment it names is still there
+	TSet<int32> SnapshotSegments;
+	TArray<uint8> SnapshotData;
+	if (FFileHelper::LoadFileToArray(SnapshotData, *(CachePath / TEXT("Segments.idx")), FILEREAD_Silent))
+	{
+		FMemoryReader Ar(SnapshotData);
+		uint32 Magic = 0;
+		uint32 Version = 0;
+		Ar << Magic << Version;
+
+		bool bValid = Magic == SegmentIndex_Magic && Version == SegmentIndex_Version;
+		if (bValid)
+		{
+			int32 NumSegments = 0;
+			Ar << NumSegments;
+			for (int32 Index = 0; Index < NumSegments && bValid && !Ar.IsError(); ++Index)
+			{
+				int32 Id = 0;
+				int64 Size = 0;
+				int64 DeadBytes = 0;
+				Ar << Id << Size << DeadBytes;
+				FSegment* Segment = FindSegment(Id);
+				const int64* FileSize = FileSizes.Find(Id);
+				bValid = Segment && FileSize && *FileSize >= Size;
+				if (bValid)
+				{
+					Segment->Size = Size;
+					Segment->DeadBytes = DeadBytes;
+					SnapshotSegments.Add(Id);
+				}
+			}
+
+			int32 NumContents = 0;
+			Ar << NumContents;
+			for (int32 Index = 0; Index < NumContents && bValid && !Ar.IsError(); ++Index)
+			{
+				FSHAHash ContentHash;
+				FContentLocation Location;
+				Ar << ContentHash << Location.SegmentId << Location.PayloadOffset << Location.RawSize << Location.StoredSize;
+				Location.NumRefs = 0;
+				ContentLocations.Add(ContentHash, Location);
+			}
+
+			int32 NumKeys = 0;
+			Ar << NumKeys;
+			KeyEntries.Reserve(NumKeys);
+			for (int32 Index = 0; Index < NumKeys && bValid && !Ar.IsError(); ++Index)
+			{
+				FString Key;
+				FKeyEntry Entry;
+				Ar << Key << Entry.ContentHash << Entry.SegmentId << Entry.RecordOffset << Entry.RecordSize << Entry.OldestSegmentId;
+				FContentLocation* Location = ContentLocations.Find(Entry.ContentHash);
+				bValid = Location != nullptr;
+				if (bValid)
+				{
+					++Location->NumRefs;
+					KeyEntries.Add(MoveTemp(Key), Entry);
+				}
+			}
+
+			int32 NumRemovedKeys = 0;
+			Ar << NumRemovedKeys;
+			for (int32 Index = 0; Index < NumRemovedKeys && bValid && !Ar.IsError(); ++Index)
+			{
+				FString Key;
+				int32 OldestSegmentId = 0;
+				Ar << Key << OldestSegmentId;
+				RemovedKeys.Add(MoveTemp(Key), OldestSegmentId);
+			}
+			bValid = bValid && !Ar.IsError();
+		}
+
+		if (!bValid)
+		{
+			UE_LOG(LogDerivedDataCache, Display, TEXT("Segmented cache %s index is out of date, rebuilding it from the segments."), *CachePath);
+			SnapshotSegments.Empty();
+			KeyEntries.Empty();
+			ContentLocations.Empty();
+			RemovedKeys.Empty();
+			for (TUniquePtr<FSegment>& Segment : Segments)
+			{
+				Segment->Size = 0;
+				Segment->DeadBytes = 0;
+			}
+		}
+	}
+
+	// Anything written after the snapshot, or everything if there was none, is recovered by scanning the records
+	for (TUniquePtr<FSegment>& Segment : Segments)
+	{
+		const int64 StartOffset = SnapshotSegments.Contains(Segment->Id) ? Segment->Size : 0;
+		const int32 SegmentId = Segment->Id;
+		Segment->Size = ScanSegment(*Segment, StartOffset, [this, SegmentId](const FParsedRecord& Record)
+		{
+			ApplyRecord(Record, SegmentId, /*bLoading=*/ true);
+		});
+
+		const int64 FileSize = FileSizes.FindChecked(SegmentId);
+		if (Segment->Size < FileSize)
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s ignoring %lld bytes of incomplete records at the end of %s."), *CachePath, FileSize - Segment->Size, *Segment->Filename);
+		}
+	}
+
+	// Keys scanned before their value are only garbage if the value was not found in a later segment either
+	for (TMap<FString, FKeyEntry>::TIterator It(KeyEntries); It; ++It)
+	{
+		const FContentLocation* Location = ContentLocations.Find(It.Value().ContentHash);
+		if (!Location || Location->SegmentId == INDEX_NONE)
+		{
+			AddDeadBytes(It.Value().SegmentId, It.Value().RecordSize);
+			It.RemoveCurrent();
+		}
+	}
+
+	// Values that lost all of their keys while nothing was tracking references are dead
+	for (TMap<FSHAHash, FContentLocation>::TIterator It(ContentLocations); It; ++It)
+	{
+		if (It.Value().NumRefs == 0 || It.Value().SegmentId == INDEX_NONE)
+		{
+			AddDeadBytes(It.Value().SegmentId, It.Value().StoredSize);
+			It.RemoveCurrent();
+		}
+	}
+
+	UE_LOG(LogDerivedDataCache, Display, TEXT("Segmented cache %s loaded %d keys referring to %d values in %d segments in %.2fs."),
+		*CachePath, KeyEntries.Num(), ContentLocations.Num(), Segments.Num(), FPlatformTime::Seconds() - StartTime);
+
+	// Compaction is not started from here because the backend graph is still being constructed; the first put or remove picks it up
+}
+
+bool FSegmentedFileDerivedDataBackend::SaveIndex()
+{
+	TArray<uint8> SnapshotData;
+	FMemoryWriter Ar(SnapshotData);
+	{
+		FReadScopeLock ReadLock(IndexLock);
+
+		uint32 Magic = SegmentIndex_Magic;
+		uint32 Version = SegmentIndex_Version;
+		Ar << Magic << Version;
+
+		int32 NumSegments = Segments.Num();
+		Ar << NumSegments;
+		for (TUniquePtr<FSegment>& Segment : Segments)
+		{
+			Ar << Segment->Id << Segment->Size << Segment->DeadBytes;
+		}
+
+		int32 NumContents = ContentLocations.Num();
+		Ar << NumContents;
+		for (TPair<FSHAHash, FContentLocation>& Pair : ContentLocations)
+		{
+			Ar << Pair.Key << Pair.Value.SegmentId << Pair.Value.PayloadOffset << Pair.Value.RawSize << Pair.Value.StoredSize;
+		}
+
+		int32 NumKeys = KeyEntries.Num();
+		Ar << NumKeys;
+		for (TPair<FString, FKeyEntry>& Pair : KeyEntries)
+		{
+			Ar << Pair.Key << Pair.Value.ContentHash << Pair.Value.SegmentId << Pair.Value.RecordOffset << Pair.Value.RecordSize << Pair.Value.OldestSegmentId;
+		}
+
+		int32 NumRemovedKeys = RemovedKeys.Num();
+		Ar << NumRemovedKeys;
+		for (TPair<FString, int32>& Pair : RemovedKeys)
+		{
+			Ar << Pair.Key << Pair.Value;
+		}
+	}
+
+	// Write to a temporary file first so that a crash never leaves a truncated snapshot behind
+	const FString IndexFilename = CachePath / TEXT("Segments.idx");
+	const FString TempFilename = IndexFilename + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(SnapshotData, *TempFilename) || !IFileManager::Get().Move(*IndexFilename, *TempFilename, true, true, false, true))
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s could not save its index, the segments will be scanned on the next run."), *CachePath);
+		return false;
+	}
+	return true;
+}
+
+void FSegmentedFileDerivedDataBackend::ApplyRecord(const FParsedRecord& Record, int32 SegmentId, bool bLoading)
+{
+	if (Record.bRemove)
+	{
+		FKeyEntry Entry;
+		if (KeyEntries.RemoveAndCopyValue(Record.Key, Entry))
+		{
+			AddDeadBytes(Entry.SegmentId, Entry.RecordSize);
+			ReleaseContent(Entry.ContentHash);
+			RemovedKeys.Add(Record.Key, Entry.OldestSegmentId);
+		}
+		return;
+	}
+
+	if (Record.StoredSize > 0)
+	{
+		FContentLocation* Location = ContentLocations.Find(Record.ContentHash);
+		if (!Location)
+		{
+			ContentLocations.Add(Record.ContentHash, FContentLocation{ SegmentId, Record.PayloadOffset, Record.RawSize, Record.StoredSize, 0 });
+		}
+		else
+		{
+			// A later copy of the same value, written by compaction, supersedes the earlier one.
+			// While loading, this also resolves keys that were scanned before the copy.
+			AddDeadBytes(Location->SegmentId, Location->StoredSize);
+			Location->SegmentId = SegmentId;
+			Location->PayloadOffset = Record.PayloadOffset;
+			Location->StoredSize = Record.StoredSize;
+		}
+	}
+
+	if (Record.Key.IsEmpty())
+	{
+		// Payload only records are written by compaction for values whose keys live elsewhere
+		AddDeadBytes(SegmentId, Record.RecordSize);
+		return;
+	}
+
+	FContentLocation* Location = ContentLocations.Find(Record.ContentHash);
+	if (!Location)
+	{
+		if (!bLoading)
+		{
+			// The value this key refers to was removed before the key was written, which only happens for garbage
+			AddDeadBytes(SegmentId, Record.RecordSize);
+			return;
+		}
+
+		// Compaction moves the payload of a deduplicated key to the end of the log, which can be after the key itself
+		Location = &ContentLocations.Add(Record.ContentHash, FContentLocation{ INDEX_NONE, 0, Record.RawSize, 0, 0 });
+	}
+	++Location->NumRefs;
+
+	int32 OldestSegmentId = SegmentId;
+	int32 RemovedOldestSegmentId;
+	if (RemovedKeys.RemoveAndCopyValue(Record.Key, RemovedOldestSegmentId))
+	{
+		OldestSegmentId = FMath::Min(OldestSegmentId, RemovedOldestSegmentId);
+	}
+
+	FKeyEntry& Entry = KeyEntries.FindOrAdd(Record.Key, FKeyEntry{ FSHAHash(), INDEX_NONE, 0, 0, SegmentId });
+	if (Entry.SegmentId != INDEX_NONE)
+	{
+		AddDeadBytes(Entry.SegmentId, Entry.RecordSize);
+		ReleaseContent(Entry.ContentHash);
+		OldestSegmentId = FMath::Min(OldestSegmentId, Entry.OldestSegmentId);
+	}
+	Entry.ContentHash = Record.ContentHash;
+	Entry.SegmentId = SegmentId;
+	Entry.RecordOffset = Record.RecordOffset;
+	Entry.RecordSize = Record.RecordSize;
+	Entry.OldestSegmentId = OldestSegmentId;
+}
+
+int64 FSegmentedFileDerivedDataBackend::ScanSegment(FSegment& Segment, int64 StartOffset, TFunctionRef<void(const FParsedRecord&)> Visitor)
+{
+	const int64 FileSize = Segment.MappedRegion ? Segment.MappedRegion->GetMappedSize() : (Segment.ReadHandle ? Segment.ReadHandle->Size() : 0);
+	TArray<ANSICHAR> KeyBuffer;
+
+	int64 Offset = StartOffset;
+	while (Offset + SegmentRecordHeaderSize <= FileSize)
+	{
+		uint8 HeaderBytes[SegmentRecordHeaderSize];
+		if (!ReadSegmentBytes(Segment, Offset, HeaderBytes, SegmentRecordHeaderSize))
+		{
+			break;
+		}
+
+		uint32 Magic;
+		uint32 KeyLength;
+		FParsedRecord Record;
+		FMemoryReaderView HeaderReader(MakeArrayView(HeaderBytes));
+		HeaderReader << Magic << KeyLength << Record.RawSize << Record.StoredSize << Record.ContentHash;
+
+		const int64 RecordEnd = Offset + SegmentRecordHeaderSize + KeyLength + Record.StoredSize;
+		if ((Magic != SegmentRecord_Magic && Magic != SegmentRemove_Magic) || KeyLength > SegmentMaxKeyLength || Record.StoredSize > Record.RawSize || RecordEnd > FileSize)
+		{
+			break;
+		}
+
+		KeyBuffer.SetNumUninitialized(KeyLength + 1);
+		if (!ReadSegmentBytes(Segment, Offset + SegmentRecordHeaderSize, (uint8*)KeyBuffer.GetData(), KeyLength))
+		{
+			break;
+		}
+		KeyBuffer[KeyLength] = 0;
+
+		Record.bRemove = Magic == SegmentRemove_Magic;
+		Record.Key = UTF8_TO_TCHAR(KeyBuffer.GetData());
+		Record.RecordOffset = Offset;
+		Record.PayloadOffset = Offset + SegmentRecordHeaderSize + KeyLength;
+		Record.RecordSize = uint32(SegmentRecordHeaderSize + KeyLength);
+		Visitor(Record);
+
+		Offset = RecordEnd;
+	}
+	return Offset;
+}
+
+bool FSegmentedFileDerivedDataBackend::AppendRecord(bool bRemove, const FString& Key, const FSHAHash& ContentHash, uint32 RawSize, TArrayView<const uint8> StoredData, FParsedRecord& OutRecord, int32& OutSegmentId)
+{
+	FTCHARToUTF8 KeyUtf8(*Key);
+	uint32 KeyLength = KeyUtf8.Length();
+	if (KeyLength > SegmentMaxKeyLength)
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s could not write %s, the key is longer than %u bytes."), *CachePath, *Key, SegmentMaxKeyLength);
+		return false;
+	}
+
+	TArray<uint8> RecordData;
+	RecordData.Reserve(SegmentRecordHeaderSize + KeyLength + StoredData.Num());
+	FMemoryWriter Ar(RecordData);
+	uint32 Magic = bRemove ? SegmentRemove_Magic : SegmentRecord_Magic;
+	uint32 StoredSize = StoredData.Num();
+	FSHAHash Hash = ContentHash;
+	Ar << Magic << KeyLength << RawSize << StoredSize << Hash;
+	Ar.Serialize(const_cast<ANSICHAR*>(KeyUtf8.Get()), KeyLength);
+	Ar.Serialize(const_cast<uint8*>(StoredData.GetData()), StoredData.Num());
+	check(RecordData.Num() == SegmentRecordHeaderSize + KeyLength + StoredData.Num());
+
+	FSegment* Segment = ActiveSegmentId != INDEX_NONE ? FindSegment(ActiveSegmentId) : nullptr;
+	if (Segment && Segment->Size > 0 && Segment->Size + RecordData.Num() > MaxSegmentSize)
+	{
+		SealActiveSegment();
+		Segment = nullptr;
+	}
+
+	if (!Segment)
+	{
+		TUniquePtr<FSegment> NewSegment = MakeUnique<FSegment>();
+		NewSegment->Id = NextSegmentId++;
+		NewSegment->Filename = CachePath / FString::Printf(TEXT("%08d.seg"), NewSegment->Id);
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		ActiveWriteHandle.Reset(PlatformFile.OpenWrite(*NewSegment->Filename, false, true));
+		NewSegment->ReadHandle.Reset(PlatformFile.OpenRead(*NewSegment->Filename, true));
+		if (!ActiveWriteHandle || !NewSegment->ReadHandle)
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s could not create segment %s."), *CachePath, *NewSegment->Filename);
+			ActiveWriteHandle.Reset();
+			return false;
+		}
+
+		Segment = NewSegment.Get();
+		ActiveSegmentId = Segment->Id;
+		FWriteScopeLock WriteLock(IndexLock);
+		Segments.Add(MoveTemp(NewSegment));
+	}
+
+	if (!ActiveWriteHandle->Write(RecordData.GetData(), RecordData.Num()) || !ActiveWriteHandle->Flush())
+	{
+		// Whatever made it to disk is an incomplete record that the next scan will stop at, so never append after it
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s failed to write to %s...out of disk space?"), *CachePath, *Segment->Filename);
+		SealActiveSegment();
+		return false;
+	}
+
+	OutRecord.bRemove = bRemove;
+	OutRecord.Key = Key;
+	OutRecord.ContentHash = ContentHash;
+	OutRecord.RawSize = RawSize;
+	OutRecord.StoredSize = StoredSize;
+	OutRecord.RecordOffset = Segment->Size;
+	OutRecord.PayloadOffset = Segment->Size + SegmentRecordHeaderSize + KeyLength;
+	OutRecord.RecordSize = uint32(SegmentRecordHeaderSize + KeyLength);
+	OutSegmentId = Segment->Id;
+	Segment->Size += RecordData.Num();
+	return true;
+}
+
+void FSegmentedFileDerivedDataBackend::SealActiveSegment()
+{
+	if (ActiveSegmentId == INDEX_NONE)
+	{
+		return;
+	}
+
+	ActiveWriteHandle.Reset();
+	FSegment* Segment = FindSegment(ActiveSegmentId);
+	ActiveSegmentId = INDEX_NONE;
+	if (Segment && Segment->Size > 0)
+	{
+		FWriteScopeLock WriteLock(IndexLock);
+		OpenSegmentForReading(*Segment, Segment->Size);
+	}
+}
+
+void FSegmentedFileDerivedDataBackend::OpenSegmentForReading(FSegment& Segment, int64 FileSize)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	Segment.MappedHandle.Reset(PlatformFile.OpenMapped(*Segment.Filename));
+	if (Segment.MappedHandle)
+	{
+		Segment.MappedRegion.Reset(Segment.MappedHandle->MapRegion(0, FileSize));
+	}
+
+	if (Segment.MappedRegion)
+	{
+		Segment.ReadHandle.Reset();
+	}
+	else
+	{
+		Segment.MappedHandle.Reset();
+		if (!Segment.ReadHandle)
+		{
+			Segment.ReadHandle.Reset(PlatformFile.OpenRead(*Segment.Filename));
+		}
+	}
+}
+
+bool FSegmentedFileDerivedDataBackend::ReadSegmentBytes(FSegment& Segment, int64 Offset, uint8* Destination, int64 Size)
+{
+	if (Segment.MappedRegion)
+	{
+		if (Offset < 0 || Offset + Size > Segment.MappedRegion->GetMappedSize())
+		{
+			return false;
+		}
+		FMemory::Memcpy(Destination, Segment.MappedRegion->GetMappedPtr() + Offset, Size);
+		return true;
+	}
+
+	FScopeLock ReadHandleLock(&Segment.ReadHandleCS);
+	return Segment.ReadHandle && Segment.ReadHandle->Seek(Offset) && Segment.ReadHandle->Read(Destination, Size);
+}
+
+bool FSegmentedFileDerivedDataBackend::DecodePayload(const TCHAR* CacheKey, const FSHAHash& ContentHash, uint32 RawSize, TArray<uint8>& StoredData, TArray<uint8>& OutData)
+{
+	if (uint32(StoredData.Num()) == RawSize)
+	{
+		OutData = MoveTemp(StoredData);
+	}
+	else
+	{
+		OutData.SetNumUninitialized(RawSize);
+		if (!FCompression::UncompressMemory(SegmentCompressionFormat, OutData.GetData(), RawSize, StoredData.GetData(), StoredData.Num(), SegmentCompressionFlags))
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s failed to decompress %s, removing it."), *CachePath, CacheKey);
+			return false;
+		}
+	}
+
+	FSHAHash DataHash;
+	FSHA1::HashBuffer(OutData.GetData(), OutData.Num(), DataHash.Hash);
+	if (DataHash != ContentHash)
+	{
+		UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s has corrupted data for %s, removing it."), *CachePath, CacheKey);
+		return false;
+	}
+	return true;
+}
+
+void FSegmentedFileDerivedDataBackend::AddDeadBytes(int32 SegmentId, int64 Bytes)
+{
+	if (FSegment* Segment = FindSegment(SegmentId))
+	{
+		Segment->DeadBytes += Bytes;
+	}
+}
+
+void FSegmentedFileDerivedDataBackend::ReleaseContent(const FSHAHash& ContentHash)
+{
+	FContentLocation* Location = ContentLocations.Find(ContentHash);
+	if (Location && --Location->NumRefs <= 0)
+	{
+		AddDeadBytes(Location->SegmentId, Location->StoredSize);
+		ContentLocations.Remove(ContentHash);
+	}
+}
+
+FSegmentedFileDerivedDataBackend::FSegment* FSegmentedFileDerivedDataBackend::FindSegment(int32 SegmentId)
+{
+	for (TUniquePtr<FSegment>& Segment : Segments)
+	{
+		if (Segment->Id == SegmentId)
+		{
+			return Segment.Get();
+		}
+	}
+	return nullptr;
+}
+
+void FSegmentedFileDerivedDataBackend::ConditionallyStartCompaction()
+{
+	if (CompactionThreshold <= 0.0f || bCompactionRunning)
+	{
+		return;
+	}
+
+	bool bNeedsCompaction = false;
+	{
+		FReadScopeLock ReadLock(IndexLock);
+		for (const TUniquePtr<FSegment>& Segment : Segments)
+		{
+			if (Segment->Id != ActiveSegmentId && Segment->Size > 0 && Segment->DeadBytes >= int64(Segment->Size * CompactionThreshold))
+			{
+				bNeedsCompaction = true;
+				break;
+			}
+		}
+	}
+
+	bool bExpected = false;
+	if (bNeedsCompaction && bCompactionRunning.compare_exchange_strong(bExpected, true))
+	{
+		FDerivedDataBackend::Get().AddToAsyncCompletionCounter(1);
+		CompactionTask = Async(EAsyncExecution::ThreadPool, [this]()
+		{
+			CompactSegments();
+			bCompactionRunning = false;
+			FDerivedDataBackend::Get().AddToAsyncCompletionCounter(-1);
+		});
+	}
+}
+
+void FSegmentedFileDerivedDataBackend::GetRecordLiveness(const FParsedRecord& Record, int32 SegmentId, bool& bOutKeyLive, bool& bOutPayloadLive) const
+{
+	bOutKeyLive = false;
+	bOutPayloadLive = false;
+
+	if (Record.bRemove)
+	{
+		// A removal only has to be kept while a segment older than this one may still hold a put of the key that it shadows.
+		// Puts earlier in this segment are dropped along with it, and a key that was put again needs no removal at all.
+		const int32* OldestSegmentId = KeyEntries.Contains(Record.Key) ? nullptr : RemovedKeys.Find(Record.Key);
+		if (OldestSegmentId)
+		{
+			for (const TUniquePtr<FSegment>& Segment : Segments)
+			{
+				if (Segment->Id >= *OldestSegmentId && Segment->Id < SegmentId)
+				{
+					bOutKeyLive = true;
+					break;
+				}
+			}
+		}
+		return;
+	}
+
+	const FKeyEntry* Entry = Record.Key.IsEmpty() ? nullptr : KeyEntries.Find(Record.Key);
+	bOutKeyLive = Entry && Entry->SegmentId == SegmentId && Entry->RecordOffset == Record.RecordOffset;
+	const FContentLocation* Location = Record.StoredSize > 0 ? ContentLocations.Find(Record.ContentHash) : nullptr;
+	bOutPayloadLive = Location && Location->SegmentId == SegmentId && Location->PayloadOffset == Record.PayloadOffset;
+}
+
+void FSegmentedFileDerivedDataBackend::CompactSegments()
+{
+	// Puts and removes keep going while segments are compacted: the append lock is only held to copy one record at a time.
+	// Sealed segments are never written to and only compaction drops them, so they can be read here without any lock.
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<int32> Candidates;
+	{
+		FScopeLock AppendLock(&AppendCS);
+		FReadScopeLock ReadLock(IndexLock);
+		for (const TUniquePtr<FSegment>& Segment : Segments)
+		{
+			if (Segment->Id != ActiveSegmentId && Segment->Size > 0 && Segment->DeadBytes >= int64(Segment->Size * CompactionThreshold))
+			{
+				Candidates.Add(Segment->Id);
+			}
+		}
+	}
+
+	int64 BytesReclaimed = 0;
+	int32 NumCompacted = 0;
+	for (int32 SegmentId : Candidates)
+	{
+		FSegment* Segment;
+		{
+			FReadScopeLock ReadLock(IndexLock);
+			Segment = FindSegment(SegmentId);
+		}
+
+		bool bFailed = false;
+		ScanSegment(*Segment, 0, [this, Segment, SegmentId, &bFailed](const FParsedRecord& Record)
+		{
+			if (bFailed)
+			{
+				return;
+			}
+
+			bool bKeyLive;
+			bool bPayloadLive;
+			{
+				FReadScopeLock ReadLock(IndexLock);
+				GetRecordLiveness(Record, SegmentId, bKeyLive, bPayloadLive);
+			}
+			if (!bKeyLive && !bPayloadLive)
+			{
+				return;
+			}
+
+			TArray<uint8> StoredData;
+			if (bPayloadLive)
+			{
+				StoredData.SetNumUninitialized(Record.StoredSize);
+				if (!ReadSegmentBytes(*Segment, Record.PayloadOffset, StoredData.GetData(), StoredData.Num()))
+				{
+					bFailed = true;
+					return;
+				}
+			}
+
+			FScopeLock AppendLock(&AppendCS);
+			{
+				// A put or remove may have superseded the record since it was checked; records never become live again
+				FReadScopeLock ReadLock(IndexLock);
+				GetRecordLiveness(Record, SegmentId, bKeyLive, bPayloadLive);
+			}
+			if (!bKeyLive && !bPayloadLive)
+			{
+				return;
+			}
+			if (!bPayloadLive)
+			{
+				StoredData.Empty();
+			}
+
+			FParsedRecord NewRecord;
+			int32 NewSegmentId;
+			if (!AppendRecord(Record.bRemove, bKeyLive ? Record.Key : FString(), Record.ContentHash, Record.RawSize, StoredData, NewRecord, NewSegmentId))
+			{
+				bFailed = true;
+				return;
+			}
+			FWriteScopeLock WriteLock(IndexLock);
+			ApplyRecord(NewRecord, NewSegmentId);
+		});
+
+		if (bFailed)
+		{
+			UE_LOG(LogDerivedDataCache, Warning, TEXT("Segmented cache %s failed to compact %s, keeping it."), *CachePath, *Segment->Filename);
+			break;
+		}
+
+		FString Filename = Segment->Filename;
+		{
+			FWriteScopeLock WriteLock(IndexLock);
+			BytesReclaimed += Segment->DeadBytes;
+			Segments.RemoveAll([SegmentId](const TUniquePtr<FSegment>& Item) { return Item->Id == SegmentId; });
+		}
+		IFileManager::Get().Delete(*Filename, false, false, true);
+		++NumCompacted;
+	}
+
+	if (NumCompacted > 0)
+	{
+		// The old snapshot names the deleted segments, replace it so the next run does not need a full scan.
+		// Appends grow the segments before they update the index, so the snapshot is taken under the append lock.
+		{
+			FScopeLock AppendLock(&AppendCS);
+			SaveIndex();
+		}
+		UE_LOG(LogDerivedDataCache, Display, TEXT("Segmented cache %s compacted %d segments and reclaimed %.1f MB in %.2fs."),
+			*CachePath, NumCompacted, double(BytesReclaimed) / (1024.0 * 1024.0), FPlatformTime::Seconds() - StartTime);
+	}
+}
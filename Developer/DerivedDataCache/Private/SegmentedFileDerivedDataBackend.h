@@ -0,0 +1,219 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DerivedDataBackendInterface.h"
+#include "ProfilingDebugging/CookStats.h"
+#include "DerivedDataCacheUsageStats.h"
+#include "Async/Future.h"
+#include "Misc/SecureHash.h"
+#include "Templates/UniquePtr.h"
+#include <atomic>
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * A local backend that packs cache values into large append-only segment files instead of one file per key.
+ *
+ * Values are compressed and addressed by the SHA1 of their uncompressed contents, so identical values stored under
+ * different keys share one payload. Sealed segments are memory mapped and the key index lives in memory, so a get is
+ * an index lookup plus a copy out of the mapping, and batched gets resolve many keys with reads sorted by location.
+ * Segments whose live data drops below a threshold are compacted in the background.
+**/
+class FSegmentedFileDerivedDataBackend : public FDerivedDataBackendInterface
+{
+public:
+	/**
+	 * Constructor
+	 *
+	 * @param	InCachePath				Directory holding the segment files and the index
+	 * @param	InMaxSegmentSize		Size in bytes after which the active segment is sealed and a new one is started
+	 * @param	InCompactionThreshold	Fraction of dead bytes in a sealed segment that triggers its compaction
+	 */
+	FSegmentedFileDerivedDataBackend(const TCHAR* InCachePath, int64 InMaxSegmentSize, float InCompactionThreshold);
+	~FSegmentedFileDerivedDataBackend();
+
+	/** return true if the cache directory could be opened and the index was loaded **/
+	bool IsUsable() const
+	{
+		return bUsable;
+	}
+
+	/** return true if the cache is not usable because another process holds the lock on its directory **/
+	bool IsLockedByAnotherProcess() const
+	{
+		return bLockedByAnotherProcess;
+	}
+
+	/** Return a name for this interface */
+	virtual FString GetName() const override
+	{
+		return CachePath;
+	}
+
+	/** return true if this cache is writable **/
+	virtual bool IsWritable() override
+	{
+		return bUsable;
+	}
+
+	/** Returns a class of speed for this interface **/
+	virtual ESpeedClass GetSpeedClass() override
+	{
+		return ESpeedClass::Local;
+	}
+
+	virtual bool CachedDataProbablyExists(const TCHAR* CacheKey) override;
+	virtual TBitArray<> CachedDataProbablyExistsBatch(TConstArrayView<FString> CacheKeys) override;
+	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData) override;
+	virtual TBitArray<> GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData) override;
+	virtual EPutStatus PutCachedData(const TCHAR* CacheKey, TArrayView<const uint8> InData, bool bPutEvenIfExists) override;
+	virtual void RemoveCachedData(const TCHAR* CacheKey, bool bTransient) override;
+	virtual void GatherUsageStats(TMap<FString, FDerivedDataCacheUsageStats>& UsageStatsMap, FString&& GraphPath) override;
+
+	virtual bool TryToPrefetch(const TCHAR* CacheKey) override { return false; }
+
+	virtual bool WouldCache(const TCHAR* CacheKey, TArrayView<const uint8> InData) override { return true; }
+
+	virtual bool ApplyDebugOptions(FBackendDebugOptions& InOptions) override { return false; }
+
+private:
+	/** One append-only file of records. Only the segment with the highest id is written to, all others are sealed. */
+	struct FSegment
+	{
+		int32 Id = 0;
+		FString Filename;
+		/** Bytes of valid records in the file */
+		int64 Size = 0;
+		/** Bytes of records and payloads that have been superseded or removed */
+		int64 DeadBytes = 0;
+		/** Mapping of the whole file once the segment is sealed */
+		TUniquePtr<IMappedFileHandle> MappedHandle;
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+		/** Fallback used for the active segment and on platforms without mapped files */
+		TUniquePtr<IFileHandle> ReadHandle;
+		FCriticalSection ReadHandleCS;
+	};
+
+	/** Where the compressed bytes of a unique value are stored */
+	struct FContentLocation
+	{
+		int32 SegmentId;
+		int64 PayloadOffset;
+		uint32 RawSize;
+		uint32 StoredSize;
+		int32 NumRefs;
+	};
+
+	/** Which value a key refers to and where the record that says so lives */
+	struct FKeyEntry
+	{
+		FSHAHash ContentHash;
+		int32 SegmentId;
+		int64 RecordOffset;
+		uint32 RecordSize;
+		/** Lowest segment that may still hold a superseded record of the key */
+		int32 OldestSegmentId;
+	};
+
+	/** A record parsed out of a segment, offsets are relative to the start of the segment */
+	struct FParsedRecord
+	{
+		bool bRemove;
+		FString Key;
+		FSHAHash ContentHash;
+		uint32 RawSize;
+		uint32 StoredSize;
+		int64 RecordOffset;
+		int64 PayloadOffset;
+		/** Size of the header and key, the payload is accounted for by the content */
+		uint32 RecordSize;
+	};
+
+	/** Loads the index snapshot if it is valid, then scans every record written after it */
+	void LoadIndex();
+	/** Writes an index snapshot covering all records written so far. Must hold AppendCS. */
+	bool SaveIndex();
+	/**
+	 * Applies a record to the in-memory index, in the order the records were written.
+	 * While loading, a key whose value has not been seen yet is kept, because compaction may have moved the value to a later
+	 * segment; LoadIndex drops the keys whose value never turned up once every segment has been scanned.
+	 */
+	void ApplyRecord(const FParsedRecord& Record, int32 SegmentId, bool bLoading = false);
+	/** Parses records from a segment starting at the given offset, returns the offset past the last complete record */
+	int64 ScanSegment(FSegment& Segment, int64 StartOffset, TFunctionRef<void(const FParsedRecord&)> Visitor);
+
+	/** Appends a record to the active segment, starting a new segment when it is full. Must hold AppendCS. */
+	bool AppendRecord(bool bRemove, const FString& Key, const FSHAHash& ContentHash, uint32 RawSize, TArrayView<const uint8> StoredData, FParsedRecord& OutRecord, int32& OutSegmentId);
+	/** Seals the active segment, if any, and maps it for reading. Must hold AppendCS. */
+	void SealActiveSegment();
+	/** Copies bytes of a segment into the destination. Must hold IndexLock, unless the caller is compaction reading a sealed segment. */
+	bool ReadSegmentBytes(FSegment& Segment, int64 Offset, uint8* Destination, int64 Size);
+	/** Maps a sealed segment for reading, falling back to a file handle if mapping is not supported */
+	void OpenSegmentForReading(FSegment& Segment, int64 FileSize);
+	/** Decompresses stored bytes and checks them against the content hash */
+	bool DecodePayload(const TCHAR* CacheKey, const FSHAHash& ContentHash, uint32 RawSize, TArray<uint8>& StoredData, TArray<uint8>& OutData);
+
+	/** Adds bytes that are no longer reachable to the dead byte count of their segment. Must hold IndexLock for writing. */
+	void AddDeadBytes(int32 SegmentId, int64 Bytes);
+	/** Drops a reference to a value, marking its payload as dead once nothing refers to it. Must hold IndexLock for writing. */
+	void ReleaseContent(const FSHAHash& ContentHash);
+	FSegment* FindSegment(int32 SegmentId);
+
+	/** Starts compaction on the thread pool if a sealed segment has crossed the dead byte threshold */
+	void ConditionallyStartCompaction();
+	/** Rewrites the live records of sealed segments above the threshold into the active segment and deletes them */
+	void CompactSegments();
+	/** Whether compaction has to copy the key and the payload of a record. Must hold IndexLock. */
+	void GetRecordLiveness(const FParsedRecord& Record, int32 SegmentId, bool& bOutKeyLive, bool& bOutPayloadLive) const;
+
+	FDerivedDataCacheUsageStats UsageStats;
+
+	/** Directory holding the segments and the index */
+	FString CachePath;
+	/** Size in bytes after which the active segment is sealed */
+	int64 MaxSegmentSize;
+	/** Fraction of dead bytes in a sealed segment that triggers its compaction */
+	float CompactionThreshold;
+	/** false if the directory could not be used */
+	bool bUsable;
+	/** true if another process holds Segments.lock */
+	bool bLockedByAnotherProcess;
+
+	/** Guards Segments, KeyEntries and ContentLocations. Readers hold it while copying bytes out of a segment. */
+	mutable FRWLock IndexLock;
+	/** Serializes everything that appends to segments or changes the index. Compaction only takes it for each record it copies. */
+	FCriticalSection AppendCS;
+
+	TArray<TUniquePtr<FSegment>> Segments;
+	TMap<FString, FKeyEntry> KeyEntries;
+	TMap<FSHAHash, FContentLocation> ContentLocations;
+	/** Lowest segment that may still hold a record of each removed key; a removal record is only kept while such a segment exists */
+	TMap<FString, int32> RemovedKeys;
+
+	/** Segment currently being appended to, INDEX_NONE until the first put of this session */
+	int32 ActiveSegmentId;
+	TUniquePtr<IFileHandle> ActiveWriteHandle;
+	int32 NextSegmentId;
+
+	/** Held open while the backend is alive so that a second process does not append to the same segments */
+	TUniquePtr<IFileHandle> LockFileHandle;
+
+	/** Set while a compaction task is queued or running */
+	std::atomic<bool> bCompactionRunning;
+	TFuture<void> CompactionTask;
+
+	enum
+	{
+		/** Magic number at the start of a value record */
+		SegmentRecord_Magic = 0x5e6dd0c0,
+		/** Magic number at the start of a removal record */
+		SegmentRemove_Magic = 0x5e6dd0c1,
+		/** Magic number and version of the index snapshot */
+		SegmentIndex_Magic = 0x5e6dd0c2,
+		SegmentIndex_Version = 2,
+	};
+};
@@ -138,6 +138,28 @@ public:
 	 * @return				true if any data was found, and in this case OutData is non-empty
 	 */
 	virtual bool GetCachedData(const TCHAR* CacheKey, TArray<uint8>& OutData)=0;
+
+	/**
+	 * Synchronous retrieve of multiple cache items. Backends that can resolve many keys more cheaply together than one
+	 * at a time (e.g. by sorting reads by location) should override this.
+	 *
+	 * @param	CacheKeys	Alphanumeric+underscore key of the cache items
+	 * @param	OutData		Receives one buffer per key, empty for keys that were not found
+	 * @return				A bit array with bits indicating whether the data for the corresponding key was found
+	 */
+	virtual TBitArray<> GetCachedDataBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData)
+	{
+		TBitArray<> Result;
+		Result.Reserve(CacheKeys.Num());
+		OutData.Reset(CacheKeys.Num());
+		OutData.SetNum(CacheKeys.Num());
+		for (int32 KeyIndex = 0; KeyIndex < CacheKeys.Num(); ++KeyIndex)
+		{
+			Result.Add(GetCachedData(*CacheKeys[KeyIndex], OutData[KeyIndex]));
+		}
+		return Result;
+	}
+
 	/**
 	 * Asynchronous, fire-and-forget placement of a cache item
 	 *
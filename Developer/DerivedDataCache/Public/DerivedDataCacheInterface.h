@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "Containers/BitArray.h"
 #include "Containers/StringView.h"
+#include "Templates/Function.h"
 #include "Modules/ModuleInterface.h"
 
 class FDerivedDataCacheUsageStats;
@@ -177,6 +178,26 @@ public:
 	**/
 	virtual uint32 GetAsynchronous(const TCHAR* CacheKey, FStringView DebugContext) = 0;
 
+	/**
+	 * Synchronously checks the cache for multiple keys and retrieves the cached results of those that are present.
+	 * Backends that store many values together can resolve the whole batch with far fewer reads than one get per key.
+	 *
+	 * @param	CacheKeys		Keys to identify the data.
+	 * @param	OutData			Receives one buffer per key, empty for keys that were not found.
+	 * @param	DebugContext	A string used to describe the data being retrieved.
+	 * @return	A bit array with bits indicating whether the data for the corresponding key was retrieved.
+	**/
+	virtual TBitArray<> GetSynchronousBatch(TConstArrayView<FString> CacheKeys, TArray<TArray<uint8>>& OutData, FStringView DebugContext) = 0;
+
+	/**
+	 * Starts the async process of checking the cache for multiple keys and retrieving the cached results of those that are present.
+	 *
+	 * @param	CacheKeys		Keys to identify the data.
+	 * @param	DebugContext	A string used to describe the data being retrieved.
+	 * @param	OnComplete		Called from a worker thread with the hit bits and one buffer per key once the whole batch is resolved.
+	**/
+	virtual void GetAsynchronousBatch(TArray<FString> CacheKeys, FStringView DebugContext, TUniqueFunction<void(TBitArray<>&& bFound, TArray<TArray<uint8>>&& Data)> OnComplete) = 0;
+
 	/** 
 	 * Puts data into the cache. This is fire-and-forget and typically asynchronous.
 	 *
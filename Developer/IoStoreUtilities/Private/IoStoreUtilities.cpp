@@ -3693,20 +3693,39 @@ public:
 		StopEvent->Trigger();
 		ReporterThread.Wait();
 		FPlatformProcess::ReturnSynchEventToPool(StopEvent);
+
+		const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, 0.001);
+		FIoStoreWriterContext::FProgress Progress = WriterContext.GetProgress();
+		UE_LOG(LogIoStore, Display, TEXT("Average throughput over %.2lf seconds (MB/s) Hashed, Compressed, Serialized: %.2lf, %.2lf, %.2lf"),
+			ElapsedSeconds,
+			(double)Progress.HashedBytes / 1024.0 / 1024.0 / ElapsedSeconds,
+			(double)Progress.CompressedBytes / 1024.0 / 1024.0 / ElapsedSeconds,
+			(double)Progress.SerializedBytes / 1024.0 / 1024.0 / ElapsedSeconds);
 	}
 
 private:
 	void ReporterThreadFunc()
 	{
+		FIoStoreWriterContext::FProgress PreviousProgress = WriterContext.GetProgress();
+		double PreviousTime = StartTime;
 		while (!bStop.Load())
 		{
 			StopEvent->Wait(FTimespan::FromSeconds(2.0));
 			FIoStoreWriterContext::FProgress Progress = WriterContext.GetProgress();
-			UE_LOG(LogIoStore, Display, TEXT("Hashed, Compressed, Serialized: %lld, %lld, %lld / %lld"), Progress.HashedChunksCount, Progress.CompressedChunksCount, Progress.SerializedChunksCount, Progress.TotalChunksCount);
+			const double Time = FPlatformTime::Seconds();
+			const double IntervalSeconds = FMath::Max(Time - PreviousTime, 0.001);
+			UE_LOG(LogIoStore, Display, TEXT("Hashed, Compressed, Serialized: %lld, %lld, %lld / %lld (%.2lf, %.2lf, %.2lf MB/s)"),
+				Progress.HashedChunksCount, Progress.CompressedChunksCount, Progress.SerializedChunksCount, Progress.TotalChunksCount,
+				(double)(Progress.HashedBytes - PreviousProgress.HashedBytes) / 1024.0 / 1024.0 / IntervalSeconds,
+				(double)(Progress.CompressedBytes - PreviousProgress.CompressedBytes) / 1024.0 / 1024.0 / IntervalSeconds,
+				(double)(Progress.SerializedBytes - PreviousProgress.SerializedBytes) / 1024.0 / 1024.0 / IntervalSeconds);
+			PreviousProgress = Progress;
+			PreviousTime = Time;
 		}
 	}
 
 	const FIoStoreWriterContext& WriterContext;
+	const double StartTime = FPlatformTime::Seconds();
 	TFuture<void> ReporterThread;
 	FEvent* StopEvent;
 	TAtomic<bool> bStop{ false };
@@ -4028,12 +4047,30 @@ int32 CreateTarget(const FIoStoreArguments& Arguments, const FIoStoreWriterSetti
 
 	FIoStoreProgressReporter* IoStoreProgressReporter = new FIoStoreProgressReporter(*IoStoreWriterContext);
 
+	// Flush several containers at once so that the compression of containers using disk layout ordering, which only starts
+	// once the container is flushed, overlaps with the writing of the others
 	TArray<FIoStoreWriterResult> IoStoreWriterResults;
-	IoStoreWriterResults.Reserve(IoStoreWriters.Num());
-	for (FIoStoreWriter* IoStoreWriter : IoStoreWriters)
+	IoStoreWriterResults.SetNum(IoStoreWriters.Num());
 	{
-		IoStoreWriterResults.Emplace(IoStoreWriter->Flush().ConsumeValueOrDie());
-		delete IoStoreWriter;
+		TAtomic<int32> NextWriterIndex{ 0 };
+		TArray<TFuture<void>> FlushThreads;
+		const int32 FlushThreadCount = FMath::Clamp(GeneralIoWriterSettings.MaxConcurrentWriters, 1, FMath::Max(IoStoreWriters.Num(), 1));
+		for (int32 FlushThreadIndex = 0; FlushThreadIndex < FlushThreadCount; ++FlushThreadIndex)
+		{
+			FlushThreads.Add(Async(EAsyncExecution::Thread, [&IoStoreWriters, &IoStoreWriterResults, &NextWriterIndex]()
+			{
+				for (int32 WriterIndex = NextWriterIndex.IncrementExchange(); WriterIndex < IoStoreWriters.Num(); WriterIndex = NextWriterIndex.IncrementExchange())
+				{
+					IoStoreWriterResults[WriterIndex] = IoStoreWriters[WriterIndex]->Flush().ConsumeValueOrDie();
+					delete IoStoreWriters[WriterIndex];
+					IoStoreWriters[WriterIndex] = nullptr;
+				}
+			}));
+		}
+		for (TFuture<void>& FlushThread : FlushThreads)
+		{
+			FlushThread.Wait();
+		}
 	}
 	IoStoreWriters.Empty();
 
@@ -5750,6 +5787,8 @@ int32 CreateIoStoreContainerFiles(const TCHAR* CmdLine)
 
 	ParseSizeArgument(CmdLine, TEXT("-alignformemorymapping="), GeneralIoWriterSettings.MemoryMappingAlignment, DefaultMemoryMappingAlignment);
 	ParseSizeArgument(CmdLine, TEXT("-compressionblocksize="), GeneralIoWriterSettings.CompressionBlockSize, DefaultCompressionBlockSize);
+	ParseSizeArgument(CmdLine, TEXT("-compressionmemorylimit="), GeneralIoWriterSettings.CompressionMemoryLimit, GeneralIoWriterSettings.CompressionMemoryLimit);
+	FParse::Value(CmdLine, TEXT("-maxconcurrentwriters="), GeneralIoWriterSettings.MaxConcurrentWriters);
 		
 	GeneralIoWriterSettings.CompressionBlockAlignment = DefaultCompressionBlockAlignment;
 	
@@ -5785,6 +5824,8 @@ int32 CreateIoStoreContainerFiles(const TCHAR* CmdLine)
 	UE_LOG(LogIoStore, Display, TEXT("Using compression block size '%ld'"), GeneralIoWriterSettings.CompressionBlockSize);
 	UE_LOG(LogIoStore, Display, TEXT("Using compression block alignment '%ld'"), GeneralIoWriterSettings.CompressionBlockAlignment);
 	UE_LOG(LogIoStore, Display, TEXT("Using max partition size '%lld'"), GeneralIoWriterSettings.MaxPartitionSize);
+	UE_LOG(LogIoStore, Display, TEXT("Using compression memory limit '%lld'"), GeneralIoWriterSettings.CompressionMemoryLimit);
+	UE_LOG(LogIoStore, Display, TEXT("Using max concurrent writers '%d'"), GeneralIoWriterSettings.MaxConcurrentWriters);
 
 	FParse::Value(CmdLine, TEXT("-MetaOutputDirectory="), Arguments.MetaOutputDir);
 	FParse::Value(CmdLine, TEXT("-MetaInputDirectory="), Arguments.MetaInputDir);
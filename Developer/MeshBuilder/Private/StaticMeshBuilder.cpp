@@ -2,9 +2,11 @@
 
 #include "StaticMeshBuilder.h"
 
+#include "Async/Async.h"
 #include "BuildOptimizationHelper.h"
 #include "Components.h"
 #include "Engine/StaticMesh.h"
+#include "HAL/IConsoleManager.h"
 #include "IMeshReductionInterfaces.h"
 #include "IMeshReductionManagerModule.h"
 #include "MeshBuild.h"
@@ -20,6 +22,13 @@
 
 DEFINE_LOG_CATEGORY(LogStaticMeshBuilder);
 
+static TAutoConsoleVariable<int32> CVarStaticMeshBuilderParallelLODReduction(
+	TEXT("r.StaticMeshBuilder.ParallelLODReduction"),
+	1,
+	TEXT("If enabled, generated LODs are reduced on the thread pool as soon as the LOD they reduce from is ready,\n")
+	TEXT("so LODs sharing a base are reduced concurrently while earlier LODs finish building."),
+	ECVF_Default);
+
 //////////////////////////////////////////////////////////////////////////
 //Local functions definition
 void BuildVertexBuffer(
@@ -238,6 +247,16 @@ static bool BuildNaniteFromHiResSourceModel(
 
 
 
+/**
+ * Result of a generated LOD reduced on the thread pool ahead of its turn in FStaticMeshBuilder::Build().
+ */
+struct FAsyncLODReduction
+{
+	FMeshDescription ReducedMeshDescription;
+	float MaxDeviation = 0.0f;
+	TFuture<void> Future;
+};
+
 bool FStaticMeshBuilder::Build(FStaticMeshRenderData& StaticMeshRenderData, UStaticMesh* StaticMesh, const FStaticMeshLODGroup& LODGroup)
 {
 	const bool bNaniteBuildEnabled = StaticMesh->NaniteSettings.bEnabled;
@@ -297,6 +316,17 @@ bool FStaticMeshBuilder::Build(FStaticMeshRenderData& StaticMeshRenderData, USta
 		}
 	}
 
+	// Generated LODs (no mesh description of their own) can be reduced as soon as their base LOD is set up.
+	// Only the native reduction is known to be safe to run concurrently.
+	IMeshReduction* AsyncMeshReduction = nullptr;
+	if (NumSourceModels > 1 && !bIsThirdPartyReductiontool && CVarStaticMeshBuilderParallelLODReduction.GetValueOnAnyThread() != 0)
+	{
+		IMeshReductionManagerModule& MeshReductionModule = FModuleManager::Get().LoadModuleChecked<IMeshReductionManagerModule>("MeshReductionInterface");
+		AsyncMeshReduction = MeshReductionModule.GetStaticMeshReductionInterface();
+	}
+	TArray<TUniquePtr<FAsyncLODReduction>> AsyncLODReductions;
+	AsyncLODReductions.SetNum(NumSourceModels);
+
 	// build render data for each LOD
 	for (int32 LodIndex = 0; LodIndex < NumSourceModels; ++LodIndex)
 	{
@@ -371,11 +401,22 @@ bool FStaticMeshBuilder::Build(FStaticMeshRenderData& StaticMeshRenderData, USta
 		{
 			float OverlappingThreshold = LODBuildSettings.bRemoveDegenerates ? THRESH_POINTS_ARE_SAME : 0.0f;
 			FOverlappingCorners OverlappingCorners;
-			FStaticMeshOperations::FindOverlappingCorners(OverlappingCorners, MeshDescriptions[BaseReduceLodIndex], OverlappingThreshold);
+			if (!AsyncLODReductions[LodIndex].IsValid())
+			{
+				FStaticMeshOperations::FindOverlappingCorners(OverlappingCorners, MeshDescriptions[BaseReduceLodIndex], OverlappingThreshold);
+			}
 
 			int32 OldSectionInfoMapCount = StaticMesh->GetSectionInfoMap().GetSectionNumber(LodIndex);
 
-			if (LodIndex == BaseReduceLodIndex)
+			if (AsyncLODReductions[LodIndex].IsValid())
+			{
+				FAsyncLODReduction& AsyncLODReduction = *AsyncLODReductions[LodIndex];
+				AsyncLODReduction.Future.Wait();
+				MeshDescriptions[LodIndex] = MoveTemp(AsyncLODReduction.ReducedMeshDescription);
+				MaxDeviation = AsyncLODReduction.MaxDeviation;
+				AsyncLODReductions[LodIndex].Reset();
+			}
+			else if (LodIndex == BaseReduceLodIndex)
 			{
 				//When using LOD 0, we use a copy of the mesh description since reduce do not support inline reducing
 				FMeshDescription BaseMeshDescription = MeshDescriptions[BaseReduceLodIndex];
@@ -462,6 +503,42 @@ bool FStaticMeshBuilder::Build(FStaticMeshRenderData& StaticMeshRenderData, USta
 				}
 			}
 		}
+		// This LOD's mesh description is final now, start reducing every later generated LOD based on it.
+		if (AsyncMeshReduction)
+		{
+			for (int32 ReduceLodIndex = LodIndex + 1; ReduceLodIndex < NumSourceModels; ++ReduceLodIndex)
+			{
+				if (StaticMesh->IsMeshDescriptionValid(ReduceLodIndex) || !StaticMesh->IsReductionActive(ReduceLodIndex))
+				{
+					continue;
+				}
+
+				const FMeshReductionSettings AsyncReductionSettings = LODGroup.GetSettings(StaticMesh->GetSourceModel(ReduceLodIndex).ReductionSettings, ReduceLodIndex);
+				if (FMath::Clamp<int32>(AsyncReductionSettings.BaseLODModel, 0, ReduceLodIndex - 1) != LodIndex)
+				{
+					continue;
+				}
+
+				// Generated LODs use the build settings of the LOD they reduce from.
+				const float AsyncOverlappingThreshold = LODBuildSettings.bRemoveDegenerates ? THRESH_POINTS_ARE_SAME : 0.0f;
+				const FMeshDescription* BaseMeshDescription = &MeshDescriptions[LodIndex];
+
+				AsyncLODReductions[ReduceLodIndex] = MakeUnique<FAsyncLODReduction>();
+				FAsyncLODReduction* AsyncLODReduction = AsyncLODReductions[ReduceLodIndex].Get();
+				AsyncLODReduction->Future = Async(EAsyncExecution::ThreadPool, [AsyncMeshReduction, AsyncLODReduction, BaseMeshDescription, AsyncReductionSettings, AsyncOverlappingThreshold]()
+				{
+					TRACE_CPUPROFILER_EVENT_SCOPE(FStaticMeshBuilder::Build::AsyncReduceLOD);
+
+					FOverlappingCorners AsyncOverlappingCorners;
+					FStaticMeshOperations::FindOverlappingCorners(AsyncOverlappingCorners, *BaseMeshDescription, AsyncOverlappingThreshold);
+
+					FStaticMeshAttributes(AsyncLODReduction->ReducedMeshDescription).Register();
+					AsyncLODReduction->MaxDeviation = AsyncReductionSettings.MaxDeviation;
+					AsyncMeshReduction->ReduceMeshDescription(AsyncLODReduction->ReducedMeshDescription, AsyncLODReduction->MaxDeviation, *BaseMeshDescription, AsyncOverlappingCorners, AsyncReductionSettings);
+				});
+			}
+		}
+
 		BuildLODSlowTask.EnterProgressFrame(1);
 		const FPolygonGroupArray& PolygonGroups = MeshDescriptions[LodIndex].PolygonGroups();
 
@@ -922,7 +922,7 @@ void FMeshSimplifier::RemoveDuplicateVerts( uint32 Corner )
 	}
 }
 
-float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
+float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris, float MaxMergeError )
 {
 	check( TargetNumVerts < NumVerts || TargetNumTris < NumTris );
 
@@ -954,6 +954,10 @@ float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
 
 	while( PairHeap.Num() > 0 )
 	{
+		// Stop before any merge whose cost exceeds the limit, ie. one that would move a locked vert.
+		if( PairHeap.GetKey( PairHeap.Top() ) >= MaxMergeError )
+			break;
+
 		{
 			uint32 PairIndex = PairHeap.Top();
 			PairHeap.Pop();
@@ -980,7 +984,7 @@ float FMeshSimplifier::Simplify( uint32 TargetNumVerts, uint32 TargetNumTris )
 		ReevaluatePairs.Reset();
 	}
 
-	check( RemainingNumVerts <= TargetNumVerts && RemainingNumTris <= TargetNumTris );
+	check( MaxMergeError < MAX_flt || ( RemainingNumVerts <= TargetNumVerts && RemainingNumTris <= TargetNumTris ) );
 	
 	return MaxError;
 }
@@ -57,12 +57,19 @@ public:
 	QUADRICMESHREDUCTION_API void	SetBoundaryLocked( const TBitArray<>& UnlockedBoundaryEdges );
 	QUADRICMESHREDUCTION_API void	GetBoundaryUnlocked( TBitArray<>& UnlockedBoundaryEdges );
 
-	QUADRICMESHREDUCTION_API float	Simplify( uint32 TargetNumVerts, uint32 TargetNumTris );
+	/**
+	 * Collapses edges until both targets are met. If MaxMergeError is given, simplification also stops
+	 * once the cheapest remaining merge costs at least that much, in which case the targets may not be reached.
+	 */
+	QUADRICMESHREDUCTION_API float	Simplify( uint32 TargetNumVerts, uint32 TargetNumTris, float MaxMergeError = MAX_flt );
 	QUADRICMESHREDUCTION_API void	Compact();
 
 	uint32		GetRemainingNumVerts() const	{ return RemainingNumVerts; }
 	uint32		GetRemainingNumTris() const		{ return RemainingNumTris; }
 
+	/** Merge cost added for moving a locked vert. Pass as MaxMergeError to never collapse locked edges. */
+	float		GetLockPenalty() const			{ return LockPenalty; }
+
 protected:
 	const int32 DegreeLimit			= 24;
 	const float DegreePenalty		= 0.5f;
@@ -14,6 +14,8 @@
 #include "StaticMeshOperations.h"
 #include "RenderUtils.h"
 #include "Engine/StaticMesh.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 
 class FQuadricSimplifierMeshReductionModule : public IMeshReductionModule
 {
@@ -52,6 +54,217 @@ void CorrectAttributes( float* Attributes )
 	Color = Color.GetClamped();
 }
 
+static int32 GQuadricParallelMinTriangles = 65536;
+static FAutoConsoleVariableRef CVarQuadricParallelMinTriangles(
+	TEXT("r.QuadricMeshReduction.ParallelMinTriangles"),
+	GQuadricParallelMinTriangles,
+	TEXT("Meshes with at least this many triangles are split into spatial partitions that are reduced in parallel\n")
+	TEXT("with their borders locked, before a final serial pass over the whole mesh. 0 disables partitioning."),
+	ECVF_Default);
+
+static int32 GQuadricParallelTrianglesPerPartition = 32768;
+static FAutoConsoleVariableRef CVarQuadricParallelTrianglesPerPartition(
+	TEXT("r.QuadricMeshReduction.ParallelTrianglesPerPartition"),
+	GQuadricParallelTrianglesPerPartition,
+	TEXT("Approximate number of triangles in each partition reduced in parallel."),
+	ECVF_Default);
+
+static uint32 MortonCode3( uint32 x )
+{
+	x &= 0x000003ff;
+	x = ( x ^ ( x << 16 ) ) & 0xff0000ff;
+	x = ( x ^ ( x <<  8 ) ) & 0x0300f00f;
+	x = ( x ^ ( x <<  4 ) ) & 0x030c30c3;
+	x = ( x ^ ( x <<  2 ) ) & 0x09249249;
+	return x;
+}
+
+/**
+ * Splits the mesh into spatially coherent partitions and reduces each of them in parallel with all partition
+ * borders locked. The partitions are then stitched back together into Verts, Indexes and MaterialIndexes, ready
+ * for a final pass over the whole mesh which is free to collapse the borders.
+ *
+ * Partitions are only reduced part of the way towards the target so the final pass still has room to choose
+ * the cheapest collapses globally.
+ *
+ * @return	Largest squared error of any collapse made.
+ */
+template< typename VertType >
+static float SimplifyPartitions(
+	TArray< VertType >& Verts,
+	TArray< uint32 >& Indexes,
+	TArray< int32 >& MaterialIndexes,
+	uint32 NumAttributes,
+	const float* AttributeWeights,
+	uint32 TargetNumVerts,
+	uint32 TargetNumTris )
+{
+	const uint32 NumVerts = Verts.Num();
+	const uint32 NumTris = Indexes.Num() / 3;
+
+	const int32 NumPartitions = FMath::Clamp( FMath::DivideAndRoundUp< int32 >( NumTris, FMath::Max( GQuadricParallelTrianglesPerPartition, 1024 ) ), 2, 256 );
+
+	// Partitions stop short of the final ratio so border collapses aren't forced to happen all at once at the end.
+	const float PartitionSlack = 1.25f;
+	const float VertRatio = FMath::Min( 1.0f, PartitionSlack * (float)TargetNumVerts / NumVerts );
+	const float TriRatio  = FMath::Min( 1.0f, PartitionSlack * (float)TargetNumTris / NumTris );
+
+	// Sort triangles along a Morton curve through their centroids.
+	TArray< uint64 > SortKeys;
+	{
+		TArray< FVector > Centers;
+		Centers.AddUninitialized( NumTris );
+
+		FBox Bounds( ForceInit );
+		for( uint32 TriIndex = 0; TriIndex < NumTris; TriIndex++ )
+		{
+			Centers[ TriIndex ] = (
+				Verts[ Indexes[ TriIndex * 3 + 0 ] ].Position +
+				Verts[ Indexes[ TriIndex * 3 + 1 ] ].Position +
+				Verts[ Indexes[ TriIndex * 3 + 2 ] ].Position ) * ( 1.0f / 3.0f );
+			Bounds += Centers[ TriIndex ];
+		}
+
+		const FVector Extent = Bounds.GetSize();
+		const float MaxExtent = FMath::Max( Extent.GetMax(), SMALL_NUMBER );
+		const float QuantizeScale = 1023.0f / MaxExtent;
+
+		SortKeys.AddUninitialized( NumTris );
+		for( uint32 TriIndex = 0; TriIndex < NumTris; TriIndex++ )
+		{
+			FVector Quantized = ( Centers[ TriIndex ] - Bounds.Min ) * QuantizeScale;
+
+			uint32 Code;
+			Code  = MortonCode3( (uint32)Quantized.X );
+			Code |= MortonCode3( (uint32)Quantized.Y ) << 1;
+			Code |= MortonCode3( (uint32)Quantized.Z ) << 2;
+
+			SortKeys[ TriIndex ] = ( (uint64)Code << 32 ) | TriIndex;
+		}
+		SortKeys.Sort();
+	}
+
+	struct FPartition
+	{
+		TArray< VertType >	Verts;
+		TArray< uint32 >	Indexes;
+		TArray< int32 >		MaterialIndexes;
+		float				MaxErrorSqr = 0.0f;
+	};
+	TArray< FPartition > Partitions;
+	Partitions.SetNum( NumPartitions );
+
+	ParallelFor( NumPartitions,
+		[&]( int32 PartitionIndex )
+		{
+			FPartition& Partition = Partitions[ PartitionIndex ];
+
+			const uint32 TriBegin = (uint64)NumTris * PartitionIndex / NumPartitions;
+			const uint32 TriEnd   = (uint64)NumTris * ( PartitionIndex + 1 ) / NumPartitions;
+
+			TMap< uint32, uint32 > OldToNewVert;
+			OldToNewVert.Reserve( TriEnd - TriBegin );
+
+			Partition.Indexes.Reserve( ( TriEnd - TriBegin ) * 3 );
+			Partition.MaterialIndexes.Reserve( TriEnd - TriBegin );
+			for( uint32 i = TriBegin; i < TriEnd; i++ )
+			{
+				const uint32 TriIndex = (uint32)SortKeys[i];
+				for( uint32 k = 0; k < 3; k++ )
+				{
+					const uint32 OldIndex = Indexes[ TriIndex * 3 + k ];
+					uint32* NewIndex = OldToNewVert.Find( OldIndex );
+					if( !NewIndex )
+					{
+						NewIndex = &OldToNewVert.Add( OldIndex, Partition.Verts.Add( Verts[ OldIndex ] ) );
+					}
+					Partition.Indexes.Add( *NewIndex );
+				}
+				Partition.MaterialIndexes.Add( MaterialIndexes[ TriIndex ] );
+			}
+
+			const uint32 PartitionNumVerts = Partition.Verts.Num();
+			const uint32 PartitionNumTris = Partition.MaterialIndexes.Num();
+
+			const uint32 PartitionTargetVerts = FMath::CeilToInt( PartitionNumVerts * VertRatio );
+			const uint32 PartitionTargetTris = FMath::Max( (uint32)FMath::CeilToInt( PartitionNumTris * TriRatio ), 2u );
+			if( PartitionTargetVerts >= PartitionNumVerts && PartitionTargetTris >= PartitionNumTris )
+			{
+				return;
+			}
+
+			FMeshSimplifier Simplifier( (float*)Partition.Verts.GetData(), PartitionNumVerts, Partition.Indexes.GetData(), Partition.Indexes.Num(), Partition.MaterialIndexes.GetData(), NumAttributes );
+
+			Simplifier.SetAttributeWeights( AttributeWeights );
+			Simplifier.SetCorrectAttributes( CorrectAttributes );
+			Simplifier.SetEdgeWeight( 4.0f );
+
+			// Lock every open edge. Edges on the original mesh's boundary are locked too, the final pass will handle them.
+			Simplifier.SetBoundaryLocked( TBitArray<>( false, Partition.Indexes.Num() ) );
+
+			Partition.MaxErrorSqr = Simplifier.Simplify( PartitionTargetVerts, PartitionTargetTris, Simplifier.GetLockPenalty() );
+			Simplifier.Compact();
+
+			Partition.Verts.SetNum( Simplifier.GetRemainingNumVerts() );
+			Partition.Indexes.SetNum( Simplifier.GetRemainingNumTris() * 3 );
+			Partition.MaterialIndexes.SetNum( Simplifier.GetRemainingNumTris() );
+		} );
+
+	// Stitch the partitions back together. Locked border verts are bit identical on both sides so they weld exactly.
+	uint32 MergedNumVerts = 0;
+	uint32 MergedNumTris = 0;
+	for( const FPartition& Partition : Partitions )
+	{
+		MergedNumVerts += Partition.Verts.Num();
+		MergedNumTris += Partition.MaterialIndexes.Num();
+	}
+
+	Verts.Reset( MergedNumVerts );
+	Indexes.Reset( MergedNumTris * 3 );
+	MaterialIndexes.Reset( MergedNumTris );
+
+	FHashTable VertHash( 1 << FMath::FloorLog2( MergedNumVerts ), MergedNumVerts );
+
+	float MaxErrorSqr = 0.0f;
+	TArray< uint32 > Remap;
+	for( FPartition& Partition : Partitions )
+	{
+		MaxErrorSqr = FMath::Max( MaxErrorSqr, Partition.MaxErrorSqr );
+
+		Remap.SetNumUninitialized( Partition.Verts.Num(), false );
+		for( int32 LocalIndex = 0; LocalIndex < Partition.Verts.Num(); LocalIndex++ )
+		{
+			const VertType& Vert = Partition.Verts[ LocalIndex ];
+			const uint32 Hash = HashPosition( Vert.Position );
+
+			uint32 Index;
+			for( Index = VertHash.First( Hash ); VertHash.IsValid( Index ); Index = VertHash.Next( Index ) )
+			{
+				if( FMemory::Memcmp( &Verts[ Index ], &Vert, sizeof( VertType ) ) == 0 )
+				{
+					break;
+				}
+			}
+			if( !VertHash.IsValid( Index ) )
+			{
+				Index = Verts.Add( Vert );
+				VertHash.Add( Hash, Index );
+			}
+			Remap[ LocalIndex ] = Index;
+		}
+
+		for( uint32 LocalIndex : Partition.Indexes )
+		{
+			Indexes.Add( Remap[ LocalIndex ] );
+		}
+		MaterialIndexes.Append( Partition.MaterialIndexes );
+
+		Partition = FPartition();
+	}
+
+	return MaxErrorSqr;
+}
+
 class FQuadricSimplifierMeshReduction : public IMeshReduction
 {
 public:
@@ -399,13 +612,23 @@ public:
 				Vert.Position *= PositionScale;
 			}
 
+			float MaxErrorSqr = 0.0f;
+			if( GQuadricParallelMinTriangles > 0 && NumTris >= (uint32)GQuadricParallelMinTriangles )
+			{
+				MaxErrorSqr = SimplifyPartitions( Verts, Indexes, MaterialIndexes, NumAttributes, AttributeWeights, TargetNumVerts, TargetNumTris );
+			}
+
 			FMeshSimplifier Simplifier( (float*)Verts.GetData(), Verts.Num(), Indexes.GetData(), Indexes.Num(), MaterialIndexes.GetData(), NumAttributes );
 
 			Simplifier.SetAttributeWeights( AttributeWeights );
 			Simplifier.SetCorrectAttributes( CorrectAttributes );
 			Simplifier.SetEdgeWeight( 4.0f );
 
-			float MaxErrorSqr = Simplifier.Simplify( TargetNumVerts, TargetNumTris );
+			// The partitioned pass stops short of the target, but guard against rounding leaving nothing to do.
+			if( TargetNumVerts < (uint32)Verts.Num() || TargetNumTris < (uint32)MaterialIndexes.Num() )
+			{
+				MaxErrorSqr = FMath::Max( MaxErrorSqr, Simplifier.Simplify( TargetNumVerts, TargetNumTris ) );
+			}
 
 			if( Simplifier.GetRemainingNumVerts() == 0 || Simplifier.GetRemainingNumTris() == 0 )
 			{
@@ -1,14 +1,133 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ShaderPreprocessor.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "Misc/SecureHash.h"
 #include "Modules/ModuleManager.h"
+#include "Templates/Atomic.h"
 #include "PreprocessorPrivate.h"
 
 IMPLEMENT_MODULE(FDefaultModuleImpl, ShaderPreprocessor);
 
+static TAutoConsoleVariable<int32> CVarShaderPreprocessorResultCacheSizeMB(
+	TEXT("r.ShaderPreprocessor.ResultCacheSizeMB"),
+	64,
+	TEXT("Memory budget in MB for preprocessed shaders kept in memory, keyed by a hash of the shader platform, source, includes and defines.\n")
+	TEXT("Identical preprocessing requests for the same shader platform (e.g. materials that generate the same code, or retried jobs) then skip MCPP entirely.\n")
+	TEXT("0 disables the cache."),
+	ECVF_Default);
+
+/** A successfully preprocessed shader, as stored in FShaderPreprocessorCache. */
+struct FPreprocessedShaderCacheEntry
+{
+	FString Source;
+	TArray<FString> PragmaDirectives;
+	/** Include files loaded from disk by the run, which are validated again on every hit */
+	TArray<FString> DiskIncludes;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = Source.GetAllocatedSize() + PragmaDirectives.GetAllocatedSize() + DiskIncludes.GetAllocatedSize();
+		for (const FString& PragmaDirective : PragmaDirectives)
+		{
+			Size += PragmaDirective.GetAllocatedSize();
+		}
+		for (const FString& DiskInclude : DiskIncludes)
+		{
+			Size += DiskInclude.GetAllocatedSize();
+		}
+		return Size;
+	}
+};
+
+/**
+ * Process-wide cache of the output of successful preprocessing runs, keyed by a hash of everything that can affect it.
+ * The include files themselves are not cached here, they already live in the shader file cache of RenderCore.
+ * Emptied whenever the shader file cache is flushed (e.g. by recompileshaders).
+ */
+class FShaderPreprocessorCache
+{
+public:
+	FShaderPreprocessorCache()
+		: Generation(GetShaderFileCacheGeneration())
+		, AllocatedSize(0)
+	{
+	}
+
+	bool FindResult(const FSHAHash& Key, FString& OutSource, TArray<FString>& OutPragmaDirectives, TArray<FString>& OutDiskIncludes)
+	{
+		FlushIfStale();
+
+		FRWScopeLock Lock(RWLock, SLT_ReadOnly);
+		const FPreprocessedShaderCacheEntry* Found = Results.Find(Key);
+		if (Found)
+		{
+			OutSource = Found->Source;
+			OutPragmaDirectives.Append(Found->PragmaDirectives);
+			OutDiskIncludes = Found->DiskIncludes;
+			return true;
+		}
+		return false;
+	}
+
+	void AddResult(const FSHAHash& Key, FPreprocessedShaderCacheEntry&& Entry, SIZE_T MaxSize)
+	{
+		const SIZE_T EntrySize = Entry.GetAllocatedSize();
+		if (EntrySize > MaxSize)
+		{
+			return;
+		}
+
+		FRWScopeLock Lock(RWLock, SLT_Write);
+		if (Results.Contains(Key))
+		{
+			return;
+		}
+		if (AllocatedSize + EntrySize > MaxSize)
+		{
+			// Jobs are usually submitted in batches sharing the same sources, so a full reset is good enough.
+			Results.Reset();
+			AllocatedSize = 0;
+		}
+
+		Results.Add(Key, MoveTemp(Entry));
+		AllocatedSize += EntrySize;
+	}
+
+private:
+	void FlushIfStale()
+	{
+		const uint32 CurrentGeneration = GetShaderFileCacheGeneration();
+		if (Generation.Load(EMemoryOrder::Relaxed) != CurrentGeneration)
+		{
+			FRWScopeLock Lock(RWLock, SLT_Write);
+			if (Generation.Load(EMemoryOrder::Relaxed) != CurrentGeneration)
+			{
+				Results.Empty();
+				AllocatedSize = 0;
+				Generation = CurrentGeneration;
+			}
+		}
+	}
+
+	FRWLock RWLock;
+	/** Value of GetShaderFileCacheGeneration() when the cached results were produced. */
+	TAtomic<uint32> Generation;
+	TMap<FSHAHash, FPreprocessedShaderCacheEntry> Results;
+	/** Sum of the allocated sizes of the entries in Results. */
+	SIZE_T AllocatedSize;
+};
+
+static FShaderPreprocessorCache& GetShaderPreprocessorCache()
+{
+	static FShaderPreprocessorCache Cache;
+	return Cache;
+}
+
 /**
  * Append defines to an MCPP command line.
  * @param OutOptions - Upon return contains MCPP command line parameters as an array of strings.
@@ -43,6 +162,60 @@ public:
 		}
 	}
 
+	/**
+	 * Loads the files the source includes, recursively, before mcpp_run is called. MCPP is not reentrant so runs are
+	 * serialized, and this moves reading and converting the includes out of the lock. Includes are found by a textual
+	 * scan that ignores conditionals, so files which MCPP never asks for are not reported as loaded or as errors.
+	 */
+	void PrefetchIncludes()
+	{
+		TArray<FString> PendingFiles;
+		CachedFileContents.GetKeys(PendingFiles);
+		while (PendingFiles.Num() > 0)
+		{
+			const FString IncluderPath = PendingFiles.Pop(false);
+			const FShaderContents* IncluderContents = CachedFileContents.Find(IncluderPath);
+			if (!IncluderContents)
+			{
+				IncluderContents = PrefetchedFileContents.Find(IncluderPath);
+			}
+
+			const FString IncluderDirectory = FPaths::GetPath(IncluderPath);
+			const ANSICHAR* Line = IncluderContents->GetData();
+			while (Line && *Line)
+			{
+				const ANSICHAR* NextLine = FCStringAnsi::Strchr(Line, '\n');
+				NextLine = NextLine ? NextLine + 1 : nullptr;
+
+				FString IncludePath;
+				const bool bIsInclude = ParseQuotedInclude(Line, IncludePath);
+				Line = NextLine;
+				if (!bIsInclude)
+				{
+					continue;
+				}
+
+				if (!IncludePath.StartsWith(TEXT("/")))
+				{
+					IncludePath = IncluderDirectory / IncludePath;
+				}
+				FixupVirtualFilePath(IncludePath);
+
+				if (!CachedFileContents.Contains(IncludePath) && !PrefetchedFileContents.Contains(IncludePath))
+				{
+					bool bFromDisk = false;
+					FShaderContents Contents;
+					if (LoadFileContents(IncludePath, nullptr, bFromDisk, Contents))
+					{
+						PrefetchedFileContents.Add(IncludePath, MoveTemp(Contents));
+						PrefetchedFromDisk.Add(IncludePath, bFromDisk);
+						PendingFiles.Add(IncludePath);
+					}
+				}
+			}
+		}
+	}
+
 	/** Retrieves the MCPP file loader interface. */
 	file_loader GetMcppInterface()
 	{
@@ -57,54 +230,139 @@ public:
 		return CachedFileContents.Contains(TEXT("/Engine/Public/Platform.ush"));
 	}
 
+	/** Include files that were loaded from disk rather than from the environment of the job. */
+	const TArray<FString>& GetDiskIncludes() const
+	{
+		return DiskIncludes;
+	}
+
 private:
 	/** Holder for shader contents (string + size). */
 	typedef TArray<ANSICHAR> FShaderContents;
-	
-	/** MCPP callback for retrieving file contents. */
-	static int GetFileContents(void* InUserData, const ANSICHAR* InVirtualFilePath, const ANSICHAR** OutContents, size_t* OutContentSize)
+
+	/** Parses a line of the form #include "Path". */
+	static bool ParseQuotedInclude(const ANSICHAR* Line, FString& OutPath)
 	{
-		FMcppFileLoader* This = (FMcppFileLoader*)InUserData;
+		auto SkipBlanks = [](const ANSICHAR* Cursor)
+		{
+			while (*Cursor == ' ' || *Cursor == '\t')
+			{
+				++Cursor;
+			}
+			return Cursor;
+		};
 
-		FUTF8ToTCHAR UTF8Converter(InVirtualFilePath);
-		FString VirtualFilePath = UTF8Converter.Get();
+		const ANSICHAR* Cursor = SkipBlanks(Line);
+		if (*Cursor != '#')
+		{
+			return false;
+		}
+		Cursor = SkipBlanks(Cursor + 1);
+		if (FCStringAnsi::Strncmp(Cursor, "include", 7) != 0)
+		{
+			return false;
+		}
+		Cursor = SkipBlanks(Cursor + 7);
+		if (*Cursor != '"')
+		{
+			return false;
+		}
+		const ANSICHAR* PathStart = ++Cursor;
+		while (*Cursor && *Cursor != '"' && *Cursor != '\n')
+		{
+			++Cursor;
+		}
+		if (*Cursor != '"' || Cursor == PathStart)
+		{
+			return false;
+		}
+		OutPath = FString(int32(Cursor - PathStart), PathStart);
+		return true;
+	}
 
+	/** Maps a path to the file MCPP should read for the shader platform of the job. */
+	void FixupVirtualFilePath(FString& VirtualFilePath) const
+	{
 		// Substitute virtual platform path here to make sure that #line directives refer to the platform-specific file.
-		ReplaceVirtualFilePathForShaderPlatform(VirtualFilePath, This->ShaderInput.Target.GetPlatform());
+		ReplaceVirtualFilePathForShaderPlatform(VirtualFilePath, ShaderInput.Target.GetPlatform());
 
 		// Fixup autogen file
-		ReplaceVirtualFilePathForShaderAutogen(VirtualFilePath, This->ShaderInput.Target.GetPlatform());
+		ReplaceVirtualFilePathForShaderAutogen(VirtualFilePath, ShaderInput.Target.GetPlatform());
 
 		// Collapse any relative directories to allow #include "../MyFile.ush"
 		FPaths::CollapseRelativeDirectories(VirtualFilePath);
+	}
+
+	/** Loads an include from the environment of the job or from disk, as the contents handed to MCPP. */
+	bool LoadFileContents(const FString& VirtualFilePath, TArray<FShaderCompilerError>* OutErrors, bool& bOutFromDisk, FShaderContents& OutContents) const
+	{
+		FString FileContents;
+
+		bOutFromDisk = false;
+		if (ShaderInput.Environment.IncludeVirtualPathToContentsMap.Contains(VirtualFilePath))
+		{
+			FileContents = ShaderInput.Environment.IncludeVirtualPathToContentsMap.FindRef(VirtualFilePath);
+		}
+		else if (ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.Contains(VirtualFilePath))
+		{
+			FileContents = *ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.FindRef(VirtualFilePath);
+		}
+		else
+		{
+			LoadShaderSourceFile(*VirtualFilePath, ShaderInput.Target.GetPlatform(), &FileContents, OutErrors);
+			bOutFromDisk = true;
+		}
+
+		if (FileContents.Len() > 0)
+		{
+			// Adds a #line 1 "<Absolute file path>" on top of every file content to have nice absolute virtual source
+			// file path in error messages.
+			FileContents = FString::Printf(TEXT("#line 1 \"%s\"\n%s"), *VirtualFilePath, *FileContents);
+			OutContents = StringToArray<ANSICHAR>(*FileContents, FileContents.Len() + 1);
+			return true;
+		}
+		return false;
+	}
+
+	/** MCPP callback for retrieving file contents. */
+	static int GetFileContents(void* InUserData, const ANSICHAR* InVirtualFilePath, const ANSICHAR** OutContents, size_t* OutContentSize)
+	{
+		FMcppFileLoader* This = (FMcppFileLoader*)InUserData;
+
+		FUTF8ToTCHAR UTF8Converter(InVirtualFilePath);
+		FString VirtualFilePath = UTF8Converter.Get();
+		This->FixupVirtualFilePath(VirtualFilePath);
 
 		FShaderContents* CachedContents = This->CachedFileContents.Find(VirtualFilePath);
 		if (!CachedContents)
 		{
-			FString FileContents;
-
-			if (This->ShaderInput.Environment.IncludeVirtualPathToContentsMap.Contains(VirtualFilePath))
-			{
-				FileContents = This->ShaderInput.Environment.IncludeVirtualPathToContentsMap.FindRef(VirtualFilePath);
-			}
-			else if (This->ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.Contains(VirtualFilePath))
+			bool bFromDisk = false;
+			FShaderContents Contents;
+			if (FShaderContents* Prefetched = This->PrefetchedFileContents.Find(VirtualFilePath))
 			{
-				FileContents = *This->ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.FindRef(VirtualFilePath);
+				bFromDisk = This->PrefetchedFromDisk.FindChecked(VirtualFilePath);
+				if (bFromDisk)
+				{
+					CheckShaderHashCacheInclude(VirtualFilePath, This->ShaderInput.Target.GetPlatform());
+				}
+				CachedContents = &This->CachedFileContents.Add(VirtualFilePath, MoveTemp(*Prefetched));
 			}
 			else
 			{
-				CheckShaderHashCacheInclude(VirtualFilePath, This->ShaderInput.Target.GetPlatform());
-
-				LoadShaderSourceFile(*VirtualFilePath, This->ShaderInput.Target.GetPlatform(), &FileContents, &This->ShaderOutput.Errors);
+				if (!This->ShaderInput.Environment.IncludeVirtualPathToContentsMap.Contains(VirtualFilePath) &&
+					!This->ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.Contains(VirtualFilePath))
+				{
+					CheckShaderHashCacheInclude(VirtualFilePath, This->ShaderInput.Target.GetPlatform());
+				}
+				if (This->LoadFileContents(VirtualFilePath, &This->ShaderOutput.Errors, bFromDisk, Contents))
+				{
+					CachedContents = &This->CachedFileContents.Add(VirtualFilePath, MoveTemp(Contents));
+				}
 			}
 
-			if (FileContents.Len() > 0)
+			if (bFromDisk)
 			{
-				// Adds a #line 1 "<Absolute file path>" on top of every file content to have nice absolute virtual source
-				// file path in error messages.
-				FileContents = FString::Printf(TEXT("#line 1 \"%s\"\n%s"), *VirtualFilePath, *FileContents);
-
-				CachedContents = &This->CachedFileContents.Add(VirtualFilePath, StringToArray<ANSICHAR>(*FileContents, FileContents.Len() + 1));
+				This->DiskIncludes.Add(VirtualFilePath);
 			}
 		}
 
@@ -126,6 +384,12 @@ private:
 	FShaderCompilerOutput& ShaderOutput;
 	/** File contents are cached as needed. */
 	TMap<FString,FShaderContents> CachedFileContents;
+	/** Includes loaded by PrefetchIncludes, moved to CachedFileContents when MCPP asks for them. */
+	TMap<FString,FShaderContents> PrefetchedFileContents;
+	/** Whether each prefetched include was loaded from disk. */
+	TMap<FString,bool> PrefetchedFromDisk;
+	/** Virtual paths of the files loaded through LoadShaderSourceFile, in load order. */
+	TArray<FString> DiskIncludes;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -206,6 +470,66 @@ static void DumpShaderDefinesAsCommentedCode(const FShaderCompilerInput& ShaderI
 	}
 }
 
+static void HashString(FSHA1& HashState, const FString& String)
+{
+	// Include the terminator so that consecutive strings can not alias each other.
+	HashState.UpdateWithString(*String, String.Len() + 1);
+}
+
+static void HashDefinitions(FSHA1& HashState, const TMap<FString, FString>& Definitions)
+{
+	const int32 NumDefinitions = Definitions.Num();
+	HashState.Update((const uint8*)&NumDefinitions, sizeof(NumDefinitions));
+	for (TMap<FString, FString>::TConstIterator It(Definitions); It; ++It)
+	{
+		HashString(HashState, It.Key());
+		HashString(HashState, It.Value());
+	}
+}
+
+/**
+ * Computes the key of a preprocessed shader in FShaderPreprocessorCache. Covers everything MCPP gets to see except
+ * the include files on disk, which are only invalidated through FlushShaderFileCache().
+ */
+static FSHAHash ComputePreprocessedShaderCacheKey(const FShaderCompilerInput& ShaderInput, const FShaderCompilerDefinitions& AdditionalDefines)
+{
+	FSHA1 HashState;
+
+	const int32 Platform = (int32)ShaderInput.Target.GetPlatform();
+	HashState.Update((const uint8*)&Platform, sizeof(Platform));
+	HashString(HashState, ShaderInput.VirtualSourceFilePath);
+	HashString(HashState, ShaderInput.SourceFilePrefix);
+
+	HashDefinitions(HashState, ShaderInput.Environment.GetDefinitions());
+	HashDefinitions(HashState, AdditionalDefines.GetDefinitionMap());
+
+	const TMap<FString, FString>& IncludeContents = ShaderInput.Environment.IncludeVirtualPathToContentsMap;
+	const int32 NumIncludes = IncludeContents.Num();
+	HashState.Update((const uint8*)&NumIncludes, sizeof(NumIncludes));
+	for (TMap<FString, FString>::TConstIterator It(IncludeContents); It; ++It)
+	{
+		HashString(HashState, It.Key());
+		HashString(HashState, It.Value());
+	}
+
+	const int32 NumExternalIncludes = ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap.Num();
+	HashState.Update((const uint8*)&NumExternalIncludes, sizeof(NumExternalIncludes));
+	for (const auto& It : ShaderInput.Environment.IncludeVirtualPathToExternalContentsMap)
+	{
+		HashString(HashState, It.Key);
+		if (It.Value.IsValid())
+		{
+			HashString(HashState, *It.Value);
+		}
+	}
+
+	HashState.Final();
+
+	FSHAHash Hash;
+	HashState.GetHash(&Hash.Hash[0]);
+	return Hash;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 /**
@@ -237,12 +561,48 @@ bool PreprocessShader(
 		check(CheckVirtualShaderFilePath(ShaderInput.VirtualSourceFilePath));
 	}
 
+	// List the defines used for compilation in the preprocessed shaders, especially to know witch permutation vector this shader is.
+	const bool bDumpDefines = DefinesPolicy == EDumpShaderDefines::AlwaysIncludeDefines || (DefinesPolicy == EDumpShaderDefines::DontCare && ShaderInput.DumpDebugInfoPath.Len() > 0);
+
+	const SIZE_T ResultCacheSize = SIZE_T(FMath::Max(CVarShaderPreprocessorResultCacheSizeMB.GetValueOnAnyThread(), 0)) * 1024 * 1024;
+	FSHAHash ResultCacheKey;
+	if (ResultCacheSize > 0)
+	{
+		ResultCacheKey = ComputePreprocessedShaderCacheKey(ShaderInput, AdditionalDefines);
+
+		FString CachedSource;
+		TArray<FString> CachedDiskIncludes;
+		if (GetShaderPreprocessorCache().FindResult(ResultCacheKey, CachedSource, ShaderOutput.PragmaDirectives, CachedDiskIncludes))
+		{
+			// Same validation a run does when it loads the includes
+			for (const FString& DiskInclude : CachedDiskIncludes)
+			{
+				CheckShaderHashCacheInclude(DiskInclude, ShaderInput.Target.GetPlatform());
+			}
+
+			if (bDumpDefines)
+			{
+				DumpShaderDefinesAsCommentedCode(ShaderInput, &OutPreprocessedShader);
+			}
+
+			OutPreprocessedShader += CachedSource;
+			return true;
+		}
+	}
+
 	int32 McppResult = 0;
 	FString McppOutput, McppErrors;
 
+	// MCPP is not reentrant, so every mcpp_run in the process is serialized by this lock. Its state lives in globals of
+	// the prebuilt ThirdParty library, including the allocator set by mcpp_setmalloc. The result cache above is what
+	// lets identical jobs skip it.
 	static FCriticalSection McppCriticalSection;
 
+	const int32 NumErrorsBefore = ShaderOutput.Errors.Num();
+	const int32 NumPragmaDirectivesBefore = ShaderOutput.PragmaDirectives.Num();
+
 	bool bHasIncludedMandatoryHeaders = false;
+	TArray<FString> DiskIncludes;
 	{
 		FMcppFileLoader FileLoader(ShaderInput, ShaderOutput);
 
@@ -250,18 +610,6 @@ bool PreprocessShader(
 		AddMcppDefines(McppOptions, ShaderInput.Environment.GetDefinitions());
 		AddMcppDefines(McppOptions, AdditionalDefines.GetDefinitionMap());
 
-		// MCPP is not threadsafe.
-
-		FScopeLock McppLock(&McppCriticalSection);
-
-#if USE_UE_MALLOC_FOR_MCPP
-		auto spp_malloc		= [](size_t sz)				{ return GMcppAlloc.Alloc(sz); };
-		auto spp_realloc	= [](void* ptr, size_t sz)	{ return GMcppAlloc.Realloc(ptr, sz); };
-		auto spp_free		= [](void* ptr)				{ GMcppAlloc.Free(ptr); };
-
-		mcpp_setmalloc(spp_malloc, spp_realloc, spp_free);
-#endif
-
 		// Convert MCPP options to array of ANSI-C strings
 		TArray<const ANSICHAR*> McppOptionsANSI;
 		for (const TArray<ANSICHAR>& Option : McppOptions)
@@ -272,13 +620,34 @@ bool PreprocessShader(
 		// Append additional options as C-string literal
 		McppOptionsANSI.Add("-V199901L");
 
+		auto VirtualSourceFilePathANSI = StringCast<ANSICHAR>(*ShaderInput.VirtualSourceFilePath);
+
+		// MCPP keeps its state in globals and is not threadsafe. Options and the includes found by scanning the source
+		// are prepared before taking the lock, so the callbacks under it mostly hand out contents that are already loaded.
+		FileLoader.PrefetchIncludes();
+
+		FScopeLock McppLock(&McppCriticalSection);
+
+#if USE_UE_MALLOC_FOR_MCPP
+		static bool bMcppAllocatorSet = false;
+		if (!bMcppAllocatorSet)
+		{
+			auto spp_malloc		= [](size_t sz)				{ return GMcppAlloc.Alloc(sz); };
+			auto spp_realloc	= [](void* ptr, size_t sz)	{ return GMcppAlloc.Realloc(ptr, sz); };
+			auto spp_free		= [](void* ptr)				{ GMcppAlloc.Free(ptr); };
+
+			mcpp_setmalloc(spp_malloc, spp_realloc, spp_free);
+			bMcppAllocatorSet = true;
+		}
+#endif
+
 		ANSICHAR* McppOutAnsi = NULL;
 		ANSICHAR* McppErrAnsi = NULL;
 
 		McppResult = mcpp_run(
 			McppOptionsANSI.GetData(),
 			McppOptionsANSI.Num(),
-			TCHAR_TO_ANSI(*ShaderInput.VirtualSourceFilePath),
+			VirtualSourceFilePathANSI.Get(),
 			&McppOutAnsi,
 			&McppErrAnsi,
 			FileLoader.GetMcppInterface()
@@ -288,6 +657,7 @@ bool PreprocessShader(
 		McppErrors = McppErrAnsi;
 
 		bHasIncludedMandatoryHeaders = FileLoader.HasIncludedMandatoryHeaders();
+		DiskIncludes = FileLoader.GetDiskIncludes();
 	}
 
 	if (!ParseMcppErrors(ShaderOutput.Errors, ShaderOutput.PragmaDirectives, McppErrors))
@@ -316,13 +686,22 @@ bool PreprocessShader(
 		return false;
 	}
 
-	// List the defines used for compilation in the preprocessed shaders, especially to know witch permutation vector this shader is.
-	if (DefinesPolicy == EDumpShaderDefines::AlwaysIncludeDefines || (DefinesPolicy == EDumpShaderDefines::DontCare && ShaderInput.DumpDebugInfoPath.Len() > 0))
+	if (bDumpDefines)
 	{
 		DumpShaderDefinesAsCommentedCode(ShaderInput, &OutPreprocessedShader);
 	}
 
 	OutPreprocessedShader += McppOutput;
 
+	// Only clean runs are cached, since a cache hit can not replay errors reported while loading includes.
+	if (ResultCacheSize > 0 && ShaderOutput.Errors.Num() == NumErrorsBefore)
+	{
+		FPreprocessedShaderCacheEntry Entry;
+		Entry.Source = McppOutput;
+		Entry.PragmaDirectives = TArray<FString>(ShaderOutput.PragmaDirectives.GetData() + NumPragmaDirectivesBefore, ShaderOutput.PragmaDirectives.Num() - NumPragmaDirectivesBefore);
+		Entry.DiskIncludes = MoveTemp(DiskIncludes);
+		GetShaderPreprocessorCache().AddResult(ResultCacheKey, MoveTemp(Entry), ResultCacheSize);
+	}
+
 	return true;
 }
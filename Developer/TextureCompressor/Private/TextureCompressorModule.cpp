@@ -4,8 +4,11 @@
 #include "Math/RandomStream.h"
 #include "Containers/IndirectArray.h"
 #include "Stats/Stats.h"
+#include "Async/Async.h"
 #include "Async/AsyncWork.h"
 #include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
 #include "Modules/ModuleManager.h"
 #include "Engine/Texture.h"
 #include "Interfaces/ITargetPlatformManagerModule.h"
@@ -19,6 +22,27 @@
 
 DEFINE_LOG_CATEGORY_STATIC(LogTextureCompressor, Log, All);
 
+static TAutoConsoleVariable<int32> CVarVectorizedMipGen(
+	TEXT("r.TextureCompressor.VectorizedMipGen"),
+	1,
+	TEXT("If enabled, mips filtered with a separable kernel are generated with a vectorized two pass filter\n")
+	TEXT("instead of sampling the full 2D kernel for every texel. Results only differ by float rounding."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarStreamingMipChainMinSize(
+	TEXT("r.TextureCompressor.StreamingMipChainMinSize"),
+	4096,
+	TEXT("Textures whose top mip is at least this large in either dimension compress each generated mip as soon as it is\n")
+	TEXT("available and release its float data afterwards, instead of building the whole float mip chain first. 0 disables."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarTopMipBandHeight(
+	TEXT("r.TextureCompressor.TopMipBandHeight"),
+	256,
+	TEXT("Rows of the top mip converted, filtered and compressed at a time when the mip chain is streamed, so the float top\n")
+	TEXT("mip never exists as a whole. Only used for formats and settings that give the same result. 0 disables."),
+	ECVF_Default);
+
 /*------------------------------------------------------------------------------
 	Mip-Map Generation
 ------------------------------------------------------------------------------*/
@@ -107,12 +131,30 @@ FLinearColor LookupSourceMip(const FImageView2D& SourceImageData, int32 X, int32
 	return SourceImageData.Access(X,Y);
 }
 
+// 1D version of the address mode handling in LookupSourceMip, returns INDEX_NONE for the black border
+template <EMipGenAddressMode AddressMode>
+int32 ResolveSourceMipCoord(int32 Coord, int32 Size)
+{
+	if(AddressMode == MGTAM_Wrap)
+	{
+		return (int32)((uint32)Coord) & (Size - 1);
+	}
+	else if(AddressMode == MGTAM_Clamp)
+	{
+		return FMath::Clamp(Coord, 0, Size - 1);
+	}
+	else
+	{
+		return (uint32)Coord < (uint32)Size ? Coord : INDEX_NONE;
+	}
+}
+
 // Kernel class for image filtering operations like image downsampling
 // at max MaxKernelExtend x MaxKernelExtend
 class FImageKernel2D
 {
 public:
-	FImageKernel2D() :FilterTableSize(0)
+	FImageKernel2D() :FilterTableSize(0), bSeparable(false)
 	{
 	}
 
@@ -136,12 +178,15 @@ public:
 			// blur only
 			BuildGaussian1D(Table1D, TableSize1D, 1.0f, -SharpenFactor);
 			BuildFilterTable2DFrom1D(KernelWeights, Table1D, TableSize1D);
+			SetSeparableWeights(Table1D, TableSize1D);
 			return;
 		}
 		else if(TableSize1D == 2)
 		{
 			// 2x2 kernel: simple average
 			KernelWeights[0] = KernelWeights[1] = KernelWeights[2] = KernelWeights[3] = 0.25f;
+			KernelWeights1D[0] = KernelWeights1D[1] = 0.5f;
+			bSeparable = true;
 			return;
 		}
 		else if(TableSize1D == 4)
@@ -179,6 +224,7 @@ public:
 
 		AddFilterTable1D(Table1D, NegativeTable1D, TableSize1D);
 		BuildFilterTable2DFrom1D(KernelWeights, Table1D, TableSize1D);
+		SetSeparableWeights(Table1D, TableSize1D);
 	}
 
 	inline uint32 GetFilterTableSize() const
@@ -186,6 +232,19 @@ public:
 		return FilterTableSize;
 	}
 
+	// true if the 2D weights are the outer product of GetAt1D() with itself
+	inline bool IsSeparable() const
+	{
+		return bSeparable;
+	}
+
+	inline float GetAt1D(uint32 X) const
+	{
+		checkSlow(bSeparable);
+		checkSlow(X < FilterTableSize);
+		return KernelWeights1D[X];
+	}
+
 	inline float GetAt(uint32 X, uint32 Y) const
 	{
 		checkSlow(X < FilterTableSize);
@@ -197,11 +256,22 @@ public:
 	{
 		checkSlow(X < FilterTableSize);
 		checkSlow(Y < FilterTableSize);
+		// the caller may change the weights in any way
+		bSeparable = false;
 		return KernelWeights[X + Y * FilterTableSize];
 	}
 
 private:
 
+	void SetSeparableWeights(const float* InTable1D, uint32 TableSize)
+	{
+		for(uint32 x = 0; x < TableSize; ++x)
+		{
+			KernelWeights1D[x] = InTable1D[x];
+		}
+		bSeparable = true;
+	}
+
 	inline static float NormalDistribution(float X, float Variance)
 	{
 		const float StandardDeviation = FMath::Sqrt(Variance);
@@ -311,8 +381,79 @@ private:
 	uint32 FilterTableSize;
 	// normalized, means the sum of it should be 1.0f
 	float KernelWeights[MaxKernelExtend * MaxKernelExtend];
+	// 1D weights the 2D kernel was built from, only valid if bSeparable
+	float KernelWeights1D[MaxKernelExtend];
+	bool bSeparable;
 };
 
+/**
+ * Filters one destination row with a separable kernel: a vertical pass into ColumnSums followed by a horizontal pass.
+ * Each texel is a single 4 wide vector so both passes run at SIMD width without any per-texel address mode handling,
+ * which is resolved up front in SourceColumns (one entry per column the horizontal pass reads).
+ */
+template <EMipGenAddressMode AddressMode>
+static void FilterMipRowSeparable(
+	const FImageView2D& SourceImageData,
+	FImageView2D& DestImageData,
+	int32 DestY,
+	const FImageKernel2D& Kernel,
+	uint32 ScaleFactor,
+	const TArray<int32>& SourceColumns,
+	TArray<FLinearColor>& ColumnSums)
+{
+	const int32 KernelSize = (int32)Kernel.GetFilterTableSize();
+	const int32 KernelCenter = KernelSize / 2 - 1;
+	const int32 NumColumns = SourceColumns.Num();
+
+	ColumnSums.SetNumZeroed(NumColumns, false);
+	FLinearColor* RESTRICT Sums = ColumnSums.GetData();
+
+	// vertical pass
+	for (int32 KernelY = 0; KernelY < KernelSize; ++KernelY)
+	{
+		const int32 SourceY = ResolveSourceMipCoord<AddressMode>(DestY * ScaleFactor + KernelY - KernelCenter, SourceImageData.SizeY);
+		if (SourceY == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FLinearColor* RESTRICT SourceRow = &SourceImageData.Access(0, SourceY);
+		const VectorRegister Weight = VectorSetFloat1(Kernel.GetAt1D(KernelY));
+
+		for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+		{
+			const int32 SourceX = SourceColumns[ColumnIndex];
+			if (AddressMode != MGTAM_BorderBlack || SourceX != INDEX_NONE)
+			{
+				VectorRegister Sum = VectorLoad(&Sums[ColumnIndex]);
+				Sum = VectorMultiplyAdd(VectorLoad(&SourceRow[SourceX]), Weight, Sum);
+				VectorStore(Sum, &Sums[ColumnIndex]);
+			}
+		}
+	}
+
+	// horizontal pass
+	VectorRegister Weights[16];
+	check(KernelSize <= UE_ARRAY_COUNT(Weights));
+	for (int32 KernelX = 0; KernelX < KernelSize; ++KernelX)
+	{
+		Weights[KernelX] = VectorSetFloat1(Kernel.GetAt1D(KernelX));
+	}
+
+	FLinearColor* RESTRICT DestRow = &DestImageData.Access(0, DestY);
+	for (int32 DestX = 0; DestX < DestImageData.SizeX; ++DestX)
+	{
+		const FLinearColor* RESTRICT Columns = &Sums[DestX * ScaleFactor];
+
+		VectorRegister Filtered = VectorZero();
+		for (int32 KernelX = 0; KernelX < KernelSize; ++KernelX)
+		{
+			Filtered = VectorMultiplyAdd(VectorLoad(&Columns[KernelX]), Weights[KernelX], Filtered);
+		}
+		VectorStore(Filtered, &DestRow[DestX]);
+	}
+}
+
 template <EMipGenAddressMode AddressMode>
 static FVector4 ComputeAlphaCoverage(const FVector4& Thresholds, const FVector4& Scales, const FImageView2D& SourceImageData)
 {
@@ -446,8 +587,29 @@ static void GenerateSharpenedMipB8G8R8A8Templ(
 		AlphaScale = ComputeAlphaScale<AddressMode>(AlphaCoverages, AlphaThresholds, SourceImageData);
 	}
 	
+	// Plain filtering with a separable kernel takes the vectorized two pass path, the sharpen without color shift
+	// mode needs the 2D kernel and a second 2x2 filter per texel so it stays on the scalar path below.
+	const bool bSeparableFilter = !bUnfiltered && !bSharpenWithoutColorShift && Kernel.IsSeparable() && CVarVectorizedMipGen.GetValueOnAnyThread() != 0;
+
+	TArray<int32> SourceColumns;
+	if ( bSeparableFilter )
+	{
+		const int32 NumColumns = (DestImageData.SizeX - 1) * ScaleFactor + Kernel.GetFilterTableSize();
+		SourceColumns.SetNumUninitialized(NumColumns);
+		for ( int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex )
+		{
+			SourceColumns[ColumnIndex] = ResolveSourceMipCoord<AddressMode>(ColumnIndex - KernelCenter, SourceImageData.SizeX);
+		}
+	}
+
 	ParallelFor(DestImageData.SizeY, [&](int32 DestY)
 	{
+		if ( bSeparableFilter )
+		{
+			TArray<FLinearColor> ColumnSums;
+			FilterMipRowSeparable<AddressMode>(SourceImageData, DestImageData, DestY, Kernel, ScaleFactor, SourceColumns, ColumnSums);
+		}
+
 		for ( int32 DestX = 0;DestX < DestImageData.SizeX; DestX++ )
 		{
 			const int32 SourceX = DestX * ScaleFactor;
@@ -455,7 +617,11 @@ static void GenerateSharpenedMipB8G8R8A8Templ(
 
 			FLinearColor FilteredColor(0, 0, 0, 0);
 
-			if ( bUnfiltered )
+			if ( bSeparableFilter )
+			{
+				FilteredColor = DestImageData.Access(DestX, DestY);
+			}
+			else if ( bUnfiltered )
 			{
 				FilteredColor = LookupSourceMip<AddressMode>(SourceImageData, SourceX + 0, SourceY + 0);
 			}
@@ -884,12 +1050,126 @@ static void DownscaleImage(const FImage& SrcImage, FImage& DstImage, const FText
 	}
 }
 
+// Smallest mip dimension that is compressed on another thread.
+// This number was too small (128) for current hardware and caused too many
+// context switch for work taking < 1ms. Bump the value for 2020 CPUs.
+static const int32 MinAsyncCompressionSize = 512;
+
+/**
+ * Compresses the mips of a texture as they are generated rather than once the whole float mip chain exists, so that
+ * compression overlaps with generating the rest of the chain. Each generated mip's float data is released once it has
+ * been compressed. The float source mips and the generator's intermediate images stay alive until the chain is done,
+ * so this saves little more than the lower mips of the chain, unless the top mip is handed over in bands. Mips in the
+ * packed mip tail are kept until the end and compressed together.
+ */
+class FStreamingMipChainCompressor
+{
+public:
+	FStreamingMipChainCompressor(const ITextureFormat* InTextureFormat, const FTextureBuildSettings& InBuildSettings);
+	~FStreamingMipChainCompressor();
+
+	/**
+	 * Sets the mips that start the chain, they are taken over together with the first generated mip.
+	 * The mip tail layout and alpha detection depend on the final top mip, which isn't final until the first mip
+	 * has been generated from it.
+	 * @param InNumMips - number of mips in the whole chain, including the base mips
+	 */
+	void SetBaseMips(TArray<FImage>& InBaseMips, int32 InNumMips);
+
+	/** Takes the next mip of the chain. */
+	void AddMip(FImage&& Mip);
+
+	/**
+	 * true if the format compresses rows of blocks independently and without device tiling, so that the top mip can
+	 * be compressed a band at a time and the compressed bands concatenated.
+	 */
+	bool CanCompressTopMipInBands() const;
+
+	/**
+	 * Starts a chain whose top mip is handed over in bands by AddTopMipBand, followed by the other mips given to AddMip.
+	 * @param bInImageHasAlphaChannel - alpha detection for the whole top mip, the bands can't be looked at together
+	 */
+	void SetBandedTopMip(int32 SizeX, int32 SizeY, int32 InNumMips, bool bInImageHasAlphaChannel);
+
+	/** Takes the next band of rows of the top mip, the bands are compressed as they come in and their float data released. */
+	void AddTopMipBand(FImage&& Band);
+
+	/** true once the base mips were taken over, false if the chain was never streamed. */
+	bool HasStarted() const { return bStarted; }
+
+	int32 GetNumMipsAdded() const { return NumMipsAdded; }
+
+	/** Settings the mips were compressed with, including the top mip size. */
+	const FTextureBuildSettings& GetBuildSettings() const { return BuildSettings; }
+
+	/** Waits for all mips to be compressed. */
+	bool Finish(TArray<FCompressedImage2D>& OutMips, uint32& OutNumMipsInTail, uint32& OutExtData);
+
+private:
+	struct FMipJob
+	{
+		FImage Image;
+		FCompressedImage2D CompressedImage;
+		bool bSucceeded = false;
+		TFuture<void> Future;
+	};
+
+	void Start();
+	void CompressMip(FImage&& Mip);
+	void StartCompressJob(FMipJob* MipJob, bool bAsync);
+
+	const ITextureFormat& TextureFormat;
+	FTextureBuildSettings BuildSettings;
+	const bool bAllowParallelBuild;
+	int32 NumMips = 0;
+
+	TArray<FImage>* BaseMips = nullptr;
+	bool bStarted = false;
+	int32 NumMipsAdded = 0;
+
+	bool bImageHasAlphaChannel = false;
+	FTextureFormatCompressorCaps CompressorCaps;
+	int32 FirstMipTailIndex = 0;
+
+	TArray<TUniquePtr<FMipJob>> MipJobs;
+	TArray<FImage> TailMips;
+
+	/** Compression of the bands of the top mip when it was handed over in bands, concatenated into mip 0 by Finish. */
+	TArray<TUniquePtr<FMipJob>> TopMipBandJobs;
+	FIntPoint BandedTopMipSize = FIntPoint::ZeroValue;
+	int32 NumTopMipBandRows = 0;
+};
+
+// Bands of the top mip being compressed at once. Each band keeps its float image alive until it's compressed.
+static const int32 MaxTopMipBandsInFlight = 4;
+
+/**
+ * Generates mips from BaseImage. Mips are appended to OutMipChain, or handed to MipSink one at a time as soon as they
+ * are complete if a sink is given. BaseImage isn't accessed anymore once the first mip has been handed to the sink.
+ */
+static void GenerateMipChainInternal(
+	const FTextureBuildSettings& Settings,
+	const FImage& BaseImage,
+	TArray<FImage> &OutMipChain,
+	uint32 MipChainDepth,
+	FStreamingMipChainCompressor* MipSink);
+
 void ITextureCompressorModule::GenerateMipChain(
 	const FTextureBuildSettings& Settings,
 	const FImage& BaseImage,
 	TArray<FImage> &OutMipChain,
 	uint32 MipChainDepth 
 	)
+{
+	GenerateMipChainInternal(Settings, BaseImage, OutMipChain, MipChainDepth, nullptr);
+}
+
+static void GenerateMipChainInternal(
+	const FTextureBuildSettings& Settings,
+	const FImage& BaseImage,
+	TArray<FImage> &OutMipChain,
+	uint32 MipChainDepth,
+	FStreamingMipChainCompressor* MipSink)
 {
 	check(BaseImage.Format == ERawImageFormat::RGBA32F);
 
@@ -971,7 +1251,12 @@ void ITextureCompressorModule::GenerateMipChain(
 		const FImage& IntermediateSrc = *IntermediateSrcPtr;
 		FImage& IntermediateDst = *IntermediateDstPtr;
 
-		FImage& DestImage = *new(OutMipChain) FImage(IntermediateDst.SizeX, IntermediateDst.SizeY, IntermediateDst.NumSlices, ImageFormat);
+		FImage StreamedImage;
+		if (MipSink)
+		{
+			StreamedImage.Init(IntermediateDst.SizeX, IntermediateDst.SizeY, IntermediateDst.NumSlices, ImageFormat);
+		}
+		FImage& DestImage = MipSink ? StreamedImage : *new(OutMipChain) FImage(IntermediateDst.SizeX, IntermediateDst.SizeY, IntermediateDst.NumSlices, ImageFormat);
 		
 		for (int32 SliceIndex = 0; SliceIndex < IntermediateDst.NumSlices; ++SliceIndex)
 		{
@@ -1031,6 +1316,11 @@ void ITextureCompressorModule::GenerateMipChain(
 			}
 		}
 
+		if (MipSink)
+		{
+			MipSink->AddMip(MoveTemp(StreamedImage));
+		}
+
 		// Once we've created mip-maps down to 1x1, we're done.
 		if ( IntermediateDst.SizeX == 1 && IntermediateDst.SizeY == 1 && (!Settings.bVolume || IntermediateDst.NumSlices == 1))
 		{
@@ -1769,7 +2059,7 @@ static void ComputeBokehAlpha(FImage& Image)
 /**
  * Replicates the contents of the red channel to the green, blue, and alpha channels.
  */
-static void ReplicateRedChannel( TArray<FImage>& InOutMipChain )
+static void ReplicateRedChannel( TArrayView<FImage> InOutMipChain )
 {
 	const uint32 MipCount = InOutMipChain.Num();
 	for ( uint32 MipIndex = 0; MipIndex < MipCount; ++MipIndex )
@@ -1787,7 +2077,7 @@ static void ReplicateRedChannel( TArray<FImage>& InOutMipChain )
 /**
  * Replicates the contents of the alpha channel to the red, green, and blue channels.
  */
-static void ReplicateAlphaChannel( TArray<FImage>& InOutMipChain )
+static void ReplicateAlphaChannel( TArrayView<FImage> InOutMipChain )
 {
 	const uint32 MipCount = InOutMipChain.Num();
 	for ( uint32 MipIndex = 0; MipIndex < MipCount; ++MipIndex )
@@ -1836,7 +2126,7 @@ static bool DetectAlphaChannel(const FImage& InImage)
 }
 
 /** Calculate a scale per 4x4 block of each image, and apply it to the red/green channels. Store scale in the blue channel. */
-static void ApplyYCoCgBlockScale(TArray<FImage>& InOutMipChain)
+static void ApplyYCoCgBlockScale(TArrayView<FImage> InOutMipChain)
 {
 	const uint32 MipCount = InOutMipChain.Num();
 	for (uint32 MipIndex = 0; MipIndex < MipCount; ++MipIndex)
@@ -2043,6 +2333,297 @@ private:
 	bool bCompressionResults;
 };
 
+// Apply post-mip generation adjustments.
+static void ApplyPostMipGenerationAdjustments(TArrayView<FImage> InOutMipChain, const FTextureBuildSettings& BuildSettings)
+{
+	if (BuildSettings.bReplicateRed)
+	{
+		ReplicateRedChannel(InOutMipChain);
+	}
+	else if (BuildSettings.bReplicateAlpha)
+	{
+		ReplicateAlphaChannel(InOutMipChain);
+	}
+	if (BuildSettings.bApplyYCoCgBlockScale)
+	{
+		ApplyYCoCgBlockScale(InOutMipChain);
+	}
+}
+
+FStreamingMipChainCompressor::FStreamingMipChainCompressor(const ITextureFormat* InTextureFormat, const FTextureBuildSettings& InBuildSettings)
+	: TextureFormat(*InTextureFormat)
+	, BuildSettings(InBuildSettings)
+	, bAllowParallelBuild(InTextureFormat->AllowParallelBuild())
+{
+}
+
+FStreamingMipChainCompressor::~FStreamingMipChainCompressor()
+{
+	// jobs reference this object
+	for (TUniquePtr<FMipJob>& MipJob : MipJobs)
+	{
+		if (MipJob->Future.IsValid())
+		{
+			MipJob->Future.Wait();
+		}
+	}
+	for (TUniquePtr<FMipJob>& BandJob : TopMipBandJobs)
+	{
+		if (BandJob->Future.IsValid())
+		{
+			BandJob->Future.Wait();
+		}
+	}
+}
+
+void FStreamingMipChainCompressor::SetBaseMips(TArray<FImage>& InBaseMips, int32 InNumMips)
+{
+	check(!bStarted && InNumMips > InBaseMips.Num());
+	BaseMips = &InBaseMips;
+	NumMips = InNumMips;
+}
+
+void FStreamingMipChainCompressor::Start()
+{
+	check(BaseMips && BaseMips->Num() > 0);
+	bStarted = true;
+
+	TArray<FImage>& TopMips = *BaseMips;
+	BaseMips = nullptr;
+
+	ApplyPostMipGenerationAdjustments(TopMips, BuildSettings);
+
+	// Set the correct biased texture size so that the compressor understands the original source image size
+	const FImage& TopMip = TopMips[0];
+	BuildSettings.TopMipSize.X = TopMip.SizeX;
+	BuildSettings.TopMipSize.Y = TopMip.SizeY;
+	BuildSettings.VolumeSizeZ = BuildSettings.bVolume ? TopMip.NumSlices : 1;
+	BuildSettings.ArraySlices = BuildSettings.bTextureArray ? TopMip.NumSlices : 1;
+
+	bImageHasAlphaChannel = BuildSettings.bForceAlphaChannel || DetectAlphaChannel(TopMip);
+	CompressorCaps = TextureFormat.GetFormatCapabilitiesEx(BuildSettings, NumMips, TopMip, bImageHasAlphaChannel);
+	check(NumMips >= (int32)CompressorCaps.NumMipsInTail);
+	FirstMipTailIndex = CompressorCaps.NumMipsInTail > 1 ? NumMips - CompressorCaps.NumMipsInTail : NumMips;
+
+	MipJobs.Reserve(NumMips);
+	for (FImage& Mip : TopMips)
+	{
+		CompressMip(MoveTemp(Mip));
+	}
+	TopMips.Empty();
+}
+
+void FStreamingMipChainCompressor::AddMip(FImage&& Mip)
+{
+	if (!bStarted)
+	{
+		Start();
+	}
+
+	ApplyPostMipGenerationAdjustments(MakeArrayView(&Mip, 1), BuildSettings);
+	CompressMip(MoveTemp(Mip));
+}
+
+void FStreamingMipChainCompressor::CompressMip(FImage&& Mip)
+{
+	const int32 MipIndex = NumMipsAdded++;
+	check(MipIndex < NumMips);
+
+	MipJobs.Add(MakeUnique<FMipJob>());
+	if (MipIndex >= FirstMipTailIndex)
+	{
+		// the mip tail is compressed in one go by Finish
+		TailMips.Add(MoveTemp(Mip));
+		return;
+	}
+
+	FMipJob* MipJob = MipJobs.Last().Get();
+	MipJob->Image = MoveTemp(Mip);
+	StartCompressJob(MipJob, FMath::Min(MipJob->Image.SizeX, MipJob->Image.SizeY) >= MinAsyncCompressionSize);
+}
+
+void FStreamingMipChainCompressor::StartCompressJob(FMipJob* MipJob, bool bAsync)
+{
+	auto CompressJob = [this, MipJob]()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(CompressImage);
+
+		MipJob->bSucceeded = TextureFormat.CompressImageEx(&MipJob->Image, 1, BuildSettings, bImageHasAlphaChannel, CompressorCaps.ExtData, MipJob->CompressedImage);
+		MipJob->Image = FImage();
+	};
+
+	if (bAllowParallelBuild && bAsync)
+	{
+		MipJob->Future = Async(EAsyncExecution::TaskGraph, MoveTemp(CompressJob));
+	}
+	else
+	{
+		CompressJob();
+	}
+}
+
+bool FStreamingMipChainCompressor::CanCompressTopMipInBands() const
+{
+	// Formats made of 4x4 blocks or of pixels that are compressed independently of their neighbours. Platform formats
+	// that tile the image or pack a mip tail need the whole mip.
+	static const FName BandedFormatNames[] =
+	{
+		FName(TEXT("DXT1")), FName(TEXT("DXT3")), FName(TEXT("DXT5")), FName(TEXT("DXT5n")), FName(TEXT("AutoDXT")),
+		FName(TEXT("BC4")), FName(TEXT("BC5")), FName(TEXT("BC6H")), FName(TEXT("BC7")),
+		FName(TEXT("BGRA8")), FName(TEXT("RGBA8")), FName(TEXT("XGXR8")), FName(TEXT("G8")), FName(TEXT("G16")), FName(TEXT("VU8")),
+		FName(TEXT("RGBA16F")), FName(TEXT("R16F")),
+	};
+
+	bool bBandedFormat = false;
+	for (const FName& FormatName : BandedFormatNames)
+	{
+		bBandedFormat = bBandedFormat || BuildSettings.TextureFormatName == FormatName;
+	}
+
+	return bBandedFormat &&
+		!TextureFormat.SupportsTiling(BuildSettings) &&
+		TextureFormat.GetFormatCapabilities().NumMipsInTail <= 1;
+}
+
+void FStreamingMipChainCompressor::SetBandedTopMip(int32 SizeX, int32 SizeY, int32 InNumMips, bool bInImageHasAlphaChannel)
+{
+	check(!bStarted && !BaseMips && InNumMips > 1);
+	NumMips = InNumMips;
+	BandedTopMipSize = FIntPoint(SizeX, SizeY);
+	bImageHasAlphaChannel = bInImageHasAlphaChannel;
+}
+
+void FStreamingMipChainCompressor::AddTopMipBand(FImage&& Band)
+{
+	check(BandedTopMipSize.X == Band.SizeX && NumTopMipBandRows + Band.SizeY <= BandedTopMipSize.Y && Band.NumSlices == 1);
+	NumTopMipBandRows += Band.SizeY;
+
+	ApplyPostMipGenerationAdjustments(MakeArrayView(&Band, 1), BuildSettings);
+
+	if (!bStarted)
+	{
+		bStarted = true;
+
+		BuildSettings.TopMipSize.X = BandedTopMipSize.X;
+		BuildSettings.TopMipSize.Y = BandedTopMipSize.Y;
+		BuildSettings.VolumeSizeZ = 1;
+		BuildSettings.ArraySlices = 1;
+
+		// the first band stands in for the top mip, the caps of the formats that take bands don't depend on its size
+		CompressorCaps = TextureFormat.GetFormatCapabilitiesEx(BuildSettings, NumMips, Band, bImageHasAlphaChannel);
+		check(CompressorCaps.NumMipsInTail <= 1);
+		FirstMipTailIndex = NumMips;
+
+		MipJobs.Reserve(NumMips);
+		MipJobs.Add(MakeUnique<FMipJob>());
+		NumMipsAdded = 1;
+	}
+
+	// Wait for the oldest band rather than piling up the float data of the whole mip
+	const int32 NumBandJobs = TopMipBandJobs.Num();
+	if (NumBandJobs >= MaxTopMipBandsInFlight)
+	{
+		FMipJob& OldestJob = *TopMipBandJobs[NumBandJobs - MaxTopMipBandsInFlight];
+		if (OldestJob.Future.IsValid())
+		{
+			OldestJob.Future.Wait();
+		}
+	}
+
+	TopMipBandJobs.Add(MakeUnique<FMipJob>());
+	FMipJob* BandJob = TopMipBandJobs.Last().Get();
+	BandJob->Image = MoveTemp(Band);
+	StartCompressJob(BandJob, BandJob->Image.SizeX >= MinAsyncCompressionSize);
+}
+
+bool FStreamingMipChainCompressor::Finish(TArray<FCompressedImage2D>& OutMips, uint32& OutNumMipsInTail, uint32& OutExtData)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FStreamingMipChainCompressor::Finish)
+
+	check(bStarted && NumMipsAdded == NumMips);
+
+	OutNumMipsInTail = CompressorCaps.NumMipsInTail;
+	OutExtData = CompressorCaps.ExtData;
+
+	bool bCompressionSucceeded = true;
+	if (TailMips.Num())
+	{
+		FMipJob& TailJob = *MipJobs[FirstMipTailIndex];
+		TailJob.bSucceeded = TextureFormat.CompressImageEx(TailMips.GetData(), TailMips.Num(), BuildSettings, bImageHasAlphaChannel, CompressorCaps.ExtData, TailJob.CompressedImage);
+		TailMips.Empty();
+	}
+
+	OutMips.Empty(NumMips);
+	for (int32 MipIndex = 0; MipIndex < NumMips; ++MipIndex)
+	{
+		FMipJob& MipJob = *MipJobs[MipIndex];
+		FCompressedImage2D& DestMip = *new(OutMips) FCompressedImage2D;
+
+		if (MipIndex > FirstMipTailIndex)
+		{
+			// packed in the mip tail
+			const FCompressedImage2D& PrevMip = OutMips[MipIndex - 1];
+			DestMip.SizeX = FMath::Max(1, PrevMip.SizeX >> 1);
+			DestMip.SizeY = FMath::Max(1, PrevMip.SizeY >> 1);
+			DestMip.SizeZ = FMath::Max(1, PrevMip.SizeZ >> 1);
+			DestMip.PixelFormat = PrevMip.PixelFormat;
+			continue;
+		}
+
+		if (MipIndex == 0 && TopMipBandJobs.Num())
+		{
+			check(NumTopMipBandRows == BandedTopMipSize.Y);
+
+			// the compressed bands are whole rows of blocks, in order
+			for (TUniquePtr<FMipJob>& BandJob : TopMipBandJobs)
+			{
+				if (BandJob->Future.IsValid())
+				{
+					BandJob->Future.Wait();
+				}
+				bCompressionSucceeded = bCompressionSucceeded && BandJob->bSucceeded;
+			}
+
+			const FCompressedImage2D& FirstBand = TopMipBandJobs[0]->CompressedImage;
+			DestMip.SizeX = FirstBand.SizeX;
+			DestMip.SizeY = 0;
+			DestMip.SizeZ = FirstBand.SizeZ;
+			DestMip.PixelFormat = FirstBand.PixelFormat;
+
+			int64 RawDataSize = 0;
+			for (TUniquePtr<FMipJob>& BandJob : TopMipBandJobs)
+			{
+				RawDataSize += BandJob->CompressedImage.RawData.Num();
+			}
+			DestMip.RawData.Reserve(RawDataSize);
+			for (TUniquePtr<FMipJob>& BandJob : TopMipBandJobs)
+			{
+				check(BandJob->CompressedImage.PixelFormat == DestMip.PixelFormat);
+				DestMip.RawData.Append(BandJob->CompressedImage.RawData);
+				DestMip.SizeY += BandJob->CompressedImage.SizeY;
+				BandJob->CompressedImage.RawData.Empty();
+			}
+			continue;
+		}
+
+		if (MipJob.Future.IsValid())
+		{
+			MipJob.Future.Wait();
+		}
+		DestMip = MoveTemp(MipJob.CompressedImage);
+		bCompressionSucceeded = bCompressionSucceeded && MipJob.bSucceeded;
+	}
+	MipJobs.Empty();
+	TopMipBandJobs.Empty();
+
+	if (!bCompressionSucceeded)
+	{
+		OutMips.Empty();
+	}
+
+	return bCompressionSucceeded;
+}
+
 // compress mip-maps in InMipChain and add mips to Texture, might alter the source content
 static bool CompressMipChain(
 	const ITextureFormat* TextureFormat,
@@ -2063,9 +2644,6 @@ static bool CompressMipChain(
 
 	int32 MipCount = MipChain.Num();
 	check(MipCount >= (int32)CompressorCaps.NumMipsInTail);
-	// This number was too small (128) for current hardware and caused too many
-	// context switch for work taking < 1ms. Bump the value for 2020 CPUs.
-	const int32 MinAsyncCompressionSize = 512;
 	const bool bAllowParallelBuild = TextureFormat->AllowParallelBuild();
 	bool bCompressionSucceeded = true;
 	int32 FirstMipTailIndex = MipCount;
@@ -2186,6 +2764,159 @@ static void NormalizeMip(FImage& InOutMip)
 	}
 }
 
+// Rows above and below a band of the top mip that the downsample filter reads. The largest kernel has 12 taps, centered
+// 5 rows before the source row. Kept even so the band's first mip rows start on a whole row.
+static const int32 TopMipBandBorder = 8;
+
+/**
+ * Converts rows FirstRow - Border up to FirstRow + NumRows + Border of the source to the linear float top mip, with the
+ * color adjustments the top mip gets before mips are generated from it. Rows outside the source wrap around.
+ */
+static void ConvertTopMipRows(const FImage& SourceImage, int32 FirstRow, int32 NumRows, int32 Border, const FTextureBuildSettings& Settings, FImage& OutRows)
+{
+	const int64 BytesPerRow = int64(SourceImage.SizeX) * SourceImage.GetBytesPerPixel();
+
+	FImage SourceRows(SourceImage.SizeX, NumRows + 2 * Border, 1, SourceImage.Format, SourceImage.GammaSpace);
+	for (int32 RowIndex = 0; RowIndex < SourceRows.SizeY; ++RowIndex)
+	{
+		const int32 SourceRow = (FirstRow - Border + RowIndex) & (SourceImage.SizeY - 1);
+		FMemory::Memcpy(&SourceRows.RawData[RowIndex * BytesPerRow], &SourceImage.RawData[SourceRow * BytesPerRow], BytesPerRow);
+	}
+	SourceRows.CopyTo(OutRows, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+	if (Settings.bRenormalizeTopMip)
+	{
+		NormalizeMip(OutRows);
+	}
+	ITextureCompressorModule::AdjustImageColors(OutRows, Settings);
+	if (Settings.bFlipGreenChannel)
+	{
+		FlipGreenChannel(OutRows);
+	}
+}
+
+bool ITextureCompressorModule::CanGenerateTopMipInBands(const FTextureBuildSettings& Settings, const FImage& SourceImage, int32 BandHeight)
+{
+	// Everything that looks at the whole top mip, or at more than a few rows of it at once, needs the whole chain path:
+	// the top mip kernel, downscaling, bokeh alpha, alpha coverage and redrawing the border. Dithering draws from one
+	// random stream for the whole mip. YCoCg block scale assumes square images.
+	return SourceImage.NumSlices == 1 &&
+		!Settings.bCubemap && !Settings.bVolume && !Settings.bTextureArray &&
+		FMath::IsPowerOfTwo(SourceImage.SizeX) && FMath::IsPowerOfTwo(SourceImage.SizeY) &&
+		BandHeight > 0 && BandHeight % 4 == 0 && SourceImage.SizeY % BandHeight == 0 && SourceImage.SizeY >= 2 * BandHeight &&
+		SourceImage.SizeX >= 2 &&
+		!Settings.bApplyKernelToTopMip &&
+		Settings.Downscale <= 1.0f &&
+		!Settings.bComputeBokehAlpha &&
+		Settings.AlphaCoverageThresholds == FVector4(0, 0, 0, 0) &&
+		!Settings.bPreserveBorder &&
+		!Settings.bDitherMipMapAlpha &&
+		!Settings.bApplyYCoCgBlockScale;
+}
+
+void ITextureCompressorModule::GenerateTopMipInBands(
+	const FTextureBuildSettings& Settings,
+	const FImage& SourceImage,
+	int32 BandHeight,
+	TFunctionRef<void(FImage& Band)> OnBand,
+	FImage& OutFirstMip,
+	FImage& OutFirstMipSource,
+	SIZE_T* OutPeakWorkingSize)
+{
+	check(CanGenerateTopMipInBands(Settings, SourceImage, BandHeight));
+
+	const ERawImageFormat::Type ImageFormat = ERawImageFormat::RGBA32F;
+	const int32 SizeX = SourceImage.SizeX;
+	const int32 FirstMipSizeX = SizeX / 2;
+	const int32 FirstMipBandHeight = BandHeight / 2;
+	const int64 FirstMipBytesPerRow = int64(FirstMipSizeX) * sizeof(FLinearColor);
+
+	FImageKernel2D KernelSimpleAverage;
+	FImageKernel2D KernelDownsample;
+	KernelSimpleAverage.BuildSeparatableGaussWithSharpen(2);
+	KernelDownsample.BuildSeparatableGaussWithSharpen(Settings.SharpenMipKernelSize, Settings.MipSharpening);
+	check(KernelDownsample.GetFilterTableSize() / 2 - 1 <= (uint32)TopMipBandBorder);
+
+	const bool bUnfiltered = Settings.MipGenSettings == TMGS_Unfiltered;
+
+	OutFirstMip.Init(FirstMipSizeX, SourceImage.SizeY / 2, 1, ImageFormat);
+	if (Settings.bDownsampleWithAverage)
+	{
+		OutFirstMipSource.Init(FirstMipSizeX, SourceImage.SizeY / 2, 1, ImageFormat);
+	}
+
+	SIZE_T PeakWorkingSize = 0;
+	auto UpdatePeakWorkingSize = [&](SIZE_T BandWorkingSize)
+	{
+		PeakWorkingSize = FMath::Max<SIZE_T>(PeakWorkingSize, BandWorkingSize + OutFirstMip.RawData.Num() + OutFirstMipSource.RawData.Num());
+	};
+
+	for (int32 FirstRow = 0; FirstRow < SourceImage.SizeY; FirstRow += BandHeight)
+	{
+		FImage BandWithBorder;
+		ConvertTopMipRows(SourceImage, FirstRow, BandHeight, TopMipBandBorder, Settings, BandWithBorder);
+
+		// Filter the whole band including the border, the mip rows of the border are dropped
+		{
+			FImage BandMip(FirstMipSizeX, BandWithBorder.SizeY / 2, 1, ImageFormat);
+			FImage BandMipSource;
+			const FImageView2D BandView = FImageView2D::ConstructConst(BandWithBorder, 0);
+			FImageView2D BandMipView(BandMip, 0);
+			GenerateSharpenedMipB8G8R8A8(BandView, FImageView2D(), BandMipView, MGTAM_Wrap, false, FVector4(0, 0, 0, 0), FVector4(0, 0, 0, 0), KernelDownsample, 2, Settings.bSharpenWithoutColorShift, bUnfiltered);
+			if (Settings.bDownsampleWithAverage)
+			{
+				BandMipSource.Init(FirstMipSizeX, BandWithBorder.SizeY / 2, 1, ImageFormat);
+				FImageView2D BandMipSourceView(BandMipSource, 0);
+				GenerateSharpenedMipB8G8R8A8(BandView, FImageView2D(), BandMipSourceView, MGTAM_Wrap, false, FVector4(0, 0, 0, 0), FVector4(0, 0, 0, 0), KernelSimpleAverage, 2, Settings.bSharpenWithoutColorShift, bUnfiltered);
+			}
+			UpdatePeakWorkingSize(BandWithBorder.RawData.Num() + BandMip.RawData.Num() + BandMipSource.RawData.Num());
+
+			const int64 SrcOffset = int64(TopMipBandBorder / 2) * FirstMipBytesPerRow;
+			const int64 DestOffset = int64(FirstRow / 2) * FirstMipBytesPerRow;
+			FMemory::Memcpy(&OutFirstMip.RawData[DestOffset], &BandMip.RawData[SrcOffset], FirstMipBandHeight * FirstMipBytesPerRow);
+			if (Settings.bDownsampleWithAverage)
+			{
+				FMemory::Memcpy(&OutFirstMipSource.RawData[DestOffset], &BandMipSource.RawData[SrcOffset], FirstMipBandHeight * FirstMipBytesPerRow);
+			}
+		}
+
+		FImage Band(SizeX, BandHeight, 1, ImageFormat);
+		const int64 BytesPerRow = int64(SizeX) * sizeof(FLinearColor);
+		FMemory::Memcpy(Band.RawData.GetData(), &BandWithBorder.RawData[TopMipBandBorder * BytesPerRow], BandHeight * BytesPerRow);
+		UpdatePeakWorkingSize(BandWithBorder.RawData.Num() + Band.RawData.Num());
+		BandWithBorder = FImage();
+
+		OnBand(Band);
+	}
+
+	if (!Settings.bDownsampleWithAverage)
+	{
+		OutFirstMipSource = OutFirstMip;
+		UpdatePeakWorkingSize(0);
+	}
+
+	if (OutPeakWorkingSize)
+	{
+		*OutPeakWorkingSize = PeakWorkingSize;
+	}
+}
+
+/** Detects an alpha channel in the top mip after all adjustments, converting a band at a time. */
+static bool DetectTopMipAlphaChannelInBands(const FImage& SourceImage, int32 BandHeight, const FTextureBuildSettings& Settings)
+{
+	for (int32 FirstRow = 0; FirstRow < SourceImage.SizeY; FirstRow += BandHeight)
+	{
+		FImage Band;
+		ConvertTopMipRows(SourceImage, FirstRow, BandHeight, 0, Settings, Band);
+		ApplyPostMipGenerationAdjustments(MakeArrayView(&Band, 1), Settings);
+		if (DetectAlphaChannel(Band))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
 /**
  * Texture compression module
  */
@@ -2246,11 +2977,41 @@ public:
 		// we can't use the Ex version here because it needs an FImage, which needs BuildTextureMips to be called
 		const FTextureFormatCompressorCaps CompressorCaps = TextureFormat->GetFormatCapabilities();
 
-		if(!BuildTextureMips(SourceMips, BuildSettings, CompressorCaps, IntermediateMipChain))
+		// Large textures compress their mips while the rest of the chain is generated. The composite texture needs the
+		// whole float chain, as does angular filtering of cubemaps.
+		TUniquePtr<FStreamingMipChainCompressor> StreamingCompressor;
+		const int32 StreamingMipChainMinSize = CVarStreamingMipChainMinSize.GetValueOnAnyThread();
+		if (StreamingMipChainMinSize > 0 &&
+			FMath::Max(SourceMips[0].SizeX, SourceMips[0].SizeY) >= StreamingMipChainMinSize &&
+			AssociatedNormalSourceMips.Num() == 0 &&
+			!BuildSettings.bCubemap &&
+			BuildSettings.MipGenSettings != TMGS_LeaveExistingMips)
+		{
+			StreamingCompressor = MakeUnique<FStreamingMipChainCompressor>(TextureFormat, BuildSettings);
+		}
+
+		if(!BuildTextureMips(SourceMips, BuildSettings, CompressorCaps, IntermediateMipChain, StreamingCompressor.Get()))
 		{
 			return false;
 		}
 
+		if (StreamingCompressor && StreamingCompressor->HasStarted())
+		{
+			const uint32 StartCycles = FPlatformTime::Cycles();
+			const bool bCompressionSucceeded = StreamingCompressor->Finish(OutTextureMips, OutNumMipsInTail, OutExtData);
+
+			BuildSettings.TopMipSize = StreamingCompressor->GetBuildSettings().TopMipSize;
+			BuildSettings.VolumeSizeZ = StreamingCompressor->GetBuildSettings().VolumeSizeZ;
+			BuildSettings.ArraySlices = StreamingCompressor->GetBuildSettings().ArraySlices;
+			UE_LOG(LogTextureCompressor, Verbose, TEXT("Streamed mip chain of %dx%d %s, waited %fms for compression"),
+				SourceMips[0].SizeX,
+				SourceMips[0].SizeY,
+				*BuildSettings.TextureFormatName.ToString(),
+				FPlatformTime::ToMilliseconds(FPlatformTime::Cycles() - StartCycles)
+				);
+			return bCompressionSucceeded;
+		}
+
 		// apply roughness adjustment depending on normal map variation
 		if(AssociatedNormalSourceMips.Num())
 		{
@@ -2321,11 +3082,16 @@ private:
 	void* nvTextureToolsHandle;
 #endif	//PLATFORM_WINDOWS
 
+	/**
+	 * @param MipSink - if given, generated mips are handed to it as they are produced and OutMipChain ends up empty,
+	 *                  unless there was nothing to generate
+	 */
 	bool BuildTextureMips(
 		const TArray<FImage>& InSourceMips,
 		const FTextureBuildSettings& BuildSettings,
 		const FTextureFormatCompressorCaps& CompressorCaps,
-		TArray<FImage>& OutMipChain)
+		TArray<FImage>& OutMipChain,
+		FStreamingMipChainCompressor* MipSink = nullptr)
 	{
 		check(InSourceMips.Num());
 		check(InSourceMips[0].SizeX > 0 && InSourceMips[0].SizeY > 0 && InSourceMips[0].NumSlices > 0);
@@ -2516,6 +3282,15 @@ private:
 		check(StartMip < SourceMips.Num());
 		int32 CopyCount = SourceMips.Num() - StartMip;
 
+		const int32 TopMipBandHeight = CVarTopMipBandHeight.GetValueOnAnyThread();
+		if (MipSink && CopyCount == 1 && !bLongLatCubemap && NumOutputMips > 1 &&
+			CanGenerateTopMipInBands(BuildSettings, SourceMips[StartMip], TopMipBandHeight) &&
+			MipSink->CanCompressTopMipInBands())
+		{
+			BuildTopMipInBands(SourceMips[StartMip], BuildSettings, TopMipBandHeight, NumOutputMips, OutMipChain, *MipSink);
+			return true;
+		}
+
 		for (int32 MipIndex = StartMip; MipIndex < StartMip + CopyCount; ++MipIndex)
 		{
 			const FImage& Image = SourceMips[MipIndex];
@@ -2588,6 +3363,15 @@ private:
 			{
 				GenerateAngularFilteredMips(OutMipChain, NumOutputMips, BuildSettings.DiffuseConvolveMipLevel);
 			}
+			else if (MipSink)
+			{
+				// The sink takes over the base mips, and applies the post-mip generation adjustments itself.
+				MipSink->SetBaseMips(OutMipChain, NumOutputMips);
+				GenerateMipChainInternal(BuildSettings, OutMipChain.Last(), OutMipChain, MAX_uint32, MipSink);
+				check(MipSink->HasStarted() && OutMipChain.Num() == 0);
+				check(MipSink->GetNumMipsAdded() == NumOutputMips);
+				return true;
+			}
 			else
 			{
 				GenerateMipChain(BuildSettings, OutMipChain.Last(), OutMipChain);
@@ -2595,21 +3379,55 @@ private:
 		}
 		check(OutMipChain.Num() == NumOutputMips);
 
-		// Apply post-mip generation adjustments.
-		if (BuildSettings.bReplicateRed)
-		{
-			ReplicateRedChannel(OutMipChain);
-		}
-		else if (BuildSettings.bReplicateAlpha)
-		{
-			ReplicateAlphaChannel(OutMipChain);
-		}
-		if (BuildSettings.bApplyYCoCgBlockScale)
+		ApplyPostMipGenerationAdjustments(OutMipChain, BuildSettings);
+
+		return true;
+	}
+
+	/**
+	 * Streams the top mip to MipSink a band of rows at a time, followed by the rest of the chain generated from the
+	 * first mip. Only the first mip and a few bands exist as float images at once.
+	 */
+	void BuildTopMipInBands(
+		const FImage& SourceImage,
+		const FTextureBuildSettings& BuildSettings,
+		int32 BandHeight,
+		int32 NumOutputMips,
+		TArray<FImage>& OutMipChain,
+		FStreamingMipChainCompressor& MipSink)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(BuildTopMipInBands);
+
+		// The whole top mip decides the alpha channel and with it the pixel format of every band, so it's converted
+		// twice when there is no alpha to find early
+		const bool bImageHasAlphaChannel = BuildSettings.bForceAlphaChannel || DetectTopMipAlphaChannelInBands(SourceImage, BandHeight, BuildSettings);
+		MipSink.SetBandedTopMip(SourceImage.SizeX, SourceImage.SizeY, NumOutputMips, bImageHasAlphaChannel);
+
+		FImage FirstMip;
+		FImage FirstMipSource;
+		SIZE_T PeakWorkingSize = 0;
+		GenerateTopMipInBands(BuildSettings, SourceImage, BandHeight,
+			[&MipSink](FImage& Band)
+			{
+				MipSink.AddTopMipBand(MoveTemp(Band));
+			},
+			FirstMip, FirstMipSource, &PeakWorkingSize);
+
+		MipSink.AddMip(MoveTemp(FirstMip));
+		if (NumOutputMips > 2)
 		{
-			ApplyYCoCgBlockScale(OutMipChain);
+			GenerateMipChainInternal(BuildSettings, FirstMipSource, OutMipChain, MAX_uint32, &MipSink);
 		}
+		check(OutMipChain.Num() == 0);
+		check(MipSink.GetNumMipsAdded() == NumOutputMips);
 
-		return true;
+		UE_LOG(LogTextureCompressor, Verbose, TEXT("Top mip of %dx%d generated in bands of %d rows, peak float working set %.1fMB instead of %.1fMB for the whole top mip"),
+			SourceImage.SizeX,
+			SourceImage.SizeY,
+			BandHeight,
+			PeakWorkingSize / (1024.0 * 1024.0),
+			(double(SourceImage.SizeX) * SourceImage.SizeY * sizeof(FLinearColor)) / (1024.0 * 1024.0)
+			);
 	}
 
 	// @param CompositeTextureMode original type ECompositeTextureMode
@@ -0,0 +1,208 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "ImageCore.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "TextureCompressorModule.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Times mip chain generation for representative 4K and 8K float images with the scalar and the vectorized mip filter,
+ * and checks that both produce the same mips up to float rounding.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureMipGenerationBenchmark, "System.Engine.Texture.MipGenerationBenchmark", EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FTextureMipGenerationBenchmark::RunTest(const FString& Parameters)
+{
+	IConsoleVariable* VectorizedMipGen = IConsoleManager::Get().FindConsoleVariable(TEXT("r.TextureCompressor.VectorizedMipGen"));
+	if (!TestNotNull(TEXT("r.TextureCompressor.VectorizedMipGen"), VectorizedMipGen))
+	{
+		return false;
+	}
+	const int32 OldVectorizedMipGen = VectorizedMipGen->GetInt();
+
+	struct FKernelSetup
+	{
+		const TCHAR* Name;
+		uint32 KernelSize;
+		float Sharpening;
+	};
+	const FKernelSetup KernelSetups[] =
+	{
+		{ TEXT("SimpleAverage"), 2, 0.0f },
+		{ TEXT("Sharpen5"), 8, 1.0f },
+		{ TEXT("Blur5"), 8, -1.0f },
+	};
+	const int32 ImageSizes[] = { 4096, 8192 };
+
+	for (int32 ImageSize : ImageSizes)
+	{
+		FImage BaseImage(ImageSize, ImageSize, 1, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+		{
+			FRandomStream RandomStream(ImageSize);
+			TArrayView64<FLinearColor> Colors = BaseImage.AsRGBA32F();
+			for (int64 Index = 0; Index < Colors.Num(); ++Index)
+			{
+				Colors[Index] = FLinearColor(RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction(), RandomStream.GetFraction());
+			}
+		}
+
+		for (const FKernelSetup& KernelSetup : KernelSetups)
+		{
+			FTextureBuildSettings Settings;
+			Settings.SharpenMipKernelSize = KernelSetup.KernelSize;
+			Settings.MipSharpening = KernelSetup.Sharpening;
+
+			double Seconds[2];
+			TArray<FImage> MipChains[2];
+			for (int32 Vectorized = 0; Vectorized < 2; ++Vectorized)
+			{
+				VectorizedMipGen->Set(Vectorized, ECVF_SetByCode);
+
+				const double StartTime = FPlatformTime::Seconds();
+				ITextureCompressorModule::GenerateMipChain(Settings, BaseImage, MipChains[Vectorized]);
+				Seconds[Vectorized] = FPlatformTime::Seconds() - StartTime;
+			}
+
+			float MaxError = 0.0f;
+			if (TestEqual(TEXT("Mip count"), MipChains[1].Num(), MipChains[0].Num()))
+			{
+				for (int32 MipIndex = 0; MipIndex < MipChains[0].Num(); ++MipIndex)
+				{
+					TArrayView64<FLinearColor> Scalar = MipChains[0][MipIndex].AsRGBA32F();
+					TArrayView64<FLinearColor> Vector = MipChains[1][MipIndex].AsRGBA32F();
+					for (int64 Index = 0; Index < Scalar.Num(); ++Index)
+					{
+						const FLinearColor Delta = Scalar[Index] - Vector[Index];
+						MaxError = FMath::Max(MaxError, FMath::Max(FMath::Max(FMath::Abs(Delta.R), FMath::Abs(Delta.G)), FMath::Max(FMath::Abs(Delta.B), FMath::Abs(Delta.A))));
+					}
+				}
+			}
+			TestTrue(FString::Printf(TEXT("%dx%d %s vectorized mips match scalar mips (max error %g)"), ImageSize, ImageSize, KernelSetup.Name, MaxError), MaxError < 1e-4f);
+
+			AddInfo(FString::Printf(TEXT("%dx%d %s: scalar %.1f ms, vectorized %.1f ms (%.2fx)"),
+				ImageSize, ImageSize, KernelSetup.Name, Seconds[0] * 1000.0, Seconds[1] * 1000.0, Seconds[0] / FMath::Max(Seconds[1], 1e-6)));
+		}
+	}
+
+	VectorizedMipGen->Set(OldVectorizedMipGen, ECVF_SetByCode);
+	return true;
+}
+
+/**
+ * Generates the top mip of an 8 bit source in bands and checks that the bands, the first mip and the mip generated from
+ * the first mip's source match the whole image path, and that the float working set stays bounded by the band size.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTextureTopMipBandsTest, "System.Engine.Texture.TopMipBands", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FTextureTopMipBandsTest::RunTest(const FString& Parameters)
+{
+	const int32 SizeX = 1024;
+	const int32 SizeY = 512;
+	const int32 BandHeight = 64;
+	// rows of neighbours converted above and below each band
+	const int32 BandBorder = 8;
+
+	FImage SourceImage(SizeX, SizeY, 1, ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	{
+		FRandomStream RandomStream(SizeX);
+		for (uint8& Byte : SourceImage.RawData)
+		{
+			Byte = (uint8)RandomStream.RandRange(0, 255);
+		}
+	}
+
+	FImage ReferenceTopMip;
+	SourceImage.CopyTo(ReferenceTopMip, ERawImageFormat::RGBA32F, EGammaSpace::Linear);
+
+	auto MaxDifference = [](const FImage& A, const FImage& B)
+	{
+		float MaxError = 0.0f;
+		TArrayView64<const FLinearColor> ColorsA((const FLinearColor*)A.RawData.GetData(), A.RawData.Num() / sizeof(FLinearColor));
+		TArrayView64<const FLinearColor> ColorsB((const FLinearColor*)B.RawData.GetData(), B.RawData.Num() / sizeof(FLinearColor));
+		for (int64 Index = 0; Index < ColorsA.Num(); ++Index)
+		{
+			const FLinearColor Delta = ColorsA[Index] - ColorsB[Index];
+			MaxError = FMath::Max(MaxError, FMath::Max(FMath::Max(FMath::Abs(Delta.R), FMath::Abs(Delta.G)), FMath::Max(FMath::Abs(Delta.B), FMath::Abs(Delta.A))));
+		}
+		return MaxError;
+	};
+
+	struct FSetup
+	{
+		const TCHAR* Name;
+		uint32 KernelSize;
+		float Sharpening;
+		bool bDownsampleWithAverage;
+		bool bSharpenWithoutColorShift;
+	};
+	const FSetup Setups[] =
+	{
+		{ TEXT("SimpleAverage"), 2, 0.0f, false, false },
+		{ TEXT("Sharpen5"), 8, 1.0f, true, false },
+		{ TEXT("Sharpen10"), 12, 2.0f, true, true },
+		{ TEXT("Blur5"), 8, -1.0f, false, false },
+	};
+
+	for (const FSetup& Setup : Setups)
+	{
+		FTextureBuildSettings Settings;
+		Settings.SharpenMipKernelSize = Setup.KernelSize;
+		Settings.MipSharpening = Setup.Sharpening;
+		Settings.bDownsampleWithAverage = Setup.bDownsampleWithAverage;
+		Settings.bSharpenWithoutColorShift = Setup.bSharpenWithoutColorShift;
+
+		if (!TestTrue(FString::Printf(TEXT("%s can be generated in bands"), Setup.Name), ITextureCompressorModule::CanGenerateTopMipInBands(Settings, SourceImage, BandHeight)))
+		{
+			continue;
+		}
+
+		TArray<FImage> ReferenceMips;
+		ITextureCompressorModule::GenerateMipChain(Settings, ReferenceTopMip, ReferenceMips, 2);
+
+		FImage BandedTopMip(SizeX, SizeY, 1, ERawImageFormat::RGBA32F);
+		int32 NumBandRows = 0;
+		FImage FirstMip;
+		FImage FirstMipSource;
+		SIZE_T PeakWorkingSize = 0;
+		ITextureCompressorModule::GenerateTopMipInBands(Settings, SourceImage, BandHeight,
+			[&](FImage& Band)
+			{
+				if (TestEqual(TEXT("Band size"), Band.SizeX * 10000 + Band.SizeY, SizeX * 10000 + BandHeight))
+				{
+					FMemory::Memcpy(&BandedTopMip.RawData[int64(NumBandRows) * SizeX * sizeof(FLinearColor)], Band.RawData.GetData(), Band.RawData.Num());
+				}
+				NumBandRows += Band.SizeY;
+			},
+			FirstMip, FirstMipSource, &PeakWorkingSize);
+
+		TestEqual(FString::Printf(TEXT("%s band rows"), Setup.Name), NumBandRows, SizeY);
+		TestTrue(FString::Printf(TEXT("%s bands match the top mip"), Setup.Name), MaxDifference(BandedTopMip, ReferenceTopMip) == 0.0f);
+
+		const float FirstMipError = MaxDifference(FirstMip, ReferenceMips[0]);
+		TestTrue(FString::Printf(TEXT("%s first mip matches (max error %g)"), Setup.Name, FirstMipError), FirstMip.SizeX == ReferenceMips[0].SizeX && FirstMip.SizeY == ReferenceMips[0].SizeY && FirstMipError < 1e-5f);
+
+		// the mip after is generated from the first mip's source, which is the averaged mip with bDownsampleWithAverage
+		TArray<FImage> SecondMips;
+		ITextureCompressorModule::GenerateMipChain(Settings, FirstMipSource, SecondMips, 1);
+		const float SecondMipError = MaxDifference(SecondMips[0], ReferenceMips[1]);
+		TestTrue(FString::Printf(TEXT("%s second mip matches (max error %g)"), Setup.Name, SecondMipError), SecondMips[0].SizeX == ReferenceMips[1].SizeX && SecondMips[0].SizeY == ReferenceMips[1].SizeY && SecondMipError < 1e-5f);
+
+		// Only the first mip and its source are kept whole, next to the band being filtered with its border and the
+		// filtered rows. The whole float top mip alone is four times the first mip.
+		const SIZE_T BandWithBorderSize = SIZE_T(SizeX) * (BandHeight + 2 * BandBorder) * sizeof(FLinearColor);
+		const SIZE_T MaxWorkingSize = FirstMip.RawData.Num() + FirstMipSource.RawData.Num() + 2 * BandWithBorderSize;
+		TestTrue(FString::Printf(TEXT("%s peak working set %llu bytes is at most %llu"), Setup.Name, (uint64)PeakWorkingSize, (uint64)MaxWorkingSize), PeakWorkingSize > 0 && PeakWorkingSize <= MaxWorkingSize);
+
+		AddInfo(FString::Printf(TEXT("%dx%d %s in bands of %d rows: peak float working set %.2f MB, whole float top mip %.2f MB"),
+			SizeX, SizeY, Setup.Name, BandHeight, PeakWorkingSize / (1024.0 * 1024.0), ReferenceTopMip.RawData.Num() / (1024.0 * 1024.0)));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -280,6 +280,33 @@ public:
 		uint32 MipChainDepth = MAX_uint32
 		);
 
+	/**
+	 * Converts a 2D source image to the linear float top mip of a mip chain and generates the first mip from it, a band
+	 * of rows at a time, so that the float top mip never exists as a whole. Each band is converted with enough rows of
+	 * its neighbours for the downsample filter, which wraps at the top and bottom edges as GenerateMipChain does.
+	 * The first mip matches the one GenerateMipChain produces from the whole top mip.
+	 * Only supported for power of two sizes and settings that don't need the whole top mip, see CanGenerateTopMipInBands.
+	 * @param Settings - Preprocess settings.
+	 * @param SourceImage - The source of the top mip, in any format.
+	 * @param BandHeight - Rows per band, a multiple of 4 that divides the height of SourceImage.
+	 * @param OnBand - Called with each band of the top mip, in order from the top. The band may be moved from.
+	 * @param OutFirstMip - The first mip.
+	 * @param OutFirstMipSource - The image the rest of the chain is generated from, see FTextureBuildSettings::bDownsampleWithAverage.
+	 * @param OutPeakWorkingSize - If given, the largest number of bytes held in float images at any time, including the outputs.
+	 */
+	TEXTURECOMPRESSOR_API static void GenerateTopMipInBands(
+		const FTextureBuildSettings& Settings,
+		const FImage& SourceImage,
+		int32 BandHeight,
+		TFunctionRef<void(FImage& Band)> OnBand,
+		FImage& OutFirstMip,
+		FImage& OutFirstMipSource,
+		SIZE_T* OutPeakWorkingSize = nullptr
+		);
+
+	/** Whether GenerateTopMipInBands supports the settings and source image. */
+	TEXTURECOMPRESSOR_API static bool CanGenerateTopMipInBands(const FTextureBuildSettings& Settings, const FImage& SourceImage, int32 BandHeight);
+
 	/**
      * Adjusts the colors of the image using the specified settings
      *
@@ -11,6 +11,7 @@ public class BenchmarkTool : ModuleRules
 		PrivateIncludePaths.Add("Runtime/Launch/Private");		// For LaunchEngineLoop.cpp include
 
 		PrivateDependencyModuleNames.Add("Core");
+		PrivateDependencyModuleNames.Add("Json");
 		PrivateDependencyModuleNames.Add("Projects");
 	}
 }
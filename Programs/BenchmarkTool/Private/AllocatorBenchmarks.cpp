@@ -0,0 +1,127 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkTool.h"
+#include "Async/ParallelFor.h"
+#include "Math/RandomStream.h"
+
+//////////////////////////////////////////////////////////////////////////
+//
+// These go through FMemory and so measure whichever allocator the platform picked. To compare allocators, run the
+// tool once per allocator, e.g. with -binnedmalloc2, -binnedmalloc3, -mimalloc or -jemalloc where the platform
+// supports them, and pass the json of one run as the -Baseline= of the next. The allocator is recorded in the json.
+//
+
+void BM_Malloc_Free(BenchmarkState& State, SIZE_T Size)
+{
+	for (auto _ : State)
+	{
+		void* Ptr = FMemory::Malloc(Size);
+		DoNotOptimize(Ptr);
+		FMemory::Free(Ptr);
+	}
+}
+
+// Allocates a batch of random small sizes and frees them in a shuffled order, which touches many bins and pages
+void BM_Malloc_FreeShuffledBatch(BenchmarkState& State, int32 BatchSize)
+{
+	FRandomStream Random(BatchSize);
+	TArray<SIZE_T> Sizes;
+	TArray<int32> FreeOrder;
+	for (int32 Index = 0; Index < BatchSize; ++Index)
+	{
+		Sizes.Add(16 + Random.RandHelper(1024));
+		FreeOrder.Add(Index);
+	}
+	for (int32 Index = BatchSize - 1; Index > 0; --Index)
+	{
+		FreeOrder.Swap(Index, Random.RandHelper(Index + 1));
+	}
+
+	TArray<void*> Ptrs;
+	Ptrs.SetNumZeroed(BatchSize);
+	for (auto _ : State)
+	{
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			Ptrs[Index] = FMemory::Malloc(Sizes[Index]);
+		}
+		ClobberMemory();
+		for (int32 Index : FreeOrder)
+		{
+			FMemory::Free(Ptrs[Index]);
+		}
+	}
+}
+
+void BM_Realloc_Grow(BenchmarkState& State, SIZE_T MaxSize)
+{
+	for (auto _ : State)
+	{
+		void* Ptr = nullptr;
+		for (SIZE_T Size = 16; Size <= MaxSize; Size *= 2)
+		{
+			Ptr = FMemory::Realloc(Ptr, Size);
+			DoNotOptimize(Ptr);
+		}
+		FMemory::Free(Ptr);
+	}
+}
+
+// Every worker allocates and frees at the same time, to show how well the allocator scales with threads
+void BM_Malloc_Free_Parallel(BenchmarkState& State, SIZE_T Size)
+{
+	const int32 NumWorkers = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 1);
+	const int32 AllocationsPerWorker = 10000;
+
+	for (auto _ : State)
+	{
+		ParallelFor(NumWorkers, [Size, AllocationsPerWorker](int32)
+		{
+			for (int32 Index = 0; Index < AllocationsPerWorker; ++Index)
+			{
+				void* Ptr = FMemory::Malloc(Size);
+				DoNotOptimize(Ptr);
+				FMemory::Free(Ptr);
+			}
+		});
+	}
+}
+
+// Allocations are freed by a different worker than the one that allocated them, which defeats per thread caches
+void BM_Malloc_FreeOnOtherThread(BenchmarkState& State, SIZE_T Size)
+{
+	const int32 NumWorkers = FMath::Max(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 1, 2);
+	const int32 AllocationsPerWorker = 10000;
+
+	TArray<TArray<void*>> Allocations;
+	Allocations.SetNum(NumWorkers);
+
+	for (auto _ : State)
+	{
+		ParallelFor(NumWorkers, [&Allocations, Size, AllocationsPerWorker](int32 Worker)
+		{
+			Allocations[Worker].Reset(AllocationsPerWorker);
+			for (int32 Index = 0; Index < AllocationsPerWorker; ++Index)
+			{
+				Allocations[Worker].Add(FMemory::Malloc(Size));
+			}
+		});
+		ParallelFor(NumWorkers, [&Allocations, NumWorkers](int32 Worker)
+		{
+			for (void* Ptr : Allocations[(Worker + 1) % NumWorkers])
+			{
+				FMemory::Free(Ptr);
+			}
+		});
+	}
+}
+
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free, 16, 16)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free, 128, 128)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free, 1024, 1024)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free, 32768, 32768)->Iterations(1000000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free, 1048576, 1048576)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_FreeShuffledBatch, 10000, 10000)->Iterations(1000);
+UE_BENCHMARK_CAPTURE(BM_Realloc_Grow, 1048576, 1048576)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_Free_Parallel, 64, 64)->Iterations(1000);
+UE_BENCHMARK_CAPTURE(BM_Malloc_FreeOnOtherThread, 64, 64)->Iterations(1000);
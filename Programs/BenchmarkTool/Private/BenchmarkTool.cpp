@@ -7,178 +7,181 @@
 #include "Templates/RefCounting.h"
 #include "Templates/SharedPointer.h"
 #include "Misc/QueuedThreadPoolWrapper.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/App.h"
+#include "HAL/PlatformProperties.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
 #include "RequiredProgramMainCPPInclude.h"
 #include <locale.h>
-#include <iterator>
 #include <atomic>
 
-DEFINE_LOG_CATEGORY_STATIC(LogBenchmarkTool, Log, All);
+DEFINE_LOG_CATEGORY(LogBenchmarkTool);
 
 IMPLEMENT_APPLICATION(BenchmarkTool, "BenchTool");
 
 //////////////////////////////////////////////////////////////////////////
 
-class alignas(PLATFORM_CACHE_LINE_SIZE) BenchmarkState
-{
-public:
-	struct BenchmarkIterator;
-
-	BenchmarkState() = default;
-
-	FORCEINLINE void SetIterationCount(int InIterationCount) { IterationCount = InIterationCount; }
-
-	FORCEINLINE BenchmarkIterator begin();
-	FORCEINLINE BenchmarkIterator end();
+FORCENOINLINE void UseCharPointer(char const volatile*) {}
 
-private:
-	int		IterationCount = 1000;
-};
+//////////////////////////////////////////////////////////////////////////
 
-struct BenchmarkState::BenchmarkIterator
+class BenchmarkReporter
 {
 public:
-	BenchmarkIterator() = default;
-
-	FORCEINLINE BenchmarkIterator(BenchmarkState* InState, int IterationCount)
-	:	State(InState)
-	,	Counter(IterationCount)
-	{
-	}
+	BenchmarkReporter() = default;
+	virtual ~BenchmarkReporter() = default;
 
-	FORCEINLINE BenchmarkIterator& operator++() { --Counter; return *this; }
+	BenchmarkReporter(const BenchmarkReporter&) = delete;
+	BenchmarkReporter& operator=(const BenchmarkReporter&) = delete;
 
-	// This always assumes it compares to an end iterator
-	FORCEINLINE bool operator!=(const BenchmarkIterator& Rhs)
+	struct Run
 	{
-		if (Counter == 0)
+		FString	Name;
+		uint64	IterationCount = 0;
+		uint32	RepetitionCount = 0;
+		double	DurationMs = 0;			// Sum over all repetitions
+
+		// Time per iteration over the repetitions, in nanoseconds. The percentiles are taken over the batches of all
+		// repetitions instead, with only a handful of repetitions they would always be the slowest one.
+		double	MinNs = 0;
+		double	MedianNs = 0;
+		double	P90Ns = 0;
+		double	P99Ns = 0;
+		double	MaxNs = 0;
+		double	MeanNs = 0;
+		double	StdDevNs = 0;
+
+		// Median of the same benchmark in the -Baseline= file, negative if it was not in there
+		double	BaselineMedianNs = -1;
+		bool	bRegressed = false;
+
+		/** Key used to match runs against a baseline, benchmarks may be registered more than once with different iteration counts */
+		FString GetKey() const
 		{
-			return false;
+			return FString::Printf(TEXT("%s/iterations:%llu"), *Name, IterationCount);
 		}
+	};
 
-		return true;
-	}
-
-	// Let's just pretend we're an actual iterator
-
-	struct Dummy {};
-	typedef std::forward_iterator_tag	iterator_category;
-	typedef Dummy						value_type;
-	typedef Dummy						reference;
-	typedef Dummy						pointer;
-	typedef std::ptrdiff_t				difference_type;
-
-	Dummy operator*() const { return Dummy(); }
+	virtual void Start() {};
+	virtual void ReportRuns(const TArray<Run>& Runs) = 0;
+	virtual void Finalize() {};
 
 private:
-	BenchmarkState* State = nullptr;
-	int				Counter = 0;
-};
-
-BenchmarkState::BenchmarkIterator BenchmarkState::begin() 
-{ 
-	return BenchmarkIterator(this, IterationCount); 
-}
-
-BenchmarkState::BenchmarkIterator BenchmarkState::end()
-{
-	return BenchmarkIterator();
-}
-
-//////////////////////////////////////////////////////////////////////////
 
-FORCENOINLINE void UseCharPointer(char const volatile*) {}
+};
 
 //////////////////////////////////////////////////////////////////////////
 
-typedef void(BenchFunction)(BenchmarkState&);
-
-class Benchmark
+class ConsoleReporter : public BenchmarkReporter
 {
 public:
-	Benchmark(const TCHAR* InName) : Name(InName) 
+	ConsoleReporter()
 	{
 	}
 
-	virtual ~Benchmark() = default;
-
-	Benchmark(const Benchmark&) = delete;
-	Benchmark& operator=(const Benchmark&) = delete;
-
-	virtual void DoRun(BenchmarkState& State)
+	~ConsoleReporter()
 	{
-		UE_LOG(LogBenchmarkTool, Log, TEXT("Running '%s'..."), *this->Name);
-
-		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*this->Name);
-		const uint64 StartTime = FPlatformTime::Cycles64();
-
-		Run(State);
-
-		Duration = FPlatformTime::Cycles64() - StartTime;
 	}
 
-	virtual Benchmark* Iterations(uint64 InIterationCount)	{ IterationCount = InIterationCount; return this; }
-	virtual Benchmark* Threads(uint16 ThreadCount)			{ ThreadCounts.Add(ThreadCount); return this; }
-
-	static Benchmark* RegisterBenchmarkInternal(Benchmark* InBenchmark);
-
-protected:
-	FString			Name;
-	uint64			IterationCount = 0;
-	TArray<uint16>	ThreadCounts;
-	uint64			Duration = 0;			// This is in Cycles64 units
+	virtual void ReportRuns(const TArray<Run>& Runs) override
+	{
+		for (const Run& Line : Runs)
+		{
+			FString Comparison;
+			if (Line.BaselineMedianNs > 0)
+			{
+				Comparison = FString::Printf(TEXT(" %+6.1f%% vs baseline%s"), (Line.MedianNs / Line.BaselineMedianNs - 1.0) * 100.0, Line.bRegressed ? TEXT(" REGRESSED") : TEXT(""));
+			}
 
-	friend class BenchmarkRegistry;
+			UE_LOG(LogBenchmarkTool, Display,
+				TEXT("%-50s %10llu iterations x %2u took %6llu ms (median %10.2f ns, p90 %10.2f ns, p99 %10.2f ns, min %10.2f ns per iteration)%s"),
+				*Line.Name,
+				Line.IterationCount,
+				Line.RepetitionCount,
+				(uint64)Line.DurationMs,
+				Line.MedianNs,
+				Line.P90Ns,
+				Line.P99Ns,
+				Line.MinNs,
+				*Comparison);
+		}
+	}
 
 private:
-	virtual void Run(BenchmarkState& State) = 0;
 };
 
-class BenchmarkFixture : public Benchmark
+/** Writes the runs to a file, in a layout close to Google Benchmark's --benchmark_format=json so existing tools can read it */
+class JsonReporter : public BenchmarkReporter
 {
 public:
-	virtual void SetUp(BenchmarkState& State)
+	JsonReporter(const FString& InFilename)
+	:	Filename(InFilename)
 	{
 	}
 
-	virtual void TearDown(BenchmarkState& State)
-	{
-	}
-
-	virtual void DoRun(BenchmarkState& State) override
+	virtual void ReportRuns(const TArray<Run>& Runs) override
 	{
-		SetUp(State);
-		BenchmarkCase(State);
-		TearDown(State);
-	}
-
-protected:
-	virtual void BenchmarkCase(BenchmarkState&) = 0;
-};
+		FString Output;
+		TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Output);
 
-//////////////////////////////////////////////////////////////////////////
+		Writer->WriteObjectStart();
 
-class BenchmarkReporter
-{
-public:
-	BenchmarkReporter() = default;
-	virtual ~BenchmarkReporter() = default;
+		Writer->WriteObjectStart(TEXT("context"));
+		Writer->WriteValue(TEXT("date"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("platform"), FString(FPlatformProperties::IniPlatformName()));
+		Writer->WriteValue(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+		Writer->WriteValue(TEXT("num_cores"), FPlatformMisc::NumberOfCores());
+		Writer->WriteValue(TEXT("num_cores_including_hyperthreads"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+		Writer->WriteValue(TEXT("build_configuration"), FString(LexToString(FApp::GetBuildConfiguration())));
+		Writer->WriteValue(TEXT("allocator"), FString(GMalloc->GetDescriptiveName()));
+		Writer->WriteValue(TEXT("command_line"), FString(FCommandLine::Get()));
+		Writer->WriteObjectEnd();
 
-	BenchmarkReporter(const BenchmarkReporter&) = delete;
-	BenchmarkReporter& operator=(const BenchmarkReporter&) = delete;
+		Writer->WriteArrayStart(TEXT("benchmarks"));
+		for (const Run& Line : Runs)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("name"), Line.Name);
+			Writer->WriteValue(TEXT("key"), Line.GetKey());
+			Writer->WriteValue(TEXT("iterations"), (int64)Line.IterationCount);
+			Writer->WriteValue(TEXT("repetitions"), (int32)Line.RepetitionCount);
+			Writer->WriteValue(TEXT("time_unit"), TEXT("ns"));
+			Writer->WriteValue(TEXT("min"), Line.MinNs);
+			Writer->WriteValue(TEXT("median"), Line.MedianNs);
+			Writer->WriteValue(TEXT("p90"), Line.P90Ns);
+			Writer->WriteValue(TEXT("p99"), Line.P99Ns);
+			Writer->WriteValue(TEXT("max"), Line.MaxNs);
+			Writer->WriteValue(TEXT("mean"), Line.MeanNs);
+			Writer->WriteValue(TEXT("stddev"), Line.StdDevNs);
+			if (Line.BaselineMedianNs > 0)
+			{
+				Writer->WriteValue(TEXT("baseline_median"), Line.BaselineMedianNs);
+				Writer->WriteValue(TEXT("regressed"), Line.bRegressed);
+			}
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
 
-	struct Run
-	{
-		FString	Name;
-		uint64	IterationCount = 0;
-		double	DurationMs = 0;
-	};
+		Writer->WriteObjectEnd();
+		Writer->Close();
 
-	virtual void Start() {};
-	virtual void ReportRuns(const TArray<Run>& Runs) = 0;
-	virtual void Finalize() {};
+		if (FFileHelper::SaveStringToFile(Output, *Filename))
+		{
+			UE_LOG(LogBenchmarkTool, Display, TEXT("Wrote results of %d benchmarks to '%s'"), Runs.Num(), *Filename);
+		}
+		else
+		{
+			UE_LOG(LogBenchmarkTool, Error, TEXT("Failed to write results to '%s'"), *Filename);
+		}
+	}
 
 private:
-
+	FString Filename;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -200,7 +203,19 @@ public:
 		return InBenchmark;
 	}
 
-	void RunBenchmarks()
+	/**
+	 * Runs the benchmarks selected on the command line and reports them.
+	 *
+	 * -Benchmark=<substring>			only run benchmarks whose name contains the substring
+	 * -Repetitions=<n>					number of times each benchmark is run (default 5)
+	 * -Batches=<n>						number of separately timed batches the iterations of a run are split into, percentiles are taken over the batches of all repetitions (default 20)
+	 * -JsonOutput=<file>				also write the results to a json file
+	 * -Baseline=<file>					compare the median of each benchmark to a json file written by an earlier run
+	 * -RegressionThreshold=<percent>	how much slower than the baseline a median can be before it counts as a regression (default 10)
+	 *
+	 * @return false if any benchmark regressed against the baseline
+	 */
+	bool RunBenchmarks()
 	{
 		TRACE_CPUPROFILER_EVENT_SCOPE(RunBenchmarks);
 		TArray<BenchmarkReporter::Run> RunResults;
@@ -208,6 +223,14 @@ public:
 
 		FString BenchName;
 		FParse::Value(FCommandLine::Get(), TEXT("-Benchmark="), BenchName);
+
+		uint32 DefaultRepetitionCount = 5;
+		FParse::Value(FCommandLine::Get(), TEXT("-Repetitions="), DefaultRepetitionCount);
+		DefaultRepetitionCount = FMath::Max(DefaultRepetitionCount, 1u);
+
+		int32 BatchCount = 20;
+		FParse::Value(FCommandLine::Get(), TEXT("-Batches="), BatchCount);
+
 		for (auto& Bench : Benchmarks)
 		{
 			if (BenchName.Len() > 0 && Bench->Name.Find(BenchName) == INDEX_NONE)
@@ -215,117 +238,166 @@ public:
 				continue;
 			}
 
-			BenchmarkState State;
-			State.SetIterationCount(Bench->IterationCount);
+			const uint32 RepetitionCount = Bench->RepetitionCount ? Bench->RepetitionCount : DefaultRepetitionCount;
+
+			TArray<double> Samples;
+			Samples.Reserve(RepetitionCount);
+			TArray<double> BatchSamples;
+			uint64 TotalDuration = 0;
+			for (uint32 Repetition = 0; Repetition < RepetitionCount; ++Repetition)
+			{
+				BenchmarkState State;
+				State.SetIterationCount(Bench->IterationCount);
+				State.SetBatchCount(BatchCount);
+
+				Bench->DoRun(State);
 
-			Bench->DoRun(State);
+				TotalDuration += Bench->Duration;
+				Samples.Add(FPlatformTime::ToMilliseconds64(Bench->Duration) * 1000000.0 / FMath::Max<uint64>(Bench->IterationCount, 1));
+
+				const TArray<uint64>& BatchDurations = State.GetBatchDurations();
+				for (int32 BatchIndex = 0; BatchIndex < BatchDurations.Num(); ++BatchIndex)
+				{
+					BatchSamples.Add(FPlatformTime::ToMilliseconds64(BatchDurations[BatchIndex]) * 1000000.0 / FMath::Max(State.GetBatchIterationCount(BatchIndex), 1));
+				}
+			}
 
 			BenchmarkReporter::Run& RunResult = *new(RunResults) BenchmarkReporter::Run;
 
 			RunResult.Name				= Bench->Name;
 			RunResult.IterationCount	= Bench->IterationCount;
-			RunResult.DurationMs		= FPlatformTime::ToMilliseconds64(Bench->Duration);
+			RunResult.RepetitionCount	= RepetitionCount;
+			RunResult.DurationMs		= FPlatformTime::ToMilliseconds64(TotalDuration);
+			ComputeStatistics(Samples, BatchSamples, RunResult);
 		}
 
-		for (BenchmarkReporter::Run& Line : RunResults)
+		bool bAnyRegressed = false;
+		FString BaselineFilename;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-Baseline="), BaselineFilename))
 		{
-			UE_LOG(LogBenchmarkTool, Display, 
-				TEXT("%-30s %10ld iterations took %5ld ms (%f us/iteration)"),
-				*Line.Name,
-				Line.IterationCount,
-				(uint64)Line.DurationMs,
-				Line.DurationMs * 1000. / Line.IterationCount);
+			float RegressionThreshold = 10.0f;
+			FParse::Value(FCommandLine::Get(), TEXT("-RegressionThreshold="), RegressionThreshold);
+			bAnyRegressed = CompareToBaseline(BaselineFilename, RegressionThreshold, RunResults);
 		}
-	}
 
-	TArray<TUniquePtr<Benchmark>>	Benchmarks;
-};
+		ConsoleReporter Console;
+		Console.Start();
+		Console.ReportRuns(RunResults);
+		Console.Finalize();
 
-Benchmark* Benchmark::RegisterBenchmarkInternal(Benchmark* InBenchmark)
-{
-	return BenchmarkRegistry::Get().Register(InBenchmark);
-}
+		FString JsonFilename;
+		if (FParse::Value(FCommandLine::Get(), TEXT("-JsonOutput="), JsonFilename))
+		{
+			JsonReporter Json(JsonFilename);
+			Json.Start();
+			Json.ReportRuns(RunResults);
+			Json.Finalize();
+		}
 
-class FunctionBenchmark : public Benchmark
-{
-public:
-	FunctionBenchmark(const TCHAR* Name, BenchFunction* InFunction) 
-	:	Benchmark(Name)
-	,	Function(InFunction)
-	{
+		return !bAnyRegressed;
 	}
 
-	virtual void Run(BenchmarkState& State) override
-	{
-		Function(State);
-	}
+	TArray<TUniquePtr<Benchmark>>	Benchmarks;
 
 private:
-	BenchFunction*	Function = nullptr;
-};
+	/**
+	 * @param Samples		time per iteration of each repetition
+	 * @param BatchSamples	time per iteration of each batch of all repetitions, the percentiles fall back to Samples if the
+	 *						benchmark didn't loop over its state
+	 */
+	static void ComputeStatistics(TArray<double>& Samples, TArray<double>& BatchSamples, BenchmarkReporter::Run& OutRun)
+	{
+		Samples.Sort();
+		BatchSamples.Sort();
+
+		// nearest rank
+		const TArray<double>& PercentileSamples = BatchSamples.Num() ? BatchSamples : Samples;
+		auto Percentile = [&PercentileSamples](double Fraction)
+		{
+			const int32 Rank = FMath::CeilToInt(Fraction * PercentileSamples.Num());
+			return PercentileSamples[FMath::Clamp(Rank - 1, 0, PercentileSamples.Num() - 1)];
+		};
 
-//////////////////////////////////////////////////////////////////////////
+		double Sum = 0;
+		for (double Sample : Samples)
+		{
+			Sum += Sample;
+		}
+		const double Mean = Sum / Samples.Num();
 
-class ConsoleReporter : public BenchmarkReporter
-{
-public:
-	ConsoleReporter()
-	{
-	}
+		double SquaredDeviations = 0;
+		for (double Sample : Samples)
+		{
+			SquaredDeviations += FMath::Square(Sample - Mean);
+		}
 
-	~ConsoleReporter()
-	{
+		OutRun.MinNs	= Samples[0];
+		OutRun.MaxNs	= Samples.Last();
+		OutRun.MedianNs	= (Samples.Num() & 1) ? Samples[Samples.Num() / 2] : (Samples[Samples.Num() / 2 - 1] + Samples[Samples.Num() / 2]) * 0.5;
+		OutRun.P90Ns	= Percentile(0.9);
+		OutRun.P99Ns	= Percentile(0.99);
+		OutRun.MeanNs	= Mean;
+		OutRun.StdDevNs	= Samples.Num() > 1 ? FMath::Sqrt(SquaredDeviations / (Samples.Num() - 1)) : 0.0;
 	}
 
-	virtual void ReportRuns(const TArray<Run>& Runs) override
+	/** @return true if any of the runs is slower than its baseline by more than the threshold */
+	static bool CompareToBaseline(const FString& BaselineFilename, float RegressionThresholdPercent, TArray<BenchmarkReporter::Run>& Runs)
 	{
-	}
-
-private:
-};
-
-//////////////////////////////////////////////////////////////////////////
-//
-// Benchmark macros
-//
-
-#if defined(__COUNTER__) && (__COUNTER__ + 1 == __COUNTER__ + 0)
-#	define UE_BENCHMARK_UID __COUNTER__
-#else
-#	define UE_BENCHMARK_UID __LINE__
-#endif
-
-#define UE_BENCHMARK_NAME_(Name)		UE_BENCHMARK_CONCAT_(_benchmark_, UE_BENCHMARK_UID, Name)
-#define UE_BENCHMARK_CONCAT_(a, b, c)	UE_BENCHMARK_CONCAT2_(a, b, c)
-#define UE_BENCHMARK_CONCAT2_(a, b, c)	a##b##c
-
-#define UE_BENCHMARK_DECLARE_(n)		static /*[[unused]]*/ ::Benchmark* UE_BENCHMARK_NAME_(n)
-
-#define UE_BENCHMARK(n)					UE_BENCHMARK_DECLARE_(n) = (::Benchmark::RegisterBenchmarkInternal(new ::FunctionBenchmark(TEXT(#n), n)))
+		FString BaselineText;
+		TSharedPtr<FJsonObject> Baseline;
+		if (!FFileHelper::LoadFileToString(BaselineText, *BaselineFilename) ||
+			!FJsonSerializer::Deserialize(TJsonReaderFactory<TCHAR>::Create(BaselineText), Baseline) || !Baseline.IsValid())
+		{
+			UE_LOG(LogBenchmarkTool, Error, TEXT("Failed to read baseline '%s'"), *BaselineFilename);
+			return false;
+		}
 
-#define UE_BENCHMARK_CAPTURE(Func, Name, ...)	UE_BENCHMARK_DECLARE_(Func) = (::Benchmark::RegisterBenchmarkInternal(new ::FunctionBenchmark(TEXT(#Func "/" #Name), [](::BenchmarkState& State) { Func(State, __VA_ARGS__); })))
+		const TSharedPtr<FJsonObject>* BaselineContext;
+		FString BaselineAllocator;
+		if (Baseline->TryGetObjectField(TEXT("context"), BaselineContext) && (*BaselineContext)->TryGetStringField(TEXT("allocator"), BaselineAllocator) &&
+			BaselineAllocator != GMalloc->GetDescriptiveName())
+		{
+			UE_LOG(LogBenchmarkTool, Warning, TEXT("Baseline was recorded with the %s allocator, this run uses %s"), *BaselineAllocator, GMalloc->GetDescriptiveName());
+		}
 
-//////////////////////////////////////////////////////////////////////////
+		TMap<FString, double> BaselineMedians;
+		const TArray<TSharedPtr<FJsonValue>>* BaselineRuns;
+		if (Baseline->TryGetArrayField(TEXT("benchmarks"), BaselineRuns))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *BaselineRuns)
+			{
+				const TSharedPtr<FJsonObject>* RunObject;
+				FString Key;
+				double Median;
+				if (Value->TryGetObject(RunObject) && (*RunObject)->TryGetStringField(TEXT("key"), Key) && (*RunObject)->TryGetNumberField(TEXT("median"), Median))
+				{
+					BaselineMedians.Add(Key, Median);
+				}
+			}
+		}
 
-#if defined(_MSC_VER)
-template <class T>
-FORCEINLINE void DoNotOptimize(const T& Value) 
-{
-	UseCharPointer(&reinterpret_cast<char const volatile&>(Value));
-	_ReadWriteBarrier();
-}
+		bool bAnyRegressed = false;
+		for (BenchmarkReporter::Run& Run : Runs)
+		{
+			if (const double* BaselineMedian = BaselineMedians.Find(Run.GetKey()))
+			{
+				Run.BaselineMedianNs = *BaselineMedian;
+				Run.bRegressed = *BaselineMedian > 0 && Run.MedianNs > *BaselineMedian * (1.0 + RegressionThresholdPercent / 100.0);
+				if (Run.bRegressed)
+				{
+					UE_LOG(LogBenchmarkTool, Warning, TEXT("%s regressed: median %.2f ns per iteration, baseline %.2f ns"), *Run.GetKey(), Run.MedianNs, *BaselineMedian);
+					bAnyRegressed = true;
+				}
+			}
+		}
+		return bAnyRegressed;
+	}
+};
 
-inline FORCENOINLINE void ClobberMemory() { _ReadWriteBarrier(); }
-#else
-template <class T>
-FORCEINLINE void DoNotOptimize(const T& Value) 
+Benchmark* Benchmark::RegisterBenchmarkInternal(Benchmark* InBenchmark)
 {
-	/* TODO */
-  UseCharPointer(&reinterpret_cast<char const volatile&>(Value));
+	return BenchmarkRegistry::Get().Register(InBenchmark);
 }
-inline FORCENOINLINE void ClobberMemory() { /* TODO */ }
-#endif
-
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -753,9 +825,9 @@ UE_BENCHMARK(BM_Scheduling_ThreadPoolLowLevelWrapperOverhead)->Iterations(100000
 INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
 {
 	GEngineLoop.PreInit(ArgC, ArgV);
-	BenchmarkRegistry::Get().RunBenchmarks();
+	const bool bPassed = BenchmarkRegistry::Get().RunBenchmarks();
 
 	FEngineLoop::AppPreExit();
 	FEngineLoop::AppExit();
-	return 0;
+	return bPassed ? 0 : 1;
 }
\ No newline at end of file
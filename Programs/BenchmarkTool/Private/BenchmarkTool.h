@@ -3,4 +3,263 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include <iterator>
 
+DECLARE_LOG_CATEGORY_EXTERN(LogBenchmarkTool, Log, All);
+
+//////////////////////////////////////////////////////////////////////////
+
+class alignas(PLATFORM_CACHE_LINE_SIZE) BenchmarkState
+{
+public:
+	struct BenchmarkIterator;
+
+	BenchmarkState() = default;
+
+	FORCEINLINE void SetIterationCount(int InIterationCount) { IterationCount = InIterationCount; }
+	FORCEINLINE int GetIterationCount() const { return IterationCount; }
+
+	/** Splits the iterations into batches that are timed separately, so that percentiles have more than one sample per run */
+	FORCEINLINE void SetBatchCount(int InBatchCount) { BatchCount = FMath::Max(InBatchCount, 1); }
+
+	/** Duration of each batch of the last loop in Cycles64 units, empty if the benchmark didn't loop over the state */
+	const TArray<uint64>& GetBatchDurations() const { return BatchDurations; }
+
+	/** Number of iterations in a batch of the last loop */
+	int GetBatchIterationCount(int BatchIndex) const
+	{
+		const int NumBatches = GetNumBatches();
+		return int((int64)IterationCount * (BatchIndex + 1) / NumBatches - (int64)IterationCount * BatchIndex / NumBatches);
+	}
+
+	FORCEINLINE BenchmarkIterator begin();
+	FORCEINLINE BenchmarkIterator end();
+
+private:
+	/** Every batch has at least one iteration */
+	int GetNumBatches() const { return FMath::Max(FMath::Min(BatchCount, IterationCount), 1); }
+
+	/** Starts timing the first batch, @return its number of iterations */
+	int StartBatches()
+	{
+		BatchDurations.Reset(GetNumBatches());
+		BatchStartTime = FPlatformTime::Cycles64();
+		return GetBatchIterationCount(0);
+	}
+
+	/** Ends the current batch, @return the number of iterations of the next one, 0 once the last batch is done */
+	FORCENOINLINE int NextBatch()
+	{
+		const uint64 EndTime = FPlatformTime::Cycles64();
+		BatchDurations.Add(EndTime - BatchStartTime);
+
+		const int BatchIndex = BatchDurations.Num();
+		if (BatchIndex >= GetNumBatches())
+		{
+			return 0;
+		}
+
+		BatchStartTime = FPlatformTime::Cycles64();
+		return GetBatchIterationCount(BatchIndex);
+	}
+
+	int				IterationCount = 1000;
+	int				BatchCount = 1;
+	uint64			BatchStartTime = 0;
+	TArray<uint64>	BatchDurations;
+};
+
+struct BenchmarkState::BenchmarkIterator
+{
+public:
+	BenchmarkIterator() = default;
+
+	FORCEINLINE BenchmarkIterator(BenchmarkState* InState, int IterationCount)
+	:	State(InState)
+	,	Counter(IterationCount)
+	{
+	}
+
+	FORCEINLINE BenchmarkIterator& operator++() { --Counter; return *this; }
+
+	// This always assumes it compares to an end iterator
+	FORCEINLINE bool operator!=(const BenchmarkIterator& Rhs)
+	{
+		if (Counter == 0)
+		{
+			// Batches end here, so the loop only pays for the counter check it always had
+			Counter = State->NextBatch();
+			return Counter != 0;
+		}
+
+		return true;
+	}
+
+	// Let's just pretend we're an actual iterator
+
+	struct Dummy {};
+	typedef std::forward_iterator_tag	iterator_category;
+	typedef Dummy						value_type;
+	typedef Dummy						reference;
+	typedef Dummy						pointer;
+	typedef std::ptrdiff_t				difference_type;
+
+	Dummy operator*() const { return Dummy(); }
+
+private:
+	BenchmarkState* State = nullptr;
+	int				Counter = 0;
+};
+
+BenchmarkState::BenchmarkIterator BenchmarkState::begin()
+{
+	return BenchmarkIterator(this, StartBatches());
+}
+
+BenchmarkState::BenchmarkIterator BenchmarkState::end()
+{
+	return BenchmarkIterator();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+FORCENOINLINE void UseCharPointer(char const volatile*);
+
+//////////////////////////////////////////////////////////////////////////
+
+typedef void(BenchFunction)(BenchmarkState&);
+
+class Benchmark
+{
+public:
+	Benchmark(const TCHAR* InName) : Name(InName)
+	{
+	}
+
+	virtual ~Benchmark() = default;
+
+	Benchmark(const Benchmark&) = delete;
+	Benchmark& operator=(const Benchmark&) = delete;
+
+	virtual void DoRun(BenchmarkState& State)
+	{
+		UE_LOG(LogBenchmarkTool, Log, TEXT("Running '%s'..."), *this->Name);
+
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(*this->Name);
+		const uint64 StartTime = FPlatformTime::Cycles64();
+
+		Run(State);
+
+		Duration = FPlatformTime::Cycles64() - StartTime;
+	}
+
+	virtual Benchmark* Iterations(uint64 InIterationCount)	{ IterationCount = InIterationCount; return this; }
+	virtual Benchmark* Threads(uint16 ThreadCount)			{ ThreadCounts.Add(ThreadCount); return this; }
+	/** Overrides -Repetitions= for benchmarks that are too slow or too noisy for the default */
+	virtual Benchmark* Repetitions(uint32 InRepetitionCount)	{ RepetitionCount = InRepetitionCount; return this; }
+
+	static Benchmark* RegisterBenchmarkInternal(Benchmark* InBenchmark);
+
+protected:
+	FString			Name;
+	uint64			IterationCount = 0;
+	uint32			RepetitionCount = 0;	// 0 uses the -Repetitions= value
+	TArray<uint16>	ThreadCounts;
+	uint64			Duration = 0;			// This is in Cycles64 units
+
+	friend class BenchmarkRegistry;
+
+private:
+	virtual void Run(BenchmarkState& State) = 0;
+};
+
+class BenchmarkFixture : public Benchmark
+{
+public:
+	using Benchmark::Benchmark;
+
+	virtual void SetUp(BenchmarkState& State)
+	{
+	}
+
+	virtual void TearDown(BenchmarkState& State)
+	{
+	}
+
+	virtual void DoRun(BenchmarkState& State) override
+	{
+		SetUp(State);
+		Benchmark::DoRun(State);
+		TearDown(State);
+	}
+
+protected:
+	virtual void BenchmarkCase(BenchmarkState&) = 0;
+
+private:
+	virtual void Run(BenchmarkState& State) override
+	{
+		BenchmarkCase(State);
+	}
+};
+
+class FunctionBenchmark : public Benchmark
+{
+public:
+	FunctionBenchmark(const TCHAR* Name, BenchFunction* InFunction)
+	:	Benchmark(Name)
+	,	Function(InFunction)
+	{
+	}
+
+	virtual void Run(BenchmarkState& State) override
+	{
+		Function(State);
+	}
+
+private:
+	BenchFunction*	Function = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Benchmark macros
+//
+
+#if defined(__COUNTER__) && (__COUNTER__ + 1 == __COUNTER__ + 0)
+#	define UE_BENCHMARK_UID __COUNTER__
+#else
+#	define UE_BENCHMARK_UID __LINE__
+#endif
+
+#define UE_BENCHMARK_NAME_(Name)		UE_BENCHMARK_CONCAT_(_benchmark_, UE_BENCHMARK_UID, Name)
+#define UE_BENCHMARK_CONCAT_(a, b, c)	UE_BENCHMARK_CONCAT2_(a, b, c)
+#define UE_BENCHMARK_CONCAT2_(a, b, c)	a##b##c
+
+#define UE_BENCHMARK_DECLARE_(n)		static /*[[unused]]*/ ::Benchmark* UE_BENCHMARK_NAME_(n)
+
+#define UE_BENCHMARK(n)					UE_BENCHMARK_DECLARE_(n) = (::Benchmark::RegisterBenchmarkInternal(new ::FunctionBenchmark(TEXT(#n), n)))
+
+#define UE_BENCHMARK_CAPTURE(Func, Name, ...)	UE_BENCHMARK_DECLARE_(Func) = (::Benchmark::RegisterBenchmarkInternal(new ::FunctionBenchmark(TEXT(#Func "/" #Name), [](::BenchmarkState& State) { Func(State, __VA_ARGS__); })))
+
+//////////////////////////////////////////////////////////////////////////
+
+#if defined(_MSC_VER)
+template <class T>
+FORCEINLINE void DoNotOptimize(const T& Value)
+{
+	UseCharPointer(&reinterpret_cast<char const volatile&>(Value));
+	_ReadWriteBarrier();
+}
+
+inline FORCENOINLINE void ClobberMemory() { _ReadWriteBarrier(); }
+#else
+template <class T>
+FORCEINLINE void DoNotOptimize(const T& Value)
+{
+	// Tell the compiler the value is read and memory may have been written, without emitting any instruction
+	asm volatile("" : : "r,m"(Value) : "memory");
+}
+
+FORCEINLINE void ClobberMemory() { asm volatile("" : : : "memory"); }
+#endif
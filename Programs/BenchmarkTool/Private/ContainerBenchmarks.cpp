@@ -0,0 +1,283 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkTool.h"
+#include "Experimental/Containers/RobinHoodHashTable.h"
+#include "Math/RandomStream.h"
+
+//////////////////////////////////////////////////////////////////////////
+//
+// TArray
+//
+
+void BM_TArray_Add(BenchmarkState& State, int32 Num)
+{
+	for (auto _ : State)
+	{
+		TArray<int32> Array;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Array.Add(Index);
+		}
+		DoNotOptimize(Array.GetData());
+	}
+}
+
+void BM_TArray_AddReserved(BenchmarkState& State, int32 Num)
+{
+	for (auto _ : State)
+	{
+		TArray<int32> Array;
+		Array.Reserve(Num);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Array.Add(Index);
+		}
+		DoNotOptimize(Array.GetData());
+	}
+}
+
+void BM_TArray_Iterate(BenchmarkState& State, int32 Num)
+{
+	TArray<int32> Array;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Array.Add(Index);
+	}
+
+	for (auto _ : State)
+	{
+		int32 Sum = 0;
+		for (int32 Value : Array)
+		{
+			Sum += Value;
+		}
+		DoNotOptimize(Sum);
+	}
+}
+
+void BM_TArray_Find(BenchmarkState& State, int32 Num)
+{
+	TArray<int32> Array;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Array.Add(Index);
+	}
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		int32 Found = Array.Find(Value);
+		DoNotOptimize(Found);
+		Value = (Value + 7) % Num;
+	}
+}
+
+void BM_TArray_RemoveAtSwap(BenchmarkState& State, int32 Num)
+{
+	TArray<int32> Array;
+	for (auto _ : State)
+	{
+		Array.Reset();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Array.Add(Index);
+		}
+		while (Array.Num())
+		{
+			Array.RemoveAtSwap(0, 1, false);
+		}
+		ClobberMemory();
+	}
+}
+
+void BM_TArray_Sort(BenchmarkState& State, int32 Num)
+{
+	TArray<int32> Source;
+	FRandomStream Random(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Source.Add((int32)Random.GetUnsignedInt());
+	}
+
+	TArray<int32> Array;
+	for (auto _ : State)
+	{
+		Array = Source;
+		Array.Sort();
+		DoNotOptimize(Array.GetData());
+	}
+}
+
+UE_BENCHMARK_CAPTURE(BM_TArray_Add, 1000, 1000)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_TArray_AddReserved, 1000, 1000)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_TArray_Iterate, 1000, 1000)->Iterations(1000000);
+UE_BENCHMARK_CAPTURE(BM_TArray_Find, 1000, 1000)->Iterations(1000000);
+UE_BENCHMARK_CAPTURE(BM_TArray_RemoveAtSwap, 1000, 1000)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_TArray_Sort, 1000, 1000)->Iterations(10000);
+
+//////////////////////////////////////////////////////////////////////////
+//
+// TMap and TSet compared to the robin hood hash table, with the same random keys
+//
+
+static TArray<uint32> MakeHashKeys(int32 Num)
+{
+	TArray<uint32> Keys;
+	Keys.Reserve(Num);
+	FRandomStream Random(Num);
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Keys.Add(Random.GetUnsignedInt());
+	}
+	return Keys;
+}
+
+void BM_TMap_Add(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+
+	for (auto _ : State)
+	{
+		TMap<uint32, uint32> Map;
+		for (uint32 Key : Keys)
+		{
+			Map.Add(Key, Key);
+		}
+		DoNotOptimize(Map);
+	}
+}
+
+void BM_TMap_Find(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	TMap<uint32, uint32> Map;
+	for (uint32 Key : Keys)
+	{
+		Map.Add(Key, Key);
+	}
+
+	int32 Index = 0;
+	for (auto _ : State)
+	{
+		uint32* Value = Map.Find(Keys[Index]);
+		DoNotOptimize(Value);
+		Index = (Index + 1) % Num;
+	}
+}
+
+void BM_TMap_FindMiss(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	TMap<uint32, uint32> Map;
+	for (uint32 Key : Keys)
+	{
+		Map.Add(Key, Key);
+	}
+
+	uint32 Key = 0;
+	for (auto _ : State)
+	{
+		uint32* Value = Map.Find(Key++ | 0x80000000u);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_TSet_Find(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	TSet<uint32> Set;
+	for (uint32 Key : Keys)
+	{
+		Set.Add(Key);
+	}
+
+	int32 Index = 0;
+	for (auto _ : State)
+	{
+		const uint32* Value = Set.Find(Keys[Index]);
+		DoNotOptimize(Value);
+		Index = (Index + 1) % Num;
+	}
+}
+
+void BM_RobinHoodHashMap_Add(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+
+	for (auto _ : State)
+	{
+		Experimental::TRobinHoodHashMap<uint32, uint32> Map;
+		for (uint32 Key : Keys)
+		{
+			Map.FindOrAdd(Key, Key);
+		}
+		DoNotOptimize(Map);
+	}
+}
+
+void BM_RobinHoodHashMap_Find(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	Experimental::TRobinHoodHashMap<uint32, uint32> Map;
+	for (uint32 Key : Keys)
+	{
+		Map.FindOrAdd(Key, Key);
+	}
+
+	int32 Index = 0;
+	for (auto _ : State)
+	{
+		uint32* Value = Map.Find(Keys[Index]);
+		DoNotOptimize(Value);
+		Index = (Index + 1) % Num;
+	}
+}
+
+void BM_RobinHoodHashMap_FindMiss(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	Experimental::TRobinHoodHashMap<uint32, uint32> Map;
+	for (uint32 Key : Keys)
+	{
+		Map.FindOrAdd(Key, Key);
+	}
+
+	uint32 Key = 0;
+	for (auto _ : State)
+	{
+		uint32* Value = Map.Find(Key++ | 0x80000000u);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_RobinHoodHashSet_Find(BenchmarkState& State, int32 Num)
+{
+	const TArray<uint32> Keys = MakeHashKeys(Num);
+	Experimental::TRobinHoodHashSet<uint32> Set;
+	for (uint32 Key : Keys)
+	{
+		Set.FindOrAdd(Key);
+	}
+
+	int32 Index = 0;
+	for (auto _ : State)
+	{
+		Experimental::FHashElementId Id = Set.FindId(Keys[Index]);
+		DoNotOptimize(Id);
+		Index = (Index + 1) % Num;
+	}
+}
+
+// Compare TMap to the robin hood hash table with -Benchmark=Map_
+UE_BENCHMARK_CAPTURE(BM_TMap_Add, 1000, 1000)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_TMap_Add, 100000, 100000)->Iterations(100);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashMap_Add, 1000, 1000)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashMap_Add, 100000, 100000)->Iterations(100);
+UE_BENCHMARK_CAPTURE(BM_TMap_Find, 1000, 1000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_TMap_Find, 1000000, 1000000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashMap_Find, 1000, 1000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashMap_Find, 1000000, 1000000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_TMap_FindMiss, 1000, 1000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashMap_FindMiss, 1000, 1000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_TSet_Find, 1000, 1000)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_RobinHoodHashSet_Find, 1000, 1000)->Iterations(10000000);
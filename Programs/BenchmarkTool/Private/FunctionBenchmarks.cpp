@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkTool.h"
+
+//////////////////////////////////////////////////////////////////////////
+//
+// TFunction, TUniqueFunction and TFunctionRef
+//
+
+static FORCENOINLINE int32 BenchmarkFreeFunction(int32 Value)
+{
+	return Value + 1;
+}
+
+static FORCENOINLINE int32 CallFunctionRef(TFunctionRef<int32(int32)> Function, int32 Value)
+{
+	return Function(Value);
+}
+
+void BM_TFunction_Construct(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	for (auto _ : State)
+	{
+		TFunction<int32(int32)> Function = [Captured](int32 Value) { return Value + Captured; };
+		DoNotOptimize(Function);
+	}
+}
+
+// Captures more than the inline storage of TFunction, so every construction allocates
+void BM_TFunction_ConstructLargeCapture(BenchmarkState& State)
+{
+	int64 Captured[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	for (auto _ : State)
+	{
+		TFunction<int32(int32)> Function = [Captured](int32 Value) { return Value + (int32)Captured[7]; };
+		DoNotOptimize(Function);
+	}
+}
+
+void BM_TFunction_Invoke(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	TFunction<int32(int32)> Function = [Captured](int32 Value) { return Value + Captured; };
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Function(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_TUniqueFunction_Invoke(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	TUniqueFunction<int32(int32)> Function = [Captured](int32 Value) { return Value + Captured; };
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Function(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_TFunctionRef_Invoke(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	auto Lambda = [Captured](int32 Value) { return Value + Captured; };
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = CallFunctionRef(Lambda, Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_FunctionPointer_Invoke(BenchmarkState& State)
+{
+	int32 (*volatile Function)(int32) = &BenchmarkFreeFunction;
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Function(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+UE_BENCHMARK(BM_TFunction_Construct)->Iterations(10000000);
+UE_BENCHMARK(BM_TFunction_ConstructLargeCapture)->Iterations(10000000);
+UE_BENCHMARK(BM_TFunction_Invoke)->Iterations(100000000);
+UE_BENCHMARK(BM_TUniqueFunction_Invoke)->Iterations(100000000);
+UE_BENCHMARK(BM_TFunctionRef_Invoke)->Iterations(100000000);
+UE_BENCHMARK(BM_FunctionPointer_Invoke)->Iterations(100000000);
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Delegates
+//
+
+DECLARE_DELEGATE_RetVal_OneParam(int32, FBenchmarkDelegate, int32);
+DECLARE_MULTICAST_DELEGATE_OneParam(FBenchmarkMulticastDelegate, int32&);
+
+struct FBenchmarkDelegateTarget
+{
+	int32 Add(int32 Value)
+	{
+		return Value + Increment;
+	}
+
+	void AddInPlace(int32& Value)
+	{
+		Value += Increment;
+	}
+
+	int32 Increment = 1;
+};
+
+struct FBenchmarkSharedDelegateTarget : public TSharedFromThis<FBenchmarkSharedDelegateTarget, ESPMode::ThreadSafe>
+{
+	int32 Add(int32 Value)
+	{
+		return Value + Increment;
+	}
+
+	int32 Increment = 1;
+};
+
+void BM_Delegate_BindLambda(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	for (auto _ : State)
+	{
+		FBenchmarkDelegate Delegate;
+		Delegate.BindLambda([Captured](int32 Value) { return Value + Captured; });
+		DoNotOptimize(Delegate);
+	}
+}
+
+void BM_Delegate_ExecuteRaw(BenchmarkState& State)
+{
+	FBenchmarkDelegateTarget Target;
+	FBenchmarkDelegate Delegate = FBenchmarkDelegate::CreateRaw(&Target, &FBenchmarkDelegateTarget::Add);
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Delegate.Execute(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_Delegate_ExecuteLambda(BenchmarkState& State)
+{
+	int32 Captured = 3;
+	FBenchmarkDelegate Delegate = FBenchmarkDelegate::CreateLambda([Captured](int32 Value) { return Value + Captured; });
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Delegate.Execute(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+// Pins the weak pointer on every call
+void BM_Delegate_ExecuteSP(BenchmarkState& State)
+{
+	TSharedRef<FBenchmarkSharedDelegateTarget, ESPMode::ThreadSafe> Target = MakeShared<FBenchmarkSharedDelegateTarget, ESPMode::ThreadSafe>();
+	FBenchmarkDelegate Delegate = FBenchmarkDelegate::CreateSP(Target, &FBenchmarkSharedDelegateTarget::Add);
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Value = Delegate.Execute(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_MulticastDelegate_Broadcast(BenchmarkState& State, int32 NumBindings)
+{
+	TArray<FBenchmarkDelegateTarget> Targets;
+	Targets.SetNum(NumBindings);
+
+	FBenchmarkMulticastDelegate Delegate;
+	for (FBenchmarkDelegateTarget& Target : Targets)
+	{
+		Delegate.AddRaw(&Target, &FBenchmarkDelegateTarget::AddInPlace);
+	}
+
+	int32 Value = 0;
+	for (auto _ : State)
+	{
+		Delegate.Broadcast(Value);
+		DoNotOptimize(Value);
+	}
+}
+
+void BM_MulticastDelegate_AddRemove(BenchmarkState& State)
+{
+	FBenchmarkDelegateTarget Target;
+	FBenchmarkMulticastDelegate Delegate;
+
+	for (auto _ : State)
+	{
+		FDelegateHandle Handle = Delegate.AddRaw(&Target, &FBenchmarkDelegateTarget::AddInPlace);
+		Delegate.Remove(Handle);
+	}
+}
+
+UE_BENCHMARK(BM_Delegate_BindLambda)->Iterations(10000000);
+UE_BENCHMARK(BM_Delegate_ExecuteRaw)->Iterations(100000000);
+UE_BENCHMARK(BM_Delegate_ExecuteLambda)->Iterations(100000000);
+UE_BENCHMARK(BM_Delegate_ExecuteSP)->Iterations(100000000);
+UE_BENCHMARK_CAPTURE(BM_MulticastDelegate_Broadcast, 1, 1)->Iterations(10000000);
+UE_BENCHMARK_CAPTURE(BM_MulticastDelegate_Broadcast, 16, 16)->Iterations(10000000);
+UE_BENCHMARK(BM_MulticastDelegate_AddRemove)->Iterations(10000000);
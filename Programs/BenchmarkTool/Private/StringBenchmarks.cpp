@@ -0,0 +1,159 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkTool.h"
+
+//////////////////////////////////////////////////////////////////////////
+//
+// FString
+//
+
+void BM_FString_FromLiteral(BenchmarkState& State)
+{
+	for (auto _ : State)
+	{
+		FString String(TEXT("/Game/Characters/Hero/Meshes/SK_Hero_Body"));
+		DoNotOptimize(String);
+	}
+}
+
+void BM_FString_Append(BenchmarkState& State)
+{
+	for (auto _ : State)
+	{
+		FString String(TEXT("/Game/Characters/Hero"));
+		String += TEXT("/Meshes/");
+		String += TEXT("SK_Hero_Body");
+		DoNotOptimize(String);
+	}
+}
+
+void BM_FString_Printf(BenchmarkState& State)
+{
+	int32 Index = 0;
+	for (auto _ : State)
+	{
+		FString String = FString::Printf(TEXT("/Game/Characters/Hero_%d/Meshes/SK_Hero_Body.%s"), Index++, TEXT("uasset"));
+		DoNotOptimize(String);
+	}
+}
+
+void BM_FString_Find(BenchmarkState& State)
+{
+	const FString String(TEXT("/Game/Characters/Hero/Meshes/SK_Hero_Body.SK_Hero_Body"));
+
+	for (auto _ : State)
+	{
+		int32 Index = String.Find(TEXT("SK_Hero_Body"), ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+		DoNotOptimize(Index);
+	}
+}
+
+void BM_FString_Equals(BenchmarkState& State)
+{
+	const FString A(TEXT("/Game/Characters/Hero/Meshes/SK_Hero_Body"));
+	const FString B(TEXT("/game/characters/hero/meshes/sk_hero_body"));
+
+	for (auto _ : State)
+	{
+		bool bEqual = A.Equals(B, ESearchCase::IgnoreCase);
+		DoNotOptimize(bEqual);
+	}
+}
+
+UE_BENCHMARK(BM_FString_FromLiteral)->Iterations(10000000);
+UE_BENCHMARK(BM_FString_Append)->Iterations(10000000);
+UE_BENCHMARK(BM_FString_Printf)->Iterations(1000000);
+UE_BENCHMARK(BM_FString_Find)->Iterations(10000000);
+UE_BENCHMARK(BM_FString_Equals)->Iterations(10000000);
+
+//////////////////////////////////////////////////////////////////////////
+//
+// FName
+//
+
+void BM_FName_CreateExisting(BenchmarkState& State)
+{
+	FName Existing(TEXT("BenchmarkExistingName"));
+
+	for (auto _ : State)
+	{
+		FName Name(TEXT("BenchmarkExistingName"));
+		DoNotOptimize(Name);
+	}
+}
+
+void BM_FName_CreateWithNumber(BenchmarkState& State)
+{
+	FName Existing(TEXT("BenchmarkExistingName"));
+
+	for (auto _ : State)
+	{
+		FName Name(TEXT("BenchmarkExistingName_17"));
+		DoNotOptimize(Name);
+	}
+}
+
+// Every iteration adds a new entry to the name table, which is never freed; keep the iteration count low
+void BM_FName_CreateNew(BenchmarkState& State)
+{
+	static int32 UniqueIndex = 0;
+	TCHAR Buffer[64];
+
+	for (auto _ : State)
+	{
+		FCString::Sprintf(Buffer, TEXT("BenchmarkNewName%dx"), UniqueIndex++);
+		FName Name(Buffer);
+		DoNotOptimize(Name);
+	}
+}
+
+void BM_FName_Find(BenchmarkState& State)
+{
+	FName Existing(TEXT("BenchmarkExistingName"));
+
+	for (auto _ : State)
+	{
+		FName Name(TEXT("BenchmarkExistingName"), FNAME_Find);
+		DoNotOptimize(Name);
+	}
+}
+
+void BM_FName_FindMissing(BenchmarkState& State)
+{
+	for (auto _ : State)
+	{
+		FName Name(TEXT("BenchmarkNameThatIsNeverAdded"), FNAME_Find);
+		DoNotOptimize(Name);
+	}
+}
+
+void BM_FName_Compare(BenchmarkState& State)
+{
+	const FName A(TEXT("BenchmarkNameA"));
+	const FName B(TEXT("BenchmarkNameB"));
+
+	for (auto _ : State)
+	{
+		int32 Result = A.Compare(B);
+		DoNotOptimize(Result);
+	}
+}
+
+void BM_FName_ToString(BenchmarkState& State)
+{
+	const FName Name(TEXT("BenchmarkExistingName"), 17);
+
+	for (auto _ : State)
+	{
+		FString String = Name.ToString();
+		DoNotOptimize(String);
+	}
+}
+
+UE_BENCHMARK(BM_FName_CreateExisting)->Iterations(10000000);
+UE_BENCHMARK(BM_FName_CreateWithNumber)->Iterations(10000000);
+UE_BENCHMARK(BM_FName_CreateNew)->Iterations(100000);
+UE_BENCHMARK(BM_FName_Find)->Iterations(10000000);
+UE_BENCHMARK(BM_FName_FindMissing)->Iterations(10000000);
+UE_BENCHMARK(BM_FName_Compare)->Iterations(10000000);
+UE_BENCHMARK(BM_FName_ToString)->Iterations(10000000);
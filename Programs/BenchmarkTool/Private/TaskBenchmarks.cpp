@@ -0,0 +1,110 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "BenchmarkTool.h"
+#include "Async/ParallelFor.h"
+#include "Async/Fundamental/Scheduler.h"
+
+//////////////////////////////////////////////////////////////////////////
+//
+// ParallelFor, with a cheap body so the numbers are dominated by the dispatch and batching overhead
+//
+
+static FORCEINLINE void CheapParallelForBody(TArray<float>& Values, int32 Index)
+{
+	Values[Index] = FMath::Sqrt(Values[Index] + 1.0f);
+}
+
+void BM_ParallelFor(BenchmarkState& State, int32 Num)
+{
+	TArray<float> Values;
+	Values.SetNumZeroed(Num);
+
+	for (auto _ : State)
+	{
+		ParallelFor(Num, [&Values](int32 Index) { CheapParallelForBody(Values, Index); });
+	}
+}
+
+void BM_ParallelFor_MinBatchSize(BenchmarkState& State, int32 Num)
+{
+	TArray<float> Values;
+	Values.SetNumZeroed(Num);
+
+	for (auto _ : State)
+	{
+		ParallelFor(Num, 1024, [&Values](int32 Index) { CheapParallelForBody(Values, Index); });
+	}
+}
+
+void BM_ParallelFor_Adaptive(BenchmarkState& State, int32 Num)
+{
+	TArray<float> Values;
+	Values.SetNumZeroed(Num);
+
+	for (auto _ : State)
+	{
+		ParallelFor(PARALLELFOR_CALLSITE(TEXT("BM_ParallelFor_Adaptive")), Num, 1, [&Values](int32 Index) { CheapParallelForBody(Values, Index); }, EParallelForFlags::Adaptive);
+	}
+}
+
+void BM_ParallelFor_SingleThread(BenchmarkState& State, int32 Num)
+{
+	TArray<float> Values;
+	Values.SetNumZeroed(Num);
+
+	for (auto _ : State)
+	{
+		ParallelFor(Num, [&Values](int32 Index) { CheapParallelForBody(Values, Index); }, EParallelForFlags::ForceSingleThread);
+	}
+}
+
+// Compare batching strategies with -Benchmark=BM_ParallelFor
+UE_BENCHMARK_CAPTURE(BM_ParallelFor, 100, 100)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor, 100000, 100000)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_MinBatchSize, 100, 100)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_MinBatchSize, 100000, 100000)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_Adaptive, 100, 100)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_Adaptive, 100000, 100000)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_SingleThread, 100, 100)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_ParallelFor_SingleThread, 100000, 100000)->Iterations(10000);
+
+//////////////////////////////////////////////////////////////////////////
+//
+// LowLevelTasks scheduler
+//
+
+// Launches one empty task and waits for it, the round trip through a worker
+void BM_LowLevelTasks_LaunchAndWait(BenchmarkState& State)
+{
+	for (auto _ : State)
+	{
+		LowLevelTasks::FTask Task;
+		Task.Init(TEXT("BM_LowLevelTasks_LaunchAndWait"), []() {});
+		verify(LowLevelTasks::TryLaunch(Task));
+		LowLevelTasks::BusyWaitForTask(Task);
+	}
+}
+
+// Launches a batch of empty tasks and waits for all of them, the throughput of the queues
+void BM_LowLevelTasks_LaunchBatch(BenchmarkState& State, int32 NumTasks)
+{
+	std::atomic<int32> NumExecuted(0);
+
+	for (auto _ : State)
+	{
+		TArray<LowLevelTasks::FTask> Tasks;
+		Tasks.SetNum(NumTasks);
+		for (LowLevelTasks::FTask& Task : Tasks)
+		{
+			Task.Init(TEXT("BM_LowLevelTasks_LaunchBatch"), [&NumExecuted]() { NumExecuted.fetch_add(1, std::memory_order_relaxed); });
+			verify(LowLevelTasks::TryLaunch(Task));
+		}
+		LowLevelTasks::BusyWaitForTasks<LowLevelTasks::FTask>(Tasks);
+	}
+
+	DoNotOptimize(NumExecuted);
+}
+
+UE_BENCHMARK(BM_LowLevelTasks_LaunchAndWait)->Iterations(100000);
+UE_BENCHMARK_CAPTURE(BM_LowLevelTasks_LaunchBatch, 100, 100)->Iterations(10000);
+UE_BENCHMARK_CAPTURE(BM_LowLevelTasks_LaunchBatch, 10000, 10000)->Iterations(100);
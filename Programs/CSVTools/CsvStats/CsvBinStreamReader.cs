@@ -0,0 +1,300 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace CSVStats
+{
+	// A run of consecutive frames returned by CsvBinStreamReader
+	public class CsvBinFrameBlock
+	{
+		public int FirstFrame;
+		public int FrameCount;
+
+		// One entry per column in CsvBinStreamReader.StatNames. Null for columns rejected by the stat filter, or if frames weren't decoded
+		public float[][] Columns;
+
+		// Events in this block. Frame numbers are absolute
+		public List<CsvEvent> Events;
+	}
+
+	// Streaming reader for the columnar CSVBIN version 3 files written by the engine (csv.BinaryOutput=1 or -csvBinary).
+	// See the CsvBinary namespace in CsvProfiler.cpp for the layout. Frames are returned a block at a time, so a capture
+	// never has to be held in memory in full, and columns rejected by the stat filter are skipped without being decoded.
+	public class CsvBinStreamReader : IDisposable
+	{
+		public const int Version = 3;
+
+		enum BlockType : byte
+		{
+			End = 0,
+			Strings = 1,
+			Series = 2,
+			Frames = 3,
+			Metadata = 4,
+		};
+
+		enum ColumnType : byte
+		{
+			Float = 0,
+			Int = 1,
+		};
+
+		// Stat names, in column order. New stats can appear between blocks
+		public List<string> StatNames = new List<string>();
+
+		// Only complete once ReadNextBlock has returned null, since the engine writes metadata when the capture ends.
+		// Stays null for captures that were cut short
+		public CsvMetadata MetaData = null;
+
+		// True if the file ended without an End block, e.g. because the capture is still being written or the process
+		// crashed. Everything up to the last complete block is still returned
+		public bool Truncated { get { return bTruncated; } }
+
+		public int FrameCount { get { return frameCount; } }
+
+		public CsvBinStreamReader(string filename, Func<string, bool> statFilterIn = null)
+		{
+			fileReader = new BinaryReader(new FileStream(filename, FileMode.Open, FileAccess.Read, FileShare.Read, 1024 * 1024));
+			statFilter = statFilterIn;
+
+			if (fileReader.ReadString() != "CSVBIN")
+			{
+				throw new Exception("Failed to read " + filename + ". Bad format");
+			}
+			int version = fileReader.ReadInt32();
+			if (version != Version)
+			{
+				throw new Exception("Failed to read " + filename + ". Version mismatch. Version is " + version.ToString() + ". Expected: " + Version.ToString());
+			}
+		}
+
+		// Returns the CSVBIN version of a .csv.bin file, so callers can pick the right reader
+		public static int ReadVersion(string filename)
+		{
+			using (BinaryReader reader = new BinaryReader(new FileStream(filename, FileMode.Open, FileAccess.Read, FileShare.Read)))
+			{
+				if (reader.ReadString() != "CSVBIN")
+				{
+					throw new Exception("Failed to read " + filename + ". Bad format");
+				}
+				return reader.ReadInt32();
+			}
+		}
+
+		// Returns the next block of frames, or null at the end of the file. If decodeFrames is false, only the frame count
+		// is read and the block's columns and events are skipped; this is the fast path for reading stat names and metadata.
+		// A partial block at the end of the file is treated as the end of the stream.
+		public CsvBinFrameBlock ReadNextBlock(bool decodeFrames = true)
+		{
+			while (!bReachedEnd)
+			{
+				// Blocks are written whole, so a block that fits in the file is complete
+				long bytesLeft = fileReader.BaseStream.Length - fileReader.BaseStream.Position;
+				if (bytesLeft < BlockHeaderSize)
+				{
+					bReachedEnd = true;
+					bTruncated = true;
+					break;
+				}
+				BlockType blockType = (BlockType)fileReader.ReadByte();
+				int payloadSize = fileReader.ReadInt32();
+				if (payloadSize < 0 || payloadSize > bytesLeft - BlockHeaderSize)
+				{
+					bReachedEnd = true;
+					bTruncated = true;
+					break;
+				}
+
+				switch (blockType)
+				{
+					case BlockType.Strings:
+						{
+							int count = (int)ReadVarUInt();
+							for (int i = 0; i < count; i++)
+							{
+								int length = (int)ReadVarUInt();
+								stringTable.Add(Encoding.UTF8.GetString(fileReader.ReadBytes(length)));
+							}
+						}
+						break;
+
+					case BlockType.Series:
+						{
+							int count = (int)ReadVarUInt();
+							for (int i = 0; i < count; i++)
+							{
+								string statName = stringTable[(int)ReadVarUInt()];
+								StatNames.Add(statName);
+								columnTypes.Add((ColumnType)fileReader.ReadByte());
+								columnWanted.Add(statFilter == null || statFilter(statName));
+							}
+						}
+						break;
+
+					case BlockType.Metadata:
+						{
+							MetaData = new CsvMetadata();
+							int count = (int)ReadVarUInt();
+							for (int i = 0; i < count; i++)
+							{
+								string key = stringTable[(int)ReadVarUInt()].ToLowerInvariant();
+								MetaData.Values[key] = stringTable[(int)ReadVarUInt()];
+							}
+						}
+						break;
+
+					case BlockType.Frames:
+						return ReadFrameBlock(payloadSize, decodeFrames);
+
+					case BlockType.End:
+						bReachedEnd = true;
+						break;
+
+					default:
+						// Unknown block type from a newer writer. Skip it
+						fileReader.BaseStream.Seek(payloadSize, SeekOrigin.Current);
+						break;
+				}
+			}
+			return null;
+		}
+
+		public void Dispose()
+		{
+			fileReader.Close();
+		}
+
+		CsvBinFrameBlock ReadFrameBlock(int payloadSize, bool decodeFrames)
+		{
+			long blockEnd = fileReader.BaseStream.Position + payloadSize;
+
+			CsvBinFrameBlock block = new CsvBinFrameBlock();
+			block.FirstFrame = frameCount;
+			block.FrameCount = (int)ReadVarUInt();
+			block.Events = new List<CsvEvent>();
+			frameCount += block.FrameCount;
+
+			int columnCount = (int)ReadVarUInt();
+			if (columnCount > StatNames.Count)
+			{
+				throw new Exception("Frame block has " + columnCount + " columns, but only " + StatNames.Count + " stats were declared");
+			}
+			block.Columns = new float[StatNames.Count][];
+
+			if (!decodeFrames)
+			{
+				fileReader.BaseStream.Seek(blockEnd, SeekOrigin.Begin);
+				return block;
+			}
+
+			for (int columnIndex = 0; columnIndex < columnCount; columnIndex++)
+			{
+				int columnSize = (int)ReadVarUInt();
+				if (!columnWanted[columnIndex])
+				{
+					fileReader.BaseStream.Seek(columnSize, SeekOrigin.Current);
+					continue;
+				}
+
+				byte[] columnData = fileReader.ReadBytes(columnSize);
+				block.Columns[columnIndex] = DecodeColumn(columnData, block.FrameCount, columnTypes[columnIndex]);
+			}
+
+			int eventCount = (int)ReadVarUInt();
+			for (int i = 0; i < eventCount; i++)
+			{
+				int frameOffset = (int)ReadVarUInt();
+				string name = stringTable[(int)ReadVarUInt()];
+				block.Events.Add(new CsvEvent(name, block.FirstFrame + frameOffset));
+			}
+
+			if (fileReader.BaseStream.Position != blockEnd)
+			{
+				throw new Exception("Frame block size doesn't match its contents");
+			}
+			return block;
+		}
+
+		static float[] DecodeColumn(byte[] data, int frameCount, ColumnType columnType)
+		{
+			int[] rawValues = new int[frameCount];
+			int position = 0;
+			int previousValue = 0;
+			for (int i = 0; i < frameCount; i++)
+			{
+				ulong encoded = DecodeVarUInt(data, ref position);
+				if (columnType == ColumnType.Int)
+				{
+					// Zigzag encoded delta to the previous frame
+					long delta = (long)(encoded >> 1) ^ -(long)(encoded & 1);
+					previousValue = (int)(previousValue + delta);
+				}
+				else
+				{
+					// Float bits xor'd with the previous frame
+					previousValue ^= (int)(uint)encoded;
+				}
+				rawValues[i] = previousValue;
+			}
+
+			float[] values = new float[frameCount];
+			if (columnType == ColumnType.Int)
+			{
+				for (int i = 0; i < frameCount; i++)
+				{
+					values[i] = (float)rawValues[i];
+				}
+			}
+			else
+			{
+				Buffer.BlockCopy(rawValues, 0, values, 0, frameCount * sizeof(float));
+			}
+			return values;
+		}
+
+		static ulong DecodeVarUInt(byte[] data, ref int position)
+		{
+			ulong value = 0;
+			int shift = 0;
+			byte b;
+			do
+			{
+				b = data[position++];
+				value |= (ulong)(b & 0x7f) << shift;
+				shift += 7;
+			}
+			while ((b & 0x80) != 0);
+			return value;
+		}
+
+		ulong ReadVarUInt()
+		{
+			ulong value = 0;
+			int shift = 0;
+			byte b;
+			do
+			{
+				b = fileReader.ReadByte();
+				value |= (ulong)(b & 0x7f) << shift;
+				shift += 7;
+			}
+			while ((b & 0x80) != 0);
+			return value;
+		}
+
+		// Block type and payload size
+		const int BlockHeaderSize = 5;
+
+		BinaryReader fileReader;
+		Func<string, bool> statFilter;
+		List<string> stringTable = new List<string>();
+		List<ColumnType> columnTypes = new List<ColumnType>();
+		List<bool> columnWanted = new List<bool>();
+		int frameCount = 0;
+		bool bReachedEnd = false;
+		bool bTruncated = false;
+	}
+}
@@ -692,6 +692,12 @@ namespace CSVStats
 				throw new Exception("Failed to read "+filename+". Bad format");
 			}
 			int version=fileReader.ReadInt32();
+			if (version == CsvBinStreamReader.Version)
+			{
+				// Columnar files written directly by the engine
+				fileReader.Close();
+				return ReadStreamedBinFile(filename, statNamesToRead, numRowsToSkip, justHeader);
+			}
 			if (version != CsvBinVersion)
 			{
 				throw new Exception("Failed to read "+filename+". Version mismatch. Version is "+version.ToString()+". Expected: "+CsvBinVersion.ToString());
@@ -804,6 +810,76 @@ namespace CSVStats
 			return csvStatsOut;
 		}
 
+		static CsvStats ReadStreamedBinFile(string filename, string[] statNamesToRead, int numRowsToSkip, bool justHeader)
+		{
+			CsvStats csvStatsOut = new CsvStats();
+			Func<string, bool> statFilter = null;
+			if (statNamesToRead != null)
+			{
+				statFilter = statName => statNamesToRead.Any(searchString => DoesSearchStringMatch(statName, searchString));
+			}
+
+			using (CsvBinStreamReader reader = new CsvBinStreamReader(filename, statFilter))
+			{
+				// Columns map to stats by index. Duplicate stat names keep the first column, like the text reader
+				List<StatSamples> columnStats = new List<StatSamples>();
+				CsvBinFrameBlock block;
+				while ((block = reader.ReadNextBlock(!justHeader)) != null)
+				{
+					while (columnStats.Count < reader.StatNames.Count)
+					{
+						string statName = reader.StatNames[columnStats.Count];
+						StatSamples stat = null;
+						if ((statFilter == null || statFilter(statName)) && csvStatsOut.GetStat(statName) == null)
+						{
+							stat = new StatSamples(statName);
+							csvStatsOut.AddStat(stat);
+						}
+						columnStats.Add(stat);
+					}
+
+					for (int columnIndex = 0; columnIndex < block.Columns.Length; columnIndex++)
+					{
+						StatSamples stat = columnStats[columnIndex];
+						float[] column = block.Columns[columnIndex];
+						if (stat == null || column == null)
+						{
+							continue;
+						}
+
+						// Stats which appeared partway through the capture read as zero before that
+						if (stat.samples.Count < block.FirstFrame)
+						{
+							stat.samples.AddRange(new float[block.FirstFrame - stat.samples.Count]);
+						}
+						stat.samples.AddRange(column);
+					}
+
+					foreach (CsvEvent ev in block.Events)
+					{
+						if (ev.Frame >= numRowsToSkip)
+						{
+							csvStatsOut.Events.Add(ev);
+						}
+					}
+				}
+				csvStatsOut.metaData = reader.MetaData;
+
+				if (!justHeader)
+				{
+					foreach (StatSamples stat in csvStatsOut.Stats.Values)
+					{
+						if (numRowsToSkip > 0)
+						{
+							stat.samples.RemoveRange(0, Math.Min(numRowsToSkip, stat.samples.Count));
+						}
+					}
+					csvStatsOut.ComputeAveragesAndTotal();
+				}
+			}
+			return csvStatsOut;
+		}
+
 		public void WriteToCSV(string filename)
         {
             System.IO.StreamWriter csvOutFile;
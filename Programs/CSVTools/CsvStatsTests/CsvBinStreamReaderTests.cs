@@ -0,0 +1,293 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using CSVStats;
+
+namespace CsvStatsTests
+{
+	[TestClass]
+	public class CsvBinStreamReaderTests
+	{
+		// Writes CSVBIN version 3 files the same way FCsvStreamWriter does in CsvProfiler.cpp
+		class CsvBinTestWriter
+		{
+			public List<long> BlockEnds = new List<long>();
+			public List<int> FramesBeforeBlockEnd = new List<int>();
+			public long MetadataEnd;
+
+			public CsvBinTestWriter(BinaryWriter writerIn)
+			{
+				writer = writerIn;
+				writer.Write("CSVBIN");
+				writer.Write(CsvBinStreamReader.Version);
+			}
+
+			public void WriteStrings(params string[] strings)
+			{
+				List<byte> payload = new List<byte>();
+				WriteVarUInt(payload, (ulong)strings.Length);
+				foreach (string str in strings)
+				{
+					byte[] utf8 = Encoding.UTF8.GetBytes(str);
+					WriteVarUInt(payload, (ulong)utf8.Length);
+					payload.AddRange(utf8);
+				}
+				WriteBlock(1, payload);
+			}
+
+			public void WriteSeries(params int[] nameIndexAndType)
+			{
+				List<byte> payload = new List<byte>();
+				WriteVarUInt(payload, (ulong)(nameIndexAndType.Length / 2));
+				for (int i = 0; i < nameIndexAndType.Length; i += 2)
+				{
+					WriteVarUInt(payload, (ulong)nameIndexAndType[i]);
+					payload.Add((byte)nameIndexAndType[i + 1]);
+				}
+				WriteBlock(2, payload);
+			}
+
+			public void WriteFrames(float[] floatColumn, int[] intColumn, int eventFrameOffset, int eventNameIndex)
+			{
+				List<byte> payload = new List<byte>();
+				WriteVarUInt(payload, (ulong)floatColumn.Length);
+				WriteVarUInt(payload, 2);
+
+				List<byte> column = new List<byte>();
+				int previousValue = 0;
+				foreach (float value in floatColumn)
+				{
+					int bits = BitConverter.ToInt32(BitConverter.GetBytes(value), 0);
+					WriteVarUInt(column, (uint)(bits ^ previousValue));
+					previousValue = bits;
+				}
+				WriteVarUInt(payload, (ulong)column.Count);
+				payload.AddRange(column);
+
+				column.Clear();
+				previousValue = 0;
+				foreach (int value in intColumn)
+				{
+					long delta = (long)value - previousValue;
+					WriteVarUInt(column, (ulong)((delta << 1) ^ (delta >> 63)));
+					previousValue = value;
+				}
+				WriteVarUInt(payload, (ulong)column.Count);
+				payload.AddRange(column);
+
+				WriteVarUInt(payload, 1);
+				WriteVarUInt(payload, (ulong)eventFrameOffset);
+				WriteVarUInt(payload, (ulong)eventNameIndex);
+
+				frameCount += floatColumn.Length;
+				WriteBlock(3, payload);
+			}
+
+			public void WriteMetadataAndEnd(int keyIndex, int valueIndex)
+			{
+				List<byte> payload = new List<byte>();
+				WriteVarUInt(payload, 1);
+				WriteVarUInt(payload, (ulong)keyIndex);
+				WriteVarUInt(payload, (ulong)valueIndex);
+				WriteBlock(4, payload);
+				MetadataEnd = writer.BaseStream.Position;
+				WriteBlock(0, new List<byte>());
+			}
+
+			void WriteBlock(byte blockType, List<byte> payload)
+			{
+				writer.Write(blockType);
+				writer.Write(payload.Count);
+				writer.Write(payload.ToArray());
+				BlockEnds.Add(writer.BaseStream.Position);
+				FramesBeforeBlockEnd.Add(frameCount);
+			}
+
+			static void WriteVarUInt(List<byte> output, ulong value)
+			{
+				while (value >= 0x80)
+				{
+					output.Add((byte)(value | 0x80));
+					value >>= 7;
+				}
+				output.Add((byte)value);
+			}
+
+			BinaryWriter writer;
+			int frameCount = 0;
+		}
+
+		static float[] MakeFloats(int count, int seed)
+		{
+			float[] values = new float[count];
+			for (int i = 0; i < count; i++)
+			{
+				values[i] = 16.6f + (float)Math.Sin(i + seed) * (i % 7);
+			}
+			return values;
+		}
+
+		static int[] MakeInts(int count, int seed)
+		{
+			int[] values = new int[count];
+			for (int i = 0; i < count; i++)
+			{
+				values[i] = 1000 + (i * 37 + seed) % 101 - 50;
+			}
+			return values;
+		}
+
+		static byte[] WriteCapture(out CsvBinTestWriter testWriter)
+		{
+			using (MemoryStream stream = new MemoryStream())
+			using (BinaryWriter writer = new BinaryWriter(stream))
+			{
+				testWriter = new CsvBinTestWriter(writer);
+				testWriter.WriteStrings("FrameTime", "Memory", "Hitch", "Platform", "Test");
+				testWriter.WriteSeries(0, 0, 1, 1);
+				testWriter.WriteFrames(MakeFloats(256, 0), MakeInts(256, 0), 100, 2);
+				testWriter.WriteFrames(MakeFloats(10, 256), MakeInts(10, 256), 3, 2);
+				testWriter.WriteMetadataAndEnd(3, 4);
+				writer.Flush();
+				return stream.ToArray();
+			}
+		}
+
+		static int ReadAllFrames(string filename, out CsvBinStreamReader readerOut, List<float> frameTimes, List<float> memory, List<CsvEvent> events)
+		{
+			CsvBinStreamReader reader = new CsvBinStreamReader(filename);
+			CsvBinFrameBlock block;
+			while ((block = reader.ReadNextBlock()) != null)
+			{
+				frameTimes.AddRange(block.Columns[0]);
+				memory.AddRange(block.Columns[1]);
+				events.AddRange(block.Events);
+			}
+			reader.Dispose();
+			readerOut = reader;
+			return reader.FrameCount;
+		}
+
+		[TestMethod]
+		public void RoundTrip()
+		{
+			CsvBinTestWriter testWriter;
+			byte[] capture = WriteCapture(out testWriter);
+			string filename = Path.GetTempFileName();
+			try
+			{
+				File.WriteAllBytes(filename, capture);
+
+				List<float> frameTimes = new List<float>();
+				List<float> memory = new List<float>();
+				List<CsvEvent> events = new List<CsvEvent>();
+				CsvBinStreamReader reader;
+				Assert.AreEqual(266, ReadAllFrames(filename, out reader, frameTimes, memory, events));
+				Assert.IsFalse(reader.Truncated);
+				CollectionAssert.AreEqual(new List<string> { "FrameTime", "Memory" }, reader.StatNames);
+
+				List<float> expectedFrameTimes = new List<float>(MakeFloats(256, 0));
+				expectedFrameTimes.AddRange(MakeFloats(10, 256));
+				CollectionAssert.AreEqual(expectedFrameTimes, frameTimes);
+
+				List<float> expectedMemory = new List<float>();
+				foreach (int value in MakeInts(256, 0))
+				{
+					expectedMemory.Add(value);
+				}
+				foreach (int value in MakeInts(10, 256))
+				{
+					expectedMemory.Add(value);
+				}
+				CollectionAssert.AreEqual(expectedMemory, memory);
+
+				Assert.AreEqual(2, events.Count);
+				Assert.AreEqual("Hitch", events[0].Name);
+				Assert.AreEqual(100, events[0].Frame);
+				Assert.AreEqual(259, events[1].Frame);
+
+				Assert.IsNotNull(reader.MetaData);
+				Assert.AreEqual("Test", reader.MetaData.Values["platform"]);
+
+				CsvStats stats = CsvStats.ReadBinFile(filename);
+				Assert.AreEqual(266, stats.GetStat("FrameTime").samples.Count);
+			}
+			finally
+			{
+				File.Delete(filename);
+			}
+		}
+
+		[TestMethod]
+		public void EngineCapture()
+		{
+			// Written by FCsvStreamWriter, System.Core.Profiling.CsvProfiler.BinaryOutput checks the engine still produces it
+			string filename = Path.Combine(AppContext.BaseDirectory, "Fixtures", "EngineCapture.csvbin");
+
+			List<float> frameTimes = new List<float>();
+			List<float> memory = new List<float>();
+			List<CsvEvent> events = new List<CsvEvent>();
+			CsvBinStreamReader reader;
+			Assert.AreEqual(266, ReadAllFrames(filename, out reader, frameTimes, memory, events));
+			Assert.IsFalse(reader.Truncated);
+			CollectionAssert.AreEqual(new List<string> { "FrameTime", "Memory" }, reader.StatNames);
+
+			for (int i = 0; i < 266; i++)
+			{
+				Assert.AreEqual(16.5f + (i % 7) * 0.25f, frameTimes[i]);
+				Assert.AreEqual(1000 + (i * 37) % 101 - 50, memory[i]);
+			}
+
+			Assert.AreEqual(2, events.Count);
+			Assert.AreEqual("Hitch", events[0].Name);
+			Assert.AreEqual(100, events[0].Frame);
+			Assert.AreEqual("Hitch", events[1].Name);
+			Assert.AreEqual(259, events[1].Frame);
+
+			Assert.IsNotNull(reader.MetaData);
+			Assert.AreEqual("Test", reader.MetaData.Values["platform"]);
+		}
+
+		[TestMethod]
+		public void Truncated()
+		{
+			CsvBinTestWriter testWriter;
+			byte[] capture = WriteCapture(out testWriter);
+			string filename = Path.GetTempFileName();
+			try
+			{
+				// Cut the capture at every length past the file header, including in the middle of block headers
+				for (int length = 11; length < capture.Length; length++)
+				{
+					using (FileStream stream = new FileStream(filename, FileMode.Create))
+					{
+						stream.Write(capture, 0, length);
+					}
+
+					int expectedFrames = 0;
+					for (int blockIndex = 0; blockIndex < testWriter.BlockEnds.Count && testWriter.BlockEnds[blockIndex] <= length; blockIndex++)
+					{
+						expectedFrames = testWriter.FramesBeforeBlockEnd[blockIndex];
+					}
+
+					List<float> frameTimes = new List<float>();
+					List<float> memory = new List<float>();
+					List<CsvEvent> events = new List<CsvEvent>();
+					CsvBinStreamReader reader;
+					Assert.AreEqual(expectedFrames, ReadAllFrames(filename, out reader, frameTimes, memory, events), "Frames read from " + length + " bytes");
+					Assert.AreEqual(expectedFrames, frameTimes.Count);
+					Assert.IsTrue(reader.Truncated, "Truncated at " + length + " bytes");
+					Assert.AreEqual(length >= testWriter.MetadataEnd, reader.MetaData != null, "Metadata read from " + length + " bytes");
+				}
+			}
+			finally
+			{
+				File.Delete(filename);
+			}
+		}
+	}
+}
@@ -13,6 +13,8 @@
 #include "Interfaces/ITargetPlatformManagerModule.h"
 #include "RHIShaderFormatDefinitions.inl"
 #include "ShaderCompilerCommon.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 
 #define DEBUG_USING_CONSOLE	0
 
@@ -215,9 +217,20 @@ public:
 				if (TokenTime > 0)
 				{
 					TimeToLive = TokenTime;
-					break;
 				}
 			}
+			else if (Switch.StartsWith(TEXT("SharedMemory=")))
+			{
+				OpenMailbox(Switch.RightChop(13));
+			}
+		}
+	}
+
+	~FWorkLoop()
+	{
+		if (SharedMemoryRegion)
+		{
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(SharedMemoryRegion);
 		}
 	}
 
@@ -249,21 +262,35 @@ public:
 			}
 
 			// Prepare for output
+			if (bProcessingMailboxInput && WriteOutputToMailbox(SingleJobResults, PipelineJobResults))
+			{
+				// Results went back through shared memory, no files involved.
+			}
+			else
+			{
 #if UE_BUILD_DEBUG
-			TArray<uint8> MemBlock;
-			FMemoryWriter MemWriter(MemBlock);
-			FArchive* OutputFilePtr = &MemWriter;
+				TArray<uint8> MemBlock;
+				FMemoryWriter MemWriter(MemBlock);
+				FArchive* OutputFilePtr = &MemWriter;
 #else
-			FArchive* OutputFilePtr = CreateOutputArchive();
-			check(OutputFilePtr);
+				FArchive* OutputFilePtr = CreateOutputArchive();
+				check(OutputFilePtr);
 #endif
-			WriteToOutputArchive(OutputFilePtr, SingleJobResults, PipelineJobResults);
+				WriteToOutputArchive(OutputFilePtr, SingleJobResults, PipelineJobResults);
 
-			// Close the output file.
-			delete OutputFilePtr;
+				// Close the output file.
+				delete OutputFilePtr;
 
-			// Change the output file name to requested one
-			IFileManager::Get().Move(*OutputFilePath, *TempFilePath);
+				// Must happen before the output file appears, the parent returns the mailbox to idle once it has read it.
+				if (bProcessingMailboxInput)
+				{
+					Mailbox->SetState(FShaderCompileWorkerMailbox::OutputInFile);
+				}
+
+				// Change the output file name to requested one
+				IFileManager::Get().Move(*OutputFilePath, *TempFilePath);
+			}
+			bProcessingMailboxInput = false;
 
 			if (IsUsingXGE())
 			{
@@ -306,13 +333,64 @@ private:
 	TMap<FString, uint32> FormatVersionMap;
 	FString TempFilePath;
 
-	/** Opens an input file, trying multiple times if necessary. */
+	/** Shared memory region the parent hands batches over through, null when only files are used. */
+	FPlatformMemory::FSharedMemoryRegion* SharedMemoryRegion = nullptr;
+	FShaderCompileWorkerMailbox* Mailbox = nullptr;
+	/** Whether the batch being processed came from the mailbox, in which case its results go back the same way. */
+	bool bProcessingMailboxInput = false;
+
+	/** Value of the parent's shader file cache generation when our cache was last flushed. */
+	uint32 ShaderFileCacheGeneration = 0;
+	bool bHasFlushedShaderFileCache = false;
+
+	void OpenMailbox(const FString& RegionName)
+	{
+		// The parent created the region, its real size is recorded in the header.
+		SharedMemoryRegion = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, sizeof(FShaderCompileWorkerMailbox));
+		if (SharedMemoryRegion)
+		{
+			FShaderCompileWorkerMailbox* MappedMailbox = (FShaderCompileWorkerMailbox*)SharedMemoryRegion->GetAddress();
+			const SIZE_T RegionSize = MappedMailbox->IsValid() ? sizeof(FShaderCompileWorkerMailbox) + (SIZE_T)MappedMailbox->PayloadCapacity : 0;
+
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(SharedMemoryRegion);
+			SharedMemoryRegion = RegionSize > 0 ? FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, false, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, RegionSize) : nullptr;
+		}
+
+		if (SharedMemoryRegion)
+		{
+			Mailbox = (FShaderCompileWorkerMailbox*)SharedMemoryRegion->GetAddress();
+			UE_LOG(LogShaders, Log, TEXT("Receiving jobs through shared memory region %s (%lld bytes)"), *RegionName, Mailbox->PayloadCapacity);
+		}
+		else
+		{
+			UE_LOG(LogShaders, Warning, TEXT("Couldn't open shared memory region %s, receiving jobs through files only"), *RegionName);
+		}
+	}
+
+	/** Returns the next batch from the mailbox if the parent posted one. */
+	FArchive* TryOpenMailboxInput()
+	{
+		if (Mailbox && Mailbox->TrySetState(FShaderCompileWorkerMailbox::InputReady, FShaderCompileWorkerMailbox::Processing))
+		{
+			bProcessingMailboxInput = true;
+			return new FMemoryReaderView(MakeArrayView<const uint8>(Mailbox->GetPayload(), (int32)Mailbox->InputSize));
+		}
+		return nullptr;
+	}
+
+	/** Opens the next batch from the mailbox or an input file, trying multiple times if necessary. */
 	FArchive* OpenInputFile()
 	{
 		FArchive* InputFile = nullptr;
 		bool bFirstOpenTry = true;
 		while(!InputFile && !IsEngineExitRequested())
 		{
+			InputFile = TryOpenMailboxInput();
+			if (InputFile)
+			{
+				break;
+			}
+
 			// Try to open the input file that we are going to process
 			InputFile = IFileManager::Get().CreateFileReader(*InputFilePath,FILEREAD_Silent);
 
@@ -370,6 +448,9 @@ private:
 			}
 		}
 
+		uint32 ReceivedShaderFileCacheGeneration = 0;
+		InputFile << ReceivedShaderFileCacheGeneration;
+
 		// Initialize shader hash cache before reading any includes.
 		InitializeShaderHashCache();
 
@@ -418,7 +499,13 @@ private:
 
 			// Flush cache, to make sure we load the latest version of the input file.
 			// (Otherwise quick changes to a shader file can result in the wrong output.)
-			FlushShaderFileCache();
+			// The parent's generation only changes when it flushed its own cache, so batches in between keep our includes warm.
+			if (!bHasFlushedShaderFileCache || ReceivedShaderFileCacheGeneration != ShaderFileCacheGeneration)
+			{
+				FlushShaderFileCache();
+				ShaderFileCacheGeneration = ReceivedShaderFileCacheGeneration;
+				bHasFlushedShaderFileCache = true;
+			}
 
 			for (int32 BatchIndex = 0; BatchIndex < NumBatches; BatchIndex++)
 			{
@@ -542,7 +629,8 @@ private:
 		// Don't delete the input file if we are running under Incredibuild.
 		// In xml mode, we signal completion by creating a zero byte "Success" file after the output file has been fully written.
 		// In intercept mode, completion is signaled by this process terminating.
-		if (!IsUsingXGE())
+		// Batches received through the mailbox have no input file to remove.
+		if (!IsUsingXGE() && !bProcessingMailboxInput)
 		{
 			do 
 			{
@@ -583,6 +671,25 @@ private:
 		return OutputFilePtr;
 	}
 
+	/** Writes the results into the mailbox payload, returns false if they don't fit and have to go through the output file. */
+	bool WriteOutputToMailbox(TArray<FJobResult>& SingleJobResults, TArray<FPipelineJobResult>& PipelineJobResults)
+	{
+		// The input has been fully consumed at this point, so the payload can be reused for the output.
+		TArray<uint8> OutputData;
+		FMemoryWriter OutputWriter(OutputData);
+		WriteToOutputArchive(&OutputWriter, SingleJobResults, PipelineJobResults);
+
+		if (OutputData.Num() > Mailbox->PayloadCapacity)
+		{
+			return false;
+		}
+
+		FMemory::Memcpy(Mailbox->GetPayload(), OutputData.GetData(), OutputData.Num());
+		Mailbox->OutputSize = OutputData.Num();
+		Mailbox->SetState(FShaderCompileWorkerMailbox::OutputReady);
+		return true;
+	}
+
 	void WriteToOutputArchive(FArchive* OutputFilePtr, TArray<FJobResult>& SingleJobResults, TArray<FPipelineJobResult>& PipelineJobResults)
 	{
 		FArchive& OutputFile = *OutputFilePtr;
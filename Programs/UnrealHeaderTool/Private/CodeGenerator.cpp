@@ -6744,13 +6744,35 @@ ECompilationResult::Type PreparseModules(const FString& ModuleInfoPath, int32& N
 	};
 #endif
 
-	for (FManifestModule& Module : GManifest.Modules)
+	// The headers of every module are loaded and pre-parsed in a single parallel pass before any of them is processed,
+	// so that modules with only a handful of headers don't each pay for their own barrier. Everything that only depends on
+	// the header itself is computed in that pass. Creating the classes, registering the source files and resolving super
+	// classes touches global state and is done afterwards in a serial join, module by module, in manifest order.
+	struct FPreparseHeader
+	{
+		const FManifestModule* Module;
+		UPackage* Package;
+		const FString* RawFilename;
+		FPerHeaderData PerHeaderData;
+		FString FullFilename;
+		FString CleanFilename;
+		uint32 CleanFilenameHash;
+	};
+
+	struct FPreparseModule
 	{
-		if (Result != ECompilationResult::Succeeded)
-		{
-			break;
-		}
+		FManifestModule* Module;
+		UPackage* Package;
+		// Headers of folder type N are PreparseHeaders[FirstHeader[N]] up to PreparseHeaders[FirstHeader[N + 1]]
+		int32 FirstHeader[FolderType_Count + 1];
+	};
 
+	TArray<FPreparseModule> PreparseModuleList;
+	TArray<FPreparseHeader> PreparseHeaders;
+	PreparseModuleList.Reserve(GManifest.Modules.Num());
+
+	for (FManifestModule& Module : GManifest.Modules)
+	{
 		// Force regeneration of all subsequent modules, otherwise data will get corrupted.
 		Module.ForceRegeneration();
 
@@ -6809,13 +6831,11 @@ ECompilationResult::Type PreparseModules(const FString& ModuleInfoPath, int32& N
 		// Add new module or overwrite whatever we had loaded, that data is obsolete.
 		GPackageToManifestModuleMap.Add(Package, &Module);
 
-		double ThisModulePreparseTime = 0.0;
-		int32 NumHeadersPreparsed = 0;
-		FDurationTimer ThisModuleTimer(ThisModulePreparseTime);
-		ThisModuleTimer.Start();
+		FPreparseModule& PreparseModule = PreparseModuleList.AddDefaulted_GetRef();
+		PreparseModule.Module  = &Module;
+		PreparseModule.Package = Package;
 
-		// Pre-parse the headers
-		for (int32 PassIndex = 0; PassIndex < FolderType_Count && Result == ECompilationResult::Succeeded; ++PassIndex)
+		for (int32 PassIndex = 0; PassIndex < FolderType_Count; ++PassIndex)
 		{
 			EHeaderFolderTypes CurrentlyProcessing = (EHeaderFolderTypes)PassIndex;
 
@@ -6825,105 +6845,150 @@ ECompilationResult::Type PreparseModules(const FString& ModuleInfoPath, int32& N
 				(CurrentlyProcessing == PublicClassesHeaders) ? Module.PublicUObjectClassesHeaders :
 				(CurrentlyProcessing == PublicHeaders       ) ? Module.PublicUObjectHeaders        :
 				                                                Module.PrivateUObjectHeaders;
-			if (!UObjectHeaders.Num())
+
+			PreparseModule.FirstHeader[PassIndex] = PreparseHeaders.Num();
+			for (const FString& RawFilename : UObjectHeaders)
 			{
-				continue;
+				FPreparseHeader& PreparseHeader = PreparseHeaders.AddDefaulted_GetRef();
+				PreparseHeader.Module      = &Module;
+				PreparseHeader.Package     = Package;
+				PreparseHeader.RawFilename = &RawFilename;
 			}
+		}
+		PreparseModule.FirstHeader[FolderType_Count] = PreparseHeaders.Num();
+	}
 
-			NumHeadersPreparsed += UObjectHeaders.Num();
-
-			TArray<FString> HeaderFiles;
-			HeaderFiles.SetNum(UObjectHeaders.Num());
+	// Load and pre-parse the headers of all modules. The parallel pass and the serial import below are timed separately,
+	// so the log shows how much of the pre-parse is left serial.
+	double ParallelPreparseTime = 0.0;
+	{
+		FScopedDurationTimer ParallelPreparseTimer(ParallelPreparseTime);
+		SCOPE_SECONDS_COUNTER_UHT(PreparseHeaders);
+		ParallelFor(PreparseHeaders.Num(), [&](int32 Index)
+		{
+			FPreparseHeader& PreparseHeader = PreparseHeaders[Index];
+			const FString& RawFilename = *PreparseHeader.RawFilename;
 
+#if !PLATFORM_EXCEPTIONS_DISABLED
+			try
+#endif
 			{
-				SCOPE_SECONDS_COUNTER_UHT(LoadHeaderContentFromFile);
-				ParallelFor(UObjectHeaders.Num(), [&](int32 Index)
+				PreparseHeader.FullFilename = FPaths::ConvertRelativePathToFull(ModuleInfoPath, RawFilename);
+				const FString& FullFilename = PreparseHeader.FullFilename;
+
+				FString HeaderFile;
+				if (!FFileHelper::LoadFileToString(HeaderFile, *FullFilename))
 				{
-					const FString& RawFilename = UObjectHeaders[Index];
+					FError::Throwf(TEXT("UnrealHeaderTool was unable to load source file '%s'"), *FullFilename);
+				}
 
-#if !PLATFORM_EXCEPTIONS_DISABLED
-					try
-#endif
+				PerformSimplifiedClassParse(PreparseHeader.Package, *RawFilename, *HeaderFile, PreparseHeader.PerHeaderData);
+
+				PreparseHeader.CleanFilename     = FPaths::GetCleanFilename(RawFilename);
+				PreparseHeader.CleanFilenameHash = GetTypeHash(PreparseHeader.CleanFilename);
+
+				// Save metadata for the class path, both for it's include path and relative to the module base directory
+				const FManifestModule& Module = *PreparseHeader.Module;
+				if (FullFilename.StartsWith(Module.BaseDirectory))
+				{
+					FUnrealSourceFile* UnrealSourceFilePtr = PreparseHeader.PerHeaderData.UnrealSourceFile.Get();
+
+					// Get the path relative to the module directory
+					const TCHAR* ModuleRelativePath = *FullFilename + Module.BaseDirectory.Len();
+
+					UnrealSourceFilePtr->SetModuleRelativePath(ModuleRelativePath);
+
+					// Calculate the include path
+					const TCHAR* IncludePath = ModuleRelativePath;
+
+					// Walk over the first potential slash
+					if (*IncludePath == TEXT('/'))
 					{
-						const FString FullFilename = FPaths::ConvertRelativePathToFull(ModuleInfoPath, RawFilename);
+						IncludePath++;
+					}
 
-						if (!FFileHelper::LoadFileToString(HeaderFiles[Index], *FullFilename))
-						{
-							FError::Throwf(TEXT("UnrealHeaderTool was unable to load source file '%s'"), *FullFilename);
-						}
+					// Does this module path start with a known include path location? If so, we can cut that part out of the include path
+					static const TCHAR PublicFolderName[]  = TEXT("Public/");
+					static const TCHAR PrivateFolderName[] = TEXT("Private/");
+					static const TCHAR ClassesFolderName[] = TEXT("Classes/");
+					if (FCString::Strnicmp(IncludePath, PublicFolderName, UE_ARRAY_COUNT(PublicFolderName) - 1) == 0)
+					{
+						IncludePath += (UE_ARRAY_COUNT(PublicFolderName) - 1);
 					}
-#if !PLATFORM_EXCEPTIONS_DISABLED
-					catch (TCHAR* ErrorMsg)
+					else if (FCString::Strnicmp(IncludePath, PrivateFolderName, UE_ARRAY_COUNT(PrivateFolderName) - 1) == 0)
 					{
-						FString AbsFilename = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*RawFilename);
-						LogException(MoveTemp(AbsFilename), 1, ErrorMsg);
-					}				
-#endif
-				});
-			}
+						IncludePath += (UE_ARRAY_COUNT(PrivateFolderName) - 1);
+					}
+					else if (FCString::Strnicmp(IncludePath, ClassesFolderName, UE_ARRAY_COUNT(ClassesFolderName) - 1) == 0)
+					{
+						IncludePath += (UE_ARRAY_COUNT(ClassesFolderName) - 1);
+					}
 
+					// Add the include path
+					if (*IncludePath != 0)
+					{
+						UnrealSourceFilePtr->SetIncludePath(MoveTemp(IncludePath));
+					}
+				}
+			}
 #if !PLATFORM_EXCEPTIONS_DISABLED
-			FTaskGraphInterface::Get().WaitUntilTasksComplete(ExceptionTasks);
-#endif
-
-			if (Result != ECompilationResult::Succeeded)
+			catch (const FFileLineException& Ex)
 			{
-				continue;
+				FString AbsFilename = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*Ex.Filename);
+				LogException(MoveTemp(AbsFilename), Ex.Line, Ex.Message);
 			}
-
-			TArray<FPerHeaderData> PerHeaderData;
-			PerHeaderData.SetNum(UObjectHeaders.Num());
-
-			ParallelFor(UObjectHeaders.Num(), [&](int32 Index)
+			catch (TCHAR* ErrorMsg)
 			{
-				const FString& RawFilename = UObjectHeaders[Index];
-
-#if !PLATFORM_EXCEPTIONS_DISABLED
-				try
-#endif
-				{
-					PerformSimplifiedClassParse(Package, *RawFilename, *HeaderFiles[Index], PerHeaderData[Index]);
-				}
-#if !PLATFORM_EXCEPTIONS_DISABLED
-				catch (const FFileLineException& Ex)
-				{
-					FString AbsFilename = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*Ex.Filename);
-					LogException(MoveTemp(AbsFilename), Ex.Line, Ex.Message);
-				}
-				catch (TCHAR* ErrorMsg)
-				{
-					FString AbsFilename = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*RawFilename);
-					LogException(MoveTemp(AbsFilename), 1, ErrorMsg);
-				}
+				FString AbsFilename = IFileManager::Get().ConvertToAbsolutePathForExternalAppForRead(*RawFilename);
+				LogException(MoveTemp(AbsFilename), 1, ErrorMsg);
+			}
 #endif
-			});
+		});
+	}
 
 #if !PLATFORM_EXCEPTIONS_DISABLED
-			FTaskGraphInterface::Get().WaitUntilTasksComplete(ExceptionTasks);
+	FTaskGraphInterface::Get().WaitUntilTasksComplete(ExceptionTasks);
 #endif
 
-			if (Result != ECompilationResult::Succeeded)
-			{
-				continue;
-			}
+	UE_LOG(LogCompile, Log, TEXT("Loaded and preparsed %i header(s) of %i module(s) in parallel in %.2f secs."), PreparseHeaders.Num(), PreparseModuleList.Num(), ParallelPreparseTime);
+
+	double TotalImportTime = 0.0;
+	for (const FPreparseModule& PreparseModule : PreparseModuleList)
+	{
+		if (Result != ECompilationResult::Succeeded)
+		{
+			break;
+		}
 
-			for (int32 Index = 0; Index < UObjectHeaders.Num(); ++Index)
+		const FManifestModule& Module = *PreparseModule.Module;
+		UPackage* Package = PreparseModule.Package;
+
+		double ThisModulePreparseTime = 0.0;
+		int32 NumHeadersPreparsed = PreparseModule.FirstHeader[FolderType_Count] - PreparseModule.FirstHeader[0];
+		FDurationTimer ThisModuleTimer(ThisModulePreparseTime);
+		ThisModuleTimer.Start();
+
+		// Import the pre-parsed headers
+		for (int32 PassIndex = 0; PassIndex < FolderType_Count && Result == ECompilationResult::Succeeded; ++PassIndex)
+		{
+			EHeaderFolderTypes CurrentlyProcessing = (EHeaderFolderTypes)PassIndex;
+
+			for (int32 Index = PreparseModule.FirstHeader[PassIndex]; Index < PreparseModule.FirstHeader[PassIndex + 1]; ++Index)
 			{
-				const FString& RawFilename = UObjectHeaders[Index];
+				FPreparseHeader& PreparseHeader = PreparseHeaders[Index];
+				const FString& RawFilename = *PreparseHeader.RawFilename;
 
 #if !PLATFORM_EXCEPTIONS_DISABLED
 				try
 #endif
 				{
 					// Import class.
-					const FString FullFilename = FPaths::ConvertRelativePathToFull(ModuleInfoPath, RawFilename);
+					const FString& FullFilename = PreparseHeader.FullFilename;
 
-					ProcessInitialClassParse(PerHeaderData[Index]);
-					TSharedRef<FUnrealSourceFile> UnrealSourceFile = PerHeaderData[Index].UnrealSourceFile.ToSharedRef();
+					ProcessInitialClassParse(PreparseHeader.PerHeaderData);
+					TSharedRef<FUnrealSourceFile> UnrealSourceFile = PreparseHeader.PerHeaderData.UnrealSourceFile.ToSharedRef();
 					FUnrealSourceFile* UnrealSourceFilePtr = &UnrealSourceFile.Get();
-					FString CleanFilename     = FPaths::GetCleanFilename(RawFilename);
-					uint32  CleanFilenameHash = GetTypeHash(CleanFilename);
-					if (const TSharedRef<FUnrealSourceFile>* ExistingSourceFile = GUnrealSourceFilesMap.FindByHash(CleanFilenameHash, CleanFilename))
+					if (const TSharedRef<FUnrealSourceFile>* ExistingSourceFile = GUnrealSourceFilesMap.FindByHash(PreparseHeader.CleanFilenameHash, PreparseHeader.CleanFilename))
 					{
 						FString NormalizedFullFilename     = FullFilename;
 						FString NormalizedExistingFilename = (*ExistingSourceFile)->GetFilename();
@@ -6936,53 +7001,12 @@ ECompilationResult::Type PreparseModules(const FString& ModuleInfoPath, int32& N
 							FError::Throwf(TEXT("Duplicate leaf header name found: %s (original: %s)"), *NormalizedFullFilename, *NormalizedExistingFilename);
 						}
 					}
-					GUnrealSourceFilesMap.AddByHash(CleanFilenameHash, MoveTemp(CleanFilename), UnrealSourceFile);
+					GUnrealSourceFilesMap.AddByHash(PreparseHeader.CleanFilenameHash, MoveTemp(PreparseHeader.CleanFilename), UnrealSourceFile);
 
 					if (CurrentlyProcessing == PublicClassesHeaders)
 					{
 						GPublicSourceFileSet.Add(UnrealSourceFilePtr);
 					}
-
-					// Save metadata for the class path, both for it's include path and relative to the module base directory
-					if (FullFilename.StartsWith(Module.BaseDirectory))
-					{
-						// Get the path relative to the module directory
-						const TCHAR* ModuleRelativePath = *FullFilename + Module.BaseDirectory.Len();
-
-						UnrealSourceFilePtr->SetModuleRelativePath(ModuleRelativePath);
-
-						// Calculate the include path
-						const TCHAR* IncludePath = ModuleRelativePath;
-
-						// Walk over the first potential slash
-						if (*IncludePath == TEXT('/'))
-						{
-							IncludePath++;
-						}
-
-						// Does this module path start with a known include path location? If so, we can cut that part out of the include path
-						static const TCHAR PublicFolderName[]  = TEXT("Public/");
-						static const TCHAR PrivateFolderName[] = TEXT("Private/");
-						static const TCHAR ClassesFolderName[] = TEXT("Classes/");
-						if (FCString::Strnicmp(IncludePath, PublicFolderName, UE_ARRAY_COUNT(PublicFolderName) - 1) == 0)
-						{
-							IncludePath += (UE_ARRAY_COUNT(PublicFolderName) - 1);
-						}
-						else if (FCString::Strnicmp(IncludePath, PrivateFolderName, UE_ARRAY_COUNT(PrivateFolderName) - 1) == 0)
-						{
-							IncludePath += (UE_ARRAY_COUNT(PrivateFolderName) - 1);
-						}
-						else if (FCString::Strnicmp(IncludePath, ClassesFolderName, UE_ARRAY_COUNT(ClassesFolderName) - 1) == 0)
-						{
-							IncludePath += (UE_ARRAY_COUNT(ClassesFolderName) - 1);
-						}
-
-						// Add the include path
-						if (*IncludePath != 0)
-						{
-							UnrealSourceFilePtr->SetIncludePath(MoveTemp(IncludePath));
-						}
-					}
 				}
 #if !PLATFORM_EXCEPTIONS_DISABLED
 				catch (const FFileLineException& Ex)
@@ -7028,9 +7052,12 @@ ECompilationResult::Type PreparseModules(const FString& ModuleInfoPath, int32& N
 #endif
 
 		ThisModuleTimer.Stop();
-		UE_LOG(LogCompile, Log, TEXT("Preparsed module %s containing %i files(s) in %.2f secs."), *Module.LongPackageName, NumHeadersPreparsed, ThisModulePreparseTime);
+		TotalImportTime += ThisModulePreparseTime;
+		UE_LOG(LogCompile, Log, TEXT("Imported the preparsed headers of module %s containing %i files(s) in %.2f secs."), *Module.LongPackageName, NumHeadersPreparsed, ThisModulePreparseTime);
 	}
 
+	UE_LOG(LogCompile, Log, TEXT("Imported the preparsed headers of %i module(s) serially in %.2f secs."), PreparseModuleList.Num(), TotalImportTime);
+
 	return Result;
 }
 
@@ -210,8 +210,27 @@ namespace Audio
 		CheckAudioRenderingThread();
 	}
 
+	// Device the calling task thread is rendering for, see FAudioRenderingTaskScope
+	static thread_local const FMixerDevice* GAudioRenderingTaskMixerDevice = nullptr;
+
+	FMixerDevice::FAudioRenderingTaskScope::FAudioRenderingTaskScope(const FMixerDevice* InMixerDevice)
+		: PreviousMixerDevice(GAudioRenderingTaskMixerDevice)
+	{
+		GAudioRenderingTaskMixerDevice = InMixerDevice;
+	}
+
+	FMixerDevice::FAudioRenderingTaskScope::~FAudioRenderingTaskScope()
+	{
+		GAudioRenderingTaskMixerDevice = PreviousMixerDevice;
+	}
+
 	void FMixerDevice::CheckAudioRenderingThread() const
 	{
+		if (GAudioRenderingTaskMixerDevice == this)
+		{
+			return;
+		}
+
 		if (AudioPlatformThreadId == INDEX_NONE)
 		{
 			AudioPlatformThreadId = FPlatformTLS::GetCurrentThreadId();
@@ -412,8 +431,8 @@ namespace Audio
 				FSourceManagerInitParams SourceManagerInitParams;
 				SourceManagerInitParams.NumSources = GetMaxSources();
 
-				// TODO: Migrate this to project settings properly
-				SourceManagerInitParams.NumSourceWorkers = 4;
+				// Use the platform's worker count if it sets one, otherwise give each worker thread of the machine a share of the sources
+				SourceManagerInitParams.NumSourceWorkers = PlatformSettings.NumSourceWorkers > 0 ? PlatformSettings.NumSourceWorkers : FMath::Max(FPlatformMisc::NumberOfWorkerThreadsToSpawn(), 1);
 
 				SourceManager->Init(SourceManagerInitParams);
 
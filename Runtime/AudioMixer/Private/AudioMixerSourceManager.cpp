@@ -25,6 +25,14 @@ FAutoConsoleVariableRef CVarDisableParallelSourceProcessing(
 	TEXT("0: Not Disabled, 1: Disabled"),
 	ECVF_Default);
 
+static int32 MinSourcesPerWorkerCvar = 8;
+FAutoConsoleVariableRef CVarMinSourcesPerWorker(
+	TEXT("au.MinSourcesPerWorker"),
+	MinSourcesPerWorkerCvar,
+	TEXT("The minimum number of sources each async source worker processes, so that small source counts don't pay for more tasks than they need.\n")
+	TEXT("Takes effect when the source manager is initialized."),
+	ECVF_Default);
+
 static int32 DisableFilteringCvar = 0;
 FAutoConsoleVariableRef CVarDisableFiltering(
 	TEXT("au.DisableFiltering"),
@@ -195,6 +203,7 @@ namespace Audio
 		AUDIO_MIXER_CHECK(MixerDevice->GetSampleRate() > 0);
 
 		NumTotalSources = InitParams.NumSources;
+		NumSourceWorkers = InitParams.NumSourceWorkers;
 
 		NumOutputFrames = MixerDevice->PlatformSettings.CallbackBufferFrameSize;
 		NumOutputSamples = NumOutputFrames * MixerDevice->GetNumDeviceChannels();
@@ -309,7 +318,7 @@ namespace Audio
 		SourceWorkers.Reset();
 		if (NumSourceWorkers > 0)
 		{
-			const int32 NumSourcesPerWorker = FMath::Max(NumTotalSources / NumSourceWorkers, 1);
+			const int32 NumSourcesPerWorker = FMath::Max(FMath::DivideAndRoundUp(NumTotalSources, NumSourceWorkers), FMath::Max(MinSourcesPerWorkerCvar, 1));
 			int32 StartId = 0;
 			int32 EndId = 0;
 			while (EndId < NumTotalSources)
@@ -3,6 +3,7 @@
 #include "AudioMixerSubmix.h"
 
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "AudioMixerDevice.h"
 #include "AudioMixerSourceVoice.h"
 #include "AudioThread.h"
@@ -32,6 +33,14 @@ FAutoConsoleVariableRef CVarBypassAllSubmixEffects(
 	TEXT("1: Submix Effects are disabled."),
 	ECVF_Default);
 
+static int32 ParallelSubmixChildrenCVar = 0;
+FAutoConsoleVariableRef CVarParallelSubmixChildren(
+	TEXT("au.ParallelSubmixChildren"),
+	ParallelSubmixChildrenCVar,
+	TEXT("When set to 1, the child submixes of a submix are processed in parallel on task threads and mixed together afterwards.\n")
+	TEXT("0: Disabled, 1: Enabled"),
+	ECVF_Default);
+
 // Define profiling categories for submixes. 
 DEFINE_STAT(STAT_AudioMixerSubmixes);
 DEFINE_STAT(STAT_AudioMixerEndpointSubmixes);
@@ -1055,6 +1064,7 @@ namespace Audio
 
 			// First loop this submix's child submixes mixing in their output into this submix's dry/wet buffers.
 			TArray<uint32> ToRemove;
+			TArray<TSharedPtr<Audio::FMixerSubmix, ESPMode::ThreadSafe>, TInlineAllocator<8>> ValidChildSubmixes;
 			for (auto& ChildSubmixEntry : ChildSubmixes)
 			{
 				TSharedPtr<Audio::FMixerSubmix, ESPMode::ThreadSafe> ChildSubmix = ChildSubmixEntry.Value.SubmixPtr.Pin();
@@ -1063,7 +1073,7 @@ namespace Audio
 				// forcibly deleted in editor, so submix validity (in addition to pointer validity) is checked before processing
 				if (ChildSubmix.IsValid() && ChildSubmix->IsValid())
 				{
-					ChildSubmix->ProcessAudio(InputBuffer);
+					ValidChildSubmixes.Add(MoveTemp(ChildSubmix));
 				}
 				else
 				{
@@ -1071,6 +1081,39 @@ namespace Audio
 				}
 			}
 
+			if (ParallelSubmixChildrenCVar && ValidChildSubmixes.Num() > 1)
+			{
+				// Sibling submixes don't share state, but they would all sum into InputBuffer, so each renders into its own buffer
+				// and the buffers are mixed in afterwards in the same order the serial path uses.
+				if (ChildOutputBuffers.Num() < ValidChildSubmixes.Num())
+				{
+					ChildOutputBuffers.SetNum(ValidChildSubmixes.Num());
+				}
+
+				ParallelFor(ValidChildSubmixes.Num(), [this, &ValidChildSubmixes](int32 ChildIndex)
+				{
+					AlignedFloatBuffer& ChildOutputBuffer = ChildOutputBuffers[ChildIndex];
+					ChildOutputBuffer.Reset(NumSamples);
+					ChildOutputBuffer.AddZeroed(NumSamples);
+
+					// Covers the whole subtree of the child, including the commands it pumps
+					FMixerDevice::FAudioRenderingTaskScope TaskScope(MixerDevice);
+					ValidChildSubmixes[ChildIndex]->ProcessAudio(ChildOutputBuffer);
+				});
+
+				for (int32 ChildIndex = 0; ChildIndex < ValidChildSubmixes.Num(); ++ChildIndex)
+				{
+					MixInBufferFast(ChildOutputBuffers[ChildIndex], InputBuffer);
+				}
+			}
+			else
+			{
+				for (TSharedPtr<Audio::FMixerSubmix, ESPMode::ThreadSafe>& ChildSubmix : ValidChildSubmixes)
+				{
+					ChildSubmix->ProcessAudio(InputBuffer);
+				}
+			}
+
 			for (uint32 Key : ToRemove)
 			{
 				ChildSubmixes.Remove(Key);
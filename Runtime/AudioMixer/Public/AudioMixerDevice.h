@@ -196,6 +196,21 @@ namespace Audio
 		void CheckAudioRenderingThread() const;
 		bool IsAudioRenderingThread() const;
 
+		/**
+		 * Lets the calling thread pass CheckAudioRenderingThread while the scope lives, for work the audio rendering thread
+		 * hands to task threads and waits for, e.g. child submixes processed in parallel. IsAudioRenderingThread stays false,
+		 * so anything deciding between running directly and queuing for the rendering thread still queues.
+		 */
+		class FAudioRenderingTaskScope
+		{
+		public:
+			explicit FAudioRenderingTaskScope(const FMixerDevice* InMixerDevice);
+			~FAudioRenderingTaskScope();
+
+		private:
+			const FMixerDevice* PreviousMixerDevice;
+		};
+
 		// Public Functions
 		FMixerSourceVoice* GetMixerSourceVoice();
 		void ReleaseMixerSourceVoice(FMixerSourceVoice* InSourceVoice);
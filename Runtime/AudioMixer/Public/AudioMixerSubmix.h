@@ -376,6 +376,9 @@ namespace Audio
 		AlignedFloatBuffer DownmixedBuffer;
 		AlignedFloatBuffer SourceInputBuffer;
 
+		// Output of each child submix when children are processed in parallel (au.ParallelSubmixChildren)
+		TArray<AlignedFloatBuffer> ChildOutputBuffers;
+
 		int32 NumChannels;
 		int32 NumSamples;
 
@@ -5,6 +5,7 @@
 #include "Logging/LogMacros.h"
 #include "Misc/ScopeLock.h"
 #include "CoreGlobals.h"
+#include "ProfilingDebugging/MiscTrace.h"
 
 namespace LowLevelTasks
 {
@@ -180,6 +181,22 @@ namespace LowLevelTasks
 		return ActiveTask;
 	}
 
+	static std::atomic_uint NumMissedDeadlines { 0 };
+
+	void Tasks_Impl::ReportMissedDeadline(const TCHAR* DebugName, uint64 DeadlineCycles, uint64 CompletedCycles)
+	{
+		NumMissedDeadlines.fetch_add(1, std::memory_order_relaxed);
+
+		const double MissedByMs = FPlatformTime::ToMilliseconds64(CompletedCycles - DeadlineCycles);
+		TRACE_BOOKMARK(TEXT("Task %s missed its deadline by %.3fms"), DebugName ? DebugName : TEXT("Unnamed"), MissedByMs);
+		UE_LOG(LowLevelTasks, Verbose, TEXT("Task %s missed its deadline by %.3fms"), DebugName ? DebugName : TEXT("Unnamed"), MissedByMs);
+	}
+
+	uint32 FScheduler::GetNumMissedDeadlines()
+	{
+		return NumMissedDeadlines.load(std::memory_order_relaxed);
+	}
+
 	bool FScheduler::IsWorkerThread() const
 	{
 		return WorkerType != EWorkerType::None && ActiveScheduler == this;
@@ -250,14 +267,16 @@ namespace LowLevelTasks
 		FQueueRegistry::FOutOfWork OutOfWork = QueueRegistry.GetOutOfWorkScope(bPermitBackgroundWork);
 		while (true)
 		{
-			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueUrgent, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
 			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueGlobal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
 			{		
 				Drowsing = false;
 				WaitCount = 0;
 			}
 
-			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueUrgent, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
 			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueSteal, false>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
 			{
 				Drowsing = false;
@@ -308,7 +327,8 @@ namespace LowLevelTasks
 		FQueueRegistry::FOutOfWork OutOfWork = QueueRegistry.GetOutOfWorkScope(bIsBackgroundWorker);
 		while (true)
 		{
-			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueUrgent, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
 			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueGlobal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
 			{
 				if (Conditional())
@@ -318,7 +338,8 @@ namespace LowLevelTasks
 				WaitCount = 0;
 			}
 
-			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			while(TryExecuteTaskFrom<&FLocalQueueType::DequeueUrgent, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
+			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueLocal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork)
 			   || TryExecuteTaskFrom<&FLocalQueueType::DequeueSteal, true>(WorkerLocalQueue, OutOfWork, bPermitBackgroundWork))
 			{
 				if (Conditional())
@@ -533,6 +533,34 @@ namespace Tasks2Tests
 			}
 		}
 
+		//deadlines
+		{
+			uint32 TestValue = 1337;
+			const uint32 MissedDeadlinesBefore = FScheduler::GetNumMissedDeadlines();
+
+			FTask Task;
+			Task.InitWithDeadline(TEXT("Deadline Test"), ETaskPriority::BackgroundNormal, FPlatformTime::Cycles64() + uint64(60.0 / FPlatformTime::GetSecondsPerCycle64()), [&TestValue]()
+			{
+				TestValue = 42;
+			});
+			verify(Task.GetPriority() == ETaskPriority::BackgroundHigh);
+			TryLaunch(Task);
+			BusyWaitForTask(Task);
+			verify(TestValue == 42);
+
+			FTask LateTask;
+			LateTask.InitWithDeadline(TEXT("Missed Deadline Test"), ETaskPriority::Normal, FPlatformTime::Cycles64(), [&TestValue]()
+			{
+				FPlatformProcess::Sleep(0.001f);
+				TestValue = 1337;
+			});
+			verify(LateTask.GetPriority() == ETaskPriority::High);
+			TryLaunch(LateTask);
+			BusyWaitForTask(LateTask);
+			verify(TestValue == 1337);
+			verify(FScheduler::GetNumMissedDeadlines() > MissedDeadlinesBefore);
+		}
+
 		//example Awaitable Tasks
 		{
 			uint32 TestValue = 1337;
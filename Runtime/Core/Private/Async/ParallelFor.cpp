@@ -1,10 +1,149 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/OutputDevice.h"
 
 CORE_API int32 GParallelForBackgroundYieldingTimeoutMs = 8;
 static FAutoConsoleVariableRef CVarParallelForBackgroundYieldingTimeout(
 	TEXT("Async.ParallelFor.YieldingTimeout"),
 	GParallelForBackgroundYieldingTimeoutMs,
 	TEXT("The timeout (in ms) when background priority parallel for task will yield execution to give higher priority tasks the chance to run.")
-);
\ No newline at end of file
+);
+
+CORE_API float GParallelForAdaptiveBatchMicroseconds = 50.0f;
+static FAutoConsoleVariableRef CVarParallelForAdaptiveBatchMicroseconds(
+	TEXT("Async.ParallelFor.AdaptiveBatchMicroseconds"),
+	GParallelForAdaptiveBatchMicroseconds,
+	TEXT("How long (in us) a batch of an adaptive parallel for should take, based on the cost per item measured by previous calls of the same call site.\n")
+	TEXT("Loops cheaper than two batches run on the calling thread only.")
+);
+
+/** Head of the list of every call site constructed so far, call sites are never destroyed before exit */
+static std::atomic<FParallelForCallSite*> GFirstParallelForCallSite(nullptr);
+
+FParallelForCallSite::FParallelForCallSite(const TCHAR* InName)
+	: Name(InName)
+	, NextCallSite(nullptr)
+	, CyclesPerItem(0.0f)
+	, NumCalls(0)
+	, NumParallelCalls(0)
+	, NumItems(0)
+	, NumBatches(0)
+	, NumThreads(0)
+	, BodyCycles(0)
+	, WallCycles(0)
+{
+	// function local statics can be constructed on any thread
+	NextCallSite = GFirstParallelForCallSite.load(std::memory_order_relaxed);
+	while (!GFirstParallelForCallSite.compare_exchange_weak(NextCallSite, this, std::memory_order_release, std::memory_order_relaxed))
+	{
+	}
+}
+
+void FParallelForCallSite::RecordCall(int32 InNumItems, int32 InNumBatches, int32 InNumThreads, uint64 InBodyCycles, uint64 InWallCycles)
+{
+	NumCalls.fetch_add(1, std::memory_order_relaxed);
+	NumParallelCalls.fetch_add(InNumThreads > 1 ? 1 : 0, std::memory_order_relaxed);
+	NumItems.fetch_add(InNumItems, std::memory_order_relaxed);
+	NumBatches.fetch_add(InNumBatches, std::memory_order_relaxed);
+	NumThreads.fetch_add(InNumThreads, std::memory_order_relaxed);
+	BodyCycles.fetch_add(InBodyCycles, std::memory_order_relaxed);
+	WallCycles.fetch_add(InWallCycles, std::memory_order_relaxed);
+
+	if (InNumItems > 0)
+	{
+		// Smooth the cost so that one call that got preempted does not throw off the next one. Concurrent calls of the same
+		// call site may lose an update, which does not matter for an estimate.
+		const float CallCyclesPerItem = float(InBodyCycles) / float(InNumItems);
+		const float OldCyclesPerItem = CyclesPerItem.load(std::memory_order_relaxed);
+		CyclesPerItem.store(OldCyclesPerItem > 0.0f ? FMath::Lerp(OldCyclesPerItem, CallCyclesPerItem, 0.25f) : CallCyclesPerItem, std::memory_order_relaxed);
+	}
+}
+
+void FParallelForCallSite::DumpStats(FOutputDevice& Ar)
+{
+	TArray<const FParallelForCallSite*> CallSites;
+	for (const FParallelForCallSite* CallSite = GFirstParallelForCallSite.load(std::memory_order_acquire); CallSite; CallSite = CallSite->NextCallSite)
+	{
+		if (CallSite->NumCalls.load(std::memory_order_relaxed) > 0)
+		{
+			CallSites.Add(CallSite);
+		}
+	}
+	CallSites.Sort([](const FParallelForCallSite& A, const FParallelForCallSite& B)
+	{
+		return A.WallCycles.load(std::memory_order_relaxed) > B.WallCycles.load(std::memory_order_relaxed);
+	});
+
+	const double MsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+
+	// Speedup is the time spent in the body over the time the callers waited. Below 1 the loop would have been faster on the
+	// calling thread alone, and well below the number of threads the batches are too small or too unbalanced.
+	Ar.Logf(TEXT("%-48s %10s %9s %12s %10s %8s %12s %12s %8s"), TEXT("ParallelFor call site"), TEXT("Calls"), TEXT("Parallel"), TEXT("Items/call"), TEXT("Batch"), TEXT("Threads"), TEXT("ns/item"), TEXT("ms total"), TEXT("Speedup"));
+	for (const FParallelForCallSite* CallSite : CallSites)
+	{
+		const uint64 Calls = CallSite->NumCalls.load(std::memory_order_relaxed);
+		const uint64 ParallelCalls = CallSite->NumParallelCalls.load(std::memory_order_relaxed);
+		const uint64 Items = CallSite->NumItems.load(std::memory_order_relaxed);
+		const uint64 Batches = CallSite->NumBatches.load(std::memory_order_relaxed);
+		const uint64 Threads = CallSite->NumThreads.load(std::memory_order_relaxed);
+		const uint64 Body = CallSite->BodyCycles.load(std::memory_order_relaxed);
+		const uint64 Wall = CallSite->WallCycles.load(std::memory_order_relaxed);
+		const double Speedup = Wall ? double(Body) / double(Wall) : 0.0;
+
+		Ar.Logf(TEXT("%-48s %10llu %8.1f%% %12.1f %10.1f %8.1f %12.1f %12.3f %7.2fx%s"),
+			CallSite->Name,
+			Calls,
+			100.0 * double(ParallelCalls) / double(Calls),
+			double(Items) / double(Calls),
+			Batches ? double(Items) / double(Batches) : 0.0,
+			double(Threads) / double(Calls),
+			Items ? double(Body) * MsPerCycle * 1000000.0 / double(Items) : 0.0,
+			double(Wall) * MsPerCycle,
+			Speedup,
+			(ParallelCalls && Speedup < 1.0) ? TEXT(" <- net loss") : TEXT(""));
+	}
+}
+
+void FParallelForCallSite::ResetStats()
+{
+	for (FParallelForCallSite* CallSite = GFirstParallelForCallSite.load(std::memory_order_acquire); CallSite; CallSite = CallSite->NextCallSite)
+	{
+		CallSite->NumCalls.store(0, std::memory_order_relaxed);
+		CallSite->NumParallelCalls.store(0, std::memory_order_relaxed);
+		CallSite->NumItems.store(0, std::memory_order_relaxed);
+		CallSite->NumBatches.store(0, std::memory_order_relaxed);
+		CallSite->NumThreads.store(0, std::memory_order_relaxed);
+		CallSite->BodyCycles.store(0, std::memory_order_relaxed);
+		CallSite->WallCycles.store(0, std::memory_order_relaxed);
+	}
+}
+
+static FAutoConsoleCommandWithOutputDevice GParallelForDumpStatsCmd(
+	TEXT("ParallelFor.DumpStats"),
+	TEXT("Lists the timings of every ParallelFor call site that keeps statistics, most expensive first."),
+	FConsoleCommandWithOutputDeviceDelegate::CreateStatic(&FParallelForCallSite::DumpStats)
+);
+
+static FAutoConsoleCommand GParallelForResetStatsCmd(
+	TEXT("ParallelFor.ResetStats"),
+	TEXT("Clears the timings of every ParallelFor call site that keeps statistics."),
+	FConsoleCommandDelegate::CreateStatic(&FParallelForCallSite::ResetStats)
+);
+
+namespace ParallelForImpl
+{
+	int32 GetAdaptiveBatchSize(const FParallelForCallSite& CallSite, int32 Num)
+	{
+		const float CyclesPerItem = CallSite.GetCyclesPerItem();
+		if (CyclesPerItem <= 0.0f || Num <= 0)
+		{
+			return 0;
+		}
+
+		const double TargetBatchCycles = double(FMath::Max(GParallelForAdaptiveBatchMicroseconds, 1.0f)) / (FPlatformTime::GetSecondsPerCycle64() * 1000000.0);
+		const double BatchSize = FMath::CeilToDouble(TargetBatchCycles / double(CyclesPerItem));
+		return int32(FMath::Clamp(BatchSize, 1.0, double(Num)));
+	}
+}
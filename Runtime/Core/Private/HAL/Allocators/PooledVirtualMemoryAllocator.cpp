@@ -32,13 +32,29 @@ FPooledVirtualMemoryAllocator::FPooledVirtualMemoryAllocator()
 	// Note: how close depends on DecideOnTheNextPoolSize behavior, which will first grow it
 	const int32 kInitialPoolSize = 8 * 1024 * 1024;
 
-	for (int32 IdxClass = 0; IdxClass < Limits::NumAllocationSizeClasses; ++IdxClass)
+	NumMemoryNodes = FMath::Clamp(FPlatformMemory::GetNumPooledMemoryNodes(), 1, (int32)Limits::MaxMemoryNodes);
+
+	for (int32 IdxNode = 0; IdxNode < Limits::MaxMemoryNodes; ++IdxNode)
 	{
-		const int32 SizeOfAllocationInPool = (IdxClass + 1) * 65536;
-		NextPoolSize[IdxClass] = FMath::Max(2, kInitialPoolSize / SizeOfAllocationInPool);
+		for (int32 IdxClass = 0; IdxClass < Limits::NumAllocationSizeClasses; ++IdxClass)
+		{
+			const int32 SizeOfAllocationInPool = (IdxClass + 1) * 65536;
+			NextPoolSize[IdxNode][IdxClass] = FMath::Max(2, kInitialPoolSize / SizeOfAllocationInPool);
+
+			ClassesListHeads[IdxNode][IdxClass] = nullptr;
+		}
+	}
+}
 
-		ClassesListHeads[IdxClass] = nullptr;
+int32 FPooledVirtualMemoryAllocator::GetCurrentMemoryNode() const
+{
+	if (NumMemoryNodes == 1)
+	{
+		return 0;
 	}
+
+	// machines with more nodes than we keep apart share the pools of a node
+	return FPlatformMemory::GetCurrentPooledMemoryNode() % NumMemoryNodes;
 }
 
 void* FPooledVirtualMemoryAllocator::Allocate(SIZE_T Size, uint32 /*AllocationHint = 0*/, FCriticalSection* /*Mutex = nullptr*/)
@@ -53,12 +69,13 @@ void* FPooledVirtualMemoryAllocator::Allocate(SIZE_T Size, uint32 /*AllocationHi
 	else
 	{
 		int32 SizeClass = GetAllocationSizeClass(Size);
+		int32 MemoryNode = GetCurrentMemoryNode();
 
 		// [RCL] TODO: find a way to convert to lock-free
 		FScopeLock Lock(&ClassesLocks[SizeClass]);
 
-		// follow the list until we can allocate
-		for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[SizeClass]; BaseDesc; BaseDesc = BaseDesc->Next)
+		// follow the list of our node until we can allocate
+		for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[MemoryNode][SizeClass]; BaseDesc; BaseDesc = BaseDesc->Next)
 		{
 			// using reference to avoid static_cast cost of checking the pointer with null, we know it's not null
 			FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*BaseDesc);
@@ -71,10 +88,10 @@ void* FPooledVirtualMemoryAllocator::Allocate(SIZE_T Size, uint32 /*AllocationHi
 			}
 		}
 
-		DecideOnTheNextPoolSize(SizeClass, true);
+		DecideOnTheNextPoolSize(MemoryNode, SizeClass, true);
 
 		// we exhausted existing pools, allocate a new one
-		FPoolDescriptorBase* NewPool = CreatePool(CalculateAllocationSizeFromClass(SizeClass), NextPoolSize[SizeClass]);
+		FPoolDescriptorBase* NewPool = CreatePool(CalculateAllocationSizeFromClass(SizeClass), NextPoolSize[MemoryNode][SizeClass], MemoryNode);
 		if (UNLIKELY(NewPool == nullptr))
 		{
 			FPlatformMemory::OnOutOfMemory(Size, 65536);
@@ -85,8 +102,8 @@ void* FPooledVirtualMemoryAllocator::Allocate(SIZE_T Size, uint32 /*AllocationHi
 		// add to the list, making it the new head
 		// the reasoning here is that each new pool will have a larger size,
 		// so it's better to have them sorted by size descending
-		NewPool->Next = ClassesListHeads[SizeClass];
-		ClassesListHeads[SizeClass] = NewPool;
+		NewPool->Next = ClassesListHeads[MemoryNode][SizeClass];
+		ClassesListHeads[MemoryNode][SizeClass] = NewPool;
 
 		FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*NewPool);
 		// should not fail at this point
@@ -113,58 +130,65 @@ void FPooledVirtualMemoryAllocator::Free(void* Ptr, SIZE_T Size, FCriticalSectio
 		// [RCL] TODO: find a way to convert to lock-free
 		FScopeLock Lock(&ClassesLocks[SizeClass]);
 
-		// follow the list until we can find the pool it came from
-		FPoolDescriptorBase* PrevBaseDesc = nullptr;
-		for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[SizeClass]; BaseDesc; PrevBaseDesc = BaseDesc, BaseDesc = BaseDesc->Next)
+		// follow the lists until we can find the pool it came from, the block may be freed on a thread of another node
+		for (int32 MemoryNode = 0; MemoryNode < NumMemoryNodes; ++MemoryNode)
 		{
-			// using reference to avoid static_cast cost of checking the pointer with null, we know it's not null
-			FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*BaseDesc);
-
-			if (UNLIKELY(Desc.Pool->WasAllocatedFromThisPool(Ptr, Size)))
+			FPoolDescriptorBase* PrevBaseDesc = nullptr;
+			for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[MemoryNode][SizeClass]; BaseDesc; PrevBaseDesc = BaseDesc, BaseDesc = BaseDesc->Next)
 			{
-				// LLVM wants to be informed of the allocations of physical RAM.
-				// This is the closest we can get.
-				LLM(FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Platform, Ptr));
-				Desc.Pool->Free(Ptr, Size);
-
-				// check if the pool is empty and delete if so
-				// Note: could defer until Trim() is called
-				if (UNLIKELY(Desc.Pool->IsEmpty()))
+				// using reference to avoid static_cast cost of checking the pointer with null, we know it's not null
+				FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*BaseDesc);
+
+				if (UNLIKELY(Desc.Pool->WasAllocatedFromThisPool(Ptr, Size)))
 				{
-					// unchain from the list
-					if (LIKELY(PrevBaseDesc))
-					{
-						PrevBaseDesc->Next = Desc.Next;
-					}
-					else
+					// LLVM wants to be informed of the allocations of physical RAM.
+					// This is the closest we can get.
+					LLM(FLowLevelMemTracker::Get().OnLowLevelFree(ELLMTracker::Platform, Ptr));
+					Desc.Pool->Free(Ptr, Size);
+
+					// check if the pool is empty and delete if so
+					// Note: could defer until Trim() is called
+					if (UNLIKELY(Desc.Pool->IsEmpty()))
 					{
-						ClassesListHeads[SizeClass] = Desc.Next;
+						// unchain from the list
+						if (LIKELY(PrevBaseDesc))
+						{
+							PrevBaseDesc->Next = Desc.Next;
+						}
+						else
+						{
+							ClassesListHeads[MemoryNode][SizeClass] = Desc.Next;
+						}
+
+						DestroyPool(BaseDesc);
+						DecideOnTheNextPoolSize(MemoryNode, SizeClass, false);
 					}
-
-					DestroyPool(BaseDesc);
-					DecideOnTheNextPoolSize(SizeClass, false);
+					return;
 				}
-				break;
 			}
 		}
 	}
 };
 
-void FPooledVirtualMemoryAllocator::DecideOnTheNextPoolSize(int32 SizeClass, bool bGrowing)
+void FPooledVirtualMemoryAllocator::DecideOnTheNextPoolSize(int32 MemoryNode, int32 SizeClass, bool bGrowing)
 {
 	// heuristic, attempts to scale exponentially
+	int32& PoolSize = NextPoolSize[MemoryNode][SizeClass];
 	if (bGrowing)
 	{
-		NextPoolSize[SizeClass] = static_cast<int32>(GVMAPoolScale * static_cast<float>(NextPoolSize[SizeClass]));
+		PoolSize = static_cast<int32>(GVMAPoolScale * static_cast<float>(PoolSize));
 	}
 	else
 	{
-		NextPoolSize[SizeClass] = FMath::Max(2, static_cast<int32>(static_cast<float>(NextPoolSize[SizeClass]) / GVMAPoolScale));
+		PoolSize = FMath::Max(2, static_cast<int32>(static_cast<float>(PoolSize) / GVMAPoolScale));
 	}
 }
 
-FPooledVirtualMemoryAllocator::FPoolDescriptorBase* FPooledVirtualMemoryAllocator::CreatePool(SIZE_T AllocationSize, int32 NumPooledAllocations)
+FPooledVirtualMemoryAllocator::FPoolDescriptorBase* FPooledVirtualMemoryAllocator::CreatePool(SIZE_T AllocationSize, int32 NumPooledAllocations, int32 MemoryNode)
 {
+	// the pool memory needs to be 64KB-aligned, or aligned to the large page size if the platform backs pools with large pages
+	const SIZE_T PoolAlignment = FMath::Max<SIZE_T>(65536, FPlatformMemory::GetPooledMemoryAlignment());
+
 	// calculate total size needed from the OS
 	SIZE_T TotalSize = 0;
 
@@ -182,8 +206,8 @@ FPooledVirtualMemoryAllocator::FPoolDescriptorBase* FPooledVirtualMemoryAllocato
 	// All the above memory will be the "header", the pool memory itself will begin from there, 64KB-aligned
 	SIZE_T HeaderSize = TotalSize;
 
-	// Let's add 64KB padding so we can find a 64KB-aligned pointer after the header
-	TotalSize = TotalSize + 65536;
+	// Let's add padding so we can find an aligned pointer after the header
+	TotalSize = TotalSize + PoolAlignment;
 
 	// now add the main memory requirements
 	TotalSize += AllocationSize * static_cast<SIZE_T>(NumPooledAllocations);
@@ -207,7 +231,11 @@ FPooledVirtualMemoryAllocator::FPoolDescriptorBase* FPooledVirtualMemoryAllocato
 	uint8* PointerToBookkeepingMemory = PointerToPool + PoolClassSizeof;
 	uint8* MemoryAfterTheHeader = PointerToBookkeepingMemory + BookkeepingMemorySize;
 
-	uint8* AlignedMemoryForThePool = Align(MemoryAfterTheHeader, 65536);
+	uint8* AlignedMemoryForThePool = Align(MemoryAfterTheHeader, PoolAlignment);
+
+	// nothing has touched the pool memory yet, so this decides where all of its pages will come from
+	FPlatformMemory::AdvisePooledMemory(AlignedMemoryForThePool, AllocationSize * static_cast<SIZE_T>(NumPooledAllocations), MemoryNode);
+
 	Ptr->Pool = new (PointerToPool) T64KBAlignedPool(AllocationSize, reinterpret_cast<SIZE_T>(AlignedMemoryForThePool), NumPooledAllocations, 
 		PointerToBookkeepingMemory, VMBlock);
 
@@ -245,13 +273,16 @@ uint64 FPooledVirtualMemoryAllocator::GetCachedFreeTotal()
 	{
 		FScopeLock Lock(&ClassesLocks[IdxSizeClass]);
 
-		for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[IdxSizeClass]; BaseDesc; BaseDesc = BaseDesc->Next)
+		for (int32 IdxNode = 0; IdxNode < NumMemoryNodes; ++IdxNode)
 		{
-			// using reference to avoid static_cast cost of checking the pointer with null, we know it's not null
-			FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*BaseDesc);
+			for(FPoolDescriptorBase* BaseDesc = ClassesListHeads[IdxNode][IdxSizeClass]; BaseDesc; BaseDesc = BaseDesc->Next)
+			{
+				// using reference to avoid static_cast cost of checking the pointer with null, we know it's not null
+				FPoolDescriptor& Desc = static_cast<FPoolDescriptor&>(*BaseDesc);
 
-			// not accounting for the overhead here since we cannot make use of that "free" memory anyway
-			TotalFree += Desc.Pool->GetAllocatableMemorySize();
+				// not accounting for the overhead here since we cannot make use of that "free" memory anyway
+				TotalFree += Desc.Pool->GetAllocatableMemorySize();
+			}
 		}
 	}
 
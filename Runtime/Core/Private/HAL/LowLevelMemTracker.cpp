@@ -16,6 +16,9 @@
 #include "Misc/VarArgs.h"
 #include "Templates/Atomic.h"
 #include "Trace/Trace.inl"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformStackWalk.h"
+#include <atomic>
 
 
 
@@ -262,6 +265,9 @@ namespace LLMPrivate
 		void TrackMoved(const void* Dest, const void* Source, int64 Size, ELLMTracker Tracker, const FTagData* TagData);
 		void IncrTag(const FTagData* Tag, int64 Amount);
 
+		/** Returns true if an allocation of the given size contains a sampled byte, and the number of bytes it stands for */
+		bool ShouldSample(int64 Size, int64 SampleRate, int64& OutWeight);
+
 		void PropagateChildSizesToParents();
 		void OnTagsResorted(FTagDataArray& OldTagDatas);
 		void LockTags(bool bLock);
@@ -279,6 +285,11 @@ namespace LLMPrivate
 
 		int8 PausedCounter[(int32)ELLMAllocType::Count];
 		int64 AllocTypeAmounts[(int32)ELLMAllocType::Count];
+
+		/** Bytes this thread can still allocate before the next sampled byte, only used when sampling */
+		int64 BytesUntilNextSample;
+		/** State of the random generator drawing the distance between sampled bytes, 0 until the first sampled allocation on this thread */
+		uint64 SampleRandomState;
 	};
 
 	/*
@@ -311,6 +322,19 @@ namespace LLMPrivate
 		void TrackMemory(FName TagName, int64 Amount, ELLMAllocType AllocType);
 		void TrackMemory(const FTagData* TagData, int64 Amount, ELLMAllocType AllocType);
 
+		/**
+		 * Switches from tracking every allocation to tracking a random sample of the allocated bytes. An allocation is tracked
+		 * if it contains a sampled byte, and counts for the number of bytes it stands for, so totals stay unbiased estimates.
+		 * Each tracked allocation also records its callstack. Allocations tracked before the switch are still tracked in full.
+		 */
+		void EnableSampling(int64 InSampleRate);
+		int64 GetSampleRate() const
+		{
+			return SampleRate;
+		}
+		/** Writes the callstacks holding the most sampled memory to the output device */
+		void DumpSampledCallstacks(FOutputDevice& Ar, int32 MaxCallstacks);
+
 		// This will pause/unpause tracking, and also manually increment a given tag
 		void PauseAndTrackMemory(FName TagName, bool bInIsStatTag, int64 Amount, ELLMAllocType AllocType);
 		void PauseAndTrackMemory(ELLMTag EnumTag, int64 Amount, ELLMAllocType AllocType);
@@ -431,6 +455,37 @@ namespace LLMPrivate
 		double LastTrimTime;
 
 		int64 AllocTypeAmounts[(int32)ELLMAllocType::Count];
+
+		/** Live sampled memory allocated from one callstack */
+		struct FSampledCallstack
+		{
+			uint64 Frames[LLM_SAMPLED_CALLSTACK_DEPTH];
+			int32 NumFrames = 0;
+			const FTagData* TagData = nullptr;
+			int64 Size = 0;
+			int64 NumAllocations = 0;
+		};
+
+		static uint32 GetSampledPointerIndex(const void* Ptr)
+		{
+			// allocations are at least 16 byte aligned, scramble the rest of the address into the top bits
+			return static_cast<uint32>(((static_cast<uint64>(reinterpret_cast<UPTRINT>(Ptr)) >> 4) * 0x9E3779B97F4A7C15ull) >> (64 - LLM_SAMPLED_POINTER_FILTER_BITS));
+		}
+		void RecordSampledCallstack(const void* Ptr, int64 Weight, const FTagData* TagData);
+		void ReleaseSampledCallstack(const void* Ptr, int64 Weight);
+		void MoveSampledCallstack(const void* Dest, const void* Source);
+
+		/** Mean number of bytes between two sampled bytes, 0 when every allocation is tracked */
+		int64 SampleRate;
+		/**
+		 * Number of tracked allocations per pointer hash, only allocated when sampling. Most frees are of allocations that were
+		 * not sampled, their counter is zero and they return without taking AllocationMapLock.
+		 */
+		std::atomic<int32*> SampledPointerCounts;
+
+		FCriticalSection SampledCallstacksLock;
+		TMap<uint64, FSampledCallstack, FDefaultSetLLMAllocator> SampledCallstacks;
+		TFastPointerLLMMap<const void*, uint64> SampledAllocationCallstacks;
 	};
 
 	const TCHAR* ToString(ETagReferenceSource ReferenceSource);
@@ -952,8 +1007,10 @@ void FLowLevelMemTracker::ProcessCommandLine(const TCHAR* CmdLine)
 
 	bool bLocalCsvWriterEnabled = FParse::Param(CmdLine, TEXT("LLMCSV"));
 	bool bLocalTraceWriterEnabled = UE_TRACE_CHANNELEXPR_IS_ENABLED(MemTagChannel);
-	// automatically enable LLM if only csv or trace output is active
-	if (bLocalCsvWriterEnabled || bLocalTraceWriterEnabled)
+	int64 SampleRate = 0;
+	FParse::Value(CmdLine, TEXT("LLMSampleRate="), SampleRate);
+	// automatically enable LLM if only csv or trace output or sampling is active
+	if (bLocalCsvWriterEnabled || bLocalTraceWriterEnabled || SampleRate > 0)
 	{
 		bShouldDisable = false;
 	}
@@ -989,6 +1046,12 @@ void FLowLevelMemTracker::ProcessCommandLine(const TCHAR* CmdLine)
 	BootstrapInitialise();
 	FinishInitialise();
 
+	// only the heap is sampled, the platform tracker sees few large allocations and is cheap to track in full
+	if (SampleRate > 0)
+	{
+		GetTracker(ELLMTracker::Default)->EnableSampling(SampleRate);
+	}
+
 	// activate tag sets (we ignore None set, it's always on)
 	FString SetList;
 	static_assert((uint8)ELLMTagSet::Max == 3, "You added a tagset, without updating FLowLevelMemTracker::ProcessCommandLine");
@@ -1020,7 +1083,7 @@ void FLowLevelMemTracker::ProcessCommandLine(const TCHAR* CmdLine)
 		CVarLLMTrackPeaks->Set(TrackPeaks);
 	}
 
-	UE_LOG(LogInit, Log, TEXT("LLM enabled CsvWriter: %s TraceWriter: %s"), bCsvWriterEnabled ? TEXT("on") : TEXT("off"), bTraceWriterEnabled ? TEXT("on") : TEXT("off"));
+	UE_LOG(LogInit, Log, TEXT("LLM enabled CsvWriter: %s TraceWriter: %s SampleRate: %lld"), bCsvWriterEnabled ? TEXT("on") : TEXT("off"), bTraceWriterEnabled ? TEXT("on") : TEXT("off"), SampleRate);
 }
 
 // Return the total amount of memory being tracked
@@ -1130,6 +1193,15 @@ bool FLowLevelMemTracker::Exec(const TCHAR* Cmd, FOutputDevice& Ar)
 
 			UpdateStatsPerFrame(TEXT("After cleanup"));
 		}
+		else if (FParse::Command(&Cmd, TEXT("SAMPLEDCALLSTACKS")))
+		{
+			int32 MaxCallstacks = FCString::Atoi(Cmd);
+			if (MaxCallstacks <= 0)
+			{
+				MaxCallstacks = 20;
+			}
+			GetTracker(ELLMTracker::Default)->DumpSampledCallstacks(Ar, MaxCallstacks);
+		}
 		return true;
 	}
 
@@ -2738,6 +2810,8 @@ namespace LLMPrivate
 		, OverrideUntaggedTagData(nullptr)
 		, OverrideTrackedTotalTagData(nullptr)
 		, LastTrimTime(0.0)
+		, SampleRate(0)
+		, SampledPointerCounts(nullptr)
 	{
 		TlsSlot = FPlatformTLS::AllocTlsSlot();
 
@@ -2851,6 +2925,10 @@ namespace LLMPrivate
 	void FLLMTracker::TrackAllocation(const void* Ptr, int64 Size, ELLMTag DefaultEnumTag, ELLMTracker Tracker, ELLMAllocType AllocType, bool bTrackInMemPro)
 	{
 		FLLMThreadState* State = GetOrCreateState();
+		if (SampleRate > 0 && !State->ShouldSample(Size, SampleRate, Size))
+		{
+			return;
+		}
 		const FTagData* TagData = State->GetTopTag();
 		if (!TagData)
 		{
@@ -2862,6 +2940,10 @@ namespace LLMPrivate
 	void FLLMTracker::TrackAllocation(const void* Ptr, int64 Size, FName DefaultTag, ELLMTracker Tracker, ELLMAllocType AllocType, bool bTrackInMemPro)
 	{
 		FLLMThreadState* State = GetOrCreateState();
+		if (SampleRate > 0 && !State->ShouldSample(Size, SampleRate, Size))
+		{
+			return;
+		}
 		const FTagData* TagData = State->GetTopTag();
 		if (!TagData)
 		{
@@ -2906,13 +2988,32 @@ namespace LLMPrivate
 			AllocInfo.SetAssetTag(AssetTagData, LLMRef);
 #endif
 			LLMCheck(Size <= 0xffffffffu);
-			FScopeLock AllocationScopeLock(&AllocationMapLock);
-			AllocationMap.Add(Ptr, static_cast<uint32>(Size), AllocInfo);
+			{
+				FScopeLock AllocationScopeLock(&AllocationMapLock);
+				AllocationMap.Add(Ptr, static_cast<uint32>(Size), AllocInfo);
+				// counted under the lock so that EnableSampling cannot miss an allocation that is being added while it switches
+				if (int32* PointerCounts = SampledPointerCounts.load(std::memory_order_relaxed))
+				{
+					FPlatformAtomics::InterlockedIncrement(&PointerCounts[GetSampledPointerIndex(Ptr)]);
+				}
+			}
+
+			if (SampleRate > 0)
+			{
+				RecordSampledCallstack(Ptr, Size, ActiveTagData);
+			}
 		}
 	}
 
 	void FLLMTracker::TrackFree(const void* Ptr, ELLMTracker Tracker, ELLMAllocType AllocType, bool bTrackInMemPro)
 	{
+		int32* PointerCounts = SampledPointerCounts.load(std::memory_order_acquire);
+		if (PointerCounts && FPlatformAtomics::AtomicRead(&PointerCounts[GetSampledPointerIndex(Ptr)]) == 0)
+		{
+			// not sampled, so it was never added to the tracking map
+			return;
+		}
+
 		// look up the pointer in the tracking map
 		FLLMAllocMap::Values Values;
 		{
@@ -2921,6 +3022,15 @@ namespace LLMPrivate
 			{
 				return;
 			}
+			if (PointerCounts)
+			{
+				FPlatformAtomics::InterlockedDecrement(&PointerCounts[GetSampledPointerIndex(Ptr)]);
+			}
+		}
+
+		if (PointerCounts)
+		{
+			ReleaseSampledCallstack(Ptr, static_cast<int64>(Values.Value1));
 		}
 
 		if (IsPaused(AllocType))
@@ -2948,6 +3058,12 @@ namespace LLMPrivate
 
 	void FLLMTracker::OnAllocMoved(const void* Dest, const void* Source, ELLMTracker Tracker, ELLMAllocType AllocType)
 	{
+		int32* PointerCounts = SampledPointerCounts.load(std::memory_order_acquire);
+		if (PointerCounts && FPlatformAtomics::AtomicRead(&PointerCounts[GetSampledPointerIndex(Source)]) == 0)
+		{
+			return;
+		}
+
 		FLLMAllocMap::Values Values;
 		{
 			FScopeLock AllocationScopeLock(&AllocationMapLock);
@@ -2957,6 +3073,16 @@ namespace LLMPrivate
 			}
 
 			AllocationMap.Add(Dest, Values.Value1, Values.Value2);
+			if (PointerCounts)
+			{
+				FPlatformAtomics::InterlockedDecrement(&PointerCounts[GetSampledPointerIndex(Source)]);
+				FPlatformAtomics::InterlockedIncrement(&PointerCounts[GetSampledPointerIndex(Dest)]);
+			}
+		}
+
+		if (PointerCounts)
+		{
+			MoveSampledCallstack(Dest, Source);
 		}
 
 		if (IsPaused(AllocType))
@@ -2973,6 +3099,116 @@ namespace LLMPrivate
 		State->TrackMoved(Dest, Source, Size, Tracker, TagData);
 	}
 
+	void FLLMTracker::EnableSampling(int64 InSampleRate)
+	{
+		if (InSampleRate <= 0 || SampleRate > 0)
+		{
+			return;
+		}
+
+		const SIZE_T PointerCountsSize = (1 << LLM_SAMPLED_POINTER_FILTER_BITS) * sizeof(int32);
+		int32* PointerCounts = reinterpret_cast<int32*>(LLMRef.Allocator.Alloc(PointerCountsSize));
+		FMemory::Memzero(PointerCounts, PointerCountsSize);
+
+		FScopeLock AllocationScopeLock(&AllocationMapLock);
+		// allocations tracked before sampling was enabled stay tracked in full and must still be found when they are freed
+		for (const auto& Tuple : AllocationMap)
+		{
+			++PointerCounts[GetSampledPointerIndex(Tuple.Key.Pointer)];
+		}
+		SampledPointerCounts.store(PointerCounts, std::memory_order_release);
+		SampleRate = InSampleRate;
+	}
+
+	void FLLMTracker::RecordSampledCallstack(const void* Ptr, int64 Weight, const FTagData* TagData)
+	{
+		uint64 Frames[LLM_SAMPLED_CALLSTACK_DEPTH];
+		const int32 NumFrames = static_cast<int32>(FPlatformStackWalk::CaptureStackBackTrace(Frames, LLM_SAMPLED_CALLSTACK_DEPTH));
+		const uint64 CallstackHash = CityHash64(reinterpret_cast<const char*>(Frames), NumFrames * sizeof(uint64)) ^ reinterpret_cast<UPTRINT>(TagData);
+
+		FScopeLock SampledCallstacksScopeLock(&SampledCallstacksLock);
+		FSampledCallstack* Callstack = SampledCallstacks.Find(CallstackHash);
+		if (!Callstack)
+		{
+			Callstack = &SampledCallstacks.Add(CallstackHash);
+			FMemory::Memcpy(Callstack->Frames, Frames, NumFrames * sizeof(uint64));
+			Callstack->NumFrames = NumFrames;
+			Callstack->TagData = TagData;
+		}
+		Callstack->Size += Weight;
+		++Callstack->NumAllocations;
+		SampledAllocationCallstacks.Add(Ptr, CallstackHash);
+	}
+
+	void FLLMTracker::ReleaseSampledCallstack(const void* Ptr, int64 Weight)
+	{
+		FScopeLock SampledCallstacksScopeLock(&SampledCallstacksLock);
+		uint64 CallstackHash;
+		if (!SampledAllocationCallstacks.RemoveAndCopyValue(Ptr, CallstackHash))
+		{
+			// tracked before sampling was enabled
+			return;
+		}
+		FSampledCallstack& Callstack = SampledCallstacks.FindChecked(CallstackHash);
+		Callstack.Size -= Weight;
+		if (--Callstack.NumAllocations == 0)
+		{
+			SampledCallstacks.Remove(CallstackHash);
+		}
+	}
+
+	void FLLMTracker::MoveSampledCallstack(const void* Dest, const void* Source)
+	{
+		FScopeLock SampledCallstacksScopeLock(&SampledCallstacksLock);
+		uint64 CallstackHash;
+		if (SampledAllocationCallstacks.RemoveAndCopyValue(Source, CallstackHash))
+		{
+			SampledAllocationCallstacks.Add(Dest, CallstackHash);
+		}
+	}
+
+	void FLLMTracker::DumpSampledCallstacks(FOutputDevice& Ar, int32 MaxCallstacks)
+	{
+		if (SampleRate <= 0)
+		{
+			Ar.Logf(TEXT("LLM sampling is not enabled, run with -LLMSampleRate=<bytes> to enable it."));
+			return;
+		}
+
+		TArray<FSampledCallstack, FDefaultLLMAllocator> Callstacks;
+		{
+			FScopeLock SampledCallstacksScopeLock(&SampledCallstacksLock);
+			Callstacks.Reserve(SampledCallstacks.Num());
+			for (const TPair<uint64, FSampledCallstack>& Pair : SampledCallstacks)
+			{
+				Callstacks.Add(Pair.Value);
+			}
+		}
+		Callstacks.Sort([](const FSampledCallstack& A, const FSampledCallstack& B) { return A.Size > B.Size; });
+
+		int64 TotalSize = 0;
+		for (const FSampledCallstack& Callstack : Callstacks)
+		{
+			TotalSize += Callstack.Size;
+		}
+		Ar.Logf(TEXT("LLM sampled memory: %.2f MB estimated from %d callstacks, sample rate %lld bytes"), (double)TotalSize / (1024.0 * 1024.0), Callstacks.Num(), SampleRate);
+
+		const int32 NumToDump = FMath::Min(MaxCallstacks, Callstacks.Num());
+		for (int32 CallstackIndex = 0; CallstackIndex < NumToDump; ++CallstackIndex)
+		{
+			const FSampledCallstack& Callstack = Callstacks[CallstackIndex];
+			Ar.Logf(TEXT("%d: %.2f MB (%lld sampled allocations) Tag: %s"), CallstackIndex, (double)Callstack.Size / (1024.0 * 1024.0), Callstack.NumAllocations,
+				Callstack.TagData ? *Callstack.TagData->GetDisplayName().ToString() : TEXT("?"));
+			for (int32 FrameIndex = 0; FrameIndex < Callstack.NumFrames; ++FrameIndex)
+			{
+				ANSICHAR HumanReadableString[1024];
+				HumanReadableString[0] = 0;
+				FPlatformStackWalk::ProgramCounterToHumanReadableString(FrameIndex, Callstack.Frames[FrameIndex], HumanReadableString, UE_ARRAY_COUNT(HumanReadableString));
+				Ar.Logf(TEXT("    %s"), ANSI_TO_TCHAR(HumanReadableString));
+			}
+		}
+	}
+
 	void FLLMTracker::TrackMemory(ELLMTag Tag, int64 Amount, ELLMAllocType AllocType)
 	{
 		TrackMemory(LLMRef.FindOrAddTagData(Tag), Amount, AllocType);
@@ -3051,6 +3287,16 @@ namespace LLMPrivate
 		{
 			FScopeLock AllocationScopeLock(&AllocationMapLock);
 			AllocationMap.Clear();
+			if (int32* PointerCounts = SampledPointerCounts.exchange(nullptr))
+			{
+				LLMRef.Allocator.Free(PointerCounts, (1 << LLM_SAMPLED_POINTER_FILTER_BITS) * sizeof(int32));
+			}
+			SampleRate = 0;
+		}
+		{
+			FScopeLock SampledCallstacksScopeLock(&SampledCallstacksLock);
+			SampledCallstacks.Empty();
+			SampledAllocationCallstacks.Empty();
 		}
 		CsvWriter.Clear();
 		TraceWriter.Clear();
@@ -3280,6 +3526,8 @@ namespace LLMPrivate
 	}
 
 	FLLMThreadState::FLLMThreadState()
+		: BytesUntilNextSample(0)
+		, SampleRandomState(0)
 	{
 		for (int32 Index = 0; Index < static_cast<int32>(ELLMAllocType::Count); ++Index)
 		{
@@ -3289,6 +3537,37 @@ namespace LLMPrivate
 		ClearAllocTypeAmounts();
 	}
 
+	bool FLLMThreadState::ShouldSample(int64 Size, int64 SampleRate, int64& OutWeight)
+	{
+		auto DrawSampleInterval = [this, SampleRate]()
+		{
+			// xorshift64*, the distance between sampled bytes is exponentially distributed so every byte is equally likely to be sampled
+			SampleRandomState ^= SampleRandomState >> 12;
+			SampleRandomState ^= SampleRandomState << 25;
+			SampleRandomState ^= SampleRandomState >> 27;
+			const double Uniform = (double)((SampleRandomState * 0x2545F4914F6CDD1Dull) >> 11) * (1.0 / 9007199254740992.0);
+			BytesUntilNextSample = FMath::Max<int64>(1, (int64)(-FMath::Loge(FMath::Max(Uniform, 1e-12)) * (double)SampleRate));
+		};
+
+		if (SampleRandomState == 0)
+		{
+			SampleRandomState = ((uint64)reinterpret_cast<UPTRINT>(this) ^ FPlatformTime::Cycles64()) | 1;
+			DrawSampleInterval();
+		}
+
+		BytesUntilNextSample -= Size;
+		if (BytesUntilNextSample > 0)
+		{
+			return false;
+		}
+		DrawSampleInterval();
+
+		// an allocation of Size bytes contains at least one sampled byte with probability 1 - e^(-Size/SampleRate)
+		const double Probability = 1.0 - FMath::Exp(-(double)Size / (double)SampleRate);
+		OutWeight = FMath::Clamp<int64>((int64)((double)Size / FMath::Max(Probability, 1e-12)), Size, MAX_uint32);
+		return true;
+	}
+
 	void FLLMThreadState::Clear()
 	{
 		TagStack.Empty();
@@ -44,6 +44,14 @@
 // Disable if you need a little more memory or speed
 #define LLM_ENABLED_TRACK_PEAK_MEMORY 1
 
+// Number of frames captured for every sampled allocation when running with -LLMSampleRate
+#ifndef LLM_SAMPLED_CALLSTACK_DEPTH
+	#define LLM_SAMPLED_CALLSTACK_DEPTH 24
+#endif
+
+// log2 of the number of counters used when sampling to tell, without taking a lock, that a freed pointer was never tracked
+#define LLM_SAMPLED_POINTER_FILTER_BITS 17
+
 
 
 namespace UE
@@ -233,6 +233,19 @@ public:
 		FirstFreeBlock = (FFreeBlock*)InAllocatedBytes;
 	}
 
+	/** Small pools have no use for AllocSize, a forked child flags the pools it inherited with it. See OnPostFork(). */
+	bool IsSealed() const
+	{
+		CheckCanary(ECanary::FirstFreeBlockIsPtr);
+		return AllocSize != 0;
+	}
+
+	void SetSealed(bool bSealed)
+	{
+		CheckCanary(ECanary::FirstFreeBlockIsPtr);
+		AllocSize = bSealed ? 1 : 0;
+	}
+
 	void Link(FPoolInfo*& PrevNext)
 	{
 		if (PrevNext)
@@ -510,10 +523,13 @@ struct FMallocBinned2::Private
 				}
 				NodePool->CheckCanary(FPoolInfo::ECanary::FirstFreeBlockIsPtr);
 
-				// If this pool was exhausted, move to available list.
+				// If this pool was exhausted, move to available list. Sealed pools stay sealed until they are empty.
 				if (!NodePool->FirstFreeBlock)
 				{
-					Table.ActivePools.LinkToFront(NodePool);
+					if (!NodePool->IsSealed())
+					{
+						Table.ActivePools.LinkToFront(NodePool);
+					}
 				}
 				else
 				{
@@ -638,6 +654,7 @@ FMallocBinned2::FPoolInfo& FMallocBinned2::FPoolList::PushNewPoolToFront(FMalloc
 	Result->Link(Front);
 	Result->Taken          = 0;
 	Result->FirstFreeBlock = Free;
+	Result->SetSealed(false);
 
 	return *Result;
 }
@@ -1040,6 +1057,16 @@ void FMallocBinned2::FPoolList::ValidateExhaustedPools()
 	}
 }
 
+void FMallocBinned2::FPoolList::ValidateSealedPools()
+{
+	for (FPoolInfo** PoolPtr = &Front; *PoolPtr; PoolPtr = &(*PoolPtr)->Next)
+	{
+		FPoolInfo* Pool = *PoolPtr;
+		check(Pool->PtrToPrevNext == PoolPtr);
+		check(Pool->IsSealed());
+	}
+}
+
 bool FMallocBinned2::ValidateHeap()
 {
 	FScopeLock Lock(&Mutex);
@@ -1048,6 +1075,7 @@ bool FMallocBinned2::ValidateHeap()
 	{
 		Table.ActivePools.ValidateActivePools();
 		Table.ExhaustedPools.ValidateExhaustedPools();
+		Table.SealedPools.ValidateSealedPools();
 	}
 
 	return true;
@@ -1146,6 +1174,44 @@ void FMallocBinned2::ClearAndDisableTLSCachesOnCurrentThread()
 	FPerThreadFreeBlockLists::ClearTLS();
 }
 
+void FMallocBinned2::OnPreFork()
+{
+	// Only the forking thread survives in the child, so blocks cached by this thread and by the global recycler are the
+	// only ones the child could pick up again. Give them back to their pools so that OnPostFork() can seal them.
+	FlushCurrentThreadCache();
+
+	FScopeLock Lock(&Mutex);
+	for (uint32 PoolIndex = 0; PoolIndex != BINNED2_SMALL_POOL_COUNT; ++PoolIndex)
+	{
+		while (FBundleNode* Bundle = Private::GGlobalRecycler.PopBundle(PoolIndex))
+		{
+			Bundle->NextBundle = nullptr;
+			Private::FreeBundles(*this, Bundle, PoolIndexToBlockSize(PoolIndex), PoolIndex);
+		}
+	}
+	CachedOSPageAllocator.FreeAll(&Mutex);
+}
+
+void FMallocBinned2::OnPostFork()
+{
+	// Every used pool lives in pages shared with the parent. Allocating from them would copy a page per block, so move
+	// them aside and let this process start new pools. Exhausted pools are sealed too, otherwise the first free into one
+	// would put it back on the active list. Frees into sealed pools still work and release the pool once it is empty.
+	FScopeLock Lock(&Mutex);
+	for (FPoolTable& Table : SmallPoolTables)
+	{
+		for (FPoolList* List : { &Table.ActivePools, &Table.ExhaustedPools })
+		{
+			while (!List->IsEmpty())
+			{
+				FPoolInfo* Pool = &List->GetFrontPool();
+				Pool->SetSealed(true);
+				Table.SealedPools.LinkToFront(Pool);
+			}
+		}
+	}
+}
+
 
 bool FMallocBinned2::FFreeBlockList::ObtainPartial(uint32 InPoolIndex)
 {
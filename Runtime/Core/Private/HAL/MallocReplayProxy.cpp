@@ -167,4 +167,14 @@ void FMallocReplayProxy::ClearAndDisableTLSCachesOnCurrentThread()
 	UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
 }
 
+void FMallocReplayProxy::OnPreFork()
+{
+	UsedMalloc->OnPreFork();
+}
+
+void FMallocReplayProxy::OnPostFork()
+{
+	UsedMalloc->OnPostFork();
+}
+
 #endif // UE_USE_MALLOC_REPLAY_PROXY
@@ -212,6 +212,14 @@ public:
 	{
 		return UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
 	}
+	virtual void OnPreFork() override
+	{
+		return UsedMalloc->OnPreFork();
+	}
+	virtual void OnPostFork() override
+	{
+		return UsedMalloc->OnPostFork();
+	}
 	virtual const TCHAR* GetDescriptiveName() override
 	{
 		return UsedMalloc->GetDescriptiveName();
@@ -256,7 +256,6 @@ private:
 
 class FIoStoreWriterContextImpl
 {
-	static constexpr uint64 DefaultMemoryLimit = 1ull << 30ull;
 public:
 	FIoStoreWriterContextImpl()
 	{
@@ -266,10 +265,16 @@ public:
 	{
 		BeginCompressionQueue.CompleteAdding();
 		FinishCompressionQueue.CompleteAdding();
-		WriterQueue.CompleteAdding();
+		for (TUniquePtr<FIoStoreWriteQueue>& WriterQueue : WriterQueues)
+		{
+			WriterQueue->CompleteAdding();
+		}
 		BeginCompressionThread.Wait();
 		FinishCompressionThread.Wait();
-		WriterThread.Wait();
+		for (TFuture<void>& WriterThread : WriterThreads)
+		{
+			WriterThread.Wait();
+		}
 		if (CompressionBufferAvailableEvent)
 		{
 			FPlatformProcess::ReturnSynchEventToPool(CompressionBufferAvailableEvent);
@@ -293,7 +298,7 @@ public:
 		CompressionBufferSize = FMath::Max(CompressionBufferSize, static_cast<int32>(WriterSettings.CompressionBlockSize));
 		CompressionBufferSize = Align(CompressionBufferSize, FAES::AESBlockSize);
 
-		TotalCompressionBufferCount = DefaultMemoryLimit / CompressionBufferSize;
+		TotalCompressionBufferCount = int32(FMath::Max<uint64>(WriterSettings.CompressionMemoryLimit / CompressionBufferSize, 1));
 		AvailableCompressionBuffers.Reserve(TotalCompressionBufferCount);
 		for (int32 BufferIndex = 0; BufferIndex < TotalCompressionBufferCount; ++BufferIndex)
 		{
@@ -302,7 +307,13 @@ public:
 
 		BeginCompressionThread = Async(EAsyncExecution::Thread, [this]() { BeginCompressionThreadFunc(); });
 		FinishCompressionThread = Async(EAsyncExecution::Thread, [this]() { FinishCompressionThreadFunc(); });
-		WriterThread = Async(EAsyncExecution::Thread, [this]() { WriterThreadFunc(); });
+		// Each container is written by one writer thread so its entries stay in order, but different containers can be written concurrently
+		const int32 WriterThreadCount = FMath::Max(WriterSettings.MaxConcurrentWriters, 1);
+		for (int32 WriterThreadIndex = 0; WriterThreadIndex < WriterThreadCount; ++WriterThreadIndex)
+		{
+			FIoStoreWriteQueue* WriterQueue = WriterQueues.Emplace_GetRef(new FIoStoreWriteQueue()).Get();
+			WriterThreads.Add(Async(EAsyncExecution::Thread, [this, WriterQueue]() { WriterThreadFunc(*WriterQueue); }));
+		}
 
 		return FIoStatus::Ok;
 	}
@@ -314,6 +325,9 @@ public:
 		Progress.HashedChunksCount = HashedChunksCount.Load();
 		Progress.CompressedChunksCount = CompressedChunksCount.Load();
 		Progress.SerializedChunksCount = SerializedChunksCount.Load();
+		Progress.HashedBytes = HashedBytes.Load();
+		Progress.CompressedBytes = CompressedBytes.Load();
+		Progress.SerializedBytes = SerializedBytes.Load();
 		return Progress;
 	}
 
@@ -375,20 +389,24 @@ public:
 private:
 	void BeginCompressionThreadFunc();
 	void FinishCompressionThreadFunc();
-	void WriterThreadFunc();
+	void WriterThreadFunc(FIoStoreWriteQueue& WriterQueue);
 
 	FIoStoreWriterSettings WriterSettings;
 	FEvent* CompressionBufferAvailableEvent = nullptr;
 	TFuture<void> BeginCompressionThread;
 	TFuture<void> FinishCompressionThread;
-	TFuture<void> WriterThread;
+	TArray<TFuture<void>> WriterThreads;
 	FIoStoreWriteQueue BeginCompressionQueue;
 	FIoStoreWriteQueue FinishCompressionQueue;
-	FIoStoreWriteQueue WriterQueue;
+	TArray<TUniquePtr<FIoStoreWriteQueue>> WriterQueues;
+	TAtomic<int32> NextWriterQueueIndex{ 0 };
 	TAtomic<uint64> TotalChunksCount{ 0 };
 	TAtomic<uint64> HashedChunksCount{ 0 };
 	TAtomic<uint64> CompressedChunksCount{ 0 };
 	TAtomic<uint64> SerializedChunksCount{ 0 };
+	TAtomic<uint64> HashedBytes{ 0 };
+	TAtomic<uint64> CompressedBytes{ 0 };
+	TAtomic<uint64> SerializedBytes{ 0 };
 	FCriticalSection AvailableCompressionBuffersCritical;
 	TArray<FIoBuffer*> AvailableCompressionBuffers;
 	int32 CompressionBufferSize = -1;
@@ -541,6 +559,7 @@ public:
 	UE_NODISCARD FIoStatus Initialize(FIoStoreWriterContextImpl& InContext, const FIoContainerSettings& InContainerSettings)
 	{
 		WriterContext = &InContext;
+		WriterQueueIndex = InContext.NextWriterQueueIndex.IncrementExchange() % InContext.WriterQueues.Num();
 		ContainerSettings = InContainerSettings;
 
 		TocFilePath = ContainerPath + TEXT(".utoc");
@@ -639,6 +658,7 @@ public:
 			const FIoBuffer* SourceBuffer = Entry->Request->GetSourceBuffer();
 			Entry->ChunkHash = FIoChunkHash::HashBuffer(SourceBuffer->Data(), SourceBuffer->DataSize());
 			WriterContext->HashedChunksCount.IncrementExchange();
+			WriterContext->HashedBytes.AddExchange(SourceBuffer->DataSize());
 			if (LayoutEntriesHead)
 			{
 				// Release the source data buffer if disk layout ordering is enabled, it will be reloaded
@@ -983,7 +1003,9 @@ private:
 		const uint64 NumChunkBlocks = Align(Entry->UncompressedSize, WriterSettings.CompressionBlockSize) / WriterSettings.CompressionBlockSize;
 		if (NumChunkBlocks == 0)
 		{
+			// Empty chunks have nothing to compress but are counted like every other chunk
 			WriterContext->CompressedChunksCount.IncrementExchange();
+			WriterContext->CompressedBytes.AddExchange(Entry->UncompressedSize);
 			Entry->FinishCompressionBarrier->DispatchSubsequents();
 			return;
 		}
@@ -1009,6 +1031,7 @@ private:
 				if (FinishedBlocksCount + 1 == Entry->ChunkBlocks.Num())
 				{
 					WriterContext->CompressedChunksCount.IncrementExchange();
+					WriterContext->CompressedBytes.AddExchange(Entry->UncompressedSize);
 					Entry->FinishCompressionBarrier->DispatchSubsequents();
 				}
 			}, TStatId(), nullptr, ENamedThreads::AnyHiPriThreadHiPriTask);
@@ -1212,6 +1235,7 @@ private:
 			ChunkBlock.IoBuffer = nullptr;
 		}
 		WriterContext->SerializedChunksCount.IncrementExchange();
+		WriterContext->SerializedBytes.AddExchange(Entry->Padding + Entry->CompressedSize);
 	}
 
 	const FString				ContainerPath;
@@ -1234,6 +1258,7 @@ private:
 	uint64						UncompressedContainerSize = 0;
 	uint64						CompressedContainerSize = 0;
 	int32						CurrentPartitionIndex = 0;
+	int32						WriterQueueIndex = 0;
 	bool						bHasMemoryMappedEntry = false;
 	bool						bHasFlushed = false;
 
@@ -1283,7 +1308,7 @@ void FIoStoreWriterContextImpl::FinishCompressionThreadFunc()
 			Entry->FinishCompressionBarrier->Wait();
 			Entry->HashTask->Wait();
 
-			WriterQueue.Enqueue(Entry);
+			WriterQueues[Entry->Writer->WriterQueueIndex]->Enqueue(Entry);
 
 			Entry->Request->FreeSourceBuffer();
 
@@ -1299,7 +1324,7 @@ void FIoStoreWriterContextImpl::FinishCompressionThreadFunc()
 	}
 }
 
-void FIoStoreWriterContextImpl::WriterThreadFunc()
+void FIoStoreWriterContextImpl::WriterThreadFunc(FIoStoreWriteQueue& WriterQueue)
 {
 	for (;;)
 	{
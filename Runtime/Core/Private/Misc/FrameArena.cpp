@@ -0,0 +1,193 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Misc/FrameArena.h"
+#include "Misc/MemStack.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/CriticalSection.h"
+#include "CoreGlobals.h"
+
+std::atomic<uint32> FFrameArena::FrameIndex { 0 };
+
+namespace FrameArenaPrivate
+{
+	/** Guards the list of threads, the chunks of every thread and the recycled chunks */
+	static FCriticalSection& GetLock()
+	{
+		static FCriticalSection Lock;
+		return Lock;
+	}
+
+	static FFrameArenaThread* FirstThread = nullptr;
+
+	/** Page sized chunks released by the last EndFrame, handed out again before asking the page allocator */
+	static FFrameArenaThread::FChunk* RecycledChunks = nullptr;
+
+	static void FreeChunk(FFrameArenaThread::FChunk* Chunk)
+	{
+		if (Chunk->Size == FPageAllocator::PageSize)
+		{
+			FPageAllocator::Get().Free(Chunk);
+		}
+		else
+		{
+			FMemory::Free(Chunk);
+		}
+	}
+}
+
+void FFrameArena::EndFrame()
+{
+	using namespace FrameArenaPrivate;
+
+	check(IsInGameThread());
+	const uint32 NewFrameIndex = FrameIndex.fetch_add(1, std::memory_order_release) + 1;
+
+	FScopeLock Lock(&GetLock());
+
+	// Chunks that were kept for this frame but not needed go back to the page allocator
+	while (RecycledChunks)
+	{
+		FFrameArenaThread::FChunk* Chunk = RecycledChunks;
+		RecycledChunks = Chunk->Next;
+		FreeChunk(Chunk);
+	}
+
+	// A thread that already allocated in the new frame has released its chunks itself
+	for (FFrameArenaThread* Thread = FirstThread; Thread; Thread = Thread->NextThread)
+	{
+		if (Thread->FrameIndex != NewFrameIndex)
+		{
+			Thread->ReleaseChunks();
+		}
+	}
+}
+
+SIZE_T FFrameArena::GetReservedSize()
+{
+	using namespace FrameArenaPrivate;
+
+	FScopeLock Lock(&GetLock());
+
+	SIZE_T Result = 0;
+	for (FFrameArenaThread::FChunk* Chunk = RecycledChunks; Chunk; Chunk = Chunk->Next)
+	{
+		Result += Chunk->Size;
+	}
+	for (FFrameArenaThread* Thread = FirstThread; Thread; Thread = Thread->NextThread)
+	{
+		for (FFrameArenaThread::FChunk* Chunk = Thread->Chunks; Chunk; Chunk = Chunk->Next)
+		{
+			Result += Chunk->Size;
+		}
+	}
+	return Result;
+}
+
+FFrameArenaThread::FFrameArenaThread()
+{
+	using namespace FrameArenaPrivate;
+
+	FScopeLock Lock(&GetLock());
+	NextThread = FirstThread;
+	FirstThread = this;
+}
+
+FFrameArenaThread::~FFrameArenaThread()
+{
+	using namespace FrameArenaPrivate;
+
+	FScopeLock Lock(&GetLock());
+	for (FFrameArenaThread** Link = &FirstThread; *Link; Link = &(*Link)->NextThread)
+	{
+		if (*Link == this)
+		{
+			*Link = NextThread;
+			break;
+		}
+	}
+	ReleaseChunks();
+}
+
+SIZE_T FFrameArenaThread::GetReservedSize() const
+{
+	FScopeLock Lock(&FrameArenaPrivate::GetLock());
+
+	SIZE_T Result = 0;
+	for (FChunk* Chunk = Chunks; Chunk; Chunk = Chunk->Next)
+	{
+		Result += Chunk->Size;
+	}
+	return Result;
+}
+
+void* FFrameArenaThread::AllocSlow(SIZE_T Size, uint32 Alignment, uint32 CurrentFrameIndex)
+{
+	using namespace FrameArenaPrivate;
+
+	// Page sized chunks come from the recycled chunks or the lock free page allocator, larger ones from the heap
+	const SIZE_T TotalSize = Size + Alignment + sizeof(FChunk);
+	const SIZE_T AllocSize = Align(TotalSize, (SIZE_T)FPageAllocator::PageSize);
+
+	FScopeLock Lock(&GetLock());
+
+	if (FrameIndex != CurrentFrameIndex)
+	{
+		// Only left if this thread got here while EndFrame was waiting for the lock
+		ReleaseChunks();
+		FrameIndex = CurrentFrameIndex;
+	}
+
+	FChunk* Chunk = nullptr;
+	if (AllocSize == FPageAllocator::PageSize)
+	{
+		if (RecycledChunks)
+		{
+			Chunk = RecycledChunks;
+			RecycledChunks = Chunk->Next;
+		}
+		else
+		{
+			Chunk = (FChunk*)FPageAllocator::Get().Alloc();
+		}
+	}
+	else
+	{
+		Chunk = (FChunk*)FMemory::Malloc(AllocSize);
+	}
+	Chunk->Size = AllocSize;
+	Chunk->Next = Chunks;
+	Chunks = Chunk;
+
+	uint8* Result = Align(Chunk->Data(), Alignment);
+	Top = Result + Size;
+	End = ((uint8*)Chunk) + AllocSize;
+	check(Top <= End);
+	return Result;
+}
+
+void FFrameArenaThread::ReleaseChunks()
+{
+	using namespace FrameArenaPrivate;
+
+	// Top and End are left alone, the owning thread may be reading them. They are reset by its next AllocSlow, which
+	// the frame index mismatch forces.
+	while (Chunks)
+	{
+		FChunk* Chunk = Chunks;
+		Chunks = Chunk->Next;
+
+		const SIZE_T ChunkSize = Chunk->Size;
+#if FRAME_ARENA_POISON
+		FMemory::Memset(Chunk->Data(), 0xcd, ChunkSize - sizeof(FChunk));
+#endif
+		if (ChunkSize == FPageAllocator::PageSize)
+		{
+			Chunk->Next = RecycledChunks;
+			RecycledChunks = Chunk;
+		}
+		else
+		{
+			FreeChunk(Chunk);
+		}
+	}
+}
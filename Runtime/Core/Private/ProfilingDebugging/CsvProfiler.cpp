@@ -110,6 +110,14 @@ TAutoConsoleVariable<int32> CVarCsvCompressionMode(
 	ECVF_Default
 );
 
+TAutoConsoleVariable<int32> CVarCsvBinaryOutput(
+	TEXT("csv.BinaryOutput"),
+	0,
+	TEXT("If 1, captures are written as columnar binary .csv.bin files instead of text. Binary files are never gzip compressed.\r\n")
+	TEXT("They are much smaller and faster to read than text, and are read directly by CsvStats based tools (PerfReportTool, CsvConvert etc)."),
+	ECVF_Default
+);
+
 TAutoConsoleVariable<int32> CVarCsvStatCounts(
 	TEXT("csv.statCounts"),
 	0,
@@ -1262,6 +1270,11 @@ public:
 		WriteString(Value);
 	}
 
+	void WriteBytes(const void* Data, int32 NumBytes)
+	{
+		SerializeInternal(const_cast<void*>(Data), NumBytes);
+	}
+
 private:
 	void WriteStringInternal(const FString& Str)
 	{
@@ -1368,6 +1381,66 @@ public:
 	}
 };
 
+/**
+ * Columnar binary format (.csv.bin, CSVBIN version 3), read by CsvBinStreamReader in Programs/CSVTools/CsvStats.
+ *
+ * The header is the .NET BinaryWriter encoding of the string "CSVBIN" followed by an int32 version, which is
+ * shared with the version 2 files written by CsvConvert. The rest of the file is a stream of blocks, each an
+ * EBlockType byte, a uint32 payload size and the payload, so readers can skip blocks they don't need:
+ *   Strings  - varint count, then strings (varint length + UTF-8), appended to the string table
+ *   Series   - varint count, then (varint name string index, uint8 EColumnType) appended to the columns
+ *   Frames   - varint frame count, varint column count, then per column a varint byte size followed by one
+ *              varint per frame. Int columns hold the zigzag encoded delta to the previous frame, float columns
+ *              hold the float bits xor'd with the previous frame. Both start from zero in every block, so each
+ *              block decodes on its own. Then varint event count and (varint frame offset, varint string index).
+ *   Metadata - varint count, then (varint key string index, varint value string index)
+ *   End      - empty, always the last block
+ * Integers other than varints are little endian.
+ */
+namespace CsvBinary
+{
+	static const int32 Version = 3;
+	static const int32 FramesPerBlock = 256;
+
+	enum class EBlockType : uint8
+	{
+		End = 0,
+		Strings = 1,
+		Series = 2,
+		Frames = 3,
+		Metadata = 4,
+	};
+
+	enum class EColumnType : uint8
+	{
+		Float = 0,
+		Int = 1,
+	};
+
+	static void WriteVarUInt(TArray<uint8>& Out, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Out.Add(uint8(Value) | 0x80);
+			Value >>= 7;
+		}
+		Out.Add(uint8(Value));
+	}
+
+	static void WriteVarInt(TArray<uint8>& Out, int64 Value)
+	{
+		// zigzag, so small negative deltas stay small
+		WriteVarUInt(Out, (uint64(Value) << 1) ^ uint64(Value >> 63));
+	}
+
+	static void WriteString(TArray<uint8>& Out, const FString& Str)
+	{
+		FTCHARToUTF8 Utf8(*Str);
+		WriteVarUInt(Out, Utf8.Length());
+		Out.Append((const uint8*)Utf8.Get(), Utf8.Length());
+	}
+}
+
 struct FCsvProcessedEvent
 {
 	inline uint64 GetAllocatedSize() const { return EventText.GetAllocatedSize(); }
@@ -1574,8 +1647,20 @@ class FCsvStreamWriter
 	uint32 RenderThreadId;
 	uint32 RHIThreadId;
 
+	// Binary output. Finalized rows are held until there are enough for a block, then encoded column by column
+	const bool bBinaryOutput;
+	TArray<FCsvRow> BinaryBlockRows;
+	TMap<FString, uint32> BinaryStringTable;
+	TArray<FString> BinaryPendingStrings;
+	int32 NumBinarySeriesWritten;
+
+	uint32 GetBinaryStringIndex(const FString& String);
+	void WriteBinaryBlock(CsvBinary::EBlockType BlockType, const TArray<uint8>& Payload);
+	void WriteBinaryPendingStrings();
+	void FlushBinaryRows();
+
 public:
-	FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, uint32 RenderThreadId, uint32 RHIThreadId);
+	FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, bool bInBinaryOutput, uint32 RenderThreadId, uint32 RHIThreadId);
 	~FCsvStreamWriter();
 
 	void AddSeries(FCsvStatSeries* Series);
@@ -1986,15 +2071,25 @@ private:
 	}
 };
 
-FCsvStreamWriter::FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, uint32 InRenderThreadId, uint32 InRHIThreadId)
-	: Stream(InOutputFile, InBufferSize, bInCompressOutput)
+FCsvStreamWriter::FCsvStreamWriter(const TSharedRef<FArchive>& InOutputFile, bool bInContinuousWrites, int32 InBufferSize, bool bInCompressOutput, bool bInBinaryOutput, uint32 InRenderThreadId, uint32 InRHIThreadId)
+	: Stream(InOutputFile, InBufferSize, bInCompressOutput && !bInBinaryOutput)
 	, WriteFrameIndex(-1)
 	, ReadFrameIndex(-1)
 	, bContinuousWrites(bInContinuousWrites)
 	, bFirstRow(true)
 	, RenderThreadId(InRenderThreadId)
 	, RHIThreadId(InRHIThreadId)
-{}
+	, bBinaryOutput(bInBinaryOutput)
+	, NumBinarySeriesWritten(0)
+{
+	if (bBinaryOutput)
+	{
+		// Same header as the .NET BinaryWriter writes: a length prefixed "CSVBIN" and an int32 version
+		const uint8 Magic[] = { 6, 'C', 'S', 'V', 'B', 'I', 'N' };
+		Stream.WriteBytes(Magic, sizeof(Magic));
+		Stream.WriteBytes(&CsvBinary::Version, sizeof(CsvBinary::Version));
+	}
+}
 
 FCsvStreamWriter::~FCsvStreamWriter()
 {
@@ -2034,10 +2129,136 @@ void FCsvStreamWriter::PushEvent(const FCsvProcessedEvent& Event)
 	Rows.FindOrAdd(Event.FrameNumber).Events.Add(Event);
 }
 
+uint32 FCsvStreamWriter::GetBinaryStringIndex(const FString& String)
+{
+	if (const uint32* Index = BinaryStringTable.Find(String))
+	{
+		return *Index;
+	}
+
+	const uint32 Index = BinaryStringTable.Num();
+	BinaryStringTable.Add(String, Index);
+	BinaryPendingStrings.Add(String);
+	return Index;
+}
+
+void FCsvStreamWriter::WriteBinaryBlock(CsvBinary::EBlockType BlockType, const TArray<uint8>& Payload)
+{
+	const uint8 Type = uint8(BlockType);
+	const uint32 PayloadSize = Payload.Num();
+	Stream.WriteBytes(&Type, sizeof(Type));
+	Stream.WriteBytes(&PayloadSize, sizeof(PayloadSize));
+	Stream.WriteBytes(Payload.GetData(), Payload.Num());
+}
+
+void FCsvStreamWriter::WriteBinaryPendingStrings()
+{
+	if (BinaryPendingStrings.Num() > 0)
+	{
+		TArray<uint8> Payload;
+		CsvBinary::WriteVarUInt(Payload, BinaryPendingStrings.Num());
+		for (const FString& String : BinaryPendingStrings)
+		{
+			CsvBinary::WriteString(Payload, String);
+		}
+		WriteBinaryBlock(CsvBinary::EBlockType::Strings, Payload);
+		BinaryPendingStrings.Reset();
+	}
+}
+
+void FCsvStreamWriter::FlushBinaryRows()
+{
+	if (BinaryBlockRows.Num() == 0)
+	{
+		return;
+	}
+
+	// Declare the series which appeared since the last block. Rows from before a series existed read as zero, as in text output
+	TArray<uint8> Payload;
+	if (NumBinarySeriesWritten < AllSeries.Num())
+	{
+		CsvBinary::WriteVarUInt(Payload, AllSeries.Num() - NumBinarySeriesWritten);
+		for (int32 ColumnIndex = NumBinarySeriesWritten; ColumnIndex < AllSeries.Num(); ++ColumnIndex)
+		{
+			const FCsvStatSeries* Series = AllSeries[ColumnIndex];
+			CsvBinary::WriteVarUInt(Payload, GetBinaryStringIndex(Series->Name));
+			Payload.Add(uint8(Series->SeriesType == FCsvStatSeries::EType::CustomStatInt ? CsvBinary::EColumnType::Int : CsvBinary::EColumnType::Float));
+		}
+		WriteBinaryPendingStrings();
+		WriteBinaryBlock(CsvBinary::EBlockType::Series, Payload);
+		NumBinarySeriesWritten = AllSeries.Num();
+		Payload.Reset();
+	}
+
+	// Events go after the columns in the block, but their strings have to be in the table first
+	TArray<uint8> EventData;
+	int32 NumEvents = 0;
+	for (int32 RowIndex = 0; RowIndex < BinaryBlockRows.Num(); ++RowIndex)
+	{
+		for (const FCsvProcessedEvent& Event : BinaryBlockRows[RowIndex].Events)
+		{
+			CsvBinary::WriteVarUInt(EventData, RowIndex);
+			CsvBinary::WriteVarUInt(EventData, GetBinaryStringIndex(Event.GetFullName()));
+			++NumEvents;
+		}
+	}
+	WriteBinaryPendingStrings();
+
+	CsvBinary::WriteVarUInt(Payload, BinaryBlockRows.Num());
+	CsvBinary::WriteVarUInt(Payload, AllSeries.Num());
+	TArray<uint8> ColumnData;
+	for (const FCsvStatSeries* Series : AllSeries)
+	{
+		const bool bIsInt = Series->SeriesType == FCsvStatSeries::EType::CustomStatInt;
+		int32 PreviousValue = 0;
+		ColumnData.Reset();
+		for (const FCsvRow& Row : BinaryBlockRows)
+		{
+			const int32 Value = Row.Values.IsValidIndex(Series->ColumnIndex) ? Row.Values[Series->ColumnIndex].Value.AsInt : 0;
+			if (bIsInt)
+			{
+				CsvBinary::WriteVarInt(ColumnData, int64(Value) - int64(PreviousValue));
+			}
+			else
+			{
+				CsvBinary::WriteVarUInt(ColumnData, uint32(Value ^ PreviousValue));
+			}
+			PreviousValue = Value;
+		}
+		CsvBinary::WriteVarUInt(Payload, ColumnData.Num());
+		Payload.Append(ColumnData);
+	}
+	CsvBinary::WriteVarUInt(Payload, NumEvents);
+	Payload.Append(EventData);
+
+	WriteBinaryBlock(CsvBinary::EBlockType::Frames, Payload);
+	BinaryBlockRows.Reset();
+}
+
 void FCsvStreamWriter::FinalizeNextRow()
 {
 	ReadFrameIndex++;
 
+	if (bBinaryOutput)
+	{
+		// Don't remove yet. Flushing series may modify this row
+		if (Rows.Find(ReadFrameIndex))
+		{
+			for (FCsvStatSeries* Series : AllSeries)
+			{
+				if (Series->CurrentWriteFrameNumber == ReadFrameIndex)
+					Series->FlushIfDirty();
+			}
+
+			BinaryBlockRows.Add(Rows.FindAndRemoveChecked(ReadFrameIndex));
+			if (BinaryBlockRows.Num() >= CsvBinary::FramesPerBlock)
+			{
+				FlushBinaryRows();
+			}
+		}
+		return;
+	}
+
 	if (bFirstRow)
 	{
 		// Write the first header row
@@ -2115,6 +2336,23 @@ void FCsvStreamWriter::Finalize(const TMap<FString, FString>& Metadata)
 		FinalizeNextRow();
 	}
 
+	if (bBinaryOutput)
+	{
+		FlushBinaryRows();
+
+		TArray<uint8> Payload;
+		CsvBinary::WriteVarUInt(Payload, Metadata.Num());
+		for (const auto& Pair : Metadata)
+		{
+			CsvBinary::WriteVarUInt(Payload, GetBinaryStringIndex(Pair.Key));
+			CsvBinary::WriteVarUInt(Payload, GetBinaryStringIndex(Pair.Value));
+		}
+		WriteBinaryPendingStrings();
+		WriteBinaryBlock(CsvBinary::EBlockType::Metadata, Payload);
+		WriteBinaryBlock(CsvBinary::EBlockType::End, TArray<uint8>());
+		return;
+	}
+
 	// Write a final summary header row
 	Stream.WriteString("EVENTS");
 	for (FCsvStatSeries* Series : AllSeries)
@@ -2180,9 +2418,13 @@ uint64 FCsvStreamWriter::GetAllocatedSize() const
 		((uint64)Rows.GetAllocatedSize()) +
 		((uint64)AllSeries.GetAllocatedSize()) +
 		((uint64)DataProcessors.GetAllocatedSize()) +
-		((uint64)Stream.GetAllocatedSize());
+		((uint64)Stream.GetAllocatedSize()) +
+		((uint64)BinaryBlockRows.GetAllocatedSize()) +
+		((uint64)BinaryStringTable.GetAllocatedSize());
 
 	for (const auto& Pair          : Rows)           { Size += (uint64)Pair.Value.GetAllocatedSize();     }
+	for (const auto& Row           : BinaryBlockRows){ Size += (uint64)Row.GetAllocatedSize();            }
+	for (const auto& Pair          : BinaryStringTable) { Size += (uint64)Pair.Key.GetAllocatedSize();    }
 	for (const auto& Series        : AllSeries)      { Size += (uint64)Series->GetAllocatedSize();        }
 	for (const auto& DataProcessor : DataProcessors) { Size += (uint64)DataProcessor->GetAllocatedSize(); }
 
@@ -2597,7 +2839,14 @@ void FCsvProfiler::BeginFrame()
 					break;
 				}
 
-				const TCHAR* CsvExtension = bCompressOutput ? TEXT(".csv.gz") : TEXT(".csv");
+				// Binary output is already compact, and the tools read it without decompressing
+				const bool bBinaryOutput = CVarCsvBinaryOutput.GetValueOnGameThread() != 0;
+				if (bBinaryOutput)
+				{
+					bCompressOutput = false;
+				}
+
+				const TCHAR* CsvExtension = bBinaryOutput ? TEXT(".csv.bin") : bCompressOutput ? TEXT(".csv.gz") : TEXT(".csv");
 
 				// Determine the output path and filename based on override params
 				FString DestinationFolder = CurrentCommand.DestinationFolder.IsEmpty() ? FPaths::ProfilingDir() + TEXT("CSV/") : CurrentCommand.DestinationFolder + TEXT("/");
@@ -2612,7 +2861,7 @@ void FCsvProfiler::BeginFrame()
 				else
 				{
 					
-					CsvWriter = new FCsvStreamWriter(OutputFile.ToSharedRef(), bContinuousWrites, BufferSize, bCompressOutput, RenderThreadId, RHIThreadId);
+					CsvWriter = new FCsvStreamWriter(OutputFile.ToSharedRef(), bContinuousWrites, BufferSize, bCompressOutput, bBinaryOutput, RenderThreadId, RHIThreadId);
 
 					NumFramesToCapture = CurrentCommand.Value;
 					GCsvRepeatFrameCount = NumFramesToCapture;
@@ -3292,6 +3541,10 @@ void FCsvProfiler::Init()
 			break;
 		}
 	}
+	if (FParse::Param(FCommandLine::Get(), TEXT("csvBinary")))
+	{
+		CVarCsvBinaryOutput->Set(1);
+	}
 	GCsvABTest.InitFromCommandline();
 #endif // CSV_PROFILER_ALLOW_DEBUG_FEATURES
 
@@ -3470,4 +3723,99 @@ void CSVTest()
 
 #endif // CSV_PROFILER_ALLOW_DEBUG_FEATURES
 
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryWriter.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCsvProfilerBinaryOutputTest, "System.Core.Profiling.CsvProfiler.BinaryOutput", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FCsvProfilerBinaryOutputTest::RunTest(const FString& Parameters)
+{
+	// Stats registered by name, skipping the stat ID lookup which has to run on the processing thread
+	class FTestStatRegister : public FCsvStatRegister
+	{
+	public:
+		int32 AddStat(const FString& Name)
+		{
+			StatNames.Add(Name);
+			StatCategoryIndices.Add(0);
+			StatFlags.Add(0);
+			return StatIndexCount++;
+		}
+	};
+
+	// Writes the capture in Programs/CSVTools/CsvStatsTests/Fixtures/EngineCapture.csvbin, which the CSVTools tests read back
+	TArray<uint8> Output;
+	{
+		FTestStatRegister StatRegister;
+		FCsvStreamWriter Writer(MakeShareable(new FMemoryWriter(Output)), false, 0, false, true, 0, 0);
+		FCsvStatSeries FrameTime(FCsvStatSeries::EType::CustomStatFloat, StatRegister.AddStat(TEXT("FrameTime")), &Writer, StatRegister, TEXT("GameThread"));
+		FCsvStatSeries Memory(FCsvStatSeries::EType::CustomStatInt, StatRegister.AddStat(TEXT("Memory")), &Writer, StatRegister, TEXT("GameThread"));
+
+		const uint32 NumFrames = CsvBinary::FramesPerBlock + 10;
+		for (uint32 FrameNumber = 0; FrameNumber < NumFrames; ++FrameNumber)
+		{
+			FrameTime.SetCustomStatValue_Float(FrameNumber, ECsvCustomStatOp::Set, 16.5f + float(FrameNumber % 7) * 0.25f);
+			Memory.SetCustomStatValue_Int(FrameNumber, ECsvCustomStatOp::Set, 1000 + int32(FrameNumber * 37) % 101 - 50);
+			if (FrameNumber == 100 || FrameNumber == 259)
+			{
+				FCsvProcessedEvent Event;
+				Event.EventText = TEXT("Hitch");
+				Event.FrameNumber = FrameNumber;
+				Event.CategoryIndex = 0;
+				Writer.PushEvent(Event);
+			}
+		}
+		FrameTime.FlushIfDirty();
+		Memory.FlushIfDirty();
+
+		TMap<FString, FString> Metadata;
+		Metadata.Add(TEXT("Platform"), TEXT("Test"));
+		Writer.Finalize(Metadata);
+	}
+
+	const uint8 Header[] = { 6, 'C', 'S', 'V', 'B', 'I', 'N', uint8(CsvBinary::Version), 0, 0, 0 };
+	TestTrue(TEXT("Header"), Output.Num() >= int32(sizeof(Header)) && FMemory::Memcmp(Output.GetData(), Header, sizeof(Header)) == 0);
+
+	// Blocks are written as strings are first needed: series names, then event names, then metadata
+	const CsvBinary::EBlockType ExpectedBlocks[] =
+	{
+		CsvBinary::EBlockType::Strings, CsvBinary::EBlockType::Series, CsvBinary::EBlockType::Strings, CsvBinary::EBlockType::Frames,
+		CsvBinary::EBlockType::Frames, CsvBinary::EBlockType::Strings, CsvBinary::EBlockType::Metadata, CsvBinary::EBlockType::End,
+	};
+	int32 Offset = sizeof(Header);
+	for (CsvBinary::EBlockType ExpectedBlock : ExpectedBlocks)
+	{
+		if (!TestTrue(TEXT("Block header in range"), Offset + 5 <= Output.Num()))
+		{
+			return false;
+		}
+		uint32 PayloadSize;
+		FMemory::Memcpy(&PayloadSize, &Output[Offset + 1], sizeof(PayloadSize));
+		TestEqual(TEXT("Block type"), int32(Output[Offset]), int32(ExpectedBlock));
+		Offset += 5 + PayloadSize;
+	}
+	TestEqual(TEXT("Capture size"), Offset, Output.Num());
+
+	const FString FixturePath = FPaths::EngineSourceDir() / TEXT("Programs/CSVTools/CsvStatsTests/Fixtures/EngineCapture.csvbin");
+	TArray<uint8> Fixture;
+	if (!FFileHelper::LoadFileToArray(Fixture, *FixturePath, FILEREAD_Silent))
+	{
+		AddWarning(FString::Printf(TEXT("%s not found, only the block layout was checked"), *FixturePath));
+	}
+	else if (Fixture != Output)
+	{
+		// Left next to the test results, to replace the fixture when the format changes on purpose
+		const FString ActualPath = FPaths::AutomationDir() / TEXT("EngineCapture.csvbin");
+		FFileHelper::SaveArrayToFile(Output, *ActualPath);
+		AddError(FString::Printf(TEXT("Binary output does not match %s, it was saved to %s"), *FixturePath, *ActualPath));
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
+
 #endif // CSV_PROFILER
@@ -1586,6 +1586,55 @@ PRAGMA_ENABLE_DEPRECATION_WARNINGS
 
 		return true;
 	}
+
+	IMPLEMENT_SIMPLE_AUTOMATION_TEST(FParallelForBatchingTest, "System.Core.Async.ParallelFor.Batching", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter);
+
+	bool FParallelForBatchingTest::RunTest(const FString& Parameters)
+	{
+		// every item must be visited exactly once whatever the batch size and the number of threads end up being
+		auto CheckVisitedOnce = [this](const TCHAR* What, int32 Num, TFunctionRef<void(TFunctionRef<void(int32)>)> RunLoop)
+		{
+			TArray<std::atomic<int32>> Visits;
+			Visits.SetNum(Num);
+			for (std::atomic<int32>& Visit : Visits)
+			{
+				Visit = 0;
+			}
+			RunLoop([&Visits](int32 Index) { Visits[Index]++; });
+
+			int32 NumWrong = 0;
+			for (std::atomic<int32>& Visit : Visits)
+			{
+				NumWrong += Visit != 1 ? 1 : 0;
+			}
+			TestEqual(FString::Printf(TEXT("%s, %d items visited once"), What, Num), NumWrong, 0);
+		};
+
+		const int32 Nums[] = { 0, 1, 7, 64, 1000, 100000 };
+		const int32 MinBatchSizes[] = { 0, 1, 3, 64, 4096 };
+		for (int32 Num : Nums)
+		{
+			for (int32 MinBatchSize : MinBatchSizes)
+			{
+				CheckVisitedOnce(*FString::Printf(TEXT("MinBatchSize %d"), MinBatchSize), Num, [Num, MinBatchSize](TFunctionRef<void(int32)> Body) { ParallelFor(Num, MinBatchSize, Body); });
+				CheckVisitedOnce(*FString::Printf(TEXT("Unbalanced, MinBatchSize %d"), MinBatchSize), Num, [Num, MinBatchSize](TFunctionRef<void(int32)> Body) { ParallelFor(Num, MinBatchSize, Body, EParallelForFlags::Unbalanced); });
+			}
+		}
+
+		// the first call measures the cost per item, the later ones size their batches from it
+		static FParallelForCallSite CallSite(TEXT("ParallelForBatchingTest"));
+		FParallelForCallSite::ResetStats();
+		for (int32 Iteration = 0; Iteration < 4; ++Iteration)
+		{
+			for (int32 Num : Nums)
+			{
+				CheckVisitedOnce(TEXT("Adaptive"), Num, [Num](TFunctionRef<void(int32)> Body) { ParallelFor(CallSite, Num, 1, Body, EParallelForFlags::Adaptive); });
+			}
+		}
+		TestTrue(TEXT("Adaptive call site measured the cost of an item"), CallSite.GetCyclesPerItem() > 0.0f);
+
+		return true;
+	}
 }
 
 #endif //WITH_DEV_AUTOMATION_TESTS
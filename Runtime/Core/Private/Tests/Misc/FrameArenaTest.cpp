@@ -0,0 +1,157 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "CoreTypes.h"
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Misc/FrameArena.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameArenaTest, "System.Core.Misc.FrameArena", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FFrameArenaTest::RunTest(const FString& Parameters)
+{
+	// alignment, and allocations larger than a page
+	{
+		void* Small = FFrameArena::Alloc(3, 1);
+		void* Aligned = FFrameArena::Alloc(16, 64);
+		void* Large = FFrameArena::Alloc(1024 * 1024, 16);
+
+		TestTrue(TEXT("Small allocations must succeed"), Small != nullptr);
+		TestTrue(TEXT("Allocations must respect the alignment"), IsAligned(Aligned, 64));
+		TestTrue(TEXT("Allocations larger than a page must succeed"), Large != nullptr && IsAligned(Large, 16));
+		FMemory::Memset(Large, 0xab, 1024 * 1024);
+	}
+
+	// arrays keep their elements when they grow
+	{
+		TArray<int32, TFrameArenaAllocator<>> Array;
+		for (int32 Index = 0; Index < 10000; ++Index)
+		{
+			Array.Add(Index);
+		}
+
+		bool bAllMatch = true;
+		for (int32 Index = 0; Index < Array.Num(); ++Index)
+		{
+			bAllMatch &= Array[Index] == Index;
+		}
+		TestTrue(TEXT("Array elements must survive reallocation"), bAllMatch);
+
+		TArray<int32, TFrameArenaAllocator<>> Moved = MoveTemp(Array);
+		TestEqual(TEXT("Moved array must keep its elements"), Moved.Num(), 10000);
+		TestEqual(TEXT("Moved from array must be empty"), Array.Num(), 0);
+	}
+
+	// maps
+	{
+		TMap<int32, int32, FFrameArenaSetAllocator> Map;
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			Map.Add(Index, Index * 2);
+		}
+		Map.Remove(500);
+
+		TestEqual(TEXT("Map must hold all the added elements"), Map.Num(), 999);
+		TestTrue(TEXT("Map must find the added elements"), Map.FindRef(999) == 1998);
+		TestTrue(TEXT("Map must not find removed elements"), Map.Find(500) == nullptr);
+	}
+
+	// arrays filled by workers and read on this thread
+	{
+		const int32 NumBatches = 16;
+		TArray<TArray<int32, TFrameArenaAllocator<>>> Batches;
+		Batches.SetNum(NumBatches);
+
+		ParallelFor(NumBatches, [&Batches](int32 BatchIndex)
+		{
+			for (int32 Index = 0; Index < 1000; ++Index)
+			{
+				Batches[BatchIndex].Add(BatchIndex * 1000 + Index);
+			}
+		});
+
+		bool bAllMatch = true;
+		for (int32 BatchIndex = 0; BatchIndex < NumBatches; ++BatchIndex)
+		{
+			bAllMatch &= Batches[BatchIndex].Num() == 1000;
+			for (int32 Index = 0; Index < Batches[BatchIndex].Num(); ++Index)
+			{
+				bAllMatch &= Batches[BatchIndex][Index] == BatchIndex * 1000 + Index;
+			}
+		}
+		TestTrue(TEXT("Arrays filled by workers must be readable from other threads"), bAllMatch);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFrameArenaEndFrameTest, "System.Core.Misc.FrameArena.EndFrame", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::SmokeFilter)
+
+bool FFrameArenaEndFrameTest::RunTest(const FString& Parameters)
+{
+	// Ends frames like the engine loop does, which releases anything other code allocated from the arena this frame
+	if (!IsInGameThread())
+	{
+		AddError(TEXT("FFrameArena::EndFrame can only be called on the game thread"));
+		return false;
+	}
+
+	// fill arrays from workers, whose chunks EndFrame has to release without the workers allocating again
+	const int32 NumBatches = 16;
+	TArray<TArray<int32, TFrameArenaAllocator<>>> Batches;
+	Batches.SetNum(NumBatches);
+	ParallelFor(NumBatches, [&Batches](int32 BatchIndex)
+	{
+		for (int32 Index = 0; Index < 1000; ++Index)
+		{
+			Batches[BatchIndex].Add(Index);
+		}
+	});
+
+	TArray<int32, TFrameArenaAllocator<>> Array;
+	Array.Add(1);
+	TestTrue(TEXT("Threads that allocated must own chunks"), FFrameArena::GetReservedSize() > 0 && FFrameArenaThread::Get().GetReservedSize() > 0);
+	TestTrue(TEXT("A container allocated this frame must be usable"), Array.GetAllocatorInstance().IsUsableThisFrame());
+
+	const uint32 FrameIndex = FFrameArena::GetFrameIndex();
+	FFrameArena::EndFrame();
+	TestEqual(TEXT("EndFrame must advance the frame index"), FFrameArena::GetFrameIndex(), FrameIndex + 1);
+	TestEqual(TEXT("EndFrame must release the chunks of this thread"), FFrameArenaThread::Get().GetReservedSize(), (SIZE_T)0);
+
+#if DO_CHECK
+	// Growing these would trip the checkf in ResizeAllocation
+	TestFalse(TEXT("A container allocated in an ended frame must not be usable"), Array.GetAllocatorInstance().IsUsableThisFrame());
+	TestFalse(TEXT("A container filled by a worker in an ended frame must not be usable"), Batches[0].GetAllocatorInstance().IsUsableThisFrame());
+#endif
+
+	// The first allocation of the new frame reuses a released page
+	{
+		const uint8* Data = (const uint8*)FFrameArena::Alloc(256, 16);
+		TestTrue(TEXT("Allocating after EndFrame must succeed"), Data != nullptr);
+
+#if FRAME_ARENA_POISON
+		bool bPoisoned = true;
+		for (int32 Index = 0; Index < 256; ++Index)
+		{
+			bPoisoned &= Data[Index] == 0xcd;
+		}
+		TestTrue(TEXT("Released memory must be poisoned"), bPoisoned);
+#endif
+
+		TArray<int32, TFrameArenaAllocator<>> NewArray;
+		NewArray.Add(1);
+		TestTrue(TEXT("A container allocated in the new frame must be usable"), NewArray.GetAllocatorInstance().IsUsableThisFrame());
+	}
+
+	// Pages nobody needed for a whole frame go back to the page allocator
+	FFrameArena::EndFrame();
+	FFrameArena::EndFrame();
+	TestEqual(TEXT("Two frames without allocations must release everything"), FFrameArena::GetReservedSize(), (SIZE_T)0);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
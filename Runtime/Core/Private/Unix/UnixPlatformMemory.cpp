@@ -29,6 +29,8 @@
 #endif
 #include <sys/file.h>
 #include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 #include "GenericPlatform/OSAllocationPool.h"
 #include "Misc/ScopeLock.h"
@@ -85,6 +87,51 @@ namespace
 	// The max allowed to be set for the caching
 	const int32 MaximumAllowedMaxNumFileMappingCache = 1000000;
 	bool GEnableProtectForkedPages = false;
+
+	/** Back pooled OS allocations with transparent huge pages, enabled with -hugepages */
+	bool GUseHugePagesForPools = false;
+
+	/** Keep pooled OS allocations apart per NUMA node, enabled with -numapools */
+	bool GUseNumaPools = false;
+
+	/** Number of NUMA nodes the pools are kept apart for, stays 1 unless -numapools is set */
+	int32 GNumPooledMemoryNodes = 1;
+
+	/** Size of a transparent huge page on x86-64 and (with 4KB base pages) on arm64 */
+	const SIZE_T HugePageSize = 2 * 1024 * 1024;
+
+	/**
+	 * Reads the number of NUMA nodes from sysfs. This runs before the allocator is created, so it must only use libc.
+	 */
+	int32 ReadNumNumaNodes()
+	{
+		int32 NumNodes = 1;
+#if !PLATFORM_FREEBSD
+		if (FILE* NodesFile = fopen("/sys/devices/system/node/possible", "r"))
+		{
+			// the list looks like "0", "0-1" or "0,2-3", so the highest node id is the largest number in it
+			char Buffer[256] = { 0 };
+			if (fgets(Buffer, sizeof(Buffer), NodesFile))
+			{
+				int32 HighestNode = 0;
+				for (char* Cursor = Buffer; *Cursor; )
+				{
+					if (*Cursor >= '0' && *Cursor <= '9')
+					{
+						HighestNode = FMath::Max(HighestNode, (int32)strtol(Cursor, &Cursor, 10));
+					}
+					else
+					{
+						++Cursor;
+					}
+				}
+				NumNodes = HighestNode + 1;
+			}
+			fclose(NodesFile);
+		}
+#endif // !PLATFORM_FREEBSD
+		return NumNodes;
+	}
 }
 
 /** Controls growth of pools - see PooledVirtualMemoryAllocator.cpp */
@@ -106,6 +153,10 @@ void FUnixPlatformMemory::Init()
 	UE_LOG(LogInit, Log, TEXT(" - VirtualMemoryAllocator pools will grow at scale %g"), GVMAPoolScale);
 	UE_LOG(LogInit, Log, TEXT(" - MemoryRangeDecommit() will %s"), 
 		GMemoryRangeDecommitIsNoOp ? TEXT("be a no-op (re-run with -vmapoolevict to change)") : TEXT("will evict the memory from RAM (re-run with -novmapoolevict to change)"));
+	UE_LOG(LogInit, Log, TEXT(" - VirtualMemoryAllocator pools will %s"),
+		GUseHugePagesForPools ? TEXT("be backed by transparent huge pages") : TEXT("not ask for transparent huge pages (re-run with -hugepages to change)"));
+	UE_LOG(LogInit, Log, TEXT(" - VirtualMemoryAllocator pools are kept apart for %d NUMA node(s)%s"),
+		GNumPooledMemoryNodes, GUseNumaPools ? TEXT("") : TEXT(" (re-run with -numapools to change)"));
 }
 
 bool FUnixPlatformMemory::HasForkPageProtectorEnabled()
@@ -260,10 +311,24 @@ class FMalloc* FUnixPlatformMemory::BaseAllocator()
 				{
 					GEnableProtectForkedPages = true;
 				}
+				if (FCStringAnsi::Stricmp(Arg, "-hugepages") == 0)
+				{
+					GUseHugePagesForPools = true;
+				}
+				if (FCStringAnsi::Stricmp(Arg, "-numapools") == 0)
+				{
+					GUseNumaPools = true;
+				}
 			}
 			free(Arg);
 			fclose(CmdLineFile);
 		}
+
+		// needs to be known before the allocator creates its pools
+		if (GUseNumaPools)
+		{
+			GNumPooledMemoryNodes = ReadNumNumaNodes();
+		}
 	}
 
 	FMalloc * Allocator = NULL;
@@ -545,6 +610,53 @@ void FUnixPlatformMemory::BinnedFreeToOS(void* Ptr, SIZE_T Size)
 	}
 }
 
+int32 FUnixPlatformMemory::GetNumPooledMemoryNodes()
+{
+	return GNumPooledMemoryNodes;
+}
+
+int32 FUnixPlatformMemory::GetCurrentPooledMemoryNode()
+{
+#if !PLATFORM_FREEBSD
+	if (GNumPooledMemoryNodes > 1)
+	{
+		unsigned int Cpu = 0;
+		unsigned int Node = 0;
+		if (syscall(SYS_getcpu, &Cpu, &Node, nullptr) == 0 && Node < (unsigned int)GNumPooledMemoryNodes)
+		{
+			return (int32)Node;
+		}
+	}
+#endif // !PLATFORM_FREEBSD
+	return 0;
+}
+
+SIZE_T FUnixPlatformMemory::GetPooledMemoryAlignment()
+{
+	return GUseHugePagesForPools ? HugePageSize : 65536;
+}
+
+void FUnixPlatformMemory::AdvisePooledMemory(void* Ptr, SIZE_T Size, int32 MemoryNode)
+{
+#if !PLATFORM_FREEBSD
+#ifdef MADV_HUGEPAGE
+	if (GUseHugePagesForPools)
+	{
+		// only has an effect if /sys/kernel/mm/transparent_hugepage/enabled is "madvise" or "always", the kernel falls back to small pages when it has no huge ones
+		madvise(Ptr, Size, MADV_HUGEPAGE);
+	}
+#endif // MADV_HUGEPAGE
+
+	if (GNumPooledMemoryNodes > 1)
+	{
+		// prefer rather than bind, so that the pages still come from another node when this one is full. MPOL_PREFERRED is from numaif.h, which we don't want to depend on.
+		const int MPolPreferred = 1;
+		unsigned long NodeMask = 1ul << MemoryNode;
+		syscall(SYS_mbind, Ptr, Size, MPolPreferred, &NodeMask, sizeof(NodeMask) * 8, 0);
+	}
+#endif // !PLATFORM_FREEBSD
+}
+
 size_t FUnixPlatformMemory::FPlatformVirtualMemoryBlock::GetVirtualSizeAlignment()
 {
 	static SIZE_T OSPageSize = FPlatformMemory::GetConstants().PageSize;
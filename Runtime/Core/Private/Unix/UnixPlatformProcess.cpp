@@ -30,6 +30,7 @@
 #include "Misc/CoreDelegates.h"
 #include "Misc/App.h"
 #include "Misc/Fork.h"
+#include "Containers/Ticker.h"
 
 namespace PlatformProcessLimits
 {
@@ -1299,6 +1300,9 @@ void FUnixPlatformProcess::TerminateProc( FProcHandle & ProcessHandle, bool Kill
  * If -WaitAndForkCmdLinePath=Foo is suppled, the command line parameters of the child processes will be filled out with the contents
  *     of files found in the directory referred to by Foo, where the child's "index" is the name of the file to be read in the directory.
  * If -WaitAndForkRequireResponse is on the command line, child processes will not proceed after being spawned until a SIGRTMIN+2 signal is sent to them.
+ * Before the first fork the parent collects garbage and trims the allocator, and each child allocates from fresh pages instead of the partially
+ *     used pages it shares with the parent, so that children copy as few pages as possible. -NoPreForkSeal turns this off.
+ * If -WaitAndForkMemoryReportInterval=x is supplied, each child logs how much of its resident memory is still shared with the parent every x seconds.
  */
 FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 {
@@ -1344,6 +1348,13 @@ FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 	// If we are asked to wait for a response signal, keep track of that here so we can behave differently in children.
 	const bool bRequireResponseSignal = FParse::Param(FCommandLine::Get(), TEXT("WaitAndForkRequireResponse"));
 
+	// Unless asked not to, seal the heap before forking so that children share as many of the parent's pages as possible.
+	const bool bSealHeapBeforeFork = !FParse::Param(FCommandLine::Get(), TEXT("NoPreForkSeal"));
+	bool bHeapSealed = false;
+
+	float ChildMemoryReportInterval = 0.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("-WaitAndForkMemoryReportInterval="), ChildMemoryReportInterval);
+
 	// Set up a signal handler for the signal to fork()
 	{
 		struct sigaction Action;
@@ -1400,6 +1411,17 @@ FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 			// Sleep for a short while to avoid spamming new processes to the OS all at once
 			FPlatformProcess::Sleep(WAIT_AND_FORK_CHILD_SPAWN_DELAY);
 
+			if (bSealHeapBeforeFork && !bHeapSealed)
+			{
+				// Everything freed from here on is freed before the children share it, rather than in every child
+				const double SealStartTime = FPlatformTime::Seconds();
+				FCoreDelegates::OnParentPreFork.Broadcast();
+				GMalloc->Trim(true);
+				bHeapSealed = true;
+
+				UE_LOG(LogHAL, Log, TEXT("WaitAndFork sealed the heap before forking in %.02fms"), (FPlatformTime::Seconds() - SealStartTime) * 1000.0);
+			}
+
 			FMemoryStatsHolder CurrentMasterMemStats(FPlatformMemory::GetStats());
 			UE_LOG(LogHAL, Log, TEXT("MemoryStats PreFork: AvailablePhysical: %.02fMiB (%+.02fMiB), PeakPhysical: %.02fMiB, PeakVirtual: %.02fMiB"),
 				CurrentMasterMemStats.AvailablePhysical, (CurrentMasterMemStats.AvailablePhysical - PreviousMasterMemStats.AvailablePhysical),
@@ -1411,6 +1433,11 @@ FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 			// Make sure there are no pending messages in the log.
 			GLog->Flush();
 
+			if (bSealHeapBeforeFork)
+			{
+				GMalloc->OnPreFork();
+			}
+
 			// ******** The fork happens here! ********
 			pid_t ChildPID = fork();
 			// ******** The fork happened! This is now either the parent process or the new child process ********
@@ -1428,6 +1455,11 @@ FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 			{
 				FForkProcessHelper::SetIsForkedChildProcess();
 
+				if (bSealHeapBeforeFork)
+				{
+					GMalloc->OnPostFork();
+				}
+
 				if (FPlatformMemory::HasForkPageProtectorEnabled())
 				{
 					UE::FForkPageProtector::OverrideGMalloc();
@@ -1503,6 +1535,22 @@ FGenericPlatformProcess::EWaitAndForkResult FUnixPlatformProcess::WaitAndFork()
 				UE_LOG(LogHAL, Log, TEXT("[Child] WaitAndFork child process has started with pid %d."), GetCurrentProcessId());
 				FApp::PrintStartupLogMessages();
 
+				// Report how much of the parent's memory this child still shares, now and periodically if requested
+				auto LogChildMemoryStats = [](float DeltaTime)
+				{
+					const FExtendedPlatformMemoryStats ExtendedStats = FPlatformMemory::GetExtendedStats();
+					const float SharedMiB = (ExtendedStats.Shared_Clean + ExtendedStats.Shared_Dirty) / (1024.f * 1024.f);
+					const float PrivateMiB = (ExtendedStats.Private_Clean + ExtendedStats.Private_Dirty) / (1024.f * 1024.f);
+					UE_LOG(LogHAL, Log, TEXT("[Child] MemoryStats: Shared: %.02fMiB, Private: %.02fMiB (%.02fMiB dirty)"),
+						SharedMiB, PrivateMiB, ExtendedStats.Private_Dirty / (1024.f * 1024.f));
+					return true;
+				};
+				LogChildMemoryStats(0.0f);
+				if (ChildMemoryReportInterval > 0.0f)
+				{
+					FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(LogChildMemoryStats), ChildMemoryReportInterval);
+				}
+
 				// Children break out of the loop and return
 				RetVal = EWaitAndForkResult::Child;
 				break;
@@ -299,6 +299,13 @@ public:
 			return nullptr;
 		}
 
+		//urgent (ETaskPriority::High) work from the global queue, checked ahead of lower priority local work and without the
+		//throttling DequeueGlobal applies, so deadline and frame critical tasks that overflowed don't wait behind background work
+		inline FTask* DequeueUrgent(bool GetBackGroundTasks)
+		{
+			return Registry->OverflowQueues[int32(ETaskPriority::High)].dequeue(DequeueHazards[int32(ETaskPriority::High)]);
+		}
+
 		inline FTask* DequeueGlobal(bool GetBackGroundTasks)
 		{
 			if ((Registry->NumActiveWorkers[GetBackGroundTasks].load(std::memory_order_relaxed) >= (2 * Registry->NumWorkersLookingForWork[GetBackGroundTasks].load(std::memory_order_relaxed) - 1)) || ((Random.GetUnsignedInt() % 4) == 0))
@@ -407,6 +414,18 @@ private:
 		uint32 MaxPriority = GetBackGroundTasks ? int32(ETaskPriority::Count) : int32(ETaskPriority::ForegroundCount);
 		CachedRandomIndex = CachedRandomIndex % NumQueues;
 
+		//look for urgent work in every queue before stealing anything else
+		for(uint32 i = 0; i < NumQueues; i++)
+		{
+			TLocalQueue* LocalQueue = Queues->LocalQueues[(CachedRandomIndex + i) % NumQueues];
+			FTask* Item;
+			if (LocalQueue->LocalQueues[uint32(ETaskPriority::High)].Steal(Item))
+			{
+				Hazard.Retire();
+				return Item;
+			}
+		}
+
 		for(uint32 i = 0; i < NumQueues; i++)
 		{
 			TLocalQueue* LocalQueue = Queues->LocalQueues[CachedRandomIndex];
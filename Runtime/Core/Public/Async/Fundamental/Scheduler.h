@@ -87,6 +87,9 @@ namespace LowLevelTasks
 		//get the active task if any
 		CORE_API static const FTask* GetActiveTask();
 
+		//number of tasks launched with InitWithDeadline that finished after their deadline, since startup
+		CORE_API static uint32 GetNumMissedDeadlines();
+
 		CORE_API bool IsWorkerThread() const;
 
 	private: //Private Interface of the Scheduler	
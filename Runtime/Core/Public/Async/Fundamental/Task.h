@@ -4,6 +4,7 @@
 #include "Logging/LogMacros.h"
 #include "TaskDelegate.h"
 #include "CoreTypes.h"
+#include "HAL/PlatformTime.h"
 #include <atomic>
 
 namespace LowLevelTasks
@@ -66,6 +67,9 @@ namespace LowLevelTasks
 	class FTask;
 	namespace Tasks_Impl
 	{
+	//called by a worker when a task with a deadline finished its runnable after the deadline, counts the miss and emits a trace bookmark
+	CORE_API void ReportMissedDeadline(const TCHAR* DebugName, uint64 DeadlineCycles, uint64 CompletedCycles);
+
 	class FTaskBase
 	{
 		friend class ::LowLevelTasks::FTask;
@@ -200,6 +204,15 @@ namespace LowLevelTasks
 		template<typename TRunnable>
 		inline void Init(const TCHAR* InDebugName, TRunnable&& InRunnable);
 
+		//InDeadlineCycles is an absolute FPlatformTime::Cycles64() value, e.g. the time by which the render thread will sync on the work
+		//tasks with a deadline are queued as urgent work (High, or BackgroundHigh for background priorities) that workers pick up first from
+		//their own, the global and the stolen queues. A runnable that finishes after its deadline is reported as a missed deadline.
+		template<typename TRunnable, typename TContinuation>
+		inline void InitWithDeadline(const TCHAR* InDebugName, ETaskPriority InPriority, uint64 InDeadlineCycles, TRunnable&& InRunnable, TContinuation&& InContinuation, bool bAllowBusyWaiting = true);
+
+		template<typename TRunnable>
+		inline void InitWithDeadline(const TCHAR* InDebugName, ETaskPriority InPriority, uint64 InDeadlineCycles, TRunnable&& InRunnable, bool bAllowBusyWaiting = true);
+
 		inline const TCHAR* GetDebugName() const;
 		inline ETaskPriority GetPriority() const;
 		inline bool IsBackgroundTask() const;
@@ -314,6 +327,41 @@ namespace LowLevelTasks
 		Init(InDebugName, ETaskPriority::Default, Forward<TRunnable>(InRunnable), true);
 	}
 
+	namespace Tasks_Impl
+	{
+	inline ETaskPriority GetDeadlinePriority(ETaskPriority Priority)
+	{
+		return Priority < ETaskPriority::ForegroundCount ? ETaskPriority::High : ETaskPriority::BackgroundHigh;
+	}
+
+	//the deadline lives in the runnable rather than in FTask, which keeps FTask at one cacheline for tasks without one
+	template<typename TRunnable>
+	inline auto MakeDeadlineRunnable(const TCHAR* InDebugName, uint64 InDeadlineCycles, TRunnable&& InRunnable)
+	{
+		return [InDebugName, InDeadlineCycles, LocalRunnable = Forward<TRunnable>(InRunnable)]()
+		{
+			LocalRunnable();
+			const uint64 CompletedCycles = FPlatformTime::Cycles64();
+			if (UNLIKELY(CompletedCycles > InDeadlineCycles))
+			{
+				ReportMissedDeadline(InDebugName, InDeadlineCycles, CompletedCycles);
+			}
+		};
+	}
+	}
+
+	template<typename TRunnable, typename TContinuation>
+	inline void FTask::InitWithDeadline(const TCHAR* InDebugName, ETaskPriority InPriority, uint64 InDeadlineCycles, TRunnable&& InRunnable, TContinuation&& InContinuation, bool bAllowBusyWaiting)
+	{
+		Init(InDebugName, Tasks_Impl::GetDeadlinePriority(InPriority), Tasks_Impl::MakeDeadlineRunnable(InDebugName, InDeadlineCycles, Forward<TRunnable>(InRunnable)), Forward<TContinuation>(InContinuation), bAllowBusyWaiting);
+	}
+
+	template<typename TRunnable>
+	inline void FTask::InitWithDeadline(const TCHAR* InDebugName, ETaskPriority InPriority, uint64 InDeadlineCycles, TRunnable&& InRunnable, bool bAllowBusyWaiting)
+	{
+		Init(InDebugName, Tasks_Impl::GetDeadlinePriority(InPriority), Tasks_Impl::MakeDeadlineRunnable(InDebugName, InDeadlineCycles, Forward<TRunnable>(InRunnable)), bAllowBusyWaiting);
+	}
+
 	inline FTask::~FTask()
 	{
 		checkf(IsCompleted(), TEXT("State: %d"), PackedData.load(std::memory_order_relaxed).GetState());
@@ -16,8 +16,12 @@
 #include "Async/TaskGraphInterfaces.h"
 #include "Misc/App.h"
 #include "Misc/Fork.h"
+#include <atomic>
 
 extern CORE_API int32 GParallelForBackgroundYieldingTimeoutMs;
+extern CORE_API float GParallelForAdaptiveBatchMicroseconds;
+
+class FOutputDevice;
 
 // Flags controlling the ParallelFor's behavior.
 enum class EParallelForFlags
@@ -37,10 +41,72 @@ enum class EParallelForFlags
 
 	// tasks should run on background priority threads
 	BackgroundPriority = 8,
+
+	// size batches and pick the number of workers from the per item cost measured by previous calls of the same call site,
+	// only has an effect when a FParallelForCallSite is passed in
+	Adaptive = 16,
 };
 
 ENUM_CLASS_FLAGS(EParallelForFlags)
 
+/**
+ * Statistics of one ParallelFor call site. Declare one as a static next to the call (see PARALLELFOR_CALLSITE) and pass it
+ * to ParallelFor to have every call timed. The measured cost per item drives EParallelForFlags::Adaptive, and the totals
+ * are listed by ParallelFor.DumpStats to find loops where going wide costs more than it saves.
+ */
+class CORE_API FParallelForCallSite
+{
+public:
+	explicit FParallelForCallSite(const TCHAR* InName);
+
+	FParallelForCallSite(const FParallelForCallSite&) = delete;
+	FParallelForCallSite& operator=(const FParallelForCallSite&) = delete;
+
+	const TCHAR* GetName() const
+	{
+		return Name;
+	}
+
+	/** Smoothed cost of a single item over the previous calls, in cycles, or 0 if the call site has not run yet */
+	float GetCyclesPerItem() const
+	{
+		return CyclesPerItem.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * Adds a finished call to the statistics
+	 *
+	 * @param InNumItems	Number of times the body was called
+	 * @param InNumBatches	Number of batches the items were split into, 1 if the call ran single threaded
+	 * @param InNumThreads	Number of threads that were asked to work on the call, including the calling one
+	 * @param InBodyCycles	Cycles spent inside the body, summed over all threads
+	 * @param InWallCycles	Cycles from the start of the call to its end on the calling thread
+	 */
+	void RecordCall(int32 InNumItems, int32 InNumBatches, int32 InNumThreads, uint64 InBodyCycles, uint64 InWallCycles);
+
+	/** Writes the statistics of every call site that has been called to the output device, most expensive first */
+	static void DumpStats(FOutputDevice& Ar);
+
+	/** Clears the statistics of every call site, the measured cost per item is kept */
+	static void ResetStats();
+
+private:
+	const TCHAR* Name;
+	FParallelForCallSite* NextCallSite;
+
+	std::atomic<float> CyclesPerItem;
+	std::atomic<uint64> NumCalls;
+	std::atomic<uint64> NumParallelCalls;
+	std::atomic<uint64> NumItems;
+	std::atomic<uint64> NumBatches;
+	std::atomic<uint64> NumThreads;
+	std::atomic<uint64> BodyCycles;
+	std::atomic<uint64> WallCycles;
+};
+
+/** Declares a static FParallelForCallSite in place and evaluates to it, e.g. ParallelFor(PARALLELFOR_CALLSITE(TEXT("UpdateBounds")), Num, 1, Body, EParallelForFlags::Adaptive) */
+#define PARALLELFOR_CALLSITE(Name) ([]() -> FParallelForCallSite& { static FParallelForCallSite CallSite(Name); return CallSite; }())
+
 namespace ParallelForImpl
 {
 	// struct to hold the working data; this outlives the ParallelFor call; lifetime is controlled by a shared pointer
@@ -54,22 +120,33 @@ namespace ParallelForImpl
 		FEvent* Event;
 		FThreadSafeCounter IndexToDo;
 		FThreadSafeCounter NumCompleted;
+		/** Cycles spent inside the body over all threads, only gathered when bTimeBody is set */
+		std::atomic<uint64> BodyCycles;
 		bool bExited;
 		bool bTriggered;
 		bool bSaveLastBlockForMaster;
-		TParallelForData(int32 InTotalNum, int32 InNumThreads, bool bInSaveLastBlockForMaster, FunctionType InBody, EParallelForFlags Flags)
+		bool bTimeBody;
+		TParallelForData(int32 InTotalNum, int32 InNumThreads, bool bInSaveLastBlockForMaster, FunctionType InBody, EParallelForFlags Flags, int32 InMinBatchSize = 1, int32 InTargetBatchSize = 0, bool bInTimeBody = false)
 			: Body(InBody)
 			, Event(FPlatformProcess::GetSynchEventFromPool(false))
+			, BodyCycles(0)
 			, bExited(false)
 			, bTriggered(false)
 			, bSaveLastBlockForMaster(bInSaveLastBlockForMaster)
+			, bTimeBody(bInTimeBody)
 		{
 			check(InTotalNum >= InNumThreads);
 
-			if ((Flags & EParallelForFlags::Unbalanced) != EParallelForFlags::None)
+			if (InTargetBatchSize > 0)
+			{
+				// The batch size was picked from the measured cost of the items
+				BlockSize = FMath::Max(InTargetBatchSize, InMinBatchSize);
+				Num = InTotalNum / BlockSize;
+			}
+			else if ((Flags & EParallelForFlags::Unbalanced) != EParallelForFlags::None)
 			{
-				BlockSize = 1;
-				Num = InTotalNum;
+				BlockSize = FMath::Max(InMinBatchSize, 1);
+				Num = InTotalNum / BlockSize;
 			}
 			else
 			{
@@ -87,6 +164,11 @@ namespace ParallelForImpl
 						}
 					}
 				}
+				if (BlockSize < InMinBatchSize)
+				{
+					BlockSize = InMinBatchSize;
+					Num = InTotalNum / BlockSize;
+				}
 			}
 
 			check(BlockSize && Num);
@@ -191,10 +273,16 @@ namespace ParallelForImpl
 				{
 					ThisBlockSize += LastBlockExtraNum;
 				}
+				const uint64 BlockStartCycles = bTimeBody ? FPlatformTime::Cycles64() : 0;
 				for (int32 LocalIndex = 0; LocalIndex < ThisBlockSize; LocalIndex++)
 				{
 					LocalBody(MyIndex * LocalBlockSize + LocalIndex);
 				}
+				if (bTimeBody)
+				{
+					// must be added before the block is counted as completed, the calling thread reads the total once all blocks are
+					BodyCycles.fetch_add(FPlatformTime::Cycles64() - BlockStartCycles, std::memory_order_relaxed);
+				}
 				checkSlow(!bExited);
 				int32 LocalNumCompleted = NumCompleted.Increment();
 				if (LocalNumCompleted == LocalNum)
@@ -255,17 +343,32 @@ namespace ParallelForImpl
 		return ENamedThreads::AnyBackgroundThreadNormalTask;
 	}
 
+	/** Batch size for the given number of items that makes each batch take about GParallelForAdaptiveBatchMicroseconds, or 0 if the cost of an item is not known yet */
+	CORE_API int32 GetAdaptiveBatchSize(const FParallelForCallSite& CallSite, int32 Num);
+
 	template<typename FunctionType>
-	inline void ParallelForInternal(int32 Num, FunctionType Body, EParallelForFlags Flags)
+	inline void ParallelForInternal(int32 Num, FunctionType Body, EParallelForFlags Flags, int32 MinBatchSize = 1, FParallelForCallSite* CallSite = nullptr)
 	{
 		SCOPE_CYCLE_COUNTER(STAT_ParallelFor);
 		check(Num >= 0);
 
+		const uint64 StartCycles = CallSite ? FPlatformTime::Cycles64() : 0;
+
+		MinBatchSize = FMath::Max(MinBatchSize, 1);
+		int32 TargetBatchSize = 0;
+		if (CallSite && (Flags & EParallelForFlags::Adaptive) != EParallelForFlags::None)
+		{
+			TargetBatchSize = GetAdaptiveBatchSize(*CallSite, Num);
+		}
+
 		int32 AnyThreadTasks = 0;
 		const bool bIsMultithread = FApp::ShouldUseThreadingForPerformance() || FForkProcessHelper::IsForkedMultithreadInstance();
 		if (Num > 1 && (Flags & EParallelForFlags::ForceSingleThread) == EParallelForFlags::None && bIsMultithread)
 		{
-			AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), Num - 1);
+			// never wake up more threads than there are batches to hand out
+			const int32 MaxNumBatches = Num / FMath::Max(MinBatchSize, TargetBatchSize);
+			AnyThreadTasks = FMath::Min<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads(), MaxNumBatches - 1);
+			AnyThreadTasks = FMath::Max(AnyThreadTasks, 0);
 		}
 		if (!AnyThreadTasks)
 		{
@@ -274,13 +377,18 @@ namespace ParallelForImpl
 			{
 				Body(Index);
 			}
+			if (CallSite)
+			{
+				const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+				CallSite->RecordCall(Num, 1, 1, Cycles, Cycles);
+			}
 			return;
 		}
 
 		const bool bPumpRenderingThread         = (Flags & EParallelForFlags::PumpRenderingThread) != EParallelForFlags::None;
 		const ENamedThreads::Type DesiredThread = GetBestDesiredThread(Flags);
 
-		TParallelForData<FunctionType>* DataPtr = new TParallelForData<FunctionType>(Num, AnyThreadTasks + 1, (Num > AnyThreadTasks + 1) && bPumpRenderingThread, Body, Flags);
+		TParallelForData<FunctionType>* DataPtr = new TParallelForData<FunctionType>(Num, AnyThreadTasks + 1, (Num > AnyThreadTasks + 1) && bPumpRenderingThread, Body, Flags, MinBatchSize, TargetBatchSize, CallSite != nullptr);
 		TSharedRef<TParallelForData<FunctionType>, ESPMode::ThreadSafe> Data = MakeShareable(DataPtr);
 		TGraphTask<TParallelForTask<FunctionType>>::CreateTask().ConstructAndDispatchWhenReady(Data, DesiredThread, AnyThreadTasks - 1);
 		// this thread can help too and this is important to prevent deadlock on recursion 
@@ -305,6 +413,10 @@ namespace ParallelForImpl
 		}
 		check(Data->NumCompleted.GetValue() == Data->Num);
 		Data->bExited = true;
+		if (CallSite)
+		{
+			CallSite->RecordCall(Num, Data->Num, AnyThreadTasks + 1, Data->BodyCycles.load(std::memory_order_relaxed), FPlatformTime::Cycles64() - StartCycles);
+		}
 		// DoneEvent waits here if some other thread finishes the last item
 		// Data must live on until all of the tasks are cleared which might be long after this function exits
 	}
@@ -415,6 +527,39 @@ inline void ParallelFor(int32 Num, TFunctionRef<void(int32)> Body, EParallelForF
 	ParallelForImpl::ParallelForInternal(Num, Body, Flags);
 }
 
+/** 
+	*	General purpose parallel for that uses the taskgraph, with a lower bound on the batch size
+	*	Use this when the body is so cheap that handing out fewer than MinBatchSize items at once costs more than it gains.
+	*
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param MinBatchSize; smallest number of consecutive items a thread takes at once, fewer threads are used if there are not enough batches for all of them
+	*	@param Body; Function to call from multiple threads
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelFor(int32 Num, int32 MinBatchSize, TFunctionRef<void(int32)> Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForInternal(Num, Body, Flags, MinBatchSize);
+}
+
+/** 
+	*	General purpose parallel for that uses the taskgraph and keeps statistics per call site
+	*	With EParallelForFlags::Adaptive the batch size and the number of threads are picked from the cost per item measured by the
+	*	previous calls of the same call site, so cheap loops are not split into batches that cost more to schedule than to run and
+	*	expensive loops are split finely enough to balance.
+	*
+	*	@param CallSite; statistics of this call site, usually PARALLELFOR_CALLSITE(TEXT("Name"))
+	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
+	*	@param MinBatchSize; smallest number of consecutive items a thread takes at once
+	*	@param Body; Function to call from multiple threads
+	*	@param Flags; Used to customize the behavior of the ParallelFor if needed.
+	*	Notes: Please add stats around to calls to parallel for and within your lambda as appropriate. Do not clog the task graph with long running tasks or tasks that block.
+**/
+inline void ParallelFor(FParallelForCallSite& CallSite, int32 Num, int32 MinBatchSize, TFunctionRef<void(int32)> Body, EParallelForFlags Flags = EParallelForFlags::None)
+{
+	ParallelForImpl::ParallelForInternal(Num, Body, Flags, MinBatchSize, &CallSite);
+}
+
 /** 
 	*	General purpose parallel for that uses the taskgraph
 	*	@param Num; number of calls of Body; Body(0), Body(1)....Body(Num - 1)
@@ -500,6 +500,35 @@ struct CORE_API FGenericPlatformMemory
 		return false;
 	}
 
+	/**
+	 * Number of memory (NUMA) nodes that pooled OS allocations are kept apart for, so that a thread can be given
+	 * memory that is local to the node it runs on. 1 on platforms without NUMA support or when it is disabled.
+	 */
+	static int32 GetNumPooledMemoryNodes()
+	{
+		return 1;
+	}
+
+	/** Returns the memory node the calling thread runs on, in the range [0, GetNumPooledMemoryNodes()) */
+	static int32 GetCurrentPooledMemoryNode()
+	{
+		return 0;
+	}
+
+	/** Alignment of pooled OS allocations that lets AdvisePooledMemory back them with large pages */
+	static SIZE_T GetPooledMemoryAlignment()
+	{
+		return 65536;
+	}
+
+	/**
+	 * Gives the OS placement hints for a range of pooled memory before any of it is touched,
+	 * e.g. to back it with large pages and to place its pages on the given memory node.
+	 */
+	static void AdvisePooledMemory(void* Ptr, SIZE_T Size, int32 MemoryNode)
+	{
+	}
+
 	/** Dumps basic platform memory statistics into the specified output device. */
 	static void DumpStats( FOutputDevice& Ar );
 
@@ -56,6 +56,11 @@
  * since BinnedAllocFromOS() can support only a limited number of allocations on some platforms.
  * 
  * CachedOSPageAllocator sits "below" this and is used for allocs larger than the largest bucketed.
+ *
+ * On platforms that report more than one pooled memory node (NUMA on Linux with -numapools), each node has its own
+ * set of buckets. Allocations are served from the node of the calling thread, and new pools are placed on that node,
+ * so threads get memory that is local to them. Pools are also aligned and advised so that the platform can back
+ * them with large pages (-hugepages on Linux), which cuts down on TLB misses.
  */
 struct FPooledVirtualMemoryAllocator
 {
@@ -86,7 +91,9 @@ private:
 		MaxAllocationSizeToPool		= NumAllocationSizeClasses * 65536,
 
 		MaxOSAllocCacheSize			= 64 * 1024 * 1024,
-		MaxOSAllocsCached			= 64
+		MaxOSAllocsCached			= 64,
+
+		MaxMemoryNodes				= 8
 	};
 
 	/**
@@ -120,22 +127,28 @@ private:
 	 * This array keeps the number of pooled allocations for each
 	 * allocation size class that we keep bumping up whenever the pool is exhausted.
 	 */
-	int32 NextPoolSize[Limits::NumAllocationSizeClasses];
+	int32 NextPoolSize[Limits::MaxMemoryNodes][Limits::NumAllocationSizeClasses];
+
+	/** Head of the pool descriptor lists, per memory node */
+	FPoolDescriptorBase* ClassesListHeads[Limits::MaxMemoryNodes][Limits::NumAllocationSizeClasses];
+
+	/** Number of memory nodes the pools are kept apart for, at most MaxMemoryNodes */
+	int32 NumMemoryNodes;
 
-	/** Head of the pool descriptor lists */
-	FPoolDescriptorBase* ClassesListHeads[Limits::NumAllocationSizeClasses];
+	/** Returns the memory node whose pools the calling thread should allocate from */
+	int32 GetCurrentMemoryNode() const;
 
-	/** Per-class locks */
+	/** Per-class locks, shared by all memory nodes */
 	FCriticalSection     ClassesLocks[Limits::NumAllocationSizeClasses];
 
 	/** Increases the number of pooled allocations next time we need a pool
 	 *
 	 * @param bGrowing - if true, we are allocating it, if false, we have just deleted a pool of this size
 	 */
-	void DecideOnTheNextPoolSize(int32 SizeClass, bool bGrowing);
+	void DecideOnTheNextPoolSize(int32 MemoryNode, int32 SizeClass, bool bGrowing);
 
-	/** Allocates a new pool */
-	FPoolDescriptorBase* CreatePool(SIZE_T AllocationSize, int32 NumPooledAllocations);
+	/** Allocates a new pool, placed on the given memory node */
+	FPoolDescriptorBase* CreatePool(SIZE_T AllocationSize, int32 NumPooledAllocations, int32 MemoryNode);
 
 	/** Destroys a pool */
 	void DestroyPool(FPoolDescriptorBase* Pool);
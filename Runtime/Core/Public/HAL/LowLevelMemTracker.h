@@ -9,13 +9,18 @@
 	#define ALLOW_LOW_LEVEL_MEM_TRACKER_IN_TEST 0
 #endif
 
+// Set to 1 to compile LLM into shipping builds, e.g. to run servers with -LLM -LLMSampleRate=<bytes> for low overhead attribution
+#ifndef ALLOW_LOW_LEVEL_MEM_TRACKER_IN_SHIPPING
+	#define ALLOW_LOW_LEVEL_MEM_TRACKER_IN_SHIPPING 0
+#endif
+
 // LLM is currently incompatible with PLATFORM_USES_FIXED_GMalloc_CLASS, because LLM is activated way too early
 // Inability to use LLM with PLATFORM_USES_FIXED_GMalloc_CLASS is not a problem, because fixed GMalloc is only used in Test/Shipping builds
 #define LLM_ENABLED_ON_PLATFORM (PLATFORM_SUPPORTS_LLM && !PLATFORM_USES_FIXED_GMalloc_CLASS)
 
 // *** enable/disable LLM here ***
 #if !defined(ENABLE_LOW_LEVEL_MEM_TRACKER) || !LLM_ENABLED_ON_PLATFORM 
-	#define ENABLE_LOW_LEVEL_MEM_TRACKER (LLM_ENABLED_ON_PLATFORM && !UE_BUILD_SHIPPING && (!UE_BUILD_TEST || ALLOW_LOW_LEVEL_MEM_TRACKER_IN_TEST) && WITH_ENGINE && 1)
+	#define ENABLE_LOW_LEVEL_MEM_TRACKER (LLM_ENABLED_ON_PLATFORM && (!UE_BUILD_SHIPPING || ALLOW_LOW_LEVEL_MEM_TRACKER_IN_SHIPPING) && (!UE_BUILD_TEST || ALLOW_LOW_LEVEL_MEM_TRACKER_IN_TEST) && WITH_ENGINE && 1)
 #endif
 
 #if ENABLE_LOW_LEVEL_MEM_TRACKER
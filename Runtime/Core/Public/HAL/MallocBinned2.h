@@ -175,6 +175,7 @@ class CORE_API FMallocBinned2 final : public FMalloc
 
 		void ValidateActivePools();
 		void ValidateExhaustedPools();
+		void ValidateSealedPools();
 
 	private:
 		FPoolInfo* Front;
@@ -185,6 +186,8 @@ class CORE_API FMallocBinned2 final : public FMalloc
 	{
 		FPoolList ActivePools;
 		FPoolList ExhaustedPools;
+		/** Pools that a forked child inherited from its parent. Only freed into, never allocated from. */
+		FPoolList SealedPools;
 		uint32    BlockSize;
 
 		FPoolTable();
@@ -683,6 +686,8 @@ public:
 	virtual void Trim(bool bTrimThreadCaches) override;
 	virtual void SetupTLSCachesOnCurrentThread() override;
 	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
+	virtual void OnPreFork() override;
+	virtual void OnPostFork() override;
 	virtual const TCHAR* GetDescriptiveName() override;
 	virtual void UpdateStats() override;
 	// End FMalloc interface.
@@ -76,6 +76,22 @@ public:
 		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
 	}
 
+	/**
+	* Called in a process that is about to fork.
+	*/
+	virtual void OnPreFork() override
+	{
+		UsedMalloc->OnPreFork();
+	}
+
+	/**
+	* Called in a forked child before it runs any other code.
+	*/
+	virtual void OnPostFork() override
+	{
+		UsedMalloc->OnPostFork();
+	}
+
 	/**
 	*	Initializes stats metadata. We need to do this as soon as possible, but cannot be done in the constructor
 	*	due to the FName::StaticInit
@@ -144,5 +144,15 @@ public:
 		UsedMalloc->ClearAndDisableTLSCachesOnCurrentThread();
 	}
 
+	virtual void OnPreFork() override
+	{
+		UsedMalloc->OnPreFork();
+	}
+
+	virtual void OnPostFork() override
+	{
+		UsedMalloc->OnPostFork();
+	}
+
 	// FMalloc interface end
 };
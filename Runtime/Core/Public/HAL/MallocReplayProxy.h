@@ -121,6 +121,10 @@ public:
 
 	virtual void ClearAndDisableTLSCachesOnCurrentThread() override;
 
+	virtual void OnPreFork() override;
+
+	virtual void OnPostFork() override;
+
 	// FMalloc interface end
 
 	// called by destructor or otherwise, idempotent
@@ -120,6 +120,18 @@ public:
 		UsedMalloc->Trim(bTrimThreadCaches);
 	}
 
+	virtual void OnPreFork() override
+	{
+		FScopeLock ScopeLock(&SynchronizationObject);
+		UsedMalloc->OnPreFork();
+	}
+
+	virtual void OnPostFork() override
+	{
+		FScopeLock ScopeLock(&SynchronizationObject);
+		UsedMalloc->OnPostFork();
+	}
+
 	virtual bool IsInternallyThreadSafe() const override
 	{ 
 		return true; 
@@ -152,6 +152,22 @@ public:
 	{
 	}
 
+	/**
+	* Called in a process that is about to fork. Allocators should return cached free blocks to their pools so that the
+	* children do not start out handing back blocks that live in pages shared with the parent.
+	*/
+	virtual void OnPreFork()
+	{
+	}
+
+	/**
+	* Called in a forked child before it runs any other code. Allocators should serve new allocations from fresh pages
+	* instead of filling the holes left in pages inherited from the parent, which would copy them on write.
+	*/
+	virtual void OnPostFork()
+	{
+	}
+
 	/**
 	*	Initializes stats metadata. We need to do this as soon as possible, but cannot be done in the constructor
 	*	due to the FName::StaticInit
@@ -979,6 +979,10 @@ struct FIoStoreWriterSettings
 	uint64 MaxPartitionSize = 0;
 	bool bEnableCsvOutput = false;
 	bool bEnableFileRegions = false;
+	/** Upper bound for the buffers holding compressed blocks that are waiting to be written, shared by all containers */
+	uint64 CompressionMemoryLimit = 1ull << 30;
+	/** Number of containers that can be written to disk at the same time */
+	int32 MaxConcurrentWriters = 4;
 };
 
 enum class EIoContainerFlags : uint8
@@ -1056,6 +1060,9 @@ public:
 		uint64 HashedChunksCount = 0;
 		uint64 CompressedChunksCount = 0;
 		uint64 SerializedChunksCount = 0;
+		uint64 HashedBytes = 0;
+		uint64 CompressedBytes = 0;
+		uint64 SerializedBytes = 0;
 	};
 
 	CORE_API FIoStoreWriterContext();
@@ -258,6 +258,10 @@ public:
 	// Called before the engine exits. Separate from OnPreExit as OnEnginePreExit occurs before shutting down any core modules.
 	static FSimpleMulticastDelegate OnEnginePreExit;
 
+	// Called once in a WaitAndFork parent before it forks its first child. Anything freed here is freed before the children
+	// share the parent's pages, so this is the place to drop garbage that every child would otherwise copy on write.
+	static FSimpleMulticastDelegate OnParentPreFork;
+
 	/** Delegate for gathering up additional localization paths that are unknown to the UE4 core (such as plugins) */
 	DECLARE_MULTICAST_DELEGATE_OneParam(FGatherAdditionalLocResPathsDelegate, TArray<FString>&);
 	static FGatherAdditionalLocResPathsDelegate GatherAdditionalLocResPathsCallback;
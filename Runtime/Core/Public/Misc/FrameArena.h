@@ -0,0 +1,241 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreTypes.h"
+#include "Misc/AssertionMacros.h"
+#include "HAL/UnrealMemory.h"
+#include "HAL/ThreadSingleton.h"
+#include "Containers/ContainerAllocationPolicies.h"
+#include "Math/UnrealMathUtility.h"
+#include "Templates/AlignmentTemplates.h"
+#include <atomic>
+
+/** Fill released frame arena memory with a pattern, so use after the end of the frame shows up quickly */
+#ifndef FRAME_ARENA_POISON
+	#define FRAME_ARENA_POISON (DO_CHECK && !UE_BUILD_SHIPPING)
+#endif
+
+/**
+ * Frame scoped linear allocator.
+ * Unlike FMemStack there are no marks: everything allocated during a frame is released at once when the frame ends.
+ * Each thread bump-allocates from its own chunks, so task workers never contend, but the memory itself can be used
+ * from any thread, e.g. filled by tasks and consumed by the game thread.
+ * Nothing allocated here may be used after FFrameArena::EndFrame(); work that allocates from the arena must be
+ * waited for before the end of the frame.
+ **/
+class CORE_API FFrameArena
+{
+public:
+	/** Allocates from the calling thread's arena for the current frame. */
+	static FORCEINLINE void* Alloc(SIZE_T Size, uint32 Alignment);
+
+	/**
+	 * Ends the current frame, which releases everything allocated during it on every thread. Page sized chunks are kept
+	 * for the next frame and given back to the page allocator if that frame doesn't need them.
+	 * Called by the engine loop on the game thread.
+	 */
+	static void EndFrame();
+
+	/** @return the number of bytes in chunks owned by any thread or kept for the next frame, used or not. */
+	static SIZE_T GetReservedSize();
+
+	/** Incremented by every EndFrame. */
+	static FORCEINLINE uint32 GetFrameIndex()
+	{
+		return FrameIndex.load(std::memory_order_acquire);
+	}
+
+private:
+	static std::atomic<uint32> FrameIndex;
+};
+
+/**
+ * The calling thread's chunks. Every thread that allocated from the arena is registered, so EndFrame can release the
+ * chunks of threads that don't allocate again. Only the bump pointer is touched without holding the arena lock.
+ **/
+class CORE_API FFrameArenaThread : public TThreadSingleton<FFrameArenaThread>
+{
+public:
+	FFrameArenaThread();
+	~FFrameArenaThread();
+
+	FORCEINLINE void* Alloc(SIZE_T Size, uint32 Alignment)
+	{
+		checkSlow(FMath::IsPowerOfTwo(Alignment));
+
+		const uint32 CurrentFrameIndex = FFrameArena::GetFrameIndex();
+		uint8* Result = Align(Top, Alignment);
+		if (LIKELY(FrameIndex == CurrentFrameIndex && Result + Size <= End && Result != nullptr))
+		{
+			Top = Result + Size;
+			return Result;
+		}
+		return AllocSlow(Size, Alignment, CurrentFrameIndex);
+	}
+
+	/** @return the number of bytes in chunks owned by this thread, used or not. */
+	SIZE_T GetReservedSize() const;
+
+	struct FChunk
+	{
+		FChunk* Next;
+		SIZE_T Size;
+
+		uint8* Data()
+		{
+			return ((uint8*)this) + sizeof(FChunk);
+		}
+	};
+
+private:
+	friend class FFrameArena;
+
+	void* AllocSlow(SIZE_T Size, uint32 Alignment, uint32 CurrentFrameIndex);
+
+	/** Releases all chunks, poisoning them first if FRAME_ARENA_POISON is set. Must hold the arena lock. */
+	void ReleaseChunks();
+
+	uint8* Top = nullptr;
+	uint8* End = nullptr;
+	/** Only accessed with the arena lock held, EndFrame releases them from the game thread */
+	FChunk* Chunks = nullptr;
+	/** The frame Top and End belong to, only written by the owning thread */
+	uint32 FrameIndex = 0;
+	/** Next thread in the list of threads with an arena, guarded by the arena lock */
+	FFrameArenaThread* NextThread = nullptr;
+};
+
+FORCEINLINE void* FFrameArena::Alloc(SIZE_T Size, uint32 Alignment)
+{
+	return FFrameArenaThread::Get().Alloc(Size, Alignment);
+}
+
+/** A container allocator that allocates from the frame arena. Freeing is a no-op, the memory goes away with the frame. */
+template<uint32 Alignment = DEFAULT_ALIGNMENT>
+class TFrameArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = true };
+	enum { RequireRangeCheck = true };
+
+	template<typename ElementType>
+	class ForElementType
+	{
+	public:
+
+		/** Default constructor. */
+		ForElementType():
+			Data(nullptr)
+		{}
+
+		/**
+		 * Moves the state of another allocator into this one.
+		 * Assumes that the allocator is currently empty, i.e. memory may be allocated but any existing elements have already been destructed (if necessary).
+		 * @param Other - The allocator to move the state from.  This allocator should be left in a valid empty state.
+		 */
+		FORCEINLINE void MoveToEmpty(ForElementType& Other)
+		{
+			checkSlow(this != &Other);
+
+			Data       = Other.Data;
+			Other.Data = nullptr;
+#if DO_CHECK
+			AllocationFrameIndex = Other.AllocationFrameIndex;
+#endif
+		}
+
+		// FContainerAllocatorInterface
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return Data;
+		}
+
+		void ResizeAllocation(SizeType PreviousNumElements, SizeType NumElements, SIZE_T NumBytesPerElement)
+		{
+			void* OldData = Data;
+			if (NumElements)
+			{
+				checkf(IsUsableThisFrame(), TEXT("A frame arena container is used after the frame it was allocated in ended"));
+
+				Data = (ElementType*)FFrameArena::Alloc(NumElements * NumBytesPerElement, FMath::Max(Alignment, (uint32)alignof(ElementType)));
+#if DO_CHECK
+				AllocationFrameIndex = FFrameArena::GetFrameIndex();
+#endif
+
+				// If the container previously held elements, copy them into the new allocation.
+				if (OldData && PreviousNumElements)
+				{
+					const SizeType NumCopiedElements = FMath::Min(NumElements, PreviousNumElements);
+					FMemory::Memcpy(Data, OldData, NumCopiedElements * NumBytesPerElement);
+				}
+			}
+			else
+			{
+				Data = nullptr;
+			}
+		}
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NumElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NumElements, NumBytesPerElement, false, Alignment);
+		}
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			// Shrinking would only waste arena space
+			return NumAllocatedElements;
+		}
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NumElements, SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NumElements, NumAllocatedElements, NumBytesPerElement, false, Alignment);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType NumAllocatedElements, SIZE_T NumBytesPerElement) const
+		{
+			return NumAllocatedElements * NumBytesPerElement;
+		}
+
+		bool HasAllocation() const
+		{
+			return !!Data;
+		}
+
+		SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+		/** @return false if the allocation belongs to a frame that has ended, which resizing asserts on. Always true without DO_CHECK. */
+		bool IsUsableThisFrame() const
+		{
+#if DO_CHECK
+			return !Data || AllocationFrameIndex == FFrameArena::GetFrameIndex();
+#else
+			return true;
+#endif
+		}
+
+	private:
+
+		/** A pointer to the container's elements. */
+		ElementType* Data;
+
+#if DO_CHECK
+		/** The frame Data was allocated in. */
+		uint32 AllocationFrameIndex = 0;
+#endif
+	};
+
+	typedef ForElementType<FScriptContainerElement> ForAnyElementType;
+};
+
+template <uint32 Alignment>
+struct TAllocatorTraits<TFrameArenaAllocator<Alignment>> : TAllocatorTraitsBase<TFrameArenaAllocator<Alignment>>
+{
+	enum { SupportsMove    = true };
+	enum { IsZeroConstruct = true };
+};
+
+/** A set allocator for TSet and TMap that keeps the elements, the allocation flags and the hash in the frame arena. */
+typedef TSetAllocator<TSparseArrayAllocator<TFrameArenaAllocator<>, TFrameArenaAllocator<>>, TFrameArenaAllocator<>> FFrameArenaSetAllocator;
@@ -133,6 +133,10 @@ struct CORE_API FUnixPlatformMemory : public FGenericPlatformMemory
 	static bool UnmapNamedSharedMemoryRegion(FSharedMemoryRegion * MemoryRegion);
 	static bool GetLLMAllocFunctions(void*(*&OutAllocFunction)(size_t), void(*&OutFreeFunction)(void*, size_t), int32& OutAlignment);
 	static CA_NO_RETURN void OnOutOfMemory(uint64 Size, uint32 Alignment);
+	static int32 GetNumPooledMemoryNodes();
+	static int32 GetCurrentPooledMemoryNode();
+	static SIZE_T GetPooledMemoryAlignment();
+	static void AdvisePooledMemory(void* Ptr, SIZE_T Size, int32 MemoryNode);
 	//~ End FGenericPlatformMemory Interface
 
 	static bool HasForkPageProtectorEnabled();
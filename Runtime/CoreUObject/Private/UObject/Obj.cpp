@@ -4420,6 +4420,12 @@ void StaticUObjectInit();
 void InitUObject();
 void StaticExit();
 
+/** Purges unreachable objects before a WaitAndFork parent forks so that the children do not inherit them. */
+static void CollectGarbageBeforeFork()
+{
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+}
+
 void InitUObject()
 {
 	LLM_SCOPE(ELLMTag::InitUObject);
@@ -4436,6 +4442,7 @@ void InitUObject()
 
 	FCoreDelegates::OnShutdownAfterError.AddStatic(StaticShutdownAfterError);
 	FCoreDelegates::OnExit.AddStatic(StaticExit);
+	FCoreDelegates::OnParentPreFork.AddStatic(CollectGarbageBeforeFork);
 #if !USE_PER_MODULE_UOBJECT_BOOTSTRAP // otherwise this is already done
 	FModuleManager::Get().OnProcessLoadedObjectsCallback().AddStatic(ProcessNewlyLoadedUObjects);
 #endif
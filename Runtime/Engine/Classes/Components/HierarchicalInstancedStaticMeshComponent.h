@@ -193,6 +193,8 @@ class ENGINE_API UHierarchicalInstancedStaticMeshComponent : public UInstancedSt
 	bool bIsOutOfDate : 1;
 	bool bConcurrentChanges : 1;
 	bool bAutoRebuildTreeOnInstanceChanges : 1;
+	// true while the built tree can be extended with newly added instances without a full rebuild
+	bool bCanBuildTreeIncrementally : 1;
 
 #if WITH_EDITOR
 	// in Editor mode we might disable the density scaling for edition
@@ -275,6 +277,7 @@ protected:
 	void BuildTreeAsync();
 	void ApplyBuildTree(FClusterBuilder& Builder);
 	void ApplyEmpty();
+	bool CanBuildTreeIncrementally() const;
 	void SetPerInstanceLightMapAndEditorData(FStaticMeshInstanceData& PerInstanceData, const TArray<TRefCountPtr<HHitProxy>>& HitProxies);
 
 	void GetInstanceTransforms(TArray<FMatrix>& InstanceTransforms) const;
@@ -28,6 +28,7 @@
 #include "Net/Core/Misc/ResizableCircularQueue.h"
 #include "Net/NetAnalyticsTypes.h"
 #include "Net/TrafficControl.h"
+#include "Net/NetConnectionInstrumentation.h"
 
 #include "NetConnection.generated.h"
 
@@ -1167,6 +1168,9 @@ public:
 
 	FORCEINLINE FHistogram GetNetHistogram() const { return NetConnectionHistogram; }
 
+	/** Send/receive counters and recent packet timings */
+	const FNetConnectionInstrumentation& GetInstrumentation() const { return Instrumentation; }
+
 	/** Whether or not a client packet has been received - used serverside, to delay any packet sends */
 	FORCEINLINE bool HasReceivedClientPacket()
 	{
@@ -1352,6 +1356,9 @@ private:
 	/** Histogram of the received packet time */
 	FHistogram NetConnectionHistogram;
 
+	/** Counters and recent packet timings of the send and receive paths */
+	FNetConnectionInstrumentation Instrumentation;
+
 	/** Online platform ID of remote player on this connection. Only valid on client connections (server side).*/
 	FName PlayerOnlinePlatformName;
 
@@ -18,6 +18,7 @@
 #include "IPAddress.h"
 #include "Net/NetAnalyticsTypes.h"
 #include "Net/NetConnectionIdHandler.h"
+#include "Net/NetConnectionInstrumentation.h"
 
 #include "NetDriver.generated.h"
 
@@ -971,6 +972,10 @@ public:
 	uint32						TotalRPCsCalled;
 	/** Total acks sent since the net driver's creation  */
 	uint32						OutTotalAcks;
+	/** Instrumentation counters of connections that have been cleaned up, so the driver totals never go backwards */
+	FNetConnectionCounters		ClosedConnectionCounters;
+	/** Driver totals at the previous TickFlush, to report per frame values */
+	FNetConnectionCounters		LastTickFlushConnectionCounters;
 
 	/** Collect net stats even if not FThreadStats::IsCollectingData(). */
 	bool bCollectNetStats;
@@ -1447,6 +1452,9 @@ public:
 	/** creates a child connection and adds it to the given parent connection */
 	ENGINE_API virtual class UChildConnection* CreateChild(UNetConnection* Parent);
 
+	/** @return the instrumentation counters summed over all current and past connections */
+	ENGINE_API FNetConnectionCounters GetConnectionCounters() const;
+
 	/** @return String that uniquely describes the net driver instance */
 	FString GetDescription() const
 	{ 
@@ -33,6 +33,7 @@
 #include "UObject/ReleaseObjectVersion.h"
 #include "ComponentRecreateRenderStateContext.h"
 #include "Algo/AnyOf.h"
+#include "Async/ParallelFor.h"
 #if WITH_EDITOR
 #include "Rendering/StaticLightingSystemInterface.h"
 #endif
@@ -52,6 +53,16 @@ static TAutoConsoleVariable<int32> CVarFoliageSplitFactor(
 	16,
 	TEXT("This controls the branching factor of the foliage tree."));
 
+static TAutoConsoleVariable<int32> CVarFoliageParallelBuildTreeMinInstances(
+	TEXT("foliage.ParallelBuildTreeMinInstances"),
+	16384,
+	TEXT("Ranges of at least this many instances are split on separate task graph workers when building the foliage tree. 0 disables the parallel build."));
+
+static TAutoConsoleVariable<int32> CVarFoliageIncrementalBuildTreeMaxInstances(
+	TEXT("foliage.IncrementalBuildTreeMaxInstances"),
+	256,
+	TEXT("If instances were only added since the last foliage tree build and there are at most this many of them, they are inserted into the existing tree instead of rebuilding it. 0 disables incremental builds."));
+
 static TAutoConsoleVariable<int32> CVarForceLOD(
 	TEXT("foliage.ForceLOD"),
 	-1,
@@ -240,12 +251,20 @@ protected:
 		}
 	};
 	TArray<FSortPair> SortPairs;
+	int32 ParallelSplitMinInstances;
+
+	// Tree of the previous build, only set when the new instances can be inserted incrementally
+	TArray<FClusterNode> BaseNodes;
+	TArray<int32> BaseSortedInstances;
+	int32 BaseOcclusionLayerNum;
+	bool bHasIncrementalBase;
 
 	void Split(int32 InNum)
 	{
 		checkSlow(InNum);
 		Clusters.Reset();
-		Split(0, InNum - 1);
+		ParallelSplitMinInstances = CVarFoliageParallelBuildTreeMinInstances.GetValueOnAnyThread();
+		Split(0, InNum - 1, Clusters, SortPairs);
 		Clusters.Sort();
 		checkSlow(Clusters.Num() > 0);
 		int32 At = 0;
@@ -257,7 +276,7 @@ protected:
 		checkSlow(At == InNum);
 	}
 
-	void Split(int32 Start, int32 End)
+	void Split(int32 Start, int32 End, TArray<FRunPair>& OutClusters, TArray<FSortPair>& OutSortPairs)
 	{
 		int32 NumRange = 1 + End - Start;
 		FBox ClusterBounds(ForceInit);
@@ -267,11 +286,11 @@ protected:
 		}
 		if (NumRange <= BranchingFactor)
 		{
-			Clusters.Add(FRunPair(Start, NumRange));
+			OutClusters.Add(FRunPair(Start, NumRange));
 			return;
 		}
 		checkSlow(NumRange >= 2);
-		SortPairs.Reset();
+		OutSortPairs.Reset();
 		int32 BestAxis = -1;
 		float BestAxisValue = -1.0f;
 		for (int32 Axis = 0; Axis < 3; Axis++)
@@ -289,12 +308,12 @@ protected:
 
 			Pair.Index = SortIndex[Index];
 			Pair.d = SortPoints[Pair.Index][BestAxis];
-			SortPairs.Add(Pair);
+			OutSortPairs.Add(Pair);
 		}
-		SortPairs.Sort();
+		OutSortPairs.Sort();
 		for (int32 Index = Start; Index <= End; Index++)
 		{
-			SortIndex[Index] = SortPairs[Index - Start].Index;
+			SortIndex[Index] = OutSortPairs[Index - Start].Index;
 		}
 
 		int32 Half = NumRange / 2;
@@ -304,7 +323,7 @@ protected:
 
 		if (NumRange & 1)
 		{
-			if (SortPairs[Half].d - SortPairs[Half - 1].d < SortPairs[Half + 1].d - SortPairs[Half].d)
+			if (OutSortPairs[Half].d - OutSortPairs[Half - 1].d < OutSortPairs[Half + 1].d - OutSortPairs[Half].d)
 			{
 				EndLeft++;
 			}
@@ -317,8 +336,30 @@ protected:
 		checkSlow(EndLeft >= Start);
 		checkSlow(End >= StartRight);
 
-		Split(Start, EndLeft);
-		Split(StartRight, End);
+		if (ParallelSplitMinInstances > 0 && NumRange >= ParallelSplitMinInstances)
+		{
+			// Both halves only touch their own range of SortIndex, so they can be split concurrently. 
+			// The right half collects its clusters separately, the final order is restored by the sort in Split(InNum).
+			TArray<FRunPair> RightClusters;
+			ParallelFor(2, [this, Start, EndLeft, StartRight, End, &OutClusters, &OutSortPairs, &RightClusters](int32 Side)
+			{
+				if (Side == 0)
+				{
+					Split(Start, EndLeft, OutClusters, OutSortPairs);
+				}
+				else
+				{
+					TArray<FSortPair> RightSortPairs;
+					Split(StartRight, End, RightClusters, RightSortPairs);
+				}
+			});
+			OutClusters.Append(RightClusters);
+		}
+		else
+		{
+			Split(Start, EndLeft, OutClusters, OutSortPairs);
+			Split(StartRight, End, OutClusters, OutSortPairs);
+		}
 	}
 
 	void BuildInstanceBuffer()
@@ -412,10 +453,22 @@ public:
 		, Transforms(MoveTemp(InTransforms))
 		, CustomDataFloats(MoveTemp(InCustomDataFloats))
 		, NumCustomDataFloats(InNumCustomDataFloats)
+		, ParallelSplitMinInstances(0)
+		, BaseOcclusionLayerNum(0)
+		, bHasIncrementalBase(false)
 		, Result(nullptr)
 	{
 	}
 
+	/** Provides the tree of the previous build so instances appended since then can be inserted into it instead of rebuilding the whole tree. */
+	void SetIncrementalBase(const TArray<FClusterNode>& InNodes, const TArray<int32>& InSortedInstances, int32 InOcclusionLayerNum)
+	{
+		BaseNodes = InNodes;
+		BaseSortedInstances = InSortedInstances;
+		BaseOcclusionLayerNum = InOcclusionLayerNum;
+		bHasIncrementalBase = true;
+	}
+
 	void BuildTreeAndBufferAsync(ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
 	{
 #if WITH_EDITOR
@@ -430,10 +483,166 @@ public:
 
 	void BuildTreeAndBuffer()
 	{
-		BuildTree();
+		if (!bHasIncrementalBase || !BuildTreeIncremental())
+		{
+			BuildTree();
+		}
 		BuildInstanceBuffer();
 	}
 
+	/**
+	 * Inserts the instances appended since the base tree was built into its nearest leaves and refits the nodes above them.
+	 * Returns false if the base can't be reused, in which case the tree must be fully rebuilt.
+	 */
+	bool BuildTreeIncremental()
+	{
+		const int32 NumBaseInstances = BaseSortedInstances.Num();
+		if (BaseNodes.Num() == 0 || DensityScaling < 1.0f || NumBaseInstances == 0 || NumBaseInstances >= OriginalNum)
+		{
+			return false;
+		}
+
+		// Leaves are all on the last level and keep their instances in node order, which is what keeps the parent ranges contiguous
+		const int32 MaxInstancesPerIncrementalLeaf = 2 * MaxInstancesPerLeaf;
+		TArray<int32> NodeNewInstanceCount;
+		NodeNewInstanceCount.AddZeroed(BaseNodes.Num());
+		TArray<int32> NewInstanceLeaf;
+		NewInstanceLeaf.AddUninitialized(OriginalNum - NumBaseInstances);
+
+		for (int32 InstanceIndex = NumBaseInstances; InstanceIndex < OriginalNum; InstanceIndex++)
+		{
+			const FVector Point = Transforms[InstanceIndex].GetOrigin();
+			int32 NodeIndex = 0;
+			while (BaseNodes[NodeIndex].FirstChild >= 0)
+			{
+				int32 BestChild = BaseNodes[NodeIndex].FirstChild;
+				float BestBoxDistSq = MAX_flt;
+				float BestCenterDistSq = MAX_flt;
+				for (int32 ChildIndex = BaseNodes[NodeIndex].FirstChild; ChildIndex <= BaseNodes[NodeIndex].LastChild; ChildIndex++)
+				{
+					const FClusterNode& Child = BaseNodes[ChildIndex];
+					const float BoxDistSq = FBox(Child.BoundMin, Child.BoundMax).ComputeSquaredDistanceToPoint(Point);
+					const float CenterDistSq = FVector::DistSquared((Child.BoundMin + Child.BoundMax) * 0.5f, Point);
+					if (BoxDistSq < BestBoxDistSq || (BoxDistSq == BestBoxDistSq && CenterDistSq < BestCenterDistSq))
+					{
+						BestChild = ChildIndex;
+						BestBoxDistSq = BoxDistSq;
+						BestCenterDistSq = CenterDistSq;
+					}
+				}
+				NodeIndex = BestChild;
+			}
+
+			const FClusterNode& Leaf = BaseNodes[NodeIndex];
+			if (1 + Leaf.LastInstance - Leaf.FirstInstance + ++NodeNewInstanceCount[NodeIndex] > MaxInstancesPerIncrementalLeaf)
+			{
+				// the leaf would grow too large for culling to stay efficient, rebuild instead
+				return false;
+			}
+			NewInstanceLeaf[InstanceIndex - NumBaseInstances] = NodeIndex;
+		}
+
+		Result = MakeUnique<FClusterTree>();
+		Result->OutOcclusionLayerNum = BaseOcclusionLayerNum;
+		Result->Nodes = MoveTemp(BaseNodes);
+		TArray<FClusterNode>& Nodes = Result->Nodes;
+
+		// Prefix sum of the new instances over the leaves, in node order
+		TArray<int32> LeafNewInstanceStart;
+		LeafNewInstanceStart.AddUninitialized(Nodes.Num());
+		int32 NumNewInstances = 0;
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+		{
+			LeafNewInstanceStart[NodeIndex] = NumNewInstances;
+			NumNewInstances += NodeNewInstanceCount[NodeIndex];
+		}
+		TArray<int32> LeafNewInstances;
+		LeafNewInstances.AddUninitialized(NumNewInstances);
+		for (int32 Index = 0; Index < NewInstanceLeaf.Num(); Index++)
+		{
+			LeafNewInstances[LeafNewInstanceStart[NewInstanceLeaf[Index]]++] = NumBaseInstances + Index;
+		}
+
+		TArray<int32>& SortedInstances = Result->SortedInstances;
+		SortedInstances.Reserve(OriginalNum);
+		int32 NewInstanceRead = 0;
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); NodeIndex++)
+		{
+			FClusterNode& Node = Nodes[NodeIndex];
+			if (Node.FirstChild >= 0)
+			{
+				continue;
+			}
+			checkSlow(Node.FirstInstance == SortedInstances.Num() - NewInstanceRead);
+
+			const int32 FirstInstance = SortedInstances.Num();
+			SortedInstances.Append(&BaseSortedInstances[Node.FirstInstance], 1 + Node.LastInstance - Node.FirstInstance);
+
+			FBox NodeBox(Node.BoundMin, Node.BoundMax);
+			for (int32 Count = 0; Count < NodeNewInstanceCount[NodeIndex]; Count++)
+			{
+				const int32 InstanceIndex = LeafNewInstances[NewInstanceRead++];
+				const FMatrix& ThisInstTrans = Transforms[InstanceIndex];
+				NodeBox += InstBox.TransformBy(ThisInstTrans);
+
+				if (GenerateInstanceScalingRange)
+				{
+					FVector CurrentScale = ThisInstTrans.GetScaleVector();
+
+					Node.MinInstanceScale = Node.MinInstanceScale.ComponentMin(CurrentScale);
+					Node.MaxInstanceScale = Node.MaxInstanceScale.ComponentMax(CurrentScale);
+				}
+				SortedInstances.Add(InstanceIndex);
+			}
+			Node.FirstInstance = FirstInstance;
+			Node.LastInstance = SortedInstances.Num() - 1;
+			Node.BoundMin = NodeBox.Min;
+			Node.BoundMax = NodeBox.Max;
+		}
+		check(SortedInstances.Num() == OriginalNum);
+
+		// Children always have larger indices than their parent, so a reverse walk refits bottom up
+		for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; NodeIndex--)
+		{
+			FClusterNode& Node = Nodes[NodeIndex];
+			if (Node.FirstChild < 0)
+			{
+				continue;
+			}
+			Node.FirstInstance = Nodes[Node.FirstChild].FirstInstance;
+			Node.LastInstance = Nodes[Node.LastChild].LastInstance;
+			FBox NodeBox(ForceInit);
+			for (int32 ChildIndex = Node.FirstChild; ChildIndex <= Node.LastChild; ChildIndex++)
+			{
+				FClusterNode& ChildNode = Nodes[ChildIndex];
+				NodeBox += ChildNode.BoundMin;
+				NodeBox += ChildNode.BoundMax;
+
+				if (GenerateInstanceScalingRange)
+				{
+					Node.MinInstanceScale = Node.MinInstanceScale.ComponentMin(ChildNode.MinInstanceScale);
+					Node.MaxInstanceScale = Node.MaxInstanceScale.ComponentMax(ChildNode.MaxInstanceScale);
+				}
+			}
+			Node.BoundMin = NodeBox.Min;
+			Node.BoundMax = NodeBox.Max;
+		}
+
+		Num = OriginalNum;
+		Result->InstanceReorderTable.Init(INDEX_NONE, OriginalNum);
+		for (int32 Index = 0; Index < Num; Index++)
+		{
+			Result->InstanceReorderTable[SortedInstances[Index]] = Index;
+		}
+
+		if (!GenerateInstanceScalingRange)
+		{
+			Nodes[0].MinInstanceScale = FVector::OneVector;
+			Nodes[0].MaxInstanceScale = FVector::OneVector;
+		}
+		return true;
+	}
+
 	void BuildTree()
 	{
 		Init();
@@ -470,7 +679,7 @@ public:
 		NumRoots = Clusters.Num();
 		Result->Nodes.Init(FClusterNode(), Clusters.Num());
 
-		for (int32 Index = 0; Index < NumRoots; Index++)
+		ParallelFor(NumRoots, [this, &SortedInstances](int32 Index)
 		{
 			FClusterNode& Node = Result->Nodes[Index];
 			Node.FirstInstance = Clusters[Index].Start;
@@ -492,7 +701,7 @@ public:
 			}
 			Node.BoundMin = NodeBox.Min;
 			Node.BoundMax = NodeBox.Max;
-		}
+		}, ParallelSplitMinInstances <= 0 || Num < ParallelSplitMinInstances);
 		TArray<int32> NodesPerLevel;
 		NodesPerLevel.Add(NumRoots);
 		int32 LOD = 0;
@@ -755,7 +964,7 @@ static void TestFoliage(const TArray<FString>& Args)
 		InstanceTransforms[Index] = Instances[Index].Transform;
 	}
 
-	FClusterBuilder Builder(InstanceTransforms, InstanceCustomDataDummy, 0, TempBox, 16, 1.0f, 1, 0);
+	FClusterBuilder Builder(MoveTemp(InstanceTransforms), InstanceCustomDataDummy, 0, TempBox, 16, 1.0f, 1, 0);
 	Builder.BuildTree();
 
 	int32 Level = 0;
@@ -2023,6 +2232,7 @@ UHierarchicalInstancedStaticMeshComponent::UHierarchicalInstancedStaticMeshCompo
 	, bIsOutOfDate(false)
 	, bConcurrentChanges(false)
 	, bAutoRebuildTreeOnInstanceChanges(true)
+	, bCanBuildTreeIncrementally(false)
 #if WITH_EDITOR
 	, bCanEnableDensityScaling(true)
 #endif
@@ -2178,6 +2388,7 @@ void UHierarchicalInstancedStaticMeshComponent::RemoveInstancesInternal(const in
 	{
 		bIsOutOfDate = true;
 		bConcurrentChanges |= IsAsyncBuilding();
+		bCanBuildTreeIncrementally = false;
 	}
 
 	for (int32 Index = 0; Index < Num; ++Index)
@@ -2361,6 +2572,8 @@ bool UHierarchicalInstancedStaticMeshComponent::UpdateInstanceTransform(int32 In
 			if (!OldInstanceBounds.IsInside(NewInstanceBounds))
 			{
 				BuiltInstanceBounds += NewInstanceBounds;
+				// the node bounds no longer contain the instance, only a full build fixes them
+				bCanBuildTreeIncrementally = false;
 			}
 
 			if (bMarkRenderStateDirty)
@@ -2372,6 +2585,7 @@ bool UHierarchicalInstancedStaticMeshComponent::UpdateInstanceTransform(int32 In
 		{
 			UnbuiltInstanceBounds += NewInstanceBounds;
 			UnbuiltInstanceBoundsList.Add(NewInstanceBounds);
+			bCanBuildTreeIncrementally = false;
 
 			BuildTreeIfOutdated(/*Async*/true, /*ForceUpdate*/false);
 		}
@@ -2477,6 +2691,7 @@ bool UHierarchicalInstancedStaticMeshComponent::BatchUpdateInstancesData(int32 S
 	bool BatchResult = true;
 
 	Super::BatchUpdateInstancesData(StartInstanceIndex, NumInstances, StartInstanceData, bMarkRenderStateDirty, bTeleport);
+	bCanBuildTreeIncrementally = false;
 	BuildTreeIfOutdated(/*Async*/true, /*ForceUpdate*/false);
 
 	return BatchResult;
@@ -2485,6 +2700,7 @@ bool UHierarchicalInstancedStaticMeshComponent::BatchUpdateInstancesData(int32 S
 void UHierarchicalInstancedStaticMeshComponent::ApplyComponentInstanceData(FInstancedStaticMeshComponentInstanceData* InstancedMeshData)
 {
 	UInstancedStaticMeshComponent::ApplyComponentInstanceData(InstancedMeshData);
+	bCanBuildTreeIncrementally = false;
 
 	BuildTreeIfOutdated(/*Async*/false, /*ForceUpdate*/false);
 }
@@ -2579,6 +2795,7 @@ void UHierarchicalInstancedStaticMeshComponent::ClearInstances()
 {
 	bIsOutOfDate = true;
 	bConcurrentChanges |= IsAsyncBuilding();
+	bCanBuildTreeIncrementally = false;
 	
 	ClusterTreePtr = MakeShareable(new TArray<FClusterNode>);
 	NumBuiltInstances = 0;
@@ -2731,7 +2948,11 @@ void UHierarchicalInstancedStaticMeshComponent::BuildTree()
 		TArray<FMatrix> InstanceTransforms;
 		GetInstanceTransforms(InstanceTransforms);
 
-		FClusterBuilder Builder(InstanceTransforms, PerInstanceSMCustomData, NumCustomDataFloats, GetStaticMesh()->GetBounds().GetBox(), DesiredInstancesPerLeaf(), CurrentDensityScaling, InstancingRandomSeed, PerInstanceSMData.Num() > 0);
+		FClusterBuilder Builder(MoveTemp(InstanceTransforms), PerInstanceSMCustomData, NumCustomDataFloats, GetStaticMesh()->GetBounds().GetBox(), DesiredInstancesPerLeaf(), CurrentDensityScaling, InstancingRandomSeed, PerInstanceSMData.Num() > 0);
+		if (CanBuildTreeIncrementally())
+		{
+			Builder.SetIncrementalBase(*ClusterTreePtr, SortedInstances, OcclusionLayerNumNodes);
+		}
 		Builder.BuildTreeAndBuffer();
 
 		ApplyBuildTree(Builder);
@@ -2778,6 +2999,7 @@ void UHierarchicalInstancedStaticMeshComponent::AcceptPrebuiltTree(TArray<FClust
 	// this is only for prebuild data, already in the correct order
 	check(!PerInstanceSMData.Num());
 	NumBuiltInstances = 0;
+	bCanBuildTreeIncrementally = false;
 	check(PerInstanceRenderData.IsValid());	
 	NumBuiltRenderInstances = InNumBuiltRenderInstances;
 	check(NumBuiltRenderInstances);
@@ -2842,6 +3064,7 @@ void UHierarchicalInstancedStaticMeshComponent::ApplyBuildTreeAsync(ENamedThread
 void UHierarchicalInstancedStaticMeshComponent::ApplyEmpty()
 {
 	bIsOutOfDate = false;
+	bCanBuildTreeIncrementally = false;
 	ClusterTreePtr = MakeShareable(new TArray<FClusterNode>);
 	NumBuiltInstances = 0;
 	NumBuiltRenderInstances = 0;
@@ -2885,6 +3108,9 @@ void UHierarchicalInstancedStaticMeshComponent::ApplyBuildTree(FClusterBuilder&
 	UnbuiltInstanceBounds.Init();
 	UnbuiltInstanceBoundsList.Empty();
 
+	// With density scaling some instances are left out of the tree and could not be inserted later on
+	bCanBuildTreeIncrementally = NumBuiltRenderInstances == NumBuiltInstances;
+
 	check(BuiltInstanceData.IsValid());
 	check(BuiltInstanceData->GetNumInstances() == NumBuiltRenderInstances);
 
@@ -2921,6 +3147,11 @@ bool UHierarchicalInstancedStaticMeshComponent::BuildTreeIfOutdated(bool Async,
 		return false;
 	}
 
+	if (ForceUpdate || (GetStaticMesh() != nullptr && CacheMeshExtendedBounds != GetStaticMesh()->GetBounds()))
+	{
+		bCanBuildTreeIncrementally = false;
+	}
+
 	if (ForceUpdate 
 		|| bIsOutOfDate
 		|| InstanceUpdateCmdBuffer.NumTotalCommands() != 0
@@ -2966,6 +3197,18 @@ bool UHierarchicalInstancedStaticMeshComponent::BuildTreeIfOutdated(bool Async,
 	return false;
 }
 
+bool UHierarchicalInstancedStaticMeshComponent::CanBuildTreeIncrementally() const
+{
+	// Only instances appended since the last build can be inserted, anything else invalidates the existing tree
+	const int32 NumAddedInstances = PerInstanceSMData.Num() - NumBuiltInstances;
+	return bCanBuildTreeIncrementally
+		&& NumAddedInstances > 0
+		&& NumAddedInstances <= CVarFoliageIncrementalBuildTreeMaxInstances.GetValueOnGameThread()
+		&& UnbuiltInstanceBoundsList.Num() == NumAddedInstances
+		&& SortedInstances.Num() == NumBuiltInstances
+		&& ClusterTreePtr.IsValid() && ClusterTreePtr->Num() > 0;
+}
+
 void UHierarchicalInstancedStaticMeshComponent::GetInstanceTransforms(TArray<FMatrix>& InstanceTransforms) const
 {
 	double StartTime = FPlatformTime::Seconds();
@@ -3019,7 +3262,11 @@ void UHierarchicalInstancedStaticMeshComponent::BuildTreeAsync()
 		TArray<FMatrix> InstanceTransforms;
 		GetInstanceTransforms(InstanceTransforms);
 		
-		TSharedRef<FClusterBuilder, ESPMode::ThreadSafe> Builder(new FClusterBuilder(InstanceTransforms, PerInstanceSMCustomData, NumCustomDataFloats, GetStaticMesh()->GetBounds().GetBox(), DesiredInstancesPerLeaf(), CurrentDensityScaling, InstancingRandomSeed, PerInstanceSMData.Num() > 0));
+		TSharedRef<FClusterBuilder, ESPMode::ThreadSafe> Builder(new FClusterBuilder(MoveTemp(InstanceTransforms), PerInstanceSMCustomData, NumCustomDataFloats, GetStaticMesh()->GetBounds().GetBox(), DesiredInstancesPerLeaf(), CurrentDensityScaling, InstancingRandomSeed, PerInstanceSMData.Num() > 0));
+		if (CanBuildTreeIncrementally())
+		{
+			Builder->SetIncrementalBase(*ClusterTreePtr, SortedInstances, OcclusionLayerNumNodes);
+		}
 
 		bIsAsyncBuilding = true;
 
@@ -0,0 +1,179 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Net/NetConnectionInstrumentation.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Misc/OutputDevice.h"
+
+int32 GNetConnectionInstrumentation = 1;
+static FAutoConsoleVariableRef CVarNetConnectionInstrumentation(
+	TEXT("net.ConnectionInstrumentation"),
+	GNetConnectionInstrumentation,
+	TEXT("Time ReceivedPacket, FlushNet and the send queueing delay of every connection, and keep the recent packet timings for net.DumpConnectionTimings."),
+	ECVF_Default);
+
+FNetConnectionCounters& FNetConnectionCounters::operator+=(const FNetConnectionCounters& Other)
+{
+	PacketsReceived += Other.PacketsReceived;
+	PacketsSent += Other.PacketsSent;
+	NetReadyChecks += Other.NetReadyChecks;
+	NotNetReady += Other.NotNetReady;
+	ReceivedPacketCycles += Other.ReceivedPacketCycles;
+	FlushNetCycles += Other.FlushNetCycles;
+	QueueDelayCycles += Other.QueueDelayCycles;
+	return *this;
+}
+
+FNetConnectionCounters FNetConnectionCounters::operator-(const FNetConnectionCounters& Other) const
+{
+	FNetConnectionCounters Result;
+	Result.PacketsReceived = PacketsReceived - Other.PacketsReceived;
+	Result.PacketsSent = PacketsSent - Other.PacketsSent;
+	Result.NetReadyChecks = NetReadyChecks - Other.NetReadyChecks;
+	Result.NotNetReady = NotNetReady - Other.NotNetReady;
+	Result.ReceivedPacketCycles = ReceivedPacketCycles - Other.ReceivedPacketCycles;
+	Result.FlushNetCycles = FlushNetCycles - Other.FlushNetCycles;
+	Result.QueueDelayCycles = QueueDelayCycles - Other.QueueDelayCycles;
+	return Result;
+}
+
+void FNetConnectionInstrumentation::RecordReceivedPacket(uint64 StartCycles, int32 PacketId, int64 SizeBits)
+{
+	Increment(PacketsReceived);
+
+	if (StartCycles == 0)
+	{
+		return;
+	}
+
+	const uint64 DurationCycles = FPlatformTime::Cycles64() - StartCycles;
+	Increment(ReceivedPacketCycles, DurationCycles);
+
+	FNetConnectionPacketTiming Timing;
+	Timing.Time = FPlatformTime::Seconds();
+	Timing.PacketId = PacketId;
+	Timing.SizeBits = (int32)SizeBits;
+	Timing.DurationMs = (float)FPlatformTime::ToMilliseconds64(DurationCycles);
+	Timing.bOutgoing = false;
+	AddRecentPacket(Timing);
+}
+
+void FNetConnectionInstrumentation::RecordSentPacket(uint64 StartCycles, int32 PacketId, int64 SizeBits)
+{
+	Increment(PacketsSent);
+
+	// Internal ack connections and packets started while timing was disabled have no start time
+	const uint64 QueuedSinceCycles = PacketStartCycles;
+	PacketStartCycles = 0;
+
+	if (StartCycles == 0)
+	{
+		return;
+	}
+
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	const uint64 DurationCycles = EndCycles - StartCycles;
+	const uint64 QueueDelay = (QueuedSinceCycles != 0 && QueuedSinceCycles <= EndCycles) ? EndCycles - QueuedSinceCycles : 0;
+	Increment(FlushNetCycles, DurationCycles);
+	Increment(QueueDelayCycles, QueueDelay);
+
+	FNetConnectionPacketTiming Timing;
+	Timing.Time = FPlatformTime::Seconds();
+	Timing.PacketId = PacketId;
+	Timing.SizeBits = (int32)SizeBits;
+	Timing.DurationMs = (float)FPlatformTime::ToMilliseconds64(DurationCycles);
+	Timing.QueueDelayMs = (float)FPlatformTime::ToMilliseconds64(QueueDelay);
+	Timing.bOutgoing = true;
+	AddRecentPacket(Timing);
+}
+
+void FNetConnectionInstrumentation::AddRecentPacket(const FNetConnectionPacketTiming& Timing)
+{
+	RecentPackets[NumRecentPacketsRecorded % NumRecentPackets] = Timing;
+	++NumRecentPacketsRecorded;
+}
+
+FNetConnectionCounters FNetConnectionInstrumentation::GetCounters() const
+{
+	FNetConnectionCounters Result;
+	Result.PacketsReceived = PacketsReceived.load(std::memory_order_relaxed);
+	Result.PacketsSent = PacketsSent.load(std::memory_order_relaxed);
+	Result.NetReadyChecks = NetReadyChecks.load(std::memory_order_relaxed);
+	Result.NotNetReady = NotNetReady.load(std::memory_order_relaxed);
+	Result.ReceivedPacketCycles = ReceivedPacketCycles.load(std::memory_order_relaxed);
+	Result.FlushNetCycles = FlushNetCycles.load(std::memory_order_relaxed);
+	Result.QueueDelayCycles = QueueDelayCycles.load(std::memory_order_relaxed);
+	return Result;
+}
+
+void FNetConnectionInstrumentation::GetRecentPackets(TArray<FNetConnectionPacketTiming>& OutPackets) const
+{
+	const uint32 NumValid = FMath::Min<uint32>(NumRecentPacketsRecorded, NumRecentPackets);
+	OutPackets.Reset(NumValid);
+	for (uint32 Index = NumRecentPacketsRecorded - NumValid; Index < NumRecentPacketsRecorded; ++Index)
+	{
+		OutPackets.Add(RecentPackets[Index % NumRecentPackets]);
+	}
+}
+
+void FNetConnectionInstrumentation::Dump(FOutputDevice& Ar) const
+{
+	const FNetConnectionCounters Counters = GetCounters();
+	Ar.Logf(TEXT("  Packets: %llu in, %llu out"), Counters.PacketsReceived, Counters.PacketsSent);
+	Ar.Logf(TEXT("  NetReady: %llu checks, %llu saturated (%.1f%%)"), Counters.NetReadyChecks, Counters.NotNetReady,
+		Counters.NetReadyChecks ? 100.0 * double(Counters.NotNetReady) / double(Counters.NetReadyChecks) : 0.0);
+	Ar.Logf(TEXT("  ReceivedPacket: %.3fms avg, FlushNet: %.3fms avg, queue delay: %.3fms avg"),
+		Counters.PacketsReceived ? FPlatformTime::ToMilliseconds64(Counters.ReceivedPacketCycles) / double(Counters.PacketsReceived) : 0.0,
+		Counters.PacketsSent ? FPlatformTime::ToMilliseconds64(Counters.FlushNetCycles) / double(Counters.PacketsSent) : 0.0,
+		Counters.PacketsSent ? FPlatformTime::ToMilliseconds64(Counters.QueueDelayCycles) / double(Counters.PacketsSent) : 0.0);
+
+	TArray<FNetConnectionPacketTiming> Packets;
+	GetRecentPackets(Packets);
+
+	const double Now = FPlatformTime::Seconds();
+	for (const FNetConnectionPacketTiming& Packet : Packets)
+	{
+		Ar.Logf(TEXT("    %8.3fs ago %s id %6d %5d bits %7.3fms queued %7.3fms"), Now - Packet.Time, Packet.bOutgoing ? TEXT("OUT") : TEXT("IN "),
+			Packet.PacketId, Packet.SizeBits, Packet.DurationMs, Packet.QueueDelayMs);
+	}
+}
+
+static void DumpConnectionTimings(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+{
+	UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+	if (!NetDriver)
+	{
+		Ar.Logf(TEXT("No net driver"));
+		return;
+	}
+
+	// An optional connection index only dumps that client connection
+	const int32 OnlyConnectionIndex = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : INDEX_NONE;
+
+	const FNetConnectionCounters Totals = NetDriver->GetConnectionCounters();
+	Ar.Logf(TEXT("%s: %llu packets in, %llu out, %llu of %llu IsNetReady checks saturated"), *NetDriver->GetDescription(),
+		Totals.PacketsReceived, Totals.PacketsSent, Totals.NotNetReady, Totals.NetReadyChecks);
+
+	if (NetDriver->ServerConnection)
+	{
+		Ar.Logf(TEXT("%s"), *NetDriver->ServerConnection->Describe());
+		NetDriver->ServerConnection->GetInstrumentation().Dump(Ar);
+	}
+
+	for (int32 Index = 0; Index < NetDriver->ClientConnections.Num(); ++Index)
+	{
+		UNetConnection* Connection = NetDriver->ClientConnections[Index];
+		if (Connection && (OnlyConnectionIndex == INDEX_NONE || OnlyConnectionIndex == Index))
+		{
+			Ar.Logf(TEXT("[%d] %s"), Index, *Connection->Describe());
+			Connection->GetInstrumentation().Dump(Ar);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice DumpConnectionTimingsCmd(
+	TEXT("net.DumpConnectionTimings"),
+	TEXT("Dumps the send/receive counters and the recent packet timings of the connections of the game net driver. Optionally takes a client connection index."),
+	FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(DumpConnectionTimings));
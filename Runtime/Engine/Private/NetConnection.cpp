@@ -37,6 +37,7 @@
 #include "Net/NetworkGranularMemoryLogging.h"
 #include "SocketSubsystem.h"
 #include "Math/NumericLimits.h"
+#include "Misc/ScopeExit.h"
 #include "UObject/UnrealNames.h"
 
 static TAutoConsoleVariable<int32> CVarPingExcludeFrameTime(TEXT("net.PingExcludeFrameTime"), 0,
@@ -812,6 +813,9 @@ void UNetConnection::CleanUp()
 
 	if (Driver != nullptr)
 	{
+		// Keep the driver totals monotonic once this connection is gone
+		Driver->ClosedConnectionCounters += Instrumentation.GetCounters();
+
 		// Remove from driver.
 		if (Driver->ServerConnection)
 		{
@@ -1421,6 +1425,8 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 {
 	check(Driver);
 
+	const uint64 FlushStartCycles = FNetConnectionInstrumentation::IsTimingEnabled() ? FPlatformTime::Cycles64() : 0;
+
 	// Update info.
 	ValidateSendBuffer();
 	LastEnd = FBitWriterMark();
@@ -1581,6 +1587,8 @@ void UNetConnection::FlushNet(bool bIgnoreSimulation)
 
 		AnalyticsVars.OutAckOnlyCount += (NumAckBits > 0 && NumBunchBits == 0);
 
+		Instrumentation.RecordSentPacket(FlushStartCycles, OutPacketId - 1, SendBuffer.GetNumBits());
+
 		bFlushedNetThisFrame = true;
 
 		InitSendBuffer();
@@ -1692,12 +1700,10 @@ int32 UNetConnection::IsNetReady(bool Saturate)
 	}
 #endif
 
-	if (NetworkCongestionControl.IsSet())
-	{
-		return NetworkCongestionControl.GetValue().IsReadyToSend(Driver->GetElapsedTime());
-	}
+	const bool bReady = NetworkCongestionControl.IsSet() ? NetworkCongestionControl.GetValue().IsReadyToSend(Driver->GetElapsedTime()) : QueuedBits + SendBuffer.GetNumBits() <= 0;
+	Instrumentation.RecordNetReady(bReady);
 
-	return QueuedBits + SendBuffer.GetNumBits() <= 0;
+	return bReady;
 }
 
 void UNetConnection::ReadInput( float DeltaSeconds )
@@ -2067,6 +2073,13 @@ void UNetConnection::ReceivedPacket( FBitReader& Reader, bool bIsReinjectedPacke
 	SCOPED_NAMED_EVENT(UNetConnection_ReceivedPacket, FColor::Green);
 	AssertValid();
 
+	const uint64 ReceivedPacketStartCycles = FNetConnectionInstrumentation::IsTimingEnabled() ? FPlatformTime::Cycles64() : 0;
+	const int64 ReceivedPacketBits = Reader.GetNumBits();
+	ON_SCOPE_EXIT
+	{
+		Instrumentation.RecordReceivedPacket(ReceivedPacketStartCycles, InPacketId, ReceivedPacketBits);
+	};
+
 	// Handle PacketId.
 	if( Reader.IsError() )
 	{
@@ -2972,6 +2985,8 @@ void UNetConnection::PrepareWriteBitsToSendBuffer(const int32 SizeInBits, const
 	// If this is the start of the queue, make sure to add the packet id
 	if ( SendBuffer.GetNumBits() == 0 && !IsInternalAck() )
 	{
+		Instrumentation.RecordPacketStarted();
+
 #if UE_NET_TRACE_ENABLED
 		// If tracing is enabled setup the NetTraceCollector for outgoing data
 		OutTraceCollector = UE_NET_TRACE_CREATE_COLLECTOR(ENetTraceVerbosity::Trace);
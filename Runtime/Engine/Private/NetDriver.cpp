@@ -65,6 +65,7 @@
 #include "Stats/StatsMisc.h"
 #include "Engine/ReplicationDriver.h"
 #include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CountersTrace.h"
 #include "Engine/LevelScriptActor.h"
 #include "Engine/NetworkSettings.h"
 #include "Net/NetworkGranularMemoryLogging.h"
@@ -72,6 +73,10 @@
 #include "AddressInfoTypes.h"
 #if USE_SERVER_PERF_COUNTERS
 #include "PerfCountersModule.h"
+
+/** Bucket bounds (in ms) of the lock-free histograms exported over the perf counters /metrics endpoint */
+static const double NetSendTimeBucketsMs[] = { 0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 33.0 };
+static const double ConnectionRTTBucketsMs[] = { 10.0, 20.0, 30.0, 50.0, 75.0, 100.0, 150.0, 200.0, 300.0, 500.0, 1000.0 };
 #endif
 
 #if WITH_EDITOR
@@ -149,6 +154,19 @@ DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush"), STAT_NetTickFlush, STATGROUP_Gam
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush GatherStats"), STAT_NetTickFlushGatherStats, STATGROUP_Game);
 DECLARE_CYCLE_STAT(TEXT("NetDriver TickFlush GatherStatsPerfCounters"), STAT_NetTickFlushGatherStatsPerfCounters, STATGROUP_Game);
 
+// Per frame connection instrumentation of the game net driver, summed over all connections
+DECLARE_DWORD_COUNTER_STAT(TEXT("Not NetReady Checks"), STAT_NetNotNetReady, STATGROUP_Net);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("ReceivedPacket Time (ms)"), STAT_NetReceivedPacketTime, STATGROUP_Net);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("FlushNet Time (ms)"), STAT_NetFlushNetTime, STATGROUP_Net);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Avg Send Queue Delay (ms)"), STAT_NetAvgQueueDelay, STATGROUP_Net);
+
+CSV_DEFINE_CATEGORY(NetConnection, true);
+
+TRACE_DECLARE_INT_COUNTER(NetNotNetReady, TEXT("Net/NotNetReady"));
+TRACE_DECLARE_FLOAT_COUNTER(NetReceivedPacketTime, TEXT("Net/ReceivedPacketTimeMs"));
+TRACE_DECLARE_FLOAT_COUNTER(NetFlushNetTime, TEXT("Net/FlushNetTimeMs"));
+TRACE_DECLARE_FLOAT_COUNTER(NetAvgQueueDelay, TEXT("Net/AvgSendQueueDelayMs"));
+
 int32 GNumSaturatedConnections; // Counter for how many connections are skipped/early out due to bandwidth saturation
 int32 GNumSharedSerializationHit;
 int32 GNumSharedSerializationMiss;
@@ -667,6 +685,10 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 	}
 	FSimpleScopeSecondsCounter ScopedTimer(GTickFlushGameDriverTimeSeconds, bEnableTimer);
 
+#if USE_SERVER_PERF_COUNTERS
+	const uint64 TickFlushStartCycles = FPlatformTime::Cycles64();
+#endif
+
 	if (IsServer() && ClientConnections.Num() > 0 && !bSkipServerReplicateActors)
 	{
 		// Update all clients.
@@ -970,6 +992,8 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 
 					int32 Buckets[kNumBuckets] = { 0 };
 
+					FPerfCounterHistogram& ConnectionRTTHistogram = PerfCounters->FindOrAddMetricHistogram(IPerfCounters::Histograms::ConnectionRTT, ConnectionRTTBucketsMs);
+
 					for (int32 i = 0; i < ClientConnections.Num(); i++)
 					{
 						UNetConnection* Connection = ClientConnections[i];
@@ -983,6 +1007,7 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 
 								int Bucket = FMath::Max(0, FMath::Min(kNumBuckets - 1, (static_cast<int>(ConnPing) / 30)));
 								++Buckets[Bucket];
+								ConnectionRTTHistogram.Observe(ConnPing);
 
 								if (ConnPing < MinPing)
 								{
@@ -1052,6 +1077,14 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 				PerfCounters->Set(TEXT("OutPackets"), OutPackets);
 				PerfCounters->Set(TEXT("InBunches"), InBunches);
 				PerfCounters->Set(TEXT("OutBunches"), OutBunches);
+
+				// Totals since startup, rates are left to the scraper
+				const FNetConnectionCounters ConnectionCounters = GetConnectionCounters();
+				PerfCounters->SetNumber(TEXT("NotNetReadyTotal"), (double)ConnectionCounters.NotNetReady, IPerfCounters::Flags::Monotonic);
+				PerfCounters->SetNumber(TEXT("ReceivedPacketTimeMsTotal"), FPlatformTime::ToMilliseconds64(ConnectionCounters.ReceivedPacketCycles), IPerfCounters::Flags::Monotonic);
+				PerfCounters->SetNumber(TEXT("FlushNetTimeMsTotal"), FPlatformTime::ToMilliseconds64(ConnectionCounters.FlushNetCycles), IPerfCounters::Flags::Monotonic);
+				PerfCounters->SetNumber(TEXT("SendQueueDelayMsTotal"), FPlatformTime::ToMilliseconds64(ConnectionCounters.QueueDelayCycles), IPerfCounters::Flags::Monotonic);
+				PerfCounters->SetNumber(TEXT("PacketsSentTotal"), (double)ConnectionCounters.PacketsSent, IPerfCounters::Flags::Monotonic);
 			}
 #endif // USE_SERVER_PERF_COUNTERS
 
@@ -1292,6 +1325,60 @@ void UNetDriver::TickFlush(float DeltaSeconds)
 
 	// Update the lag state
 	UpdateNetworkLagState();
+
+	if (NetDriverName == NAME_GameNetDriver)
+	{
+		const FNetConnectionCounters ConnectionCounters = GetConnectionCounters();
+		const FNetConnectionCounters FrameCounters = ConnectionCounters - LastTickFlushConnectionCounters;
+		LastTickFlushConnectionCounters = ConnectionCounters;
+
+		const float ReceivedPacketTimeMs = (float)FPlatformTime::ToMilliseconds64(FrameCounters.ReceivedPacketCycles);
+		const float FlushNetTimeMs = (float)FPlatformTime::ToMilliseconds64(FrameCounters.FlushNetCycles);
+		const float AvgQueueDelayMs = FrameCounters.PacketsSent ? (float)(FPlatformTime::ToMilliseconds64(FrameCounters.QueueDelayCycles) / double(FrameCounters.PacketsSent)) : 0.f;
+
+		SET_DWORD_STAT(STAT_NetNotNetReady, FrameCounters.NotNetReady);
+		SET_FLOAT_STAT(STAT_NetReceivedPacketTime, ReceivedPacketTimeMs);
+		SET_FLOAT_STAT(STAT_NetFlushNetTime, FlushNetTimeMs);
+		SET_FLOAT_STAT(STAT_NetAvgQueueDelay, AvgQueueDelayMs);
+
+		CSV_CUSTOM_STAT(NetConnection, NotNetReady, (int32)FrameCounters.NotNetReady, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(NetConnection, ReceivedPacketTimeMs, ReceivedPacketTimeMs, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(NetConnection, FlushNetTimeMs, FlushNetTimeMs, ECsvCustomStatOp::Set);
+		CSV_CUSTOM_STAT(NetConnection, AvgSendQueueDelayMs, AvgQueueDelayMs, ECsvCustomStatOp::Set);
+
+		TRACE_COUNTER_SET(NetNotNetReady, FrameCounters.NotNetReady);
+		TRACE_COUNTER_SET(NetReceivedPacketTime, ReceivedPacketTimeMs);
+		TRACE_COUNTER_SET(NetFlushNetTime, FlushNetTimeMs);
+		TRACE_COUNTER_SET(NetAvgQueueDelay, AvgQueueDelayMs);
+	}
+
+#if USE_SERVER_PERF_COUNTERS
+	if (NetDriverName == NAME_GameNetDriver)
+	{
+		if (IPerfCounters* PerfCounters = IPerfCountersModule::Get().GetPerformanceCounters())
+		{
+			const double TickFlushTimeMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - TickFlushStartCycles);
+			PerfCounters->FindOrAddMetricHistogram(IPerfCounters::Histograms::NetSendTime, NetSendTimeBucketsMs).Observe(TickFlushTimeMs);
+		}
+	}
+#endif
+}
+
+FNetConnectionCounters UNetDriver::GetConnectionCounters() const
+{
+	FNetConnectionCounters Result = ClosedConnectionCounters;
+	if (ServerConnection)
+	{
+		Result += ServerConnection->GetInstrumentation().GetCounters();
+	}
+	for (const UNetConnection* Connection : ClientConnections)
+	{
+		if (Connection)
+		{
+			Result += Connection->GetInstrumentation().GetCounters();
+		}
+	}
+	return Result;
 }
 
 void UNetDriver::UpdateNetworkLagState()
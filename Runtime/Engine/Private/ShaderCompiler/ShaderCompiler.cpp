@@ -106,6 +106,15 @@ static FAutoConsoleVariableRef CVarShaderCompilerDumpCompileJobInputs(
 	ECVF_Default
 );
 
+int32 GShaderCompilerWorkerSharedMemoryMB = 32;
+static FAutoConsoleVariableRef CVarShaderCompilerWorkerSharedMemoryMB(
+	TEXT("r.ShaderCompiler.WorkerSharedMemoryMB"),
+	GShaderCompilerWorkerSharedMemoryMB,
+	TEXT("Size in megabytes of the shared memory region used to exchange job batches with each local ShaderCompileWorker (32MB by default).\n")
+	TEXT("Batches that don't fit still go through the transfer files. If 0, only transfer files are used. Read when the shader compiling thread starts."),
+	ECVF_ReadOnly
+);
+
 int32 GShaderCompilerCacheStatsPrintoutInterval = 180;
 static FAutoConsoleVariableRef CVarShaderCompilerCacheStatsPrintoutInterval(
 	TEXT("r.ShaderCompiler.CacheStatsPrintoutInterval"),
@@ -1096,6 +1105,10 @@ bool FShaderCompileUtilities::DoWriteTasks(const TArray<FShaderCommonCompileJobP
 	}
 	TransferFile << ShaderSourceDirectoryMappings;
 
+	// Lets a long lived worker keep its shader file cache until the shader files are flushed on this side.
+	uint32 ShaderFileCacheGeneration = GetShaderFileCacheGeneration();
+	TransferFile << ShaderFileCacheGeneration;
+
 	TArray<FShaderCompileJob*> QueuedSingleJobs;
 	TArray<FShaderPipelineCompileJob*> QueuedPipelineJobs;
 	SplitJobsByType(QueuedJobs, QueuedSingleJobs, QueuedPipelineJobs);
@@ -1708,6 +1721,12 @@ struct FShaderCompileWorkerInfo
 	/** Jobs that this worker is responsible for compiling. */
 	TArray<FShaderCommonCompileJobPtr> QueuedJobs;
 
+	/** Shared memory region used to exchange batches with the worker, null if batches only go through files. */
+	FPlatformMemory::FSharedMemoryRegion* SharedMemoryRegion = nullptr;
+
+	/** Whether the current batch was issued through SharedMemoryRegion rather than the input file. */
+	bool bIssuedTasksThroughSharedMemory = false;
+
 	FShaderCompileWorkerInfo() :
 		bIssuedTasksToWorker(false),		
 		bLaunchedWorker(false),
@@ -1724,6 +1743,16 @@ struct FShaderCompileWorkerInfo
 			FPlatformProcess::TerminateProc(WorkerProcess);
 			FPlatformProcess::CloseProc(WorkerProcess);
 		}
+
+		if (SharedMemoryRegion)
+		{
+			FPlatformMemory::UnmapNamedSharedMemoryRegion(SharedMemoryRegion);
+		}
+	}
+
+	FShaderCompileWorkerMailbox* GetMailbox() const
+	{
+		return SharedMemoryRegion ? (FShaderCompileWorkerMailbox*)SharedMemoryRegion->GetAddress() : nullptr;
 	}
 };
 
@@ -1746,9 +1775,27 @@ FShaderCompileThreadRunnable::FShaderCompileThreadRunnable(FShaderCompilingManag
 	: FShaderCompileThreadRunnableBase(InManager)
 	, LastCheckForWorkersTime(0)
 {
+	const SIZE_T SharedMemorySize = (SIZE_T)FMath::Max(GShaderCompilerWorkerSharedMemoryMB, 0) * 1024 * 1024;
+
 	for (uint32 WorkerIndex = 0; WorkerIndex < Manager->NumShaderCompilingThreads; WorkerIndex++)
 	{
-		WorkerInfos.Add(new FShaderCompileWorkerInfo());
+		FShaderCompileWorkerInfo* WorkerInfo = new FShaderCompileWorkerInfo();
+
+		if (SharedMemorySize > sizeof(FShaderCompileWorkerMailbox))
+		{
+			const FString RegionName = FShaderCompileWorkerMailbox::GetRegionName(Manager->ProcessId, WorkerIndex);
+			WorkerInfo->SharedMemoryRegion = FPlatformMemory::MapNamedSharedMemoryRegion(RegionName, true, FPlatformMemory::ESharedMemoryAccess::Read | FPlatformMemory::ESharedMemoryAccess::Write, SharedMemorySize);
+			if (WorkerInfo->SharedMemoryRegion)
+			{
+				WorkerInfo->GetMailbox()->Initialize(WorkerInfo->SharedMemoryRegion->GetSize());
+			}
+			else
+			{
+				UE_LOG(LogShaderCompilers, Warning, TEXT("Could not create shared memory region '%s', worker %u will exchange batches through files."), *RegionName, WorkerIndex);
+			}
+		}
+
+		WorkerInfos.Add(WorkerInfo);
 	}
 }
 
@@ -1915,6 +1962,11 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 		if (!CurrentWorkerInfo.bIssuedTasksToWorker && CurrentWorkerInfo.QueuedJobs.Num() > 0)
 		{
 			CurrentWorkerInfo.bIssuedTasksToWorker = true;
+			CurrentWorkerInfo.bIssuedTasksThroughSharedMemory = WriteNewTasksToSharedMemory(CurrentWorkerInfo);
+			if (CurrentWorkerInfo.bIssuedTasksThroughSharedMemory)
+			{
+				continue;
+			}
 
 			const FString WorkingDirectory = Manager->AbsoluteShaderBaseWorkingDirectory + FString::FromInt(WorkerIndex);
 
@@ -1994,6 +2046,40 @@ void FShaderCompileThreadRunnable::WriteNewTasks()
 	}
 }
 
+bool FShaderCompileThreadRunnable::WriteNewTasksToSharedMemory(FShaderCompileWorkerInfo& WorkerInfo)
+{
+	FShaderCompileWorkerMailbox* Mailbox = WorkerInfo.GetMailbox();
+	if (!Mailbox)
+	{
+		return false;
+	}
+
+	// Nobody else can be looking at the mailbox if no worker is running, so recover from a worker that died mid-batch.
+	if (!WorkerInfo.WorkerProcess.IsValid())
+	{
+		Mailbox->SetState(FShaderCompileWorkerMailbox::Idle);
+	}
+	else if (Mailbox->GetState() != FShaderCompileWorkerMailbox::Idle)
+	{
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FShaderCompileThreadRunnable::WriteNewTasksToSharedMemory);
+
+	TArray<uint8> TransferData;
+	FMemoryWriter TransferWriter(TransferData);
+	if (!FShaderCompileUtilities::DoWriteTasks(WorkerInfo.QueuedJobs, TransferWriter) || TransferData.Num() > Mailbox->PayloadCapacity)
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(Mailbox->GetPayload(), TransferData.GetData(), TransferData.Num());
+	Mailbox->InputSize = TransferData.Num();
+	Mailbox->OutputSize = 0;
+	Mailbox->SetState(FShaderCompileWorkerMailbox::InputReady);
+	return true;
+}
+
 bool FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 {
 	const double CurrentTime = FPlatformTime::Seconds();
@@ -2039,8 +2125,9 @@ bool FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 				{
 					const FString WorkingDirectory = Manager->AbsoluteShaderBaseWorkingDirectory + FString::FromInt(WorkerIndex) + TEXT("/");
 					const FString OutputFileNameAndPath = WorkingDirectory + TEXT("WorkerOutputOnly.out");
+					const FShaderCompileWorkerMailbox* Mailbox = CurrentWorkerInfo.bIssuedTasksThroughSharedMemory ? CurrentWorkerInfo.GetMailbox() : nullptr;
 
-					if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*OutputFileNameAndPath))
+					if ((Mailbox && Mailbox->GetState() == FShaderCompileWorkerMailbox::OutputReady) || FPlatformFileManager::Get().GetPlatformFile().FileExists(*OutputFileNameAndPath))
 					{
 						// If the worker is no longer running but it successfully wrote out the output, no need to assert
 						bLaunchAgain = false;
@@ -2062,8 +2149,11 @@ bool FShaderCompileThreadRunnable::LaunchWorkersIfNeeded()
 				FString InputFileName(TEXT("WorkerInputOnly.in"));
 				FString OutputFileName(TEXT("WorkerOutputOnly.out"));
 
+				// Platforms may decorate the region name, so pass the undecorated one the worker will map again.
+				const FString SharedMemoryName = CurrentWorkerInfo.SharedMemoryRegion ? FShaderCompileWorkerMailbox::GetRegionName(Manager->ProcessId, WorkerIndex) : FString();
+
 				// Store the handle with this thread so that we will know not to launch it again
-				CurrentWorkerInfo.WorkerProcess = Manager->LaunchWorker(WorkingDirectory, Manager->ProcessId, WorkerIndex, InputFileName, OutputFileName);
+				CurrentWorkerInfo.WorkerProcess = Manager->LaunchWorker(WorkingDirectory, Manager->ProcessId, WorkerIndex, InputFileName, OutputFileName, SharedMemoryName);
 				CurrentWorkerInfo.bLaunchedWorker = true;
 
 				NumberLaunched++;
@@ -2091,6 +2181,20 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(FShaderCompileThreadRunnable::ReadAvailableResults);
 
+			FShaderCompileWorkerMailbox* Mailbox = CurrentWorkerInfo.bIssuedTasksThroughSharedMemory ? CurrentWorkerInfo.GetMailbox() : nullptr;
+			if (Mailbox && Mailbox->GetState() == FShaderCompileWorkerMailbox::OutputReady)
+			{
+				check(!CurrentWorkerInfo.bComplete);
+				FMemoryReaderView OutputReader(MakeArrayView<const uint8>(Mailbox->GetPayload(), (int32)Mailbox->OutputSize));
+				FShaderCompileUtilities::DoReadTaskResults(CurrentWorkerInfo.QueuedJobs, OutputReader);
+
+				Mailbox->SetState(FShaderCompileWorkerMailbox::Idle);
+				CurrentWorkerInfo.bIssuedTasksThroughSharedMemory = false;
+				CurrentWorkerInfo.bComplete = true;
+				continue;
+			}
+
+			// Batches that didn't fit in shared memory and crash reports always come back through the output file.
 			// Distributed compiles always use the same directory
 			// 'Only' indicates to the worker that it should log and continue checking for the input file after the first one is processed
 			TStringBuilder<512> OutputFileNameAndPath;
@@ -2123,6 +2227,12 @@ void FShaderCompileThreadRunnable::ReadAvailableResults()
 					}
 					checkf(bDeletedOutput, TEXT("Failed to delete %s!"), *OutputFileNameAndPath);
 
+					if (Mailbox)
+					{
+						Mailbox->SetState(FShaderCompileWorkerMailbox::Idle);
+						CurrentWorkerInfo.bIssuedTasksThroughSharedMemory = false;
+					}
+
 					CurrentWorkerInfo.bComplete = true;
 				}
 			}
@@ -2929,7 +3039,7 @@ void FShaderCompilingManager::ProcessFinishedJob(FShaderCommonCompileJob* Finish
 }
 
 /** Launches the worker, returns the launched process handle. */
-FProcHandle FShaderCompilingManager::LaunchWorker(const FString& WorkingDirectory, uint32 InProcessId, uint32 ThreadId, const FString& WorkerInputFile, const FString& WorkerOutputFile)
+FProcHandle FShaderCompilingManager::LaunchWorker(const FString& WorkingDirectory, uint32 InProcessId, uint32 ThreadId, const FString& WorkerInputFile, const FString& WorkerOutputFile, const FString& SharedMemoryName)
 {
 	// Setup the parameters that the worker application needs
 	// Surround the working directory with double quotes because it may contain a space 
@@ -2940,6 +3050,10 @@ FProcHandle FShaderCompilingManager::LaunchWorker(const FString& WorkingDirector
 	FPaths::NormalizeDirectoryName(WorkerAbsoluteDirectory);
 	FString WorkerParameters = FString(TEXT("\"")) + WorkerAbsoluteDirectory + TEXT("/\" ") + FString::FromInt(InProcessId) + TEXT(" ") + FString::FromInt(ThreadId) + TEXT(" ") + WorkerInputFile + TEXT(" ") + WorkerOutputFile;
 	WorkerParameters += FString(TEXT(" -communicatethroughfile "));
+	if (!SharedMemoryName.IsEmpty())
+	{
+		WorkerParameters += FString::Printf(TEXT(" -SharedMemory=%s "), *SharedMemoryName);
+	}
 	if ( GIsBuildMachine )
 	{
 		WorkerParameters += FString::Printf(TEXT(" -TimeToLive=%f"), GBuildWorkerTimeToLive);
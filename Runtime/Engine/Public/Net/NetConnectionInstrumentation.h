@@ -0,0 +1,120 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** net.ConnectionInstrumentation */
+extern ENGINE_API int32 GNetConnectionInstrumentation;
+
+/**
+ * Aggregate send/receive counters for one connection, or summed over all connections of a driver.
+ * All values only ever grow, deltas between two samples give per frame or per period values.
+ */
+struct ENGINE_API FNetConnectionCounters
+{
+	uint64 PacketsReceived = 0;
+	uint64 PacketsSent = 0;
+
+	/** Calls to IsNetReady, and how many of them found the connection saturated, i.e. replication that had to be skipped */
+	uint64 NetReadyChecks = 0;
+	uint64 NotNetReady = 0;
+
+	/** Cycles spent in ReceivedPacket and in the sending part of FlushNet */
+	uint64 ReceivedPacketCycles = 0;
+	uint64 FlushNetCycles = 0;
+
+	/** Sum over all sent packets of the cycles between the first bits being queued in the send buffer and the packet being sent */
+	uint64 QueueDelayCycles = 0;
+
+	FNetConnectionCounters& operator+=(const FNetConnectionCounters& Other);
+	FNetConnectionCounters operator-(const FNetConnectionCounters& Other) const;
+};
+
+/** One entry of the recent packet history of a connection */
+struct FNetConnectionPacketTiming
+{
+	/** FPlatformTime::Seconds() when the packet was received or sent */
+	double Time = 0.0;
+	int32 PacketId = 0;
+	int32 SizeBits = 0;
+
+	/** Time spent in ReceivedPacket or FlushNet */
+	float DurationMs = 0.f;
+
+	/** Time the packet was queued before being sent, outgoing packets only */
+	float QueueDelayMs = 0.f;
+
+	bool bOutgoing = false;
+};
+
+/**
+ * Cheap always-on instrumentation of the UNetConnection send and receive paths.
+ * Counters are written by the game thread only, but can be read from any thread.
+ * The last NumRecentPackets packet timings are kept in a ring buffer that can be dumped with net.DumpConnectionTimings,
+ * which is often enough to diagnose rubber-banding without enabling full net trace.
+ */
+class ENGINE_API FNetConnectionInstrumentation
+{
+public:
+	enum { NumRecentPackets = 64 };
+
+	/** net.ConnectionInstrumentation, enables the packet timings. The IsNetReady counters are always on. */
+	static FORCEINLINE bool IsTimingEnabled()
+	{
+		return GNetConnectionInstrumentation != 0;
+	}
+
+	FORCEINLINE void RecordNetReady(bool bReady)
+	{
+		Increment(NetReadyChecks);
+		if (!bReady)
+		{
+			Increment(NotNetReady);
+		}
+	}
+
+	/** Called when the first bits of a new packet are written to the send buffer */
+	FORCEINLINE void RecordPacketStarted()
+	{
+		if (IsTimingEnabled())
+		{
+			PacketStartCycles = FPlatformTime::Cycles64();
+		}
+	}
+
+	/** StartCycles is 0 when timing was disabled at the start of ReceivedPacket or FlushNet */
+	void RecordReceivedPacket(uint64 StartCycles, int32 PacketId, int64 SizeBits);
+	void RecordSentPacket(uint64 StartCycles, int32 PacketId, int64 SizeBits);
+
+	FNetConnectionCounters GetCounters() const;
+
+	/** Recent packets, oldest first */
+	void GetRecentPackets(TArray<FNetConnectionPacketTiming>& OutPackets) const;
+
+	void Dump(FOutputDevice& Ar) const;
+
+private:
+	static FORCEINLINE void Increment(std::atomic<uint64>& Counter, uint64 Value = 1)
+	{
+		// Single writer, so a plain load and store is enough and avoids a locked add on the hot path
+		Counter.store(Counter.load(std::memory_order_relaxed) + Value, std::memory_order_relaxed);
+	}
+
+	void AddRecentPacket(const FNetConnectionPacketTiming& Timing);
+
+	std::atomic<uint64> PacketsReceived { 0 };
+	std::atomic<uint64> PacketsSent { 0 };
+	std::atomic<uint64> NetReadyChecks { 0 };
+	std::atomic<uint64> NotNetReady { 0 };
+	std::atomic<uint64> ReceivedPacketCycles { 0 };
+	std::atomic<uint64> FlushNetCycles { 0 };
+	std::atomic<uint64> QueueDelayCycles { 0 };
+
+	uint64 PacketStartCycles = 0;
+
+	/** Game thread only */
+	FNetConnectionPacketTiming RecentPackets[NumRecentPackets];
+	uint32 NumRecentPacketsRecorded = 0;
+};
@@ -373,6 +373,14 @@ public:
 	/** Accesses wind parameters safely for game thread applications */
 	virtual void GetWindParameters_GameThread(const FVector& Position, FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const = 0;
 
+	/**
+	 * Tests a world space box against the most recent CPU occlusion buffer of a view of the scene, see r.AllowSoftwareOcclusion.
+	 * Safe to call from any thread, e.g. for network relevancy or AI visibility checks.
+	 * @param ViewKey - FSceneViewStateInterface::GetViewKey of the view whose buffer is tested
+	 * @return true if the box was hidden from that view, false if visible or the view has no occlusion data
+	 */
+	virtual bool IsBoxSoftwareOccluded(const FBox& Box, uint32 ViewKey) const { return false; }
+
 	/** Same as GetWindParameters, but ignores point wind sources. */
 	virtual void GetDirectionalWindParameters(FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const = 0;
 
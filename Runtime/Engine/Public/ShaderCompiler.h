@@ -608,6 +608,9 @@ private:
 	/** Used when compiling through workers, writes out the worker inputs for any new tasks in WorkerInfos.QueuedJobs. */
 	void WriteNewTasks();
 
+	/** Tries to hand the worker's new tasks over through its shared memory mailbox, returns false if the input file has to be used instead. */
+	bool WriteNewTasksToSharedMemory(struct FShaderCompileWorkerInfo& WorkerInfo);
+
 	/** Used when compiling through workers, launches worker processes if needed. */
 	bool LaunchWorkersIfNeeded();
 
@@ -917,8 +920,8 @@ private:
 	/** Opt out of material shader compilation and instead place an empty shader map. */
 	bool bNoShaderCompilation;
 
-	/** Launches the worker, returns the launched process handle. */
-	FProcHandle LaunchWorker(const FString& WorkingDirectory, uint32 ProcessId, uint32 ThreadId, const FString& WorkerInputFile, const FString& WorkerOutputFile);
+	/** Launches the worker, returns the launched process handle. SharedMemoryName is the worker's batch mailbox, if any. */
+	FProcHandle LaunchWorker(const FString& WorkingDirectory, uint32 ProcessId, uint32 ThreadId, const FString& WorkerInputFile, const FString& WorkerOutputFile, const FString& SharedMemoryName = FString());
 
 	/** Blocks on completion of the given shader maps. */
 	void BlockOnShaderMapCompletion(const TArray<int32>& ShaderMapIdsToFinishCompiling, TMap<int32, FShaderMapFinalizeResults>& CompiledShaderMaps);
@@ -38,12 +38,12 @@ bool FProceduralFoliageBroadphase::TestAgainstAABB(FProceduralFoliageInstance* I
 void FProceduralFoliageBroadphase::Insert(FProceduralFoliageInstance* Instance)
 {
 	const FBox2D MaxAABB = GetMaxAABB(Instance);
-	QuadTree.Insert(Instance, MaxAABB);
+	QuadTree.Insert(FProceduralFoliageBroadphaseEntry(Instance), MaxAABB);
 }
 
-bool CircleOverlap(const FVector& ALocation, float ARadius, const FVector& BLocation, float BRadius)
+bool CircleOverlap(const FVector2D& ALocation, float ARadius, const FVector2D& BLocation, float BRadius)
 {
-	return (ALocation - BLocation).SizeSquared2D() <= (ARadius + BRadius)*(ARadius + BRadius);
+	return (ALocation - BLocation).SizeSquared() <= (ARadius + BRadius)*(ARadius + BRadius);
 }
 
 bool FProceduralFoliageBroadphase::GetOverlaps(FProceduralFoliageInstance* Instance, TArray<FProceduralFoliageOverlap>& Overlaps) const
@@ -51,22 +51,24 @@ bool FProceduralFoliageBroadphase::GetOverlaps(FProceduralFoliageInstance* Insta
 	const float AShadeRadius     = Instance->GetShadeRadius();
 	const float ACollisionRadius = Instance->GetCollisionRadius();
 
-	TArray<FProceduralFoliageInstance*> PossibleOverlaps;
+	const FVector2D ALocation(Instance->Location);
+
+	TArray<FProceduralFoliageBroadphaseEntry, TInlineAllocator<64>> PossibleOverlaps;
 	const FBox2D AABB = GetMaxAABB(Instance);
 	QuadTree.GetElements(AABB, PossibleOverlaps);
 	Overlaps.Reserve(Overlaps.Num() + PossibleOverlaps.Num());
 	
-	for (FProceduralFoliageInstance* Overlap : PossibleOverlaps)
+	for (const FProceduralFoliageBroadphaseEntry& Overlap : PossibleOverlaps)
 	{
-		if (Overlap != Instance)
+		if (Overlap.Instance != Instance)
 		{
 			//We must determine if this is an overlap of shade or an overlap of collision. If both the collision overlap wins
-			bool bCollisionOverlap = CircleOverlap(Instance->Location, ACollisionRadius, Overlap->Location, Overlap->GetCollisionRadius());
-			bool bShadeOverlap     = CircleOverlap(Instance->Location, AShadeRadius, Overlap->Location, Overlap->GetShadeRadius());
+			bool bCollisionOverlap = CircleOverlap(ALocation, ACollisionRadius, Overlap.Location, Overlap.CollisionRadius);
+			bool bShadeOverlap     = CircleOverlap(ALocation, AShadeRadius, Overlap.Location, Overlap.ShadeRadius);
 
 			if (bCollisionOverlap || bShadeOverlap)
 			{
-				new (Overlaps)FProceduralFoliageOverlap(Instance, Overlap, bCollisionOverlap ? ESimulationOverlap::CollisionOverlap : ESimulationOverlap::ShadeOverlap);
+				new (Overlaps)FProceduralFoliageOverlap(Instance, Overlap.Instance, bCollisionOverlap ? ESimulationOverlap::CollisionOverlap : ESimulationOverlap::ShadeOverlap);
 			}
 			
 		}
@@ -78,11 +80,18 @@ bool FProceduralFoliageBroadphase::GetOverlaps(FProceduralFoliageInstance* Insta
 void FProceduralFoliageBroadphase::Remove(FProceduralFoliageInstance* Instance)
 {
 	const FBox2D AABB = GetMaxAABB(Instance);
-	const bool bRemoved = QuadTree.Remove(Instance, AABB);
+	const bool bRemoved = QuadTree.Remove(FProceduralFoliageBroadphaseEntry(Instance), AABB);
 	check(bRemoved);
 }
 
 void FProceduralFoliageBroadphase::GetInstancesInBox(const FBox2D& Box, TArray<FProceduralFoliageInstance*>& Instances) const
 {
-	QuadTree.GetElements(Box, Instances);
+	TArray<FProceduralFoliageBroadphaseEntry> Entries;
+	QuadTree.GetElements(Box, Entries);
+
+	Instances.Reserve(Instances.Num() + Entries.Num());
+	for (const FProceduralFoliageBroadphaseEntry& Entry : Entries)
+	{
+		Instances.Add(Entry.Instance);
+	}
 }
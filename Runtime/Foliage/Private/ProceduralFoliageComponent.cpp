@@ -3,6 +3,7 @@
 #include "ProceduralFoliageComponent.h"
 #include "Async/Future.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "GameFramework/Volume.h"
 #include "Components/BrushComponent.h"
 #include "InstancedFoliageActor.h"
@@ -11,6 +12,7 @@
 #include "Engine/LevelBounds.h"
 #include "EngineUtils.h"
 #include "Misc/FeedbackContext.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 #if WITH_EDITOR
 #include "WorldPartition/WorldPartition.h"
@@ -121,6 +123,7 @@ FVector UProceduralFoliageComponent::GetWorldPosition() const
 bool UProceduralFoliageComponent::ExecuteSimulation(TArray<FDesiredFoliageInstance>& OutInstances)
 {
 #if WITH_EDITOR
+	TRACE_CPUPROFILER_EVENT_SCOPE(UProceduralFoliageComponent::ExecuteSimulation);
 
 	// In World Partition, load Editor Cells intersecting bounds affected by ProceduralFoliageCompoment
 	if (UWorldPartition* WorldPartition = GetWorld()->GetWorldPartition())
@@ -180,6 +183,11 @@ bool UProceduralFoliageComponent::ExecuteSimulation(TArray<FDesiredFoliageInstan
 
 					//@todo proc foliage: Determine the composite contents of the tile (including overlaps) without copying everything to a temp tile
 
+					// This is where the overlapping border regions are merged. AddInstances resolves the overlaps between this tile and the
+					// instances copied from its neighbors, and only keeps the border instances this tile owns. The neighbors are only read
+					// and every composite tile is private to its task, so tiles merge their borders concurrently without locking. The
+					// instances are copied in location order, so the result doesn't depend on scheduling.
+
 					// Copy the base tile contents
 					const FBox2D BaseTile = GetTileRegion(X, Y, TileSize, TileOverlap);
 					Tile->CopyInstancesToTile(CompositeTile, BaseTile, FTransform::Identity, TileOverlap);
@@ -261,17 +269,29 @@ bool UProceduralFoliageComponent::ExecuteSimulation(TArray<FDesiredFoliageInstan
 			}
 		}
 
-		OutInstances.Reserve(OutInstances.Num() + OutInstanceGrowth);
-		FutureIdx = 0;
-		for (int X = 0; X < TileLayout.NumTilesX; ++X)
+		// Every tile owns a disjoint range of the output, so the tiles can be copied out concurrently without any locking.
+		// The ranges follow the tile order so the result is the same as appending the tiles one after the other.
+		TArray<int32> TileOutputOffsets;
+		TileOutputOffsets.AddUninitialized(Futures.Num());
+		int32 OutputOffset = OutInstances.Num();
+		for (int32 TileIdx = 0; TileIdx < Futures.Num(); ++TileIdx)
 		{
-			for (int Y = 0; Y < TileLayout.NumTilesY; ++Y)
+			TileOutputOffsets[TileIdx] = OutputOffset;
+			OutputOffset += Futures[TileIdx].Get()->Num();
+		}
+		check(OutputOffset == OutInstances.Num() + OutInstanceGrowth);
+
+		OutInstances.AddUninitialized(OutInstanceGrowth);
+		ParallelFor(Futures.Num(), [&Futures, &TileOutputOffsets, &OutInstances](int32 TileIdx)
+		{
+			TArray<FDesiredFoliageInstance>* DesiredInstances = Futures[TileIdx].Get();
+			FDesiredFoliageInstance* Dest = OutInstances.GetData() + TileOutputOffsets[TileIdx];
+			for (int32 InstanceIdx = 0; InstanceIdx < DesiredInstances->Num(); ++InstanceIdx)
 			{
-				TArray<FDesiredFoliageInstance>* DesiredInstances = Futures[FutureIdx++].Get();
-				OutInstances.Append(*DesiredInstances);
-				delete DesiredInstances;
+				new (Dest + InstanceIdx) FDesiredFoliageInstance(MoveTemp((*DesiredInstances)[InstanceIdx]));
 			}
-		}
+			delete DesiredInstances;
+		});
 
 		GWarn->EndSlowTask();
 
@@ -4,6 +4,7 @@
 #include "Engine/EngineTypes.h"
 #include "CollisionQueryParams.h"
 #include "ProceduralFoliageSpawner.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 #define LOCTEXT_NAMESPACE "ProceduralFoliage"
 
@@ -451,6 +452,8 @@ void UProceduralFoliageTile::RunSimulation(const int32 MaxNumSteps, bool bOnlyIn
 
 void UProceduralFoliageTile::Simulate(const UProceduralFoliageSpawner* InFoliageSpawner, const int32 InRandomSeed, const int32 MaxNumSteps, const int32 InLastCancel)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UProceduralFoliageTile::Simulate);
+
 	LastCancel = InLastCancel;
 	InitSimulation(InFoliageSpawner, InRandomSeed);
 
@@ -569,6 +572,8 @@ void UProceduralFoliageTile::GetInstancesInAABB(const FBox2D& LocalAABB, TArray<
 
 void UProceduralFoliageTile::AddInstances(const TArray<FProceduralFoliageInstance*>& NewInstances, const FTransform& RelativeTM, const FBox2D& InnerLocalAABB)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(UProceduralFoliageTile::AddInstances);
+
 	for (const FProceduralFoliageInstance* Inst : NewInstances)
 	{
 		// We need the local space because we're comparing it to the AABB
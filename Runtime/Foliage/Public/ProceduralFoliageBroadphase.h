@@ -6,6 +6,41 @@
 #include "ProceduralFoliageInstance.h"
 #include "GenericQuadTree.h"
 
+/**
+ * Broadphase element. Keeps the data needed by the overlap tests next to the instance pointer so queries
+ * don't have to dereference every candidate instance and its foliage type.
+ * Only this copy of the overlap data is laid out for the queries. The instances themselves stay separate allocations
+ * owned by the tile, because domination, aging and spreading all work on instance pointers.
+ */
+struct FProceduralFoliageBroadphaseEntry
+{
+	FProceduralFoliageInstance* Instance;
+	FVector2D Location;
+	float CollisionRadius;
+	float ShadeRadius;
+
+	FProceduralFoliageBroadphaseEntry()
+		: Instance(nullptr)
+		, Location(ForceInitToZero)
+		, CollisionRadius(0.f)
+		, ShadeRadius(0.f)
+	{
+	}
+
+	explicit FProceduralFoliageBroadphaseEntry(FProceduralFoliageInstance* InInstance)
+		: Instance(InInstance)
+		, Location(InInstance->Location)
+		, CollisionRadius(InInstance->GetCollisionRadius())
+		, ShadeRadius(InInstance->GetShadeRadius())
+	{
+	}
+
+	bool operator==(const FProceduralFoliageBroadphaseEntry& Other) const
+	{
+		return Instance == Other.Instance;
+	}
+};
+
 class FProceduralFoliageBroadphase
 {
 public:
@@ -20,5 +55,5 @@ public:
 	void Empty();
 
 private:
-	TQuadTree<FProceduralFoliageInstance*, 4> QuadTree;
+	TQuadTree<FProceduralFoliageBroadphaseEntry, 4> QuadTree;
 };
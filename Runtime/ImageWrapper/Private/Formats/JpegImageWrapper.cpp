@@ -237,11 +237,115 @@ void FJpegImageWrapper::Uncompress(const ERGBFormat InFormat, int32 InBitDepth)
 #endif
 }
 
-#if WITH_LIBJPEGTURBO
-bool FJpegImageWrapper::SetCompressedTurbo(const void* InCompressedData, int64 InCompressedSize)
+bool FJpegImageWrapper::CanUncompressInto(const ERGBFormat InFormat, int32 InBitDepth) const
+{
+	return (InFormat == ERGBFormat::RGBA || InFormat == ERGBFormat::BGRA || InFormat == ERGBFormat::Gray) && InBitDepth == 8;
+}
+
+
+void FJpegImageWrapper::UncompressInto(const ERGBFormat InFormat, int32 InBitDepth, uint8* OutData, int64 OutRowStride)
 {
+	check(CompressedData.Num());
+
+	if (!UncompressRows(InFormat, OutData, OutRowStride))
+	{
+		SetError(TEXT("Failed to decode JPEG data."));
+	}
+}
+
+
+bool FJpegImageWrapper::UncompressRows(const ERGBFormat InFormat, uint8* OutData, int64 OutRowStride)
+{
+#if WITH_LIBJPEGTURBO
+	// The decompressor is owned by this wrapper, so decoding doesn't need to be serialized with other wrappers
+	check(Decompressor);
+
+	const int PixelFormat = ConvertTJpegPixelFormat(InFormat);
+	const int Flags = TJFLAG_NOREALLOC | TJFLAG_FASTDCT;
+
+	return tjDecompress2(Decompressor, CompressedData.GetData(), CompressedData.Num(), OutData, Width, OutRowStride, Height, PixelFormat, Flags) == 0;
+#else
+	// jpgd doesn't support 64-bit sizes.
+	if (CompressedData.Num() > MAX_uint32)
+	{
+		return false;
+	}
+
 	FScopeLock JPEGLock(&GJPEGSection);
 
+	jpgd::jpeg_decoder_mem_stream MemStream(CompressedData.GetData(), (uint32)CompressedData.Num());
+	jpgd::jpeg_decoder Decoder(&MemStream);
+	if (Decoder.get_error_code() != jpgd::JPGD_SUCCESS || Decoder.begin_decoding() != jpgd::JPGD_SUCCESS)
+	{
+		return false;
+	}
+
+	if (Decoder.get_width() != Width || Decoder.get_height() != Height)
+	{
+		return false;
+	}
+
+	// jpgd produces one byte per pixel for grayscale images and RGBA with opaque alpha for color images
+	const bool bGrayScanLines = Decoder.get_num_components() == 1;
+	for (int32 Y = 0; Y < Height; ++Y)
+	{
+		const void* ScanLine = nullptr;
+		jpgd::uint ScanLineLength = 0;
+		if (Decoder.decode(&ScanLine, &ScanLineLength) != jpgd::JPGD_SUCCESS)
+		{
+			return false;
+		}
+
+		const uint8* Source = (const uint8*)ScanLine;
+		uint8* Destination = OutData + Y * OutRowStride;
+
+		if (InFormat == ERGBFormat::Gray)
+		{
+			if (bGrayScanLines)
+			{
+				FMemory::Memcpy(Destination, Source, Width);
+			}
+			else
+			{
+				// Same luma weights as jpgd::decompress_jpeg_image_from_memory
+				for (int32 X = 0; X < Width; ++X, Source += 4)
+				{
+					Destination[X] = (uint8)((Source[0] * 19595 + Source[1] * 38470 + Source[2] * 7471 + 32768) >> 16);
+				}
+			}
+		}
+		else if (bGrayScanLines)
+		{
+			for (int32 X = 0; X < Width; ++X, Destination += 4)
+			{
+				Destination[0] = Destination[1] = Destination[2] = Source[X];
+				Destination[3] = 255;
+			}
+		}
+		else if (InFormat == ERGBFormat::BGRA)
+		{
+			for (int32 X = 0; X < Width; ++X, Source += 4, Destination += 4)
+			{
+				Destination[0] = Source[2];
+				Destination[1] = Source[1];
+				Destination[2] = Source[0];
+				Destination[3] = 255;
+			}
+		}
+		else
+		{
+			FMemory::Memcpy(Destination, Source, Width * 4);
+		}
+	}
+
+	return true;
+#endif
+}
+
+#if WITH_LIBJPEGTURBO
+bool FJpegImageWrapper::SetCompressedTurbo(const void* InCompressedData, int64 InCompressedSize)
+{
+	// Compressor and Decompressor are owned by this wrapper, so the TurboJPEG calls don't need GJPEGSection
 	check(Decompressor);
 
 	int ImageWidth;
@@ -268,8 +372,6 @@ void FJpegImageWrapper::CompressTurbo(int32 Quality)
 {
 	if (CompressedData.Num() == 0)
 	{
-		FScopeLock JPEGLock(&GJPEGSection);
-
 		check(Compressor);
 
 		if (Quality == 0) { Quality = 85; }
@@ -318,20 +420,12 @@ void FJpegImageWrapper::UncompressTurbo(const ERGBFormat InFormat, int32 InBitDe
 		check(false);
 	}
 
-	FScopeLock JPEGLock(&GJPEGSection);
-
-	check(Decompressor);
 	check(CompressedData.Num());
 
 	RawData.Reset(Width * Height * Channels);
 	RawData.AddUninitialized(Width * Height * Channels);
-	const int PixelFormat = ConvertTJpegPixelFormat(InFormat);
-	const int Flags = TJFLAG_NOREALLOC | TJFLAG_FASTDCT;
 
-	if (tjDecompress2(Decompressor, CompressedData.GetData(), CompressedData.Num(), RawData.GetData(), Width, 0, Height, PixelFormat, Flags) != 0)
-	{
-		return;
-	}
+	UncompressRows(InFormat, RawData.GetData(), Width * Channels);
 }
 #endif	// WITH_LIBJPEGTURBO
 
@@ -35,6 +35,8 @@ public:
 	virtual bool SetCompressed(const void* InCompressedData, int64 InCompressedSize) override;
 	virtual bool SetRaw(const void* InRawData, int64 InRawSize, const int32 InWidth, const int32 InHeight, const ERGBFormat InFormat, const int32 InBitDepth) override;
 	virtual void Uncompress(const ERGBFormat InFormat, int32 InBitDepth) override;
+	virtual bool CanUncompressInto(const ERGBFormat InFormat, int32 InBitDepth) const override;
+	virtual void UncompressInto(const ERGBFormat InFormat, int32 InBitDepth, uint8* OutData, int64 OutRowStride) override;
 	virtual void Compress(int32 Quality) override;
 
 #if WITH_LIBJPEGTURBO
@@ -43,6 +45,9 @@ public:
 	void UncompressTurbo(const ERGBFormat InFormat, int32 InBitDepth);
 #endif	// WITH_LIBJPEGTURBO
 
+	/** Decodes the compressed data into rows starting at OutData, converting each scan line as the decoder produces it */
+	bool UncompressRows(const ERGBFormat InFormat, uint8* OutData, int64 OutRowStride);
+
 private:
 
 	int32 NumComponents;
@@ -222,7 +222,39 @@ void FPngImageWrapper::Uncompress(const ERGBFormat InFormat, const int32 InBitDe
 }
 
 
+bool FPngImageWrapper::CanUncompressInto(const ERGBFormat InFormat, int32 InBitDepth) const
+{
+	return (InFormat == ERGBFormat::BGRA || InFormat == ERGBFormat::RGBA || InFormat == ERGBFormat::Gray) && (InBitDepth == 8 || InBitDepth == 16);
+}
+
+
+void FPngImageWrapper::UncompressInto(const ERGBFormat InFormat, int32 InBitDepth, uint8* OutData, int64 OutRowStride)
+{
+	check(CompressedData.Num());
+	UncompressPNGData(InFormat, InBitDepth, OutData, OutRowStride);
+}
+
+
 void FPngImageWrapper::UncompressPNGData(const ERGBFormat InFormat, const int32 InBitDepth)
+{
+	check(Width > 0);
+	check(Height > 0);
+
+	// Calculate Pixel Depth
+	const uint64 PixelChannels = (InFormat == ERGBFormat::Gray) ? 1 : 4;
+	const uint64 BytesPerPixel = (InBitDepth * PixelChannels) / 8;
+	const uint64 BytesPerRow = BytesPerPixel * Width;
+	RawData.Reset(Height * BytesPerRow);
+	RawData.AddUninitialized(Height * BytesPerRow);
+
+	UncompressPNGData(InFormat, InBitDepth, RawData.GetData(), BytesPerRow);
+
+	RawFormat = InFormat;
+	RawBitDepth = InBitDepth;
+}
+
+
+void FPngImageWrapper::UncompressPNGData(const ERGBFormat InFormat, const int32 InBitDepth, uint8* OutData, int64 OutRowStride)
 {
 	//Preserve old single thread code on some platform in relation to a type incompatibility at compile time.
 #if PLATFORM_ANDROID || PLATFORM_LUMIN || PLATFORM_LUMINGL4
@@ -302,18 +334,12 @@ void FPngImageWrapper::UncompressPNGData(const ERGBFormat InFormat, const int32
 				}
 			}
 
-			// Calculate Pixel Depth
-			const uint64 PixelChannels = (InFormat == ERGBFormat::Gray) ? 1 : 4;
-			const uint64 BytesPerPixel = (InBitDepth * PixelChannels) / 8;
-			const uint64 BytesPerRow = BytesPerPixel * Width;
-			RawData.Empty(Height * BytesPerRow);
-			RawData.AddUninitialized(Height * BytesPerRow);
-
 			png_set_read_fn(png_ptr, this, FPngImageWrapper::user_read_compressed);
 
+			// libpng decodes each row straight into its place in the destination
 			for (int64 i = 0; i < Height; i++)
 			{
-				row_pointers[i]= &RawData[i * BytesPerRow];
+				row_pointers[i]= OutData + i * OutRowStride;
 			}
 			png_set_rows(png_ptr, info_ptr, row_pointers);
 
@@ -387,9 +413,6 @@ void FPngImageWrapper::UncompressPNGData(const ERGBFormat InFormat, const int32
 		UE_LOG(LogImageWrapper, Error, TEXT("%s"), *e.ErrorText);
 	}
 #endif
-
-	RawFormat = InFormat;
-	RawBitDepth = InBitDepth;
 }
 
 
@@ -420,8 +443,11 @@ bool FPngImageWrapper::LoadPNGHeader()
 	// Test whether the data this PNGLoader is pointing at is a PNG or not.
 	if (IsPNG())
 	{
+		//Preserve old single thread code on some platform in relation to a type incompatibility at compile time.
+#if PLATFORM_ANDROID || PLATFORM_LUMIN || PLATFORM_LUMINGL4
 		// thread safety
 		FScopeLock PNGLock(&GPNGSection);
+#endif
 
 		png_structp png_ptr = png_create_read_struct_2(PNG_LIBPNG_VER_STRING, this, FPngImageWrapper::user_error_fn, FPngImageWrapper::user_warning_fn, NULL, FPngImageWrapper::user_malloc, FPngImageWrapper::user_free);
 		check(png_ptr);
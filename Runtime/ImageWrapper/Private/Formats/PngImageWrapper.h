@@ -49,6 +49,8 @@ public:
 	virtual void Reset() override;
 	virtual bool SetCompressed(const void* InCompressedData, int64 InCompressedSize) override;
 	virtual void Uncompress(const ERGBFormat InFormat, int32 InBitDepth) override;
+	virtual bool CanUncompressInto(const ERGBFormat InFormat, int32 InBitDepth) const override;
+	virtual void UncompressInto(const ERGBFormat InFormat, int32 InBitDepth, uint8* OutData, int64 OutRowStride) override;
 
 public:
 
@@ -69,6 +71,9 @@ public:
 	/** Helper function used to uncompress PNG data from a buffer */
 	void UncompressPNGData(const ERGBFormat InFormat, const int32 InBitDepth);
 
+	/** Helper function used to uncompress PNG data from a buffer into rows starting at OutData */
+	void UncompressPNGData(const ERGBFormat InFormat, const int32 InBitDepth, uint8* OutData, int64 OutRowStride);
+
 protected:
 
 	// Callbacks for the pnglibs
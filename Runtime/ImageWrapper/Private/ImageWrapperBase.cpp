@@ -68,14 +68,62 @@ bool FImageWrapperBase::GetRaw(const ERGBFormat InFormat, int32 InBitDepth, TArr
 }
 
 
+bool FImageWrapperBase::GetRawInto(const ERGBFormat InFormat, int32 InBitDepth, void* OutData, int64 OutDataSize, int64 OutRowStride)
+{
+	LastError.Empty();
+
+	const int64 BytesPerRow = (int64)Width * (InFormat == ERGBFormat::Gray ? 1 : 4) * InBitDepth / 8;
+	if (OutRowStride == 0)
+	{
+		OutRowStride = BytesPerRow;
+	}
+
+	if (OutData == nullptr || Height <= 0 || OutRowStride < BytesPerRow || OutDataSize < OutRowStride * (Height - 1) + BytesPerRow)
+	{
+		SetError(TEXT("Destination memory is too small for the image."));
+		return false;
+	}
+
+	if (CanUncompressInto(InFormat, InBitDepth))
+	{
+		UncompressInto(InFormat, InBitDepth, (uint8*)OutData, OutRowStride);
+	}
+	else
+	{
+		// Decode into our own raw data and copy the rows out
+		Uncompress(InFormat, InBitDepth);
+
+		if (LastError.IsEmpty())
+		{
+			if (RawData.Num() < BytesPerRow * Height)
+			{
+				SetError(TEXT("Uncompressed data is smaller than the image."));
+			}
+			else
+			{
+				for (int64 Row = 0; Row < Height; ++Row)
+				{
+					FMemory::Memcpy((uint8*)OutData + Row * OutRowStride, RawData.GetData() + Row * BytesPerRow, BytesPerRow);
+				}
+			}
+
+			// Behave like GetRaw, which moves the raw data out, but keep the allocation for the next image decoded with this wrapper
+			RawData.Reset();
+		}
+	}
+
+	return LastError.IsEmpty();
+}
+
+
 bool FImageWrapperBase::SetCompressed(const void* InCompressedData, int64 InCompressedSize)
 {
 	if(InCompressedSize > 0 && InCompressedData != nullptr)
 	{
 		Reset();
-		RawData.Empty();			// Invalidates the raw data too
+		RawData.Reset();			// Invalidates the raw data too, but keeps the allocation for wrappers that are reused
 
-		CompressedData.Empty(InCompressedSize);
+		CompressedData.Reset(InCompressedSize);
 		CompressedData.AddUninitialized(InCompressedSize);
 		FMemory::Memcpy(CompressedData.GetData(), InCompressedData, InCompressedSize);
 
@@ -94,9 +142,9 @@ bool FImageWrapperBase::SetRaw(const void* InRawData, int64 InRawSize, const int
 	check(InHeight > 0);
 
 	Reset();
-	CompressedData.Empty();		// Invalidates the compressed data too
+	CompressedData.Reset();		// Invalidates the compressed data too, but keeps the allocation for wrappers that are reused
 
-	RawData.Empty(InRawSize);
+	RawData.Reset(InRawSize);
 	RawData.AddUninitialized(InRawSize);
 	FMemory::Memcpy(RawData.GetData(), InRawData, InRawSize);
 
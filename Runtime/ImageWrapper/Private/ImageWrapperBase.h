@@ -70,6 +70,29 @@ public:
 	 */
 	virtual void Uncompress(const ERGBFormat InFormat, int32 InBitDepth) = 0;
 
+	/**
+	 * Whether the format can uncompress straight into external memory with UncompressInto.
+	 *
+	 * @param InFormat How we want to manipulate the RGB data
+	 * @param InBitDepth The output bit-depth per channel
+	 */
+	virtual bool CanUncompressInto(const ERGBFormat InFormat, int32 InBitDepth) const
+	{
+		return false;
+	}
+
+	/**
+	 * Function to uncompress our data into external memory, one row at a time, without touching the raw data.
+	 * Only called when CanUncompressInto returned true, errors are reported with SetError.
+	 *
+	 * @param InFormat How we want to manipulate the RGB data
+	 * @param OutData The start of the top row, large enough for Height rows of OutRowStride bytes
+	 * @param OutRowStride The distance in bytes between the start of two rows
+	 */
+	virtual void UncompressInto(const ERGBFormat InFormat, int32 InBitDepth, uint8* OutData, int64 OutRowStride)
+	{
+	}
+
 public:
 
 	//~ IImageWrapper interface
@@ -92,6 +115,7 @@ public:
 	}
 
 	virtual bool GetRaw(const ERGBFormat InFormat, int32 InBitDepth, TArray64<uint8>& OutRawData) override;
+	virtual bool GetRawInto(const ERGBFormat InFormat, int32 InBitDepth, void* OutData, int64 OutDataSize, int64 OutRowStride = 0) override;
 
 	virtual int32 GetWidth() const override
 	{
@@ -3,7 +3,11 @@
 #include "ImageWrapperPrivate.h"
 
 #include "CoreTypes.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Templates/Atomic.h"
 
 #include "Formats/BmpImageWrapper.h"
 #include "Formats/ExrImageWrapper.h"
@@ -45,6 +49,51 @@ namespace
 
 		return true;
 	}
+
+	/** Image wrappers owned by one worker of a batch, at most one per format. */
+	class FBatchImageWrappers
+	{
+	public:
+		FBatchImageWrappers(IImageWrapperModule& InModule)
+			: Module(InModule)
+		{ }
+
+		IImageWrapper* FindOrCreate(EImageFormat InFormat)
+		{
+			for (const TTuple<EImageFormat, TSharedPtr<IImageWrapper>>& Pair : Wrappers)
+			{
+				if (Pair.Get<0>() == InFormat)
+				{
+					return Pair.Get<1>().Get();
+				}
+			}
+
+			TSharedPtr<IImageWrapper> NewWrapper = Module.CreateImageWrapper(InFormat);
+			Wrappers.Add(MakeTuple(InFormat, NewWrapper));
+			return NewWrapper.Get();
+		}
+
+	private:
+		IImageWrapperModule& Module;
+		TArray<TTuple<EImageFormat, TSharedPtr<IImageWrapper>>, TInlineAllocator<2>> Wrappers;
+	};
+
+	/** Runs ProcessRequest over all requests on up to one worker per task graph thread, each pulling the next unclaimed request. */
+	template <typename RequestType, typename ProcessType>
+	void ProcessImageBatch(IImageWrapperModule& Module, TArrayView<RequestType> Requests, ProcessType ProcessRequest)
+	{
+		const int32 NumWorkers = FMath::Min(Requests.Num(), FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+		TAtomic<int32> NextRequestIndex(0);
+
+		ParallelFor(NumWorkers, [&Module, Requests, &ProcessRequest, &NextRequestIndex](int32 WorkerIndex)
+		{
+			FBatchImageWrappers Wrappers(Module);
+			for (int32 RequestIndex = NextRequestIndex++; RequestIndex < Requests.Num(); RequestIndex = NextRequestIndex++)
+			{
+				ProcessRequest(Wrappers, Requests[RequestIndex]);
+			}
+		});
+	}
 }
 
 
@@ -140,6 +189,51 @@ public:
 		return Format;
 	}
 
+	virtual void DecompressImages(TArrayView<FImageWrapperDecodeRequest> Requests) override
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FImageWrapperModule::DecompressImages)
+
+		ProcessImageBatch(*this, Requests, [this](FBatchImageWrappers& Wrappers, FImageWrapperDecodeRequest& Request)
+		{
+			const EImageFormat ImageFormat = Request.ImageFormat != EImageFormat::Invalid ? Request.ImageFormat : DetectImageFormat(Request.CompressedData, Request.CompressedSize);
+			IImageWrapper* ImageWrapper = ImageFormat != EImageFormat::Invalid ? Wrappers.FindOrCreate(ImageFormat) : nullptr;
+
+			Request.bSuccess = false;
+			if (ImageWrapper && ImageWrapper->SetCompressed(Request.CompressedData, Request.CompressedSize))
+			{
+				Request.OutWidth = ImageWrapper->GetWidth();
+				Request.OutHeight = ImageWrapper->GetHeight();
+
+				if (Request.OutData)
+				{
+					Request.bSuccess = ImageWrapper->GetRawInto(Request.RawFormat, Request.BitDepth, Request.OutData, Request.OutDataSize, Request.OutRowStride);
+				}
+				else
+				{
+					Request.bSuccess = ImageWrapper->GetRaw(Request.RawFormat, Request.BitDepth, Request.OutRawData);
+				}
+			}
+		});
+	}
+
+	virtual void CompressImages(TArrayView<FImageWrapperEncodeRequest> Requests) override
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FImageWrapperModule::CompressImages)
+
+		ProcessImageBatch(*this, Requests, [](FBatchImageWrappers& Wrappers, FImageWrapperEncodeRequest& Request)
+		{
+			IImageWrapper* ImageWrapper = Wrappers.FindOrCreate(Request.ImageFormat);
+
+			Request.bSuccess = false;
+			if (ImageWrapper && ImageWrapper->SetRaw(Request.RawData, Request.RawSize, Request.Width, Request.Height, Request.RawFormat, Request.BitDepth))
+			{
+				// The wrapper's compressed data is reused by the next image this worker encodes, so take a copy
+				Request.OutCompressedData = ImageWrapper->GetCompressed(Request.Quality);
+				Request.bSuccess = Request.OutCompressedData.Num() > 0;
+			}
+		});
+	}
+
 public:
 
 	//~ IModuleInterface interface
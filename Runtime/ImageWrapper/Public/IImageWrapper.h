@@ -140,6 +140,20 @@ public:
 		}
 	}
 
+	/**
+	 * Decompresses the image straight into caller-provided memory, so that many images can be decoded into one
+	 * allocation (e.g. a ring of movie frames) without an intermediate buffer per image. PNG and JPEG write the
+	 * decoded rows directly into the destination, other formats decode into the wrapper and copy the rows out.
+	 *
+	 * @param InFormat How we want to manipulate the RGB data.
+	 * @param InBitDepth The output bit-depth per channel, normally 8.
+	 * @param OutData Will contain the uncompressed raw data, starting with the top row.
+	 * @param OutDataSize The size in bytes of the memory at OutData.
+	 * @param OutRowStride The distance in bytes between the start of two rows, or 0 for tightly packed rows.
+	 * @return true on success, false otherwise.
+	 */
+	virtual bool GetRawInto(const ERGBFormat InFormat, int32 InBitDepth, void* OutData, int64 OutDataSize, int64 OutRowStride = 0) = 0;
+
 	/**
 	 * Gets the width of the image.
 	 *
@@ -3,11 +3,68 @@
 #pragma once
 
 #include "CoreTypes.h"
+#include "Containers/ArrayView.h"
+#include "IImageWrapper.h"
 #include "Modules/ModuleInterface.h"
 #include "Templates/SharedPointer.h"
 
-class IImageWrapper;
-enum class EImageFormat : int8;
+
+/**
+ * One image of a batch decoded by IImageWrapperModule::DecompressImages.
+ */
+struct FImageWrapperDecodeRequest
+{
+	/** The compressed file contents, must stay valid until the batch has been decoded. */
+	const void* CompressedData = nullptr;
+	int64 CompressedSize = 0;
+
+	/** Format of the compressed data, or EImageFormat::Invalid to detect it from the header. */
+	EImageFormat ImageFormat = EImageFormat::Invalid;
+
+	/** Layout and bit-depth per channel of the decoded pixels. */
+	ERGBFormat RawFormat = ERGBFormat::BGRA;
+	int32 BitDepth = 8;
+
+	/** Optional memory to decode into, see IImageWrapper::GetRawInto. If null, the pixels are returned in OutRawData. */
+	void* OutData = nullptr;
+	int64 OutDataSize = 0;
+	int64 OutRowStride = 0;
+
+	/** Receives the pixels when OutData is null. */
+	TArray64<uint8> OutRawData;
+
+	/** Dimensions of the image, set even if the destination memory turned out to be too small. */
+	int32 OutWidth = 0;
+	int32 OutHeight = 0;
+
+	/** Whether the image was decoded. */
+	bool bSuccess = false;
+};
+
+
+/**
+ * One image of a batch encoded by IImageWrapperModule::CompressImages.
+ */
+struct FImageWrapperEncodeRequest
+{
+	/** The raw pixels, must stay valid until the batch has been encoded. */
+	const void* RawData = nullptr;
+	int64 RawSize = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	ERGBFormat RawFormat = ERGBFormat::BGRA;
+	int32 BitDepth = 8;
+
+	/** Format to compress to, and the quality passed to IImageWrapper::GetCompressed. */
+	EImageFormat ImageFormat = EImageFormat::PNG;
+	int32 Quality = 0;
+
+	/** Receives the compressed file contents. */
+	TArray64<uint8> OutCompressedData;
+
+	/** Whether the image was encoded. */
+	bool bSuccess = false;
+};
 
 
 /**
@@ -36,6 +93,23 @@ public:
 	 */
 	virtual EImageFormat DetectImageFormat(const void* InCompressedData, int64 InCompressedSize) = 0;
 
+	/**
+	 * Decodes a batch of images on the task graph and returns when all of them are done.
+	 * Each worker keeps one image wrapper per format for the whole batch, so codec contexts and scratch buffers
+	 * are reused from one image to the next instead of being created per image.
+	 *
+	 * @param Requests The images to decode, results are written back into each request.
+	 */
+	virtual void DecompressImages(TArrayView<FImageWrapperDecodeRequest> Requests) = 0;
+
+	/**
+	 * Encodes a batch of images on the task graph and returns when all of them are done.
+	 *
+	 * @param Requests The images to encode, results are written back into each request.
+	 * @see DecompressImages
+	 */
+	virtual void CompressImages(TArrayView<FImageWrapperEncodeRequest> Requests) = 0;
+
 public:
 
 	/** Virtual destructor. */
@@ -10,6 +10,7 @@
 #include "Misc/ScopedSlowTask.h"
 #include "Misc/QueuedThreadPool.h"
 #include "Misc/QueuedThreadPoolWrapper.h"
+#include "Misc/FrameArena.h"
 #include "HAL/FileManager.h"
 #include "HAL/PlatformAffinity.h"
 #include "Misc/FileHelper.h"
@@ -5260,6 +5261,9 @@ void FEngineLoop::Tick()
 
 		FCoreDelegates::OnEndFrame.Broadcast();
 
+		// Everything allocated from the frame arena this frame is released
+		FFrameArena::EndFrame();
+
 		#if !UE_SERVER && WITH_ENGINE
 		{
 			// We emit dynamic resolution's end frame right before RHI's. GEngine is going to ignore it if no BeginFrame was done.
@@ -14,6 +14,7 @@
 #include "Misc/FeedbackContext.h"
 
 #include "EntitySystem/EntityAllocationIterator.h"
+#include "EntitySystem/MovieSceneEntitySystemTask.h"
 
 UE::MovieScene::FEntityManager*& GEntityManagerForDebugging = UE::MovieScene::GEntityManagerForDebuggingVisualizers;
 
@@ -51,6 +52,14 @@ FAutoConsoleVariableRef CVarThreadedEvaluationEntityThreshold(
 	ECVF_Default
 );
 
+int32 GThreadedEvaluationParallelAllocationThreshold = 4;
+FAutoConsoleVariableRef CVarThreadedEvaluationParallelAllocationThreshold(
+	TEXT("Sequencer.ThreadedEvaluation.ParallelAllocationThreshold"),
+	GThreadedEvaluationParallelAllocationThreshold,
+	TEXT("(Default: 4) Defines the number of matching entity allocations above which tasks that support it will evaluate their allocations in parallel.\n"),
+	ECVF_Default
+);
+
 FEntityManager* GEntityManagerForDebuggingVisualizers = nullptr;
 
 static bool IsValidUint16(int32 Test)
@@ -16,6 +16,7 @@ DECLARE_CYCLE_STAT(TEXT("Evaluation Phase"),            MovieSceneEval_Evaluatio
 
 TRACE_DECLARE_INT_COUNTER(MovieSceneEntitySystemFlushes, TEXT("MovieScene/ECSFlushes"));
 TRACE_DECLARE_INT_COUNTER(MovieSceneEntitySystemEvaluations, TEXT("MovieScene/ECSEvaluations"));
+TRACE_DECLARE_INT_COUNTER(MovieSceneEntitySystemTasks, TEXT("MovieScene/ECSTasks"));
 
 FMovieSceneEntitySystemRunner::FMovieSceneEntitySystemRunner()
 	: Linker(nullptr)
@@ -293,6 +294,7 @@ void FMovieSceneEntitySystemRunner::GameThread_SpawnPhase()
 		bCanQueueEventTriggers = true;
 		{
 			Linker->SystemGraph.ExecutePhase(ESystemPhase::Spawn, Linker, AllTasks);
+			TRACE_COUNTER_ADD(MovieSceneEntitySystemTasks, AllTasks.Num());
 		}
 		bCanQueueEventTriggers = false;
 
@@ -345,6 +347,7 @@ void FMovieSceneEntitySystemRunner::GameThread_InstantiationPhase()
 
 	FGraphEventArray AllTasks;
 	Linker->SystemGraph.ExecutePhase(ESystemPhase::Instantiation, Linker, AllTasks);
+	TRACE_COUNTER_ADD(MovieSceneEntitySystemTasks, AllTasks.Num());
 
 	if (AllTasks.Num() != 0)
 	{
@@ -411,6 +414,7 @@ void FMovieSceneEntitySystemRunner::GameThread_EvaluationPhase()
 
 	FGraphEventArray AllTasks;
 	Linker->SystemGraph.ExecutePhase(ESystemPhase::Evaluation, Linker, AllTasks);
+	TRACE_COUNTER_ADD(MovieSceneEntitySystemTasks, AllTasks.Num());
 
 	if (AllTasks.Num() != 0)
 	{
@@ -26,6 +26,17 @@ struct FAssignEvalTimesTask
 	}
 };
 
+namespace UE
+{
+namespace MovieScene
+{
+
+// Only reads the gathered frame times, so allocations can be assigned concurrently
+template<> struct TEntityTaskTraits<FAssignEvalTimesTask> : TDefaultEntityTaskTraits<FAssignEvalTimesTask> { enum { ParallelAllocations = true }; };
+
+} // namespace MovieScene
+} // namespace UE
+
 UMovieSceneEvalTimeSystem::UMovieSceneEvalTimeSystem(const FObjectInitializer& ObjInit)
 	: Super(ObjInit)
 {
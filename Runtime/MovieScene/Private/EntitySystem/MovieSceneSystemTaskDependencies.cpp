@@ -24,9 +24,25 @@ void FSystemTaskPrerequisites::FilterByComponent(FGraphEventArray& OutArray, std
 	}
 }
 
+void FSystemTaskPrerequisites::FilterWritesByComponent(FGraphEventArray& OutArray, FComponentTypeID ComponentType) const
+{
+	for (const FPrerequisite& Prereq : Prereqs)
+	{
+		if (!Prereq.bReadOnly && Prereq.ComponentType == ComponentType)
+		{
+			OutArray.Add(Prereq.GraphEvent);
+		}
+	}
+}
+
 void FSystemTaskPrerequisites::AddComponentTask(FComponentTypeID ComponentType, const FGraphEventRef& InNewTask)
 {
-	Prereqs.Add(FPrerequisite{ InNewTask, ComponentType });
+	Prereqs.Add(FPrerequisite{ InNewTask, ComponentType, false });
+}
+
+void FSystemTaskPrerequisites::AddComponentReadTask(FComponentTypeID ComponentType, const FGraphEventRef& InNewTask)
+{
+	Prereqs.Add(FPrerequisite{ InNewTask, ComponentType, true });
 }
 
 void FSystemTaskPrerequisites::Consume(const FSystemTaskPrerequisites& Other)
@@ -53,18 +69,23 @@ void FSystemSubsequentTasks::ResetNode(uint16 InNodeID)
 	}
 }
 
+FSystemTaskPrerequisites& FSystemSubsequentTasks::GetOrCreateSubsequents()
+{
+	if (!Subsequents)
+	{
+		Subsequents = MakeShared<FSystemTaskPrerequisites>();
+		Graph->Nodes.Array[NodeID].SubsequentTasks = Subsequents;
+	}
+	return *Subsequents;
+}
+
 void FSystemSubsequentTasks::AddMasterTask(FGraphEventRef MasterTask)
 {
 	SCOPE_CYCLE_COUNTER(MovieSceneEval_SystemDependencyCost)
 
 	if (MasterTask)
 	{
-		if (!Subsequents)
-		{
-			Subsequents = MakeShared<FSystemTaskPrerequisites>();
-			Graph->Nodes.Array[NodeID].SubsequentTasks = Subsequents;
-		}
-		Subsequents->AddMasterTask(MasterTask);
+		GetOrCreateSubsequents().AddMasterTask(MasterTask);
 
 		AllTasks->Add(MasterTask);
 	}
@@ -76,13 +97,19 @@ void FSystemSubsequentTasks::AddComponentTask(UE::MovieScene::FComponentTypeID C
 
 	if (ComponentTask)
 	{
-		if (!Subsequents)
-		{
-			Subsequents = MakeShared<FSystemTaskPrerequisites>();
-			Graph->Nodes.Array[NodeID].SubsequentTasks = Subsequents;
-		}
+		GetOrCreateSubsequents().AddComponentTask(ComponentType, ComponentTask);
+		AllTasks->Add(ComponentTask);
+	}
+}
 
-		Subsequents->AddComponentTask(ComponentType, ComponentTask);
+void FSystemSubsequentTasks::AddComponentReadTask(UE::MovieScene::FComponentTypeID ComponentType, FGraphEventRef ComponentTask)
+{
+	SCOPE_CYCLE_COUNTER(MovieSceneEval_SystemDependencyCost)
+
+	if (ComponentTask)
+	{
+		// Read tasks are tracked so that downstream writers don't overwrite data that is still being read
+		GetOrCreateSubsequents().AddComponentReadTask(ComponentType, ComponentTask);
 		AllTasks->Add(ComponentTask);
 	}
 }
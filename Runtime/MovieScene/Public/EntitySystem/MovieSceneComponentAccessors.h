@@ -239,6 +239,19 @@ inline void PopulatePrerequisites(const FOptionalComponentAccess* In, const FSys
 		InPrerequisites.FilterByComponent(*OutGatheredPrereqs, In->ComponentType);
 	}
 }
+// Readers only need to wait for upstream writers, writers (above) also wait for upstream readers
+inline void PopulatePrerequisites(const FReadAccess* In, const FSystemTaskPrerequisites& InPrerequisites, FGraphEventArray* OutGatheredPrereqs)
+{
+	check(In->ComponentType);
+	InPrerequisites.FilterWritesByComponent(*OutGatheredPrereqs, In->ComponentType);
+}
+inline void PopulatePrerequisites(const FOptionalReadAccess* In, const FSystemTaskPrerequisites& InPrerequisites, FGraphEventArray* OutGatheredPrereqs)
+{
+	if (In->ComponentType)
+	{
+		InPrerequisites.FilterWritesByComponent(*OutGatheredPrereqs, In->ComponentType);
+	}
+}
 template<typename... T>
 void PopulatePrerequisites(const TReadOneOfAccessor<T...>* In, const FSystemTaskPrerequisites& InPrerequisites, FGraphEventArray* OutGatheredPrereqs)
 {
@@ -274,6 +287,38 @@ inline void PopulateSubsequents(const FOptionalWriteAccess* In, const FGraphEven
 		OutSubsequents.AddComponentTask(In->ComponentType, InEvent);
 	}
 }
+inline void PopulateSubsequents(const FReadAccess* In, const FGraphEventRef& InEvent, FSystemSubsequentTasks& OutSubsequents)
+{
+	check(In->ComponentType);
+	OutSubsequents.AddComponentReadTask(In->ComponentType, InEvent);
+}
+inline void PopulateSubsequents(const FOptionalReadAccess* In, const FGraphEventRef& InEvent, FSystemSubsequentTasks& OutSubsequents)
+{
+	if (In->ComponentType)
+	{
+		OutSubsequents.AddComponentReadTask(In->ComponentType, InEvent);
+	}
+}
+template<typename... T>
+void PopulateSubsequents(const TReadOneOfAccessor<T...>* In, const FGraphEventRef& InEvent, FSystemSubsequentTasks& OutSubsequents)
+{
+	VisitTupleElements(
+		[&InEvent, &OutSubsequents](const FOptionalReadAccess& Composite)
+		{
+			PopulateSubsequents(&Composite, InEvent, OutSubsequents);
+		}
+	, In->ComponentTypes);
+}
+template<typename... T>
+void PopulateSubsequents(const TReadOneOrMoreOfAccessor<T...>* In, const FGraphEventRef& InEvent, FSystemSubsequentTasks& OutSubsequents)
+{
+	VisitTupleElements(
+		[&InEvent, &OutSubsequents](const FOptionalReadAccess& Composite)
+		{
+			PopulateSubsequents(&Composite, InEvent, OutSubsequents);
+		}
+	, In->ComponentTypes);
+}
 inline void PopulateSubsequents(const void* In, const FGraphEventRef& InEvent, FSystemSubsequentTasks& OutSubsequents)
 {
 }
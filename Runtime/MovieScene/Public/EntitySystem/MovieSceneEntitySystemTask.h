@@ -12,6 +12,7 @@
 #include "EntitySystem/MovieSceneComponentPtr.h"
 
 #include "Templates/AndOrNot.h"
+#include "Async/ParallelFor.h"
 
 #include <initializer_list>
 
@@ -23,6 +24,9 @@ namespace MovieScene
 DECLARE_CYCLE_STAT(TEXT("Aquire Component Access Locks"), MovieSceneEval_AquireComponentAccessLocks, STATGROUP_MovieSceneECS);
 DECLARE_CYCLE_STAT(TEXT("Release Component Access Locks"), MovieSceneEval_ReleaseComponentAccessLocks, STATGROUP_MovieSceneECS);
 
+/** Minimum number of matching allocations for a task that supports ParallelAllocations to split its allocations across workers */
+extern MOVIESCENE_API int32 GThreadedEvaluationParallelAllocationThreshold;
+
 template<typename> struct TReadAccess;
 template<typename> struct TOptionalReadAccess;
 template<typename> struct TWriteAccess;
@@ -72,6 +76,15 @@ struct TDefaultEntityTaskTraits
 		 * FEntityTaskBuilder().Read<float>().Read<uint16>().Read<UObject*>().Dispatch_PerAllocation<FForEach_NoExpansion>(...);
 		 */
 		AutoExpandAccessors = true,
+
+		/**
+		 * When true, a threaded task visits its matching allocations in parallel rather than one after the other on a single worker.
+		 * Only enable this for tasks whose ForEachEntity/ForEachAllocation can be called concurrently for different allocations,
+		 * ie tasks that do not accumulate any state of their own.
+		 *
+		 * template<> struct TEntityTaskTraits<FMyStatelessTask> : TDefaultEntityTaskTraits<FMyStatelessTask> { enum { ParallelAllocations = true }; };
+		 */
+		ParallelAllocations = false,
 	};
 };
 
@@ -1091,6 +1104,26 @@ struct TEntityTaskBase
 		PostTask(&TaskImplInstance);
 	}
 
+	void RunParallel(TaskImpl& TaskImplInstance)
+	{
+		UE_LOG(LogMovieScene, VeryVerbose, TEXT("Running parallel entity task the following components: %s"), *FilteredTask.GetComponents().ToString(EntityManager));
+
+		TArray<FEntityAllocation*, TInlineAllocator<16>> Allocations;
+		for (FEntityAllocation* Allocation : EntityManager->Iterate(&FilteredTask.GetFilter()))
+		{
+			Allocations.Add(Allocation);
+		}
+
+		PreTask(&TaskImplInstance);
+
+		ParallelFor(Allocations.Num(), [this, &TaskImplInstance, &Allocations](int32 Index)
+		{
+			Caller::ForEachEntityImpl(TaskImplInstance, Allocations[Index], WriteContext, FilteredTask.GetComponents());
+		}, Allocations.Num() < GThreadedEvaluationParallelAllocationThreshold);
+
+		PostTask(&TaskImplInstance);
+	}
+
 private:
 
 	static void PreTask(void*, ...){}
@@ -1162,7 +1195,14 @@ struct TEntityTask : TEntityTaskBase<TaskImpl, ComponentTypes...>
 			checkf(CurrentThread == DesiredThread, TEXT("MovieScene evaluation task is not being run on its desired thread"));
 		}
 
-		this->Run(TaskImplInstance);
+		if (TEntityTaskTraits<TaskImpl>::ParallelAllocations)
+		{
+			this->RunParallel(TaskImplInstance);
+		}
+		else
+		{
+			this->Run(TaskImplInstance);
+		}
 	}
 
 private:
@@ -1205,6 +1245,26 @@ struct TEntityAllocationTaskBase
 		PostTask(&TaskImplInstance);
 	}
 
+	void RunParallel(TaskImpl& TaskImplInstance)
+	{
+		UE_LOG(LogMovieScene, VeryVerbose, TEXT("Running parallel entity task the following components: %s"), *ComponentFilter.GetComponents().ToString(EntityManager));
+
+		TArray<FEntityAllocationIteratorItem, TInlineAllocator<16>> Items;
+		for (FEntityAllocationIteratorItem Item : EntityManager->Iterate(&ComponentFilter.GetFilter()))
+		{
+			Items.Add(Item);
+		}
+
+		PreTask(&TaskImplInstance);
+
+		ParallelFor(Items.Num(), [this, &TaskImplInstance, &Items](int32 Index)
+		{
+			Caller::ForEachAllocationImpl(TaskImplInstance, Items[Index], WriteContext, ComponentFilter.GetComponents());
+		}, Items.Num() < GThreadedEvaluationParallelAllocationThreshold);
+
+		PostTask(&TaskImplInstance);
+	}
+
 private:
 
 	static void PreTask(void*, ...){}
@@ -1276,7 +1336,14 @@ struct TEntityAllocationTask : TEntityAllocationTaskBase<TaskImpl, ComponentType
 			checkf(CurrentThread == DesiredThread, TEXT("MovieScene evaluation task is not being run on its desired thread"));
 		}
 
-		this->Run(TaskImplInstance);
+		if (TEntityTaskTraits<TaskImpl>::ParallelAllocations)
+		{
+			this->RunParallel(TaskImplInstance);
+		}
+		else
+		{
+			this->Run(TaskImplInstance);
+		}
 	}
 
 private:
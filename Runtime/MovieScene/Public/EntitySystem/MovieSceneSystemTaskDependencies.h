@@ -29,7 +29,7 @@ struct FSystemTaskPrerequisites
 	{
 		for (FGraphEventRef Task : InEvents)
 		{
-			Prereqs.Add(FPrerequisite{ Task, FComponentTypeID::Invalid() });
+			Prereqs.Add(FPrerequisite{ Task, FComponentTypeID::Invalid(), false });
 			AllTasks.Add(Task);
 		}
 	}
@@ -59,6 +59,9 @@ struct FSystemTaskPrerequisites
 
 	MOVIESCENE_API void FilterByComponent(FGraphEventArray& OutArray, std::initializer_list<FComponentTypeID> ComponentTypes) const;
 
+	/** Gather only the tasks that write to the specified component, skipping tasks that only read it. Used by readers since concurrent reads do not conflict. */
+	MOVIESCENE_API void FilterWritesByComponent(FGraphEventArray& OutArray, FComponentTypeID ComponentType) const;
+
 	void AddMasterTask(const FGraphEventRef& InNewTask)
 	{
 		AddComponentTask(FComponentTypeID::Invalid(), InNewTask);
@@ -66,6 +69,9 @@ struct FSystemTaskPrerequisites
 
 	MOVIESCENE_API void AddComponentTask(FComponentTypeID ComponentType, const FGraphEventRef& InNewTask);
 
+	/** Add a task that only reads the specified component. Downstream writers of the component will wait for it, downstream readers will not. */
+	MOVIESCENE_API void AddComponentReadTask(FComponentTypeID ComponentType, const FGraphEventRef& InNewTask);
+
 	MOVIESCENE_API void Consume(const FSystemTaskPrerequisites& Other);
 
 	void Empty()
@@ -80,6 +86,7 @@ private:
 	{
 		FGraphEventRef   GraphEvent;
 		FComponentTypeID ComponentType;
+		bool             bReadOnly;
 	};
 	TArray<FPrerequisite, TInlineAllocator<4>> Prereqs;
 	mutable FGraphEventArray AllTasks;
@@ -95,8 +102,13 @@ struct MOVIESCENE_API FSystemSubsequentTasks
 
 	void AddComponentTask(FComponentTypeID ComponentType, FGraphEventRef ComponentTask);
 
+	void AddComponentReadTask(FComponentTypeID ComponentType, FGraphEventRef ComponentTask);
+
 private:
 
+	FSystemTaskPrerequisites& GetOrCreateSubsequents();
+
+
 	friend FMovieSceneEntitySystemGraph;
 
 	FSystemSubsequentTasks(FMovieSceneEntitySystemGraph* InGraph, FGraphEventArray* InAllTasks);
@@ -44,6 +44,9 @@ struct FEvaluateFloatChannels
 	}
 };
 
+// Channel evaluation has no shared state, so allocations can be evaluated concurrently
+template<> struct TEntityTaskTraits<FEvaluateFloatChannels> : TDefaultEntityTaskTraits<FEvaluateFloatChannels> { enum { ParallelAllocations = true }; };
+
 
 } // namespace MovieScene
 } // namespace UE
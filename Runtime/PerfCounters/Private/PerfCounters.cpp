@@ -12,6 +12,8 @@
 #include "Misc/ConfigCacheIni.h"
 #include "Serialization/JsonWriter.h"
 #include "Stats/Stats.h"
+#include "UObject/UObjectGlobals.h"
+#include "Algo/IsSorted.h"
 #include "ZeroLoad.h"
 
 #include "HttpServerModule.h"
@@ -27,6 +29,69 @@
 
 #define PERF_COUNTER_CONNECTION_TIMEOUT 5.0f
 
+#define OPENMETRICS_CONTENT_TYPE		TEXT("application/openmetrics-text; version=1.0.0; charset=utf-8")
+
+namespace PerfCountersMetrics
+{
+	/** Default bucket bounds (in ms) of the histograms recorded by the perf counters themselves */
+	static const double FrameTimeBucketsMs[] = { 5.0, 8.33, 16.67, 20.0, 33.33, 50.0, 66.67, 100.0, 200.0, 500.0, 1000.0 };
+	static const double GarbageCollectionTimeBucketsMs[] = { 1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0 };
+
+	/** Metric names must match [a-zA-Z_:][a-zA-Z0-9_:]*, anything else is replaced by an underscore */
+	static FString SanitizeName(const FString& Name)
+	{
+		FString Result = Name;
+		for (int32 Index = 0; Index < Result.Len(); ++Index)
+		{
+			TCHAR& Char = Result[Index];
+			const bool bValid = (Char >= TEXT('a') && Char <= TEXT('z')) || (Char >= TEXT('A') && Char <= TEXT('Z')) || Char == TEXT('_') || Char == TEXT(':')
+				|| (Index > 0 && Char >= TEXT('0') && Char <= TEXT('9'));
+			if (!bValid)
+			{
+				Char = TEXT('_');
+			}
+		}
+		return Result.IsEmpty() ? FString(TEXT("_")) : Result;
+	}
+
+	static FString EscapeLabelValue(const FString& Value)
+	{
+		return Value.Replace(TEXT("\\"), TEXT("\\\\")).Replace(TEXT("\""), TEXT("\\\"")).Replace(TEXT("\n"), TEXT("\\n"));
+	}
+
+	static FString FormatNumber(double Value)
+	{
+		if (FMath::IsNaN(Value))
+		{
+			return TEXT("NaN");
+		}
+		if (!FMath::IsFinite(Value))
+		{
+			return Value > 0.0 ? TEXT("+Inf") : TEXT("-Inf");
+		}
+		return FString::SanitizeFloat(Value);
+	}
+}
+
+FPerfCounterHistogram::FPerfCounterHistogram(TArrayView<const double> InUpperBounds)
+	: UpperBounds(InUpperBounds)
+	, BucketCounts(MakeUnique<std::atomic<uint64>[]>(InUpperBounds.Num() + 1))
+	, Count(0)
+	, Sum(0.0)
+{
+	checkf(Algo::IsSorted(UpperBounds), TEXT("FPerfCounterHistogram bucket bounds must be in ascending order"));
+}
+
+void FPerfCounterHistogram::Reset()
+{
+	for (int32 BucketIndex = 0; BucketIndex <= UpperBounds.Num(); ++BucketIndex)
+	{
+		BucketCounts[BucketIndex].store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	Sum.store(0.0, std::memory_order_relaxed);
+}
+
 FPerfCounters::FPerfCounters(const FString& InUniqueInstanceId)
 	: UniqueInstanceId(InUniqueInstanceId)
 	, InternalCountersUpdateInterval(60)
@@ -41,7 +106,11 @@ FPerfCounters::~FPerfCounters()
 	{
 		HttpRouter->UnbindRoute(StatsRouteHandle);
 		HttpRouter->UnbindRoute(ExecRouteHandle);
+		HttpRouter->UnbindRoute(MetricsRouteHandle);
 	}
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().RemoveAll(this);
+	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
 }
 
 bool FPerfCounters::Initialize()
@@ -53,6 +122,11 @@ bool FPerfCounters::Initialize()
 	}
 	LastTimeInternalCountersUpdated = FPlatformTime::Seconds() - InternalCountersUpdateInterval * FMath::FRand();	// randomize between servers
 
+	FrameTimeHistogram = &FindOrAddMetricHistogram(IPerfCounters::Histograms::FrameTime, PerfCountersMetrics::FrameTimeBucketsMs);
+	GarbageCollectionTimeHistogram = &FindOrAddMetricHistogram(IPerfCounters::Histograms::GarbageCollectionTime, PerfCountersMetrics::GarbageCollectionTimeBucketsMs);
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FPerfCounters::OnPreGarbageCollect);
+	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FPerfCounters::OnPostGarbageCollect);
+
 	// get the requested port from the command line (if specified)
 	const int32 StatsPort = IPerfCountersModule::GetHTTPStatsPort();
 	if (StatsPort < 0)
@@ -101,6 +175,21 @@ bool FPerfCounters::Initialize()
 		return false;
 	}
 
+	// Register a handler for /metrics
+	MetricsRouteHandle = HttpRouter->BindRoute(FHttpPath("/metrics"), EHttpServerRequestVerbs::VERB_GET,
+		[WeakThisPtr] (const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+	{
+		auto SharedThis = WeakThisPtr.Pin();
+		if (!SharedThis.IsValid()) { return false; }
+		return SharedThis->ProcessMetricsRequest(Request, OnComplete);
+	});
+	if(!MetricsRouteHandle.IsValid())
+	{
+		UE_LOG(LogPerfCounters, Error,
+			TEXT("FPerfCounters unable bind route: /metrics"));
+		return false;
+	}
+
 	return true;
 }
 
@@ -143,6 +232,86 @@ FString FPerfCounters::GetAllCountersAsJson()
 	return JsonStr;
 }
 
+FString FPerfCounters::GetAllCountersAsOpenMetrics()
+{
+	using namespace PerfCountersMetrics;
+
+	FString Output;
+	for (const auto& It : PerfCounterMap)
+	{
+		const FJsonVariant& JsonValue = It.Value;
+		const FString MetricName = SanitizeName(It.Key);
+		switch (JsonValue.Format)
+		{
+		case FJsonVariant::String:
+			Output += FString::Printf(TEXT("# TYPE %s info\n%s_info{value=\"%s\"} 1\n"), *MetricName, *MetricName, *EscapeLabelValue(JsonValue.StringValue));
+			break;
+		case FJsonVariant::Number:
+			if (JsonValue.Flags & IPerfCounters::Flags::Monotonic)
+			{
+				Output += FString::Printf(TEXT("# TYPE %s counter\n%s_total %s\n"), *MetricName, *MetricName, *FormatNumber(JsonValue.NumberValue));
+			}
+			else
+			{
+				Output += FString::Printf(TEXT("# TYPE %s gauge\n%s %s\n"), *MetricName, *MetricName, *FormatNumber(JsonValue.NumberValue));
+			}
+			break;
+		case FJsonVariant::Callback:
+		case FJsonVariant::Null:
+		default:
+			// json callbacks produce objects, which have no OpenMetrics equivalent
+			break;
+		}
+	}
+
+	{
+		FReadScopeLock ScopeLock(MetricHistogramsLock);
+		for (const auto& It : MetricHistogramMap)
+		{
+			const FPerfCounterHistogram& Histogram = *It.Value;
+			const FString MetricName = SanitizeName(It.Key.ToString());
+			const TArray<double>& UpperBounds = Histogram.GetUpperBounds();
+
+			// buckets are cumulative in OpenMetrics, and the +Inf bucket has to match _count, so derive both from the same reads
+			Output += FString::Printf(TEXT("# TYPE %s histogram\n"), *MetricName);
+			uint64 CumulativeCount = 0;
+			for (int32 BucketIndex = 0; BucketIndex <= UpperBounds.Num(); ++BucketIndex)
+			{
+				CumulativeCount += Histogram.GetBucketCount(BucketIndex);
+				const FString UpperBound = BucketIndex < UpperBounds.Num() ? FormatNumber(UpperBounds[BucketIndex]) : FString(TEXT("+Inf"));
+				Output += FString::Printf(TEXT("%s_bucket{le=\"%s\"} %llu\n"), *MetricName, *UpperBound, CumulativeCount);
+			}
+			Output += FString::Printf(TEXT("%s_count %llu\n%s_sum %s\n"), *MetricName, CumulativeCount, *MetricName, *FormatNumber(Histogram.GetSum()));
+		}
+	}
+
+	Output += TEXT("# EOF\n");
+	return Output;
+}
+
+FPerfCounterHistogram& FPerfCounters::FindOrAddMetricHistogram(FName Name, TArrayView<const double> UpperBounds)
+{
+	if (FPerfCounterHistogram* Existing = FindMetricHistogram(Name))
+	{
+		return *Existing;
+	}
+
+	FWriteScopeLock ScopeLock(MetricHistogramsLock);
+	TUniquePtr<FPerfCounterHistogram>& Histogram = MetricHistogramMap.FindOrAdd(Name);
+	if (!Histogram.IsValid())
+	{
+		Histogram = MakeUnique<FPerfCounterHistogram>(UpperBounds);
+	}
+	return *Histogram;
+}
+
+FPerfCounterHistogram* FPerfCounters::FindMetricHistogram(FName Name)
+{
+	FReadScopeLock ScopeLock(MetricHistogramsLock);
+	const TUniquePtr<FPerfCounterHistogram>* Histogram = MetricHistogramMap.Find(Name);
+	return Histogram ? Histogram->Get() : nullptr;
+}
+
 void FPerfCounters::ResetStatsForNextPeriod()
 {
 	UE_LOG(LogPerfCounters, Verbose, TEXT("Clearing perf counters."));
@@ -160,6 +329,8 @@ bool FPerfCounters::Tick(float DeltaTime)
 {
     QUICK_SCOPE_CYCLE_COUNTER(STAT_FPerfCounters_Tick);
 
+	FrameTimeHistogram->Observe(DeltaTime * 1000.0);
+
 	if (LIKELY(ZeroLoadThread != nullptr))
 	{
 		TickZeroLoad(DeltaTime);
@@ -215,6 +386,20 @@ void FPerfCounters::TickSystemCounters(float DeltaTime)
 	}
 }
 
+void FPerfCounters::OnPreGarbageCollect()
+{
+	GarbageCollectionStartCycles = FPlatformTime::Cycles64();
+}
+
+void FPerfCounters::OnPostGarbageCollect()
+{
+	if (GarbageCollectionStartCycles != 0)
+	{
+		GarbageCollectionTimeHistogram->Observe(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - GarbageCollectionStartCycles));
+		GarbageCollectionStartCycles = 0;
+	}
+}
+
 bool FPerfCounters::Exec(UWorld* InWorld, const TCHAR* Cmd, FOutputDevice& Ar)
 {
 	// ignore everything that doesn't start with PerfCounters
@@ -240,6 +425,14 @@ bool FPerfCounters::ProcessStatsRequest(const FHttpServerRequest& Request, const
 	return true;
 }
 
+bool FPerfCounters::ProcessMetricsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+{
+	auto ResponseBody = GetAllCountersAsOpenMetrics();
+	auto Response = FHttpServerResponse::Create(ResponseBody, OPENMETRICS_CONTENT_TYPE);
+	OnComplete(MoveTemp(Response));
+	return true;
+}
+
 bool FPerfCounters::ProcessExecRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
 {
 	FStringOutputDevice StringOutDevice;
@@ -7,6 +7,7 @@
 #include "PerfCountersModule.h"
 #include "Containers/Ticker.h"
 #include "ProfilingDebugging/Histogram.h"
+#include "Misc/ScopeRWLock.h"
 
 #include "HttpResultCallback.h"
 #include "HttpPath.h"
@@ -51,6 +52,9 @@ public:
 	virtual FString GetAllCountersAsJson() override;
 	virtual void ResetStatsForNextPeriod() override;
 	virtual TPerformanceHistogramMap& PerformanceHistograms() override { return PerformanceHistogramMap; }
+	virtual FPerfCounterHistogram& FindOrAddMetricHistogram(FName Name, TArrayView<const double> UpperBounds) override;
+	virtual FPerfCounterHistogram* FindMetricHistogram(FName Name) override;
+	virtual FString GetAllCountersAsOpenMetrics() override;
 	// Legacy load tracking, which is raw frame time, not overshoot.
 	virtual bool StartMachineLoadTracking() override;
 	// If OvershootBuckets is empty, will use legacy load tracking values, which is raw frame time, not overshoot.
@@ -64,6 +68,9 @@ private:
 	void TickZeroLoad(float DeltaTime);
 	void TickSystemCounters(float DeltaTime);
 
+	void OnPreGarbageCollect();
+	void OnPostGarbageCollect();
+
 	/**
 	 * Processes a /stats request
 	 *
@@ -82,6 +89,15 @@ private:
 	 */
 	bool ProcessExecRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
 
+	/**
+	 * Processes a /metrics request
+	 *
+	 * @param Request The incoming request
+	 * @param OnComplete The invokable response result callback
+	 * @return true if this request was handled herein, false otherwise
+	 */
+	bool ProcessMetricsRequest(const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete);
+
 	/** Unique name of this instance */
 	FString UniqueInstanceId;
 
@@ -100,6 +116,17 @@ private:
 	/** Map of performance histograms. */
 	TPerformanceHistogramMap PerformanceHistogramMap;
 
+	/** Lock-free histograms exported over /metrics, guarded by MetricHistogramsLock (the histograms themselves are not) */
+	TMap<FName, TUniquePtr<FPerfCounterHistogram>> MetricHistogramMap;
+	FRWLock MetricHistogramsLock;
+
+	/** Cached histograms recorded by the perf counters themselves */
+	FPerfCounterHistogram* FrameTimeHistogram = nullptr;
+	FPerfCounterHistogram* GarbageCollectionTimeHistogram = nullptr;
+
+	/** Start of the garbage collection in progress */
+	uint64 GarbageCollectionStartCycles = 0;
+
 	/** Data of zero-load thread (used for measuring machine load). */
 	FZeroLoad* ZeroLoadThread;
 
@@ -114,4 +141,7 @@ private:
 
 	/** Route handle for /exec binding */
 	FHttpRouteHandle ExecRouteHandle = nullptr;
+
+	/** Route handle for /metrics binding */
+	FHttpRouteHandle MetricsRouteHandle = nullptr;
 };
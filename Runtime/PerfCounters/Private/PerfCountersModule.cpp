@@ -72,6 +72,9 @@ const FName IPerfCounters::Histograms::FrameTimeWithoutSleep(TEXT("FrameTimeWith
 const FName IPerfCounters::Histograms::ServerReplicateActorsTime(TEXT("ServerReplicateActorsTime"));
 const FName IPerfCounters::Histograms::SleepTime(TEXT("SleepTime"));
 const FName IPerfCounters::Histograms::ZeroLoadFrameTime(TEXT("ZeroLoadFrameTime"));
+const FName IPerfCounters::Histograms::NetSendTime(TEXT("NetSendTime"));
+const FName IPerfCounters::Histograms::GarbageCollectionTime(TEXT("GarbageCollectionTime"));
+const FName IPerfCounters::Histograms::ConnectionRTT(TEXT("ConnectionRTT"));
 
 int32 IPerfCountersModule::GetHTTPStatsPort()
 {
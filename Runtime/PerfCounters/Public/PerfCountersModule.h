@@ -5,6 +5,9 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
+#include "Containers/ArrayView.h"
+#include "Algo/BinarySearch.h"
+#include <atomic>
 
 struct FHistogram;
 template <class CharType> struct TPrettyJsonPrintPolicy;
@@ -33,6 +36,53 @@ DECLARE_DELEGATE_OneParam(FProduceJsonCounterValue, const FPrettyJsonWriter& /*
  */
 DECLARE_DELEGATE_RetVal_TwoParams(bool, FPerfCounterExecCommandCallback, const FString& /*ExecCmd*/, FOutputDevice& /*Output*/);
 
+/**
+ * Histogram with fixed bucket bounds that can be updated from any thread without taking a lock.
+ * Bounds are inclusive upper bounds in ascending order; values above the last one go to an implicit +Inf bucket.
+ * Exported over the /metrics endpoint in OpenMetrics format.
+ */
+class PERFCOUNTERS_API FPerfCounterHistogram
+{
+public:
+
+	explicit FPerfCounterHistogram(TArrayView<const double> InUpperBounds);
+
+	FPerfCounterHistogram(const FPerfCounterHistogram&) = delete;
+	FPerfCounterHistogram& operator=(const FPerfCounterHistogram&) = delete;
+
+	/** Records a value. Only the sum needs a compare-exchange loop, everything else is a single relaxed increment. */
+	void Observe(double Value)
+	{
+		const int32 BucketIndex = Algo::LowerBound(UpperBounds, Value);
+		BucketCounts[BucketIndex].fetch_add(1, std::memory_order_relaxed);
+		Count.fetch_add(1, std::memory_order_relaxed);
+
+		double CurrentSum = Sum.load(std::memory_order_relaxed);
+		while (!Sum.compare_exchange_weak(CurrentSum, CurrentSum + Value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	/** @return bucket upper bounds, not including the +Inf bucket */
+	const TArray<double>& GetUpperBounds() const { return UpperBounds; }
+
+	/** @return number of values in the given bucket (not cumulative), the +Inf bucket is at index GetUpperBounds().Num() */
+	uint64 GetBucketCount(int32 BucketIndex) const { return BucketCounts[BucketIndex].load(std::memory_order_relaxed); }
+
+	uint64 GetCount() const { return Count.load(std::memory_order_relaxed); }
+	double GetSum() const { return Sum.load(std::memory_order_relaxed); }
+
+	/** Zeroes all buckets. Not atomic with respect to concurrent Observe() calls. */
+	void Reset();
+
+private:
+
+	TArray<double> UpperBounds;
+	TUniquePtr<std::atomic<uint64>[]> BucketCounts;
+	std::atomic<uint64> Count;
+	std::atomic<double> Sum;
+};
+
 /**
  * A programming interface for setting/updating performance counters
  */
@@ -43,7 +93,9 @@ public:
 	enum Flags : uint32
 	{
 		/** Perf counter with this flag will be removed by "perfcounters clear" command */
-		Transient = (1 << 0)
+		Transient = (1 << 0),
+		/** Perf counter with this flag only ever goes up and is exported to OpenMetrics as a counter rather than a gauge */
+		Monotonic = (1 << 1)
 	};
 
 	struct FJsonVariant
@@ -73,6 +125,13 @@ public:
 
 		/** Zero load thread frame time histogram. */
 		static const FName ZeroLoadFrameTime;
+
+		/** UNetDriver::TickFlush time of the game net driver in milliseconds, exported over /metrics. */
+		static const FName NetSendTime;
+		/** Garbage collection time in milliseconds, exported over /metrics. */
+		static const FName GarbageCollectionTime;
+		/** Round trip time of every client connection in milliseconds, sampled when net stats are gathered, exported over /metrics. */
+		static const FName ConnectionRTT;
 	};
 
 	/** Array used to store performance histograms. */
@@ -111,6 +170,19 @@ public:
 	/** Returns performance histograms for direct manipulation by the client code. */
 	virtual TPerformanceHistogramMap& PerformanceHistograms() = 0;
 
+	/**
+	 * Returns the lock-free histogram with the given name, creating it with the given bounds if needed.
+	 * Histograms are never removed, so the reference can be cached and observed from any thread.
+	 * FrameTime and GarbageCollectionTime are created and recorded by the perf counters themselves.
+	 */
+	virtual FPerfCounterHistogram& FindOrAddMetricHistogram(FName Name, TArrayView<const double> UpperBounds) = 0;
+
+	/** @return the lock-free histogram with the given name, or nullptr if it was never added */
+	virtual FPerfCounterHistogram* FindMetricHistogram(FName Name) = 0;
+
+	/** @return all numeric and string perf counters and the lock-free histograms in OpenMetrics text format */
+	virtual FString GetAllCountersAsOpenMetrics() = 0;
+
 	/** Starts tracking overall machine load. */
 	virtual bool StartMachineLoadTracking() = 0;
 
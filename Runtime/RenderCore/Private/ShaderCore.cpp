@@ -6,6 +6,7 @@
 
 #include "ShaderCore.h"
 #include "HAL/FileManager.h"
+#include "HAL/ThreadSafeCounter.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/ScopeLock.h"
@@ -103,6 +104,9 @@ FCriticalSection FileCacheCriticalSection;
 /** The shader file cache, used to minimize shader file reads */
 TMap<FString, FString> GShaderFileCache;
 
+/** Incremented every time GShaderFileCache is flushed. */
+static FThreadSafeCounter GShaderFileCacheGeneration;
+
 class FShaderHashCache
 {
 public:
@@ -1217,6 +1221,7 @@ void FlushShaderFileCache()
 	{
 		FScopeLock ScopeLock(&FileCacheCriticalSection);
 		GShaderFileCache.Empty();
+		GShaderFileCacheGeneration.Increment();
 	}
 
 	if (!FPlatformProperties::RequiresCookedData())
@@ -1249,6 +1254,11 @@ void FlushShaderFileCache()
 	UE_LOG(LogShaders, Log, TEXT("FlushShaderFileCache() end"));
 }
 
+uint32 GetShaderFileCacheGeneration()
+{
+	return (uint32)GShaderFileCacheGeneration.GetValue();
+}
+
 void GenerateReferencedUniformBuffers(
 	const TCHAR* SourceFilename, 
 	const TCHAR* ShaderTypeName, 
@@ -16,7 +16,7 @@
 class Error;
 
 // this is for the protocol, not the data, bump if FShaderCompilerInput or ProcessInputFromArchive changes.
-const int32 ShaderCompileWorkerInputVersion = 13;
+const int32 ShaderCompileWorkerInputVersion = 14;
 // this is for the protocol, not the data, bump if FShaderCompilerOutput or WriteToOutputArchive changes.
 const int32 ShaderCompileWorkerOutputVersion = 6;
 // this is for the protocol, not the data.
@@ -468,6 +468,77 @@ enum class ESCWErrorCode
 	CrashInsidePlatformCompiler,
 };
 
+/**
+ * Header at the start of the shared memory region used to exchange job batches with a ShaderCompileWorker
+ * launched with -SharedMemory=<Name>. The region is owned by the parent process and outlives the worker, so a
+ * relaunched worker picks up where the previous one left off. The input batch and then the output batch are
+ * stored in the payload right after the header; whenever a batch doesn't fit, the regular transfer files are used.
+ */
+struct FShaderCompileWorkerMailbox
+{
+	enum EState : int32
+	{
+		/** Parent may write a new input batch. */
+		Idle,
+		/** Input batch is in the payload, waiting for the worker. */
+		InputReady,
+		/** Worker is processing the input batch. */
+		Processing,
+		/** Output batch is in the payload, waiting for the parent. */
+		OutputReady,
+		/** Output batch did not fit and was written to the regular output file. */
+		OutputInFile,
+	};
+
+	static constexpr uint32 ExpectedMagic = 0x4D574353; // 'SCWM'
+
+	uint32 Magic;
+	volatile int32 State;
+	int64 PayloadCapacity;
+	int64 InputSize;
+	int64 OutputSize;
+
+	static FString GetRegionName(uint32 ParentProcessId, uint32 WorkerIndex)
+	{
+		return FString::Printf(TEXT("ShaderCompileWorker_%u_%u"), ParentProcessId, WorkerIndex);
+	}
+
+	void Initialize(SIZE_T RegionSize)
+	{
+		Magic = ExpectedMagic;
+		PayloadCapacity = (int64)RegionSize - (int64)sizeof(FShaderCompileWorkerMailbox);
+		InputSize = 0;
+		OutputSize = 0;
+		SetState(Idle);
+	}
+
+	bool IsValid() const
+	{
+		return Magic == ExpectedMagic && PayloadCapacity > 0;
+	}
+
+	uint8* GetPayload()
+	{
+		return reinterpret_cast<uint8*>(this + 1);
+	}
+
+	EState GetState() const
+	{
+		return (EState)FPlatformAtomics::AtomicRead(&State);
+	}
+
+	/** Publishes everything written to the payload before the state change. */
+	void SetState(EState NewState)
+	{
+		FPlatformAtomics::InterlockedExchange(&State, (int32)NewState);
+	}
+
+	bool TrySetState(EState ExpectedState, EState NewState)
+	{
+		return FPlatformAtomics::InterlockedCompareExchange(&State, (int32)NewState, (int32)ExpectedState) == (int32)ExpectedState;
+	}
+};
+
 /**
  * Validates the format of a virtual shader file path.
  * Meant to be use as such: check(CheckVirtualShaderFilePath(VirtualFilePath));
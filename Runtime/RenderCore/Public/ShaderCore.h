@@ -900,6 +900,12 @@ extern void BuildShaderFileToUniformBufferMap(TMap<FString, TArray<const TCHAR*>
  */
 extern RENDERCORE_API void FlushShaderFileCache();
 
+/**
+ * Returns a counter that is incremented every time the shader file cache is flushed.
+ * Caches derived from shader source files can compare it to know when their contents are stale.
+ */
+extern RENDERCORE_API uint32 GetShaderFileCacheGeneration();
+
 extern RENDERCORE_API void VerifyShaderSourceFiles(EShaderPlatform ShaderPlatform);
 
 struct FCachedUniformBufferDeclaration
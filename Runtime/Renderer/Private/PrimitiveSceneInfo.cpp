@@ -1014,6 +1014,7 @@ void FPrimitiveSceneInfo::AddToScene(FRHICommandListImmediate& RHICmdList, FScen
 			PrimitiveBounds.MinDrawDistanceSq = FMath::Square(Proxy->GetMinDrawDistance());
 			PrimitiveBounds.MaxDrawDistance = Proxy->GetMaxDrawDistance();
 			PrimitiveBounds.MaxCullDistance = PrimitiveBounds.MaxDrawDistance;
+			Scene->PrimitiveBoundsSoA.Set(PackedIndex, PrimitiveBounds);
 
 			Scene->PrimitiveFlagsCompact[PackedIndex] = FPrimitiveFlagsCompact(Proxy);
 
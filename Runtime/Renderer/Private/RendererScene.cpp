@@ -637,6 +637,7 @@ void FScene::CheckPrimitiveArrays(int MaxTypeOffsetIndex)
 	check(Primitives.Num() == PrimitiveTransforms.Num());
 	check(Primitives.Num() == PrimitiveSceneProxies.Num());
 	check(Primitives.Num() == PrimitiveBounds.Num());
+	check(Primitives.Num() == PrimitiveBoundsSoA.Num());
 	check(Primitives.Num() == PrimitiveFlagsCompact.Num());
 	check(Primitives.Num() == PrimitiveVisibilityIds.Num());
 	check(Primitives.Num() == PrimitiveOcclusionFlags.Num());
@@ -3074,6 +3075,36 @@ void FScene::GetWindParameters(const FVector& Position, FVector& OutDirection, f
 	OutMaxGustAmt	= AccumWindData.MaxGustAmt;
 }
 
+bool FScene::IsBoxSoftwareOccluded(const FBox& Box, uint32 ViewKey) const
+{
+	TSharedPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe> Results;
+	{
+		FScopeLock Lock(&SoftwareOcclusionResultsCS);
+		if (const TWeakPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe>* ViewResults = SoftwareOcclusionResults.Find(ViewKey))
+		{
+			Results = ViewResults->Pin();
+		}
+	}
+
+	return Results.IsValid() && FSceneSoftwareOcclusion::IsBoxOccluded(*Results, Box);
+}
+
+void FScene::SetSoftwareOcclusionResults(uint32 ViewKey, const TSharedPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe>& Results) const
+{
+	FScopeLock Lock(&SoftwareOcclusionResultsCS);
+
+	// Drop the buffers of view states that were destroyed since
+	for (auto It = SoftwareOcclusionResults.CreateIterator(); It; ++It)
+	{
+		if (!It.Value().IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SoftwareOcclusionResults.Add(ViewKey, Results);
+}
+
 void FScene::GetWindParameters_GameThread(const FVector& Position, FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const
 {
 	FWindData AccumWindData;
@@ -3611,6 +3642,7 @@ void FScene::ApplyWorldOffset_RenderThread(const FVector& InOffset)
 	{
 		PrimitiveBounds[Idx].BoxSphereBounds.Origin+= InOffset;
 	}
+	PrimitiveBoundsSoA.ApplyWorldOffset(InOffset);
 
 	// Primitive occlusion bounds
 	for (int32 Idx = 0; Idx < PrimitiveOcclusionBounds.Num(); ++Idx)
@@ -3933,6 +3965,7 @@ void FScene::UpdateAllPrimitiveSceneInfos(FRDGBuilder& GraphBuilder, bool bAsync
 							TArraySwapElements(PrimitiveTransforms, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveSceneProxies, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveBounds, DestIndex, SourceIndex);
+							PrimitiveBoundsSoA.Swap(DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveFlagsCompact, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveVisibilityIds, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveOcclusionFlags, DestIndex, SourceIndex);
@@ -3985,6 +4018,7 @@ void FScene::UpdateAllPrimitiveSceneInfos(FRDGBuilder& GraphBuilder, bool bAsync
 				PrimitiveTransforms.Pop(false);
 				PrimitiveSceneProxies.Pop(false);
 				PrimitiveBounds.Pop(false);
+				PrimitiveBoundsSoA.Pop();
 				PrimitiveFlagsCompact.Pop(false);
 				PrimitiveVisibilityIds.Pop(false);
 				PrimitiveOcclusionFlags.Pop(false);
@@ -4047,6 +4081,7 @@ void FScene::UpdateAllPrimitiveSceneInfos(FRDGBuilder& GraphBuilder, bool bAsync
 			PrimitiveTransforms.Reserve(PrimitiveTransforms.Num() + AddedLocalPrimitiveSceneInfos.Num());
 			PrimitiveSceneProxies.Reserve(PrimitiveSceneProxies.Num() + AddedLocalPrimitiveSceneInfos.Num());
 			PrimitiveBounds.Reserve(PrimitiveBounds.Num() + AddedLocalPrimitiveSceneInfos.Num());
+			PrimitiveBoundsSoA.Reserve(PrimitiveBoundsSoA.Num() + AddedLocalPrimitiveSceneInfos.Num());
 			PrimitiveFlagsCompact.Reserve(PrimitiveFlagsCompact.Num() + AddedLocalPrimitiveSceneInfos.Num());
 			PrimitiveVisibilityIds.Reserve(PrimitiveVisibilityIds.Num() + AddedLocalPrimitiveSceneInfos.Num());
 			PrimitiveOcclusionFlags.Reserve(PrimitiveOcclusionFlags.Num() + AddedLocalPrimitiveSceneInfos.Num());
@@ -4079,6 +4114,7 @@ void FScene::UpdateAllPrimitiveSceneInfos(FRDGBuilder& GraphBuilder, bool bAsync
 				PrimitiveTransforms.Add(LocalToWorld);
 				PrimitiveSceneProxies.Add(PrimitiveSceneInfo->Proxy);
 				PrimitiveBounds.AddUninitialized();
+				PrimitiveBoundsSoA.AddUninitialized();
 				PrimitiveFlagsCompact.AddUninitialized();
 				PrimitiveVisibilityIds.AddUninitialized();
 				PrimitiveOcclusionFlags.AddUninitialized();
@@ -4162,6 +4198,7 @@ void FScene::UpdateAllPrimitiveSceneInfos(FRDGBuilder& GraphBuilder, bool bAsync
 							TArraySwapElements(PrimitiveTransforms, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveSceneProxies, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveBounds, DestIndex, SourceIndex);
+							PrimitiveBoundsSoA.Swap(DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveFlagsCompact, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveVisibilityIds, DestIndex, SourceIndex);
 							TArraySwapElements(PrimitiveOcclusionFlags, DestIndex, SourceIndex);
@@ -62,6 +62,14 @@ static TAutoConsoleVariable<int32> CVarMobileAllowSoftwareOcclusion(
 	ECVF_RenderThreadSafe
 	);
 
+static TAutoConsoleVariable<int32> CVarAllowSoftwareOcclusion(
+	TEXT("r.AllowSoftwareOcclusion"),
+	0,
+	TEXT("Whether to rasterize the scene on CPU for primitive occlusion on any feature level, instead of using hardware occlusion queries.\n")
+	TEXT("Avoids the GPU readback latency of occlusion queries. r.Mobile.AllowSoftwareOcclusion only applies to mobile feature levels."),
+	ECVF_RenderThreadSafe
+	);
+
 int32 GEnableComputeBuildHZB = 1;
 static FAutoConsoleVariableRef CVarEnableComputeBuildHZB(
 	TEXT("r.EnableComputeBuildHZB"),
@@ -286,10 +294,20 @@ bool FSceneViewState::IsShadowOccluded(FRHICommandListImmediate& RHICmdList, FSc
 	}
 }
 
-void FSceneViewState::ConditionallyAllocateSceneSoftwareOcclusion(ERHIFeatureLevel::Type InFeatureLevel)
+bool ShouldUseSoftwareOcclusion(ERHIFeatureLevel::Type InFeatureLevel)
 {
+	if (CVarAllowSoftwareOcclusion.GetValueOnAnyThread() != 0)
+	{
+		return true;
+	}
+
 	bool bMobileAllowSoftwareOcclusion = CVarMobileAllowSoftwareOcclusion.GetValueOnAnyThread() != 0;
-	bool bShouldBeEnabled = InFeatureLevel <= ERHIFeatureLevel::ES3_1 && bMobileAllowSoftwareOcclusion;
+	return InFeatureLevel <= ERHIFeatureLevel::ES3_1 && bMobileAllowSoftwareOcclusion;
+}
+
+void FSceneViewState::ConditionallyAllocateSceneSoftwareOcclusion(ERHIFeatureLevel::Type InFeatureLevel)
+{
+	bool bShouldBeEnabled = ShouldUseSoftwareOcclusion(InFeatureLevel);
 
 	if (bShouldBeEnabled && !SceneSoftwareOcclusion)
 	{
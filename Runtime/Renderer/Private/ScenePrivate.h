@@ -2293,6 +2293,109 @@ struct FPrimitiveBounds
 	float MaxCullDistance;
 };
 
+/**
+ * Structure-of-arrays mirror of FScene::PrimitiveBounds, used by the vectorized frustum culling kernel.
+ * Every array is padded with zeroed entries to a multiple of LaneCount so the kernel can always load whole batches.
+ */
+struct FPrimitiveBoundsSoA
+{
+	/** Number of primitives tested per iteration of the culling kernel. */
+	static constexpr int32 LaneCount = 8;
+
+	typedef TArray<float, TAlignedHeapAllocator<32>> FFloatArray;
+
+	FFloatArray OriginX;
+	FFloatArray OriginY;
+	FFloatArray OriginZ;
+	FFloatArray ExtentX;
+	FFloatArray ExtentY;
+	FFloatArray ExtentZ;
+	FFloatArray SphereRadius;
+	FFloatArray MinDrawDistanceSq;
+	FFloatArray MaxCullDistance;
+
+	FORCEINLINE int32 Num() const
+	{
+		return NumPrimitives;
+	}
+
+	void Reserve(int32 Number)
+	{
+		const int32 PaddedNum = Align(Number, LaneCount);
+		ForEachArray([PaddedNum](FFloatArray& Array) { Array.Reserve(PaddedNum); });
+	}
+
+	/** Appends one entry. Its value is undefined until Set() is called. */
+	void AddUninitialized()
+	{
+		++NumPrimitives;
+		if (OriginX.Num() < NumPrimitives)
+		{
+			ForEachArray([](FFloatArray& Array) { Array.AddZeroed(LaneCount); });
+		}
+	}
+
+	void Pop()
+	{
+		check(NumPrimitives > 0);
+		--NumPrimitives;
+		const int32 Index = NumPrimitives;
+		ForEachArray([Index](FFloatArray& Array) { Array[Index] = 0.0f; });
+
+		const int32 PaddedNum = Align(NumPrimitives, LaneCount);
+		if (OriginX.Num() > PaddedNum)
+		{
+			ForEachArray([PaddedNum](FFloatArray& Array) { Array.SetNum(PaddedNum, false); });
+		}
+	}
+
+	void Swap(int32 IndexA, int32 IndexB)
+	{
+		ForEachArray([IndexA, IndexB](FFloatArray& Array) { Array.Swap(IndexA, IndexB); });
+	}
+
+	void Set(int32 Index, const FPrimitiveBounds& Bounds)
+	{
+		checkSlow(Index < NumPrimitives);
+		OriginX[Index] = Bounds.BoxSphereBounds.Origin.X;
+		OriginY[Index] = Bounds.BoxSphereBounds.Origin.Y;
+		OriginZ[Index] = Bounds.BoxSphereBounds.Origin.Z;
+		ExtentX[Index] = Bounds.BoxSphereBounds.BoxExtent.X;
+		ExtentY[Index] = Bounds.BoxSphereBounds.BoxExtent.Y;
+		ExtentZ[Index] = Bounds.BoxSphereBounds.BoxExtent.Z;
+		SphereRadius[Index] = Bounds.BoxSphereBounds.SphereRadius;
+		MinDrawDistanceSq[Index] = Bounds.MinDrawDistanceSq;
+		MaxCullDistance[Index] = Bounds.MaxCullDistance;
+	}
+
+	void ApplyWorldOffset(const FVector& InOffset)
+	{
+		for (int32 Index = 0; Index < NumPrimitives; ++Index)
+		{
+			OriginX[Index] += InOffset.X;
+			OriginY[Index] += InOffset.Y;
+			OriginZ[Index] += InOffset.Z;
+		}
+	}
+
+private:
+	template<typename FuncType>
+	FORCEINLINE void ForEachArray(FuncType&& Func)
+	{
+		Func(OriginX);
+		Func(OriginY);
+		Func(OriginZ);
+		Func(ExtentX);
+		Func(ExtentY);
+		Func(ExtentZ);
+		Func(SphereRadius);
+		Func(MinDrawDistanceSq);
+		Func(MaxCullDistance);
+	}
+
+	int32 NumPrimitives = 0;
+};
+
 /**
  * Precomputed primitive visibility ID.
  */
@@ -2601,6 +2704,8 @@ public:
 	TArray<FPrimitiveSceneProxy*> PrimitiveSceneProxies;
 	/** Packed array of primitive bounds. */
 	TArray<FPrimitiveBounds> PrimitiveBounds;
+	/** Structure-of-arrays copy of PrimitiveBounds for the vectorized frustum culling path. */
+	FPrimitiveBoundsSoA PrimitiveBoundsSoA;
 	/** Packed array of primitive flags. */
 	TArray<FPrimitiveFlagsCompact> PrimitiveFlagsCompact;
 	/** Packed array of precomputed primitive visibility IDs. */
@@ -2795,6 +2900,13 @@ public:
 	/** Wind source components, tracked so the game thread can also access wind parameters */
 	TArray<UWindDirectionalSourceComponent*> WindComponents_GameThread;
 
+	/**
+	 * Most recent software occlusion buffer of each view by view key, read from other threads through IsBoxSoftwareOccluded.
+	 * The view state's FSceneSoftwareOcclusion owns the buffers, so the entries of destroyed view states expire.
+	 */
+	mutable TMap<uint32, TWeakPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe>> SoftwareOcclusionResults;
+	mutable FCriticalSection SoftwareOcclusionResultsCS;
+
 	/** SpeedTree wind objects in the scene. FLocalVertexFactoryShaderParametersBase needs to lookup by FVertexFactory, but wind objects are per tree (i.e. per UStaticMesh)*/
 	TMap<const UStaticMesh*, struct FSpeedTreeWindComputation*> SpeedTreeWindComputationMap;
 	TMap<FVertexFactory*, const UStaticMesh*> SpeedTreeVertexFactoryMap;
@@ -2960,6 +3072,10 @@ public:
 	virtual const TArray<FWindSourceSceneProxy*>& GetWindSources_RenderThread() const override;
 	virtual void GetWindParameters(const FVector& Position, FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const override;
 	virtual void GetWindParameters_GameThread(const FVector& Position, FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const override;
+	virtual bool IsBoxSoftwareOccluded(const FBox& Box, uint32 ViewKey) const override;
+
+	/** Publishes the latest completed software occlusion buffer of a view for IsBoxSoftwareOccluded. */
+	void SetSoftwareOcclusionResults(uint32 ViewKey, const TSharedPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe>& Results) const;
 	virtual void GetDirectionalWindParameters(FVector& OutDirection, float& OutSpeed, float& OutMinGustAmt, float& OutMaxGustAmt) const override;
 	virtual void AddSpeedTreeWind(FVertexFactory* VertexFactory, const UStaticMesh* StaticMesh) override;
 	virtual void RemoveSpeedTreeWind_RenderThread(FVertexFactory* VertexFactory, const UStaticMesh* StaticMesh) override;
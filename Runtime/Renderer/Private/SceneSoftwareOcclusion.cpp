@@ -5,6 +5,7 @@
 =============================================================================*/
 
 #include "SceneSoftwareOcclusion.h"
+#include "RendererModule.h"
 #include "EngineGlobals.h"
 #include "SceneRendering.h"
 #include "DynamicPrimitiveDrawing.h"
@@ -12,7 +13,11 @@
 #include "RenderTargetTemp.h"
 #include "CanvasTypes.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Async/ParallelFor.h"
 #include "Math/Vector.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
 
 DECLARE_STATS_GROUP(TEXT("Software Occlusion"),STATGROUP_SoftwareOcclusion, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("(RT) Gather Time"),STAT_SoftwareOcclusionGather,STATGROUP_SoftwareOcclusion);
@@ -61,6 +66,14 @@ static FAutoConsoleVariableRef CVarSOSIMD(
 	ECVF_RenderThreadSafe
 	);
 
+static int32 GSOParallelBins = 1;
+static FAutoConsoleVariableRef CVarSOParallelBins(
+	TEXT("r.so.ParallelBins"),
+	GSOParallelBins,
+	TEXT("Sort and rasterize framebuffer bins in parallel on task workers"),
+	ECVF_RenderThreadSafe
+	);
+
 static int32 GSOVisualizeBuffer = 0;
 static FAutoConsoleVariableRef CVarSOVisualizeBuffer(
 	TEXT("r.so.VisualizeBuffer"),
@@ -90,6 +103,17 @@ namespace EScreenVertexFlags
 struct FFramebufferBin
 {
 	uint64 Data[FRAMEBUFFER_HEIGHT];
+	// Farthest depth of any occluder rasterized into each row, used to answer queries after the frame is complete
+	float RowDepth[FRAMEBUFFER_HEIGHT];
+
+	FFramebufferBin()
+	{
+		FMemory::Memzero(Data);
+		for (float& Depth : RowDepth)
+		{
+			Depth = MAX_flt;
+		}
+	}
 };
 
 struct FScreenPosition
@@ -106,6 +130,7 @@ struct FOcclusionFrameResults
 {
 	FFramebufferBin	Bins[BIN_NUM];
 	TMap<FPrimitiveComponentId, bool> VisibilityMap;
+	FMatrix ViewProj;
 };
 
 struct FOcclusionMeshData
@@ -173,26 +198,27 @@ inline uint64 ComputeBinRowMask(int32 BinMinX, float fX0, float fX1)
 	}
 }
 
-inline void RasterizeHalf(float X0, float X1, float DX0, float DX1, int32 Row0, int32 Row1, uint64* BinData, int32 BinMinX)
+inline void RasterizeHalf(float X0, float X1, float DX0, float DX1, int32 Row0, int32 Row1, float TriDepth, FFramebufferBin& Bin, int32 BinMinX)
 {
 	checkSlow(Row0 <= Row1);
 	checkSlow(Row0 >= 0 && Row1 < FRAMEBUFFER_HEIGHT);
 	
 	for (int32 Row = Row0; Row <= Row1; Row++, X0+=DX0, X1+=DX1)
 	{
-		uint64 FrameBufferMask = BinData[Row];
+		uint64 FrameBufferMask = Bin.Data[Row];
 		if (FrameBufferMask != ~0ull) // whether this row is already fully rasterized
 		{
 			uint64 RowMask = ComputeBinRowMask(BinMinX, X0, X1);
 			if (RowMask)
 			{
-				BinData[Row] = (FrameBufferMask | RowMask);
+				Bin.Data[Row] = (FrameBufferMask | RowMask);
+				Bin.RowDepth[Row] = FMath::Min(Bin.RowDepth[Row], TriDepth);
 			}
 		}
 	}
 }
 
-static void RasterizeOccluderTri(const FScreenTriangle& Tri, uint64* BinData, int32 BinMinX)
+static void RasterizeOccluderTri(const FScreenTriangle& Tri, float TriDepth, FFramebufferBin& Bin, int32 BinMinX)
 {
 	FScreenPosition A = Tri.V[0];
 	FScreenPosition B = Tri.V[1];
@@ -218,7 +244,7 @@ static void RasterizeOccluderTri(const FScreenTriangle& Tri, uint64* BinData, in
 		float X0 = A.X + dX0*(RowS - A.Y);
 		float X1 = A.X + dX1*(RowS - A.Y);
 		ensure(X0 <= X1);
-		RasterizeHalf(X0, X1, dX0, dX1, RowS, RowE, BinData, BinMinX);
+		RasterizeHalf(X0, X1, dX0, dX1, RowS, RowE, TriDepth, Bin, BinMinX);
 		bRasterized|= true;
 		RowS = RowE + 1;
 	}
@@ -236,7 +262,7 @@ static void RasterizeOccluderTri(const FScreenTriangle& Tri, uint64* BinData, in
 			Swap(X0, X1);
 			Swap(dX0, dX1);
 		}
-		RasterizeHalf(X0, X1, dX0, dX1, RowS, RowMax, BinData, BinMinX);
+		RasterizeHalf(X0, X1, dX0, dX1, RowS, RowMax, TriDepth, Bin, BinMinX);
 		bRasterized|= true;
 	}
 
@@ -245,7 +271,7 @@ static void RasterizeOccluderTri(const FScreenTriangle& Tri, uint64* BinData, in
 	{
 		float X0 = FMath::Min3(A.X, B.X, C.X);
 		float X1 = FMath::Max3(A.X, B.X, C.X);
-		RasterizeHalf(X0, X1, 0.0f, 0.0f, RowS, RowS, BinData, BinMinX);
+		RasterizeHalf(X0, X1, 0.0f, 0.0f, RowS, RowS, TriDepth, Bin, BinMinX);
 	}
 }
 
@@ -553,7 +579,11 @@ static bool ProcessOccludeeGeom(const FOcclusionSceneData& SceneData, FOcclusion
 			ST.V[0] = {MinX, MinY};
 			ST.V[1] = {MaxX, MaxY};
 			ST.V[2] = {MinX, MaxY};
-			AddTriangle(ST, Depth, PrimitiveId, 0, FrameData);
+			if (AddTriangle(ST, Depth, PrimitiveId, 0, FrameData))
+			{
+				// Occluded unless a bin finds an uncovered pixel
+				VisibilityMap.FindOrAdd(PrimitiveId);
+			}
 		}
 
 		MinMax+= (RunSize*2);
@@ -565,6 +595,56 @@ static bool ProcessOccludeeGeom(const FOcclusionSceneData& SceneData, FOcclusion
 	return true;
 }
 
+bool FSceneSoftwareOcclusion::IsBoxOccluded(const FOcclusionFrameResults& Results, const FBox& Box)
+{
+	const FMatrix WorldToFB = Results.ViewProj * FramebufferMat;
+	const FVector MinMax[2] = { Box.Min, Box.Max };
+
+	int32 Quad[4];
+	float QuadDepth = 0.f;
+	int32 QuadClipped = 0;
+	ProcessOccludeeGeomScalar(WorldToFB, MinMax, 1, Quad, &QuadDepth, &QuadClipped);
+
+	if (QuadClipped != 0)
+	{
+		// clipped by near plane, visible
+		return false;
+	}
+
+	const int32 MinX = Quad[0];
+	const int32 MinY = Quad[1];
+	const int32 MaxX = Quad[2];
+	const int32 MaxY = Quad[3];
+	if (MinX > MaxX || MinY > MaxY)
+	{
+		// not on screen, hidden from the view the buffer was rendered for
+		return true;
+	}
+
+	const int32 BinMin = FMath::Max(MinX / BIN_WIDTH, 0);
+	const int32 BinMax = FMath::Min(MaxX / BIN_WIDTH, BIN_NUM - 1);
+	for (int32 BinIdx = BinMin; BinIdx <= BinMax; ++BinIdx)
+	{
+		const FFramebufferBin& Bin = Results.Bins[BinIdx];
+		const int32 BinMinX = BinIdx * BIN_WIDTH;
+		const int32 X0 = FMath::Max(MinX - BinMinX, 0);
+		const int32 X1 = FMath::Min(MaxX - BinMinX, BIN_WIDTH - 1);
+		const int32 NumBits = (X1 - X0) + 1;
+		const uint64 RowMask = (NumBits == BIN_WIDTH) ? ~0ull : ((1ull << NumBits) - 1) << X0;
+
+		for (int32 Row = MinY; Row <= MaxY; ++Row)
+		{
+			// Any uncovered pixel, or coverage from an occluder that may be behind the box, keeps it visible
+			if ((~Bin.Data[Row] & RowMask) || Bin.RowDepth[Row] < QuadDepth)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
 static void CollectOccludeeGeom(const FBoxSphereBounds& Bounds, FPrimitiveComponentId PrimitiveId, FOcclusionSceneData& SceneData)
 {
 	const FBox Box = Bounds.GetBox();
@@ -805,6 +885,72 @@ public:
 	FPrimitiveComponentId CurrentPrimitiveId;
 };
 
+#if !UE_BUILD_SHIPPING
+static FArchive& operator<<(FArchive& Ar, FPrimitiveComponentId& PrimId)
+{
+	return Ar << PrimId.PrimIDValue;
+}
+
+static FArchive& operator<<(FArchive& Ar, FOcclusionMeshData& MeshData)
+{
+	if (Ar.IsLoading())
+	{
+		MeshData.VerticesSP = MakeShared<FOccluderVertexArray, ESPMode::ThreadSafe>();
+		MeshData.IndicesSP = MakeShared<FOccluderIndexArray, ESPMode::ThreadSafe>();
+	}
+
+	Ar << MeshData.LocalToWorld;
+	Ar << *MeshData.VerticesSP;
+	Ar << *MeshData.IndicesSP;
+	Ar << MeshData.PrimId;
+	return Ar;
+}
+
+static const uint32 OCCLUSION_CAPTURE_VERSION = 1;
+
+static FArchive& operator<<(FArchive& Ar, FOcclusionSceneData& SceneData)
+{
+	Ar << SceneData.ViewProj;
+	Ar << SceneData.OccludeeBoxMinMax;
+	Ar << SceneData.OccludeeBoxPrimId;
+	Ar << SceneData.OccluderData;
+	Ar << SceneData.NumOccluderTriangles;
+	return Ar;
+}
+
+/** File name the next submitted occlusion scene is written to, set by r.so.Capture. Render thread only. */
+static FString GSOCaptureFilename;
+
+static FAutoConsoleCommand CmdSOCapture(
+	TEXT("r.so.Capture"),
+	TEXT("Writes the occluders and occludees gathered for the next software occlusion frame to a file, for use with r.so.Benchmark.\n")
+	TEXT("Usage: r.so.Capture [Filename]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("SoftwareOcclusion.socap");
+		ENQUEUE_RENDER_COMMAND(SoftwareOcclusionCapture)([Filename](FRHICommandListImmediate&)
+		{
+			GSOCaptureFilename = Filename;
+		});
+	}));
+
+static void WriteOcclusionCapture(FOcclusionSceneData& SceneData, const FString& Filename)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Ar)
+	{
+		UE_LOG(LogRenderer, Warning, TEXT("Failed to write software occlusion capture '%s'"), *Filename);
+		return;
+	}
+
+	uint32 Version = OCCLUSION_CAPTURE_VERSION;
+	*Ar << Version;
+	*Ar << SceneData;
+	UE_LOG(LogRenderer, Display, TEXT("Wrote software occlusion capture '%s': %d occluders, %d occluder triangles, %d occludees"), 
+		*Filename, SceneData.OccluderData.Num(), SceneData.NumOccluderTriangles, SceneData.OccludeeBoxPrimId.Num());
+}
+#endif // !UE_BUILD_SHIPPING
+
 static void ProcessOcclusionFrame(const FOcclusionSceneData& InSceneData, FOcclusionFrameResults& OutResults)
 {
 	FOcclusionFrameData FrameData;
@@ -822,6 +968,8 @@ static void ProcessOcclusionFrame(const FOcclusionSceneData& InSceneData, FOcclu
 		ProcessOccludeeGeom(InSceneData, FrameData, OutResults.VisibilityMap);
 	}
 
+	OutResults.ViewProj = InSceneData.ViewProj;
+
 	int32 NumRasterizedOccluderTris = 0;
 	int32 NumRasterizedOccludeeTris = 0;
 	{
@@ -830,8 +978,13 @@ static void ProcessOcclusionFrame(const FOcclusionSceneData& InSceneData, FOcclu
 		const uint8* MeshFlags = FrameData.ScreenTrianglesFlags.GetData();
 		const FPrimitiveComponentId* PrimitiveIds = FrameData.ScreenTrianglesPrimID.GetData();
 		const FScreenTriangle* Tris = FrameData.ScreenTriangles.GetData();
-						
-		for (int32 BinIdx = 0; BinIdx < BIN_NUM; ++BinIdx)
+
+		// Bins cover disjoint columns of the framebuffer, so each one is sorted and rasterized independently
+		TArray<FPrimitiveComponentId> VisibleOccludees[BIN_NUM];
+		int32 NumBinOccluderTris[BIN_NUM] = {};
+		int32 NumBinOccludeeTris[BIN_NUM] = {};
+
+		ParallelFor(BIN_NUM, [&](int32 BinIdx)
 		{
 			// Sort triangles in the bin by depth
 			FrameData.SortedTriangles[BinIdx].Sort([](const FSortedIndexDepth& A, const FSortedIndexDepth& B) { 
@@ -849,24 +1002,34 @@ static void ProcessOcclusionFrame(const FOcclusionSceneData& InSceneData, FOcclu
 			{
 				int32 TriID = SortedTriIndices[TriIdx].Index;
 				uint8 Flags = MeshFlags[TriID];
-				FPrimitiveComponentId PrimitiveId = PrimitiveIds[TriID];
 				const FScreenTriangle& Tri = Tris[TriID];
 
 				if (Flags != 0)
 				{
 					// rasterize occluder
-					RasterizeOccluderTri(Tri, Bin.Data, BinMinX);
-					NumRasterizedOccluderTris++;
+					RasterizeOccluderTri(Tri, SortedTriIndices[TriIdx].Depth, Bin, BinMinX);
+					NumBinOccluderTris[BinIdx]++;
 				}
 				else
 				{
 					// rasterize occludee
-					bool& VisBit = OutResults.VisibilityMap.FindOrAdd(PrimitiveId);
-					bool bVisible = RasterizeOccludeeQuad(Tri, Bin.Data, BinMinX);
-					VisBit|= bVisible;
-					NumRasterizedOccludeeTris++;
+					if (RasterizeOccludeeQuad(Tri, Bin.Data, BinMinX))
+					{
+						VisibleOccludees[BinIdx].Add(PrimitiveIds[TriID]);
+					}
+					NumBinOccludeeTris[BinIdx]++;
 				}
 			}
+		}, GSOParallelBins == 0);
+
+		for (int32 BinIdx = 0; BinIdx < BIN_NUM; ++BinIdx)
+		{
+			for (FPrimitiveComponentId PrimitiveId : VisibleOccludees[BinIdx])
+			{
+				OutResults.VisibilityMap.FindOrAdd(PrimitiveId) = true;
+			}
+			NumRasterizedOccluderTris += NumBinOccluderTris[BinIdx];
+			NumRasterizedOccludeeTris += NumBinOccludeeTris[BinIdx];
 		}
 	}
 	
@@ -876,6 +1039,62 @@ static void ProcessOcclusionFrame(const FOcclusionSceneData& InSceneData, FOcclu
 	INC_DWORD_STAT_BY(STAT_SoftwareOccludeeTris, NumRasterizedOccludeeTris);
 }
 
+#if !UE_BUILD_SHIPPING
+static FAutoConsoleCommand CmdSOBenchmark(
+	TEXT("r.so.Benchmark"),
+	TEXT("Runs the CPU software occlusion pipeline over a scene written by r.so.Capture and logs timings. Does not touch the RHI.\n")
+	TEXT("Usage: r.so.Benchmark [Filename] [Iterations]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		const FString Filename = Args.Num() > 0 ? Args[0] : FPaths::ProjectSavedDir() / TEXT("SoftwareOcclusion.socap");
+		const int32 NumIterations = Args.Num() > 1 ? FMath::Max(1, FCString::Atoi(*Args[1])) : 100;
+
+		TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Filename));
+		if (!Ar)
+		{
+			UE_LOG(LogRenderer, Warning, TEXT("Failed to open software occlusion capture '%s'"), *Filename);
+			return;
+		}
+
+		uint32 Version = 0;
+		*Ar << Version;
+		if (Version != OCCLUSION_CAPTURE_VERSION)
+		{
+			UE_LOG(LogRenderer, Warning, TEXT("Software occlusion capture '%s' has version %u, expected %u"), *Filename, Version, OCCLUSION_CAPTURE_VERSION);
+			return;
+		}
+
+		FOcclusionSceneData SceneData;
+		*Ar << SceneData;
+
+		double MinTime = MAX_dbl;
+		double MaxTime = 0.0;
+		double TotalTime = 0.0;
+		int32 NumOccluded = 0;
+		for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+		{
+			TUniquePtr<FOcclusionFrameResults> Results = MakeUnique<FOcclusionFrameResults>();
+			const double StartTime = FPlatformTime::Seconds();
+			ProcessOcclusionFrame(SceneData, *Results);
+			const double Time = FPlatformTime::Seconds() - StartTime;
+
+			MinTime = FMath::Min(MinTime, Time);
+			MaxTime = FMath::Max(MaxTime, Time);
+			TotalTime += Time;
+
+			NumOccluded = 0;
+			for (const TPair<FPrimitiveComponentId, bool>& Pair : Results->VisibilityMap)
+			{
+				NumOccluded += Pair.Value ? 0 : 1;
+			}
+		}
+
+		UE_LOG(LogRenderer, Display, TEXT("Software occlusion benchmark '%s': %d iterations, %d occluder triangles, %d occludees (%d occluded), min %.3fms avg %.3fms max %.3fms"),
+			*Filename, NumIterations, SceneData.NumOccluderTriangles, SceneData.OccludeeBoxPrimId.Num(), NumOccluded,
+			MinTime * 1000.0, TotalTime * 1000.0 / NumIterations, MaxTime * 1000.0);
+	}));
+#endif // !UE_BUILD_SHIPPING
+
 FSceneSoftwareOcclusion::FSceneSoftwareOcclusion()
 {
 }
@@ -1068,6 +1287,14 @@ static FGraphEventRef SubmitScene(const FScene* Scene, FViewInfo& View, FOcclusi
 	
 	// reserve space for occludees vis flags 
 	Results->VisibilityMap.Reserve(NumCollectedOccludees);
+
+#if !UE_BUILD_SHIPPING
+	if (!GSOCaptureFilename.IsEmpty())
+	{
+		WriteOcclusionCapture(*SceneData, GSOCaptureFilename);
+		GSOCaptureFilename.Empty();
+	}
+#endif
 	
 	// Submit occlusion task
 	FOcclusionSceneData* SceneDataParam = SceneData.Release();
@@ -1087,7 +1314,7 @@ int32 FSceneSoftwareOcclusion::Process(FRHICommandListImmediate& RHICmdList, con
 	Available = MoveTemp(Processing);
 
 	// Submit occlusion scene for next frame
-	Processing = MakeUnique<FOcclusionFrameResults>();
+	Processing = MakeShared<FOcclusionFrameResults, ESPMode::ThreadSafe>();
 	TaskRef = SubmitScene(Scene, View, Processing.Get());
 
 	// Apply available occlusion results
@@ -1095,6 +1322,7 @@ int32 FSceneSoftwareOcclusion::Process(FRHICommandListImmediate& RHICmdList, con
 	if (Available.IsValid())
 	{
 		NumCulled = ApplyResults(Scene, View, *Available);
+		Scene->SetSoftwareOcclusionResults(View.ViewState->GetViewKey(), Available);
 	}
 	
 	return NumCulled;
@@ -1122,8 +1350,8 @@ void FSceneSoftwareOcclusion::DebugDraw(FRDGBuilder& GraphBuilder, const FViewIn
 		return;
 	}
 
-	FOcclusionFrameResults* Results = Available.Get();
-	if (Results == nullptr)
+	TSharedPtr<const FOcclusionFrameResults, ESPMode::ThreadSafe> Results = Available;
+	if (!Results.IsValid())
 	{
 		return;
 	}
@@ -11,6 +11,9 @@ class FScene;
 class FViewInfo;
 struct FOcclusionFrameResults;
 
+/** Whether scenes rendered at the given feature level should rasterize occluders on the CPU instead of issuing hardware occlusion queries. */
+bool ShouldUseSoftwareOcclusion(ERHIFeatureLevel::Type InFeatureLevel);
+
 class FSceneSoftwareOcclusion
 {
 public:
@@ -21,8 +24,11 @@ public:
 	void FlushResults();
 	void DebugDraw(FRDGBuilder& GraphBuilder, const FViewInfo& View, FScreenPassRenderTarget Output, int32 InX, int32 InY);
 
+	/** Tests a world space box against a completed occlusion buffer. Returns true only if the box is definitely hidden. */
+	static bool IsBoxOccluded(const FOcclusionFrameResults& Results, const FBox& Box);
+
 private:
 	FGraphEventRef TaskRef;
-	TUniquePtr<FOcclusionFrameResults> Available;
-	TUniquePtr<FOcclusionFrameResults> Processing;
-};
\ No newline at end of file
+	TSharedPtr<FOcclusionFrameResults, ESPMode::ThreadSafe> Available;
+	TSharedPtr<FOcclusionFrameResults, ESPMode::ThreadSafe> Processing;
+};
@@ -483,6 +483,165 @@ static FAutoConsoleVariableRef CVarFrustumCullNumWordsPerTask(
 	ECVF_Default
 	);
 
+static int32 GFrustumCullUseSoA = 1;
+static FAutoConsoleVariableRef CVarFrustumCullUseSoA(
+	TEXT("r.FrustumCullUseSoA"),
+	GFrustumCullUseSoA,
+	TEXT("Whether frustum culling uses the structure-of-arrays bounds and the vectorized kernel that tests 8 primitives per iteration.\n")
+	TEXT("The scalar path is still used when custom culling, HLOD overrides or the DistanceCulledPrimitives show flag are active."),
+	ECVF_RenderThreadSafe
+	);
+
+/** Plane of the view frustum with each component replicated across a vector register. */
+struct FFrustumCullSplatPlane
+{
+	VectorRegister X;
+	VectorRegister Y;
+	VectorRegister Z;
+	VectorRegister W;
+	VectorRegister AbsX;
+	VectorRegister AbsY;
+	VectorRegister AbsZ;
+};
+
+/** Per view constants shared by every iteration of the vectorized culling kernel. */
+struct FFrustumCullSoAContext
+{
+	TArray<FFrustumCullSplatPlane, TInlineAllocator<8>> Planes;
+	VectorRegister ViewOriginX;
+	VectorRegister ViewOriginY;
+	VectorRegister ViewOriginZ;
+	VectorRegister MaxDrawDistanceScale;
+	VectorRegister FadeRadius;
+	VectorRegister FloatMax;
+
+	FFrustumCullSoAContext(const FConvexVolume& Frustum, const FVector& ViewOrigin, float InMaxDrawDistanceScale, float InFadeRadius)
+	{
+		Planes.Reserve(Frustum.Planes.Num());
+		for (const FPlane& Plane : Frustum.Planes)
+		{
+			FFrustumCullSplatPlane& SplatPlane = Planes.AddDefaulted_GetRef();
+			SplatPlane.X = VectorSetFloat1(Plane.X);
+			SplatPlane.Y = VectorSetFloat1(Plane.Y);
+			SplatPlane.Z = VectorSetFloat1(Plane.Z);
+			SplatPlane.W = VectorSetFloat1(Plane.W);
+			SplatPlane.AbsX = VectorAbs(SplatPlane.X);
+			SplatPlane.AbsY = VectorAbs(SplatPlane.Y);
+			SplatPlane.AbsZ = VectorAbs(SplatPlane.Z);
+		}
+
+		ViewOriginX = VectorSetFloat1(ViewOrigin.X);
+		ViewOriginY = VectorSetFloat1(ViewOrigin.Y);
+		ViewOriginZ = VectorSetFloat1(ViewOrigin.Z);
+		MaxDrawDistanceScale = VectorSetFloat1(InMaxDrawDistanceScale);
+		FadeRadius = VectorSetFloat1(InFadeRadius);
+		FloatMax = VectorSetFloat1(FLT_MAX);
+	}
+};
+
+/** Per primitive culling results for one word of the visibility map, one bit per primitive. */
+struct FFrustumCullWordMasks
+{
+	/** Bounds pass the frustum box test, and the sphere test if enabled. */
+	uint32 InFrustum = 0;
+	/** Closer than the min draw distance or beyond the max draw distance plus fade radius. */
+	uint32 DistanceCulled = 0;
+	/** Beyond the max draw distance. */
+	uint32 BeyondMaxDraw = 0;
+	/** Beyond the max draw distance minus the fade radius. */
+	uint32 InFadeRange = 0;
+};
+
+/**
+ * Tests four consecutive primitives of the SoA bounds, returning the results as 4 bit masks.
+ * Mirrors the scalar math of FrustumCull(), IntersectBox8Plane() and FConvexVolume::IntersectSphere().
+ */
+template<bool bAlsoUseSphereTest>
+FORCEINLINE void FrustumCullLanes4(const FPrimitiveBoundsSoA& RESTRICT Bounds, int32 Index, const FFrustumCullSoAContext& RESTRICT Context,
+	uint32& OutInFrustum, uint32& OutDistanceCulled, uint32& OutBeyondMaxDraw, uint32& OutInFadeRange)
+{
+	const VectorRegister OriginX = VectorLoadAligned(Bounds.OriginX.GetData() + Index);
+	const VectorRegister OriginY = VectorLoadAligned(Bounds.OriginY.GetData() + Index);
+	const VectorRegister OriginZ = VectorLoadAligned(Bounds.OriginZ.GetData() + Index);
+	const VectorRegister ExtentX = VectorLoadAligned(Bounds.ExtentX.GetData() + Index);
+	const VectorRegister ExtentY = VectorLoadAligned(Bounds.ExtentY.GetData() + Index);
+	const VectorRegister ExtentZ = VectorLoadAligned(Bounds.ExtentZ.GetData() + Index);
+
+	// Distance culling
+	const VectorRegister DeltaX = VectorSubtract(OriginX, Context.ViewOriginX);
+	const VectorRegister DeltaY = VectorSubtract(OriginY, Context.ViewOriginY);
+	const VectorRegister DeltaZ = VectorSubtract(OriginZ, Context.ViewOriginZ);
+	const VectorRegister DistanceSquared = VectorMultiplyAdd(DeltaZ, DeltaZ, VectorMultiplyAdd(DeltaY, DeltaY, VectorMultiply(DeltaX, DeltaX)));
+
+	// Preserve infinite draw distance
+	const VectorRegister MaxCullDistance = VectorLoadAligned(Bounds.MaxCullDistance.GetData() + Index);
+	const VectorRegister MaxDrawDistance = VectorSelect(VectorCompareLT(MaxCullDistance, Context.FloatMax), VectorMultiply(MaxCullDistance, Context.MaxDrawDistanceScale), Context.FloatMax);
+	const VectorRegister MinDrawDistanceSq = VectorLoadAligned(Bounds.MinDrawDistanceSq.GetData() + Index);
+
+	const VectorRegister FarDistance = VectorAdd(MaxDrawDistance, Context.FadeRadius);
+	const VectorRegister NearFadeDistance = VectorSubtract(MaxDrawDistance, Context.FadeRadius);
+
+	const VectorRegister DistanceCulled = VectorBitwiseOr(
+		VectorCompareGT(DistanceSquared, VectorMultiply(FarDistance, FarDistance)),
+		VectorCompareLT(DistanceSquared, MinDrawDistanceSq));
+	const VectorRegister BeyondMaxDraw = VectorCompareGT(DistanceSquared, VectorMultiply(MaxDrawDistance, MaxDrawDistance));
+	const VectorRegister InFadeRange = VectorCompareGT(DistanceSquared, VectorMultiply(NearFadeDistance, NearFadeDistance));
+
+	// Frustum culling, a lane is outside as soon as it is fully in front of any plane
+	VectorRegister Outside = VectorZero();
+	VectorRegister SphereRadius = VectorZero();
+	if (bAlsoUseSphereTest)
+	{
+		SphereRadius = VectorLoadAligned(Bounds.SphereRadius.GetData() + Index);
+	}
+
+	for (const FFrustumCullSplatPlane& Plane : Context.Planes)
+	{
+		const VectorRegister Distance = VectorSubtract(VectorMultiplyAdd(OriginZ, Plane.Z, VectorMultiplyAdd(OriginY, Plane.Y, VectorMultiply(OriginX, Plane.X))), Plane.W);
+		const VectorRegister PushOut = VectorMultiplyAdd(ExtentZ, Plane.AbsZ, VectorMultiplyAdd(ExtentY, Plane.AbsY, VectorMultiply(ExtentX, Plane.AbsX)));
+		Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, PushOut));
+		if (bAlsoUseSphereTest)
+		{
+			Outside = VectorBitwiseOr(Outside, VectorCompareGT(Distance, SphereRadius));
+		}
+	}
+
+	OutInFrustum = ~(uint32)VectorMaskBits(Outside) & 0xF;
+	OutDistanceCulled = (uint32)VectorMaskBits(DistanceCulled);
+	OutBeyondMaxDraw = (uint32)VectorMaskBits(BeyondMaxDraw);
+	OutInFadeRange = (uint32)VectorMaskBits(InFadeRange);
+}
+
+/**
+ * Vectorized culling kernel, tests the 32 primitives of one visibility map word 8 at a time.
+ * Lanes past the end of the scene are padding and must be masked out by the caller.
+ */
+template<bool bAlsoUseSphereTest>
+static FORCEINLINE FFrustumCullWordMasks FrustumCullWordSoA(const FPrimitiveBoundsSoA& RESTRICT Bounds, int32 WordIndex, const FFrustumCullSoAContext& RESTRICT Context)
+{
+	static_assert(NumBitsPerDWORD % FPrimitiveBoundsSoA::LaneCount == 0, "Visibility map words must hold a whole number of kernel iterations");
+
+	FFrustumCullWordMasks Masks;
+	const int32 FirstIndex = WordIndex * NumBitsPerDWORD;
+	const int32 EndIndex = FMath::Min<int32>(FirstIndex + NumBitsPerDWORD, Align(Bounds.Num(), FPrimitiveBoundsSoA::LaneCount));
+
+	for (int32 Index = FirstIndex; Index < EndIndex; Index += FPrimitiveBoundsSoA::LaneCount)
+	{
+		uint32 InFrustum_0, DistanceCulled_0, BeyondMaxDraw_0, InFadeRange_0;
+		uint32 InFrustum_1, DistanceCulled_1, BeyondMaxDraw_1, InFadeRange_1;
+		FrustumCullLanes4<bAlsoUseSphereTest>(Bounds, Index, Context, InFrustum_0, DistanceCulled_0, BeyondMaxDraw_0, InFadeRange_0);
+		FrustumCullLanes4<bAlsoUseSphereTest>(Bounds, Index + 4, Context, InFrustum_1, DistanceCulled_1, BeyondMaxDraw_1, InFadeRange_1);
+
+		const uint32 Shift = Index - FirstIndex;
+		Masks.InFrustum |= (InFrustum_0 | (InFrustum_1 << 4)) << Shift;
+		Masks.DistanceCulled |= (DistanceCulled_0 | (DistanceCulled_1 << 4)) << Shift;
+		Masks.BeyondMaxDraw |= (BeyondMaxDraw_0 | (BeyondMaxDraw_1 << 4)) << Shift;
+		Masks.InFadeRange |= (InFadeRange_0 | (InFadeRange_1 << 4)) << Shift;
+	}
+
+	return Masks;
+}
+
 
 template<bool UseCustomCulling, bool bAlsoUseSphereTest, bool bUseFastIntersect>
 static int32 FrustumCull(const FScene* RESTRICT Scene, FViewInfo& View)
@@ -506,8 +665,17 @@ static int32 FrustumCull(const FScene* RESTRICT Scene, FViewInfo& View)
 	const int32 BitArrayWords = FMath::DivideAndRoundUp(View.PrimitiveVisibilityMap.Num(), (int32)NumBitsPerDWORD);
 	const int32 NumTasks = FMath::DivideAndRoundUp(BitArrayWords, FrustumCullNumWordsPerTask);
 
+	// The vectorized kernel has no notion of per primitive draw distance overrides, those fall back to the scalar loop
+	const bool bUseSoAKernel = GFrustumCullUseSoA
+		&& !UseCustomCulling
+		&& !HLODState
+		&& !View.Family->EngineShowFlags.DistanceCulledPrimitives
+		&& Scene->PrimitiveBoundsSoA.Num() == BitArrayNum;
+
+	const FFrustumCullSoAContext SoAContext(View.ViewFrustum, View.ViewMatrices.GetViewOrigin(), MaxDrawDistanceScale, GDisableLODFade ? 0.0f : GDistanceFadeMaxTravel);
+
 	ParallelFor(NumTasks, 
-		[&NumCulledPrimitives, Scene, &View, MaxDrawDistanceScale, HLODState](int32 TaskIndex)
+		[&NumCulledPrimitives, Scene, &View, MaxDrawDistanceScale, HLODState, bUseSoAKernel, &SoAContext](int32 TaskIndex)
 		{
 			QUICK_SCOPE_CYCLE_COUNTER(STAT_FrustumCull_Loop);
 			const FPlane* PermutedPlanePtr = View.ViewFrustum.PermutedPlanes.GetData();
@@ -527,91 +695,122 @@ static int32 FrustumCull(const FScene* RESTRICT Scene, FViewInfo& View)
 				uint32 VisBits = 0;
 				uint32 FadingBits = 0;
 				uint32 DistanceCulledBits = 0;
-				for (int32 BitSubIndex = 0; BitSubIndex < NumBitsPerDWORD && WordIndex * NumBitsPerDWORD + BitSubIndex < BitArrayNumInner; BitSubIndex++, Mask <<= 1)
+
+				if (bUseSoAKernel)
 				{
-					int32 Index = WordIndex * NumBitsPerDWORD + BitSubIndex;
+					const int32 NumValidBits = FMath::Min<int32>(NumBitsPerDWORD, BitArrayNumInner - WordIndex * NumBitsPerDWORD);
+					const uint32 ValidMask = NumValidBits == NumBitsPerDWORD ? ~0u : ((1u << NumValidBits) - 1);
+					const FFrustumCullWordMasks Masks = FrustumCullWordSoA<bAlsoUseSphereTest>(Scene->PrimitiveBoundsSoA, WordIndex, SoAContext);
 
-					FPrimitiveSceneProxy* RESTRICT Proxy = Scene->Primitives[Index]->Proxy;
-					const bool bUsingDistanceCullFade = Proxy->IsUsingDistanceCullFade();
+					// Same decisions as the scalar loop below, resolved for the whole word at once
+					const uint32 AlwaysVisibleBits = Scene->PrimitivesAlwaysVisible.GetData()[WordIndex] & ValidMask;
+					const uint32 SurvivingBits = Masks.InFrustum & ~Masks.DistanceCulled & ~AlwaysVisibleBits & ValidMask;
 
-					const FPrimitiveBounds& RESTRICT Bounds = Scene->PrimitiveBounds[Index];
-					float DistanceSquared = (Bounds.BoxSphereBounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
-					int32 VisibilityId = INDEX_NONE;
+					VisBits = AlwaysVisibleBits | (SurvivingBits & ~Masks.BeyondMaxDraw);
+					DistanceCulledBits = Masks.DistanceCulled & ValidMask;
+					STAT(NumPrimitivesCulledForTask += FMath::CountBits(ValidMask & ~AlwaysVisibleBits & ~SurvivingBits));
 
-					if (UseCustomCulling &&
-						((Scene->PrimitiveOcclusionFlags[Index] & CustomVisibilityFlags) == CustomVisibilityFlags))
+					// Only primitives inside the fade band need their proxy inspected
+					uint32 FadeCandidateBits = (AlwaysVisibleBits & Masks.InFadeRange) | (SurvivingBits & (Masks.BeyondMaxDraw | Masks.InFadeRange));
+					while (FadeCandidateBits)
 					{
-						VisibilityId = Scene->PrimitiveVisibilityIds[Index].ByteIndex;
+						const uint32 BitSubIndex = FMath::CountTrailingZeros(FadeCandidateBits);
+						FadeCandidateBits &= FadeCandidateBits - 1;
+
+						if (Scene->Primitives[WordIndex * NumBitsPerDWORD + BitSubIndex]->Proxy->IsUsingDistanceCullFade())
+						{
+							FadingBits |= 1u << BitSubIndex;
+						}
 					}
+				}
+				else
+				{
+					for (int32 BitSubIndex = 0; BitSubIndex < NumBitsPerDWORD && WordIndex * NumBitsPerDWORD + BitSubIndex < BitArrayNumInner; BitSubIndex++, Mask <<= 1)
+					{
+						int32 Index = WordIndex * NumBitsPerDWORD + BitSubIndex;
 
-					// Preserve infinite draw distance
-					float MaxDrawDistance = Bounds.MaxCullDistance < FLT_MAX ? Bounds.MaxCullDistance * MaxDrawDistanceScale : FLT_MAX; 
-					float MinDrawDistanceSq = Bounds.MinDrawDistanceSq;
+						FPrimitiveSceneProxy* RESTRICT Proxy = Scene->Primitives[Index]->Proxy;
+						const bool bUsingDistanceCullFade = Proxy->IsUsingDistanceCullFade();
 
-					// If cull distance is disabled, always show the primitive (except foliage)
-					if (View.Family->EngineShowFlags.DistanceCulledPrimitives && !Proxy->IsDetailMesh())
-					{
-						MaxDrawDistance = FLT_MAX;
-					}
+						const FPrimitiveBounds& RESTRICT Bounds = Scene->PrimitiveBounds[Index];
+						float DistanceSquared = (Bounds.BoxSphereBounds.Origin - ViewOriginForDistanceCulling).SizeSquared();
+						int32 VisibilityId = INDEX_NONE;
 
-					// Fading HLODs and their children must be visible, objects hidden by HLODs can be culled
-					if (HLODState)
-					{
-						if (HLODState->IsNodeForcedVisible(Index))
+						if (UseCustomCulling &&
+							((Scene->PrimitiveOcclusionFlags[Index] & CustomVisibilityFlags) == CustomVisibilityFlags))
 						{
-							MaxDrawDistance = FLT_MAX;
-							MinDrawDistanceSq = 0.f;
+							VisibilityId = Scene->PrimitiveVisibilityIds[Index].ByteIndex;
 						}
-						else if (HLODState->IsNodeForcedHidden(Index))
+
+						// Preserve infinite draw distance
+						float MaxDrawDistance = Bounds.MaxCullDistance < FLT_MAX ? Bounds.MaxCullDistance * MaxDrawDistanceScale : FLT_MAX; 
+						float MinDrawDistanceSq = Bounds.MinDrawDistanceSq;
+
+						// If cull distance is disabled, always show the primitive (except foliage)
+						if (View.Family->EngineShowFlags.DistanceCulledPrimitives && !Proxy->IsDetailMesh())
 						{
-							MaxDrawDistance = 0.f;
+							MaxDrawDistance = FLT_MAX;
 						}
-					}
 
-					const bool bDistanceCulled = DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) || (DistanceSquared < MinDrawDistanceSq);
+						// Fading HLODs and their children must be visible, objects hidden by HLODs can be culled
+						if (HLODState)
+						{
+							if (HLODState->IsNodeForcedVisible(Index))
+							{
+								MaxDrawDistance = FLT_MAX;
+								MinDrawDistanceSq = 0.f;
+							}
+							else if (HLODState->IsNodeForcedHidden(Index))
+							{
+								MaxDrawDistance = 0.f;
+							}
+						}
 
-					// Store distane culled primitives so it can correctly culled when collecting RT primitives
-					if (bDistanceCulled)
-					{
-						DistanceCulledBits |= Mask;
-					}
+						const bool bDistanceCulled = DistanceSquared > FMath::Square(MaxDrawDistance + FadeRadius) || (DistanceSquared < MinDrawDistanceSq);
 
-					// Handle primitives that are always visible.
-					if (Scene->PrimitivesAlwaysVisible[Index])
-					{
-						VisBits |= Mask;
-						if (bUsingDistanceCullFade && DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+						// Store distane culled primitives so it can correctly culled when collecting RT primitives
+						if (bDistanceCulled)
 						{
-							FadingBits |= Mask;
+							DistanceCulledBits |= Mask;
 						}
-					}
-					else if (bDistanceCulled ||
-						(UseCustomCulling && !View.CustomVisibilityQuery->IsVisible(VisibilityId, FBoxSphereBounds(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent, Bounds.BoxSphereBounds.SphereRadius))) ||
-						(bAlsoUseSphereTest && View.ViewFrustum.IntersectSphere(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.SphereRadius) == false) ||
-						(bUseFastIntersect ? IntersectBox8Plane(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent, PermutedPlanePtr) : View.ViewFrustum.IntersectBox(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent)) == false)
-					{
-						STAT(++NumPrimitivesCulledForTask);
-					}
-					else
-					{
-						if (DistanceSquared > FMath::Square(MaxDrawDistance))
+
+						// Handle primitives that are always visible.
+						if (Scene->PrimitivesAlwaysVisible[Index])
 						{
-							if (Scene->Primitives[Index]->Proxy->IsUsingDistanceCullFade())
+							VisBits |= Mask;
+							if (bUsingDistanceCullFade && DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
 							{
 								FadingBits |= Mask;
 							}
 						}
+						else if (bDistanceCulled ||
+							(UseCustomCulling && !View.CustomVisibilityQuery->IsVisible(VisibilityId, FBoxSphereBounds(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent, Bounds.BoxSphereBounds.SphereRadius))) ||
+							(bAlsoUseSphereTest && View.ViewFrustum.IntersectSphere(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.SphereRadius) == false) ||
+							(bUseFastIntersect ? IntersectBox8Plane(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent, PermutedPlanePtr) : View.ViewFrustum.IntersectBox(Bounds.BoxSphereBounds.Origin, Bounds.BoxSphereBounds.BoxExtent)) == false)
+						{
+							STAT(++NumPrimitivesCulledForTask);
+						}
 						else
 						{
-							// The primitive is visible!
-							VisBits |= Mask;
-							if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+							if (DistanceSquared > FMath::Square(MaxDrawDistance))
 							{
 								if (Scene->Primitives[Index]->Proxy->IsUsingDistanceCullFade())
 								{
 									FadingBits |= Mask;
 								}
 							}
+							else
+							{
+								// The primitive is visible!
+								VisBits |= Mask;
+								if (DistanceSquared > FMath::Square(MaxDrawDistance - FadeRadius))
+								{
+									if (Scene->Primitives[Index]->Proxy->IsUsingDistanceCullFade())
+									{
+										FadingBits |= Mask;
+									}
+								}
+							}
 						}
 					}
 				}
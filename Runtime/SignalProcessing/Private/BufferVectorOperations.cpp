@@ -4,8 +4,145 @@
 
 #define AUDIO_USE_SIMD 1
 
+// On x86 the mixing kernels process 8 samples per iteration with AVX and fall back to 4-wide vector operations for
+// the tail. Unless the target always has AVX, the AVX kernels are compiled for AVX on their own and only called once
+// cpuid reports that the CPU and OS support it. Buffers are only guaranteed to be 16 byte aligned, so unaligned loads
+// are used.
+#if AUDIO_USE_SIMD && PLATFORM_ALWAYS_HAS_AVX
+	#define AUDIO_USE_AVX 1
+	#define AUDIO_AVX_TARGET
+#elif AUDIO_USE_SIMD && PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY && PLATFORM_HAS_CPUID && (PLATFORM_WINDOWS || PLATFORM_LINUX || PLATFORM_MAC)
+	#define AUDIO_USE_AVX 1
+	#if defined(__clang__) || defined(__GNUC__)
+		#define AUDIO_AVX_TARGET __attribute__((target("avx")))
+	#else
+		// MSVC compiles AVX intrinsics without /arch:AVX
+		#define AUDIO_AVX_TARGET
+	#endif
+#else
+	#define AUDIO_USE_AVX 0
+#endif
+
+#if AUDIO_USE_AVX
+	#include <immintrin.h>
+	#if !PLATFORM_ALWAYS_HAS_AVX
+		#if defined(_MSC_VER)
+			#include <intrin.h>
+		#else
+			#include <cpuid.h>
+		#endif
+	#endif
+#endif
+
 namespace Audio
 {
+#if AUDIO_USE_AVX
+#if !PLATFORM_ALWAYS_HAS_AVX
+	static bool CPUSupportsAVX()
+	{
+		// CPUID.(EAX=01H):ECX.OSXSAVE[bit 27] and ECX.AVX[bit 28]
+		const uint32 OSXSAVE_AVX_BITS = (1u << 27) | (1u << 28);
+#if defined(_MSC_VER)
+		int CPUInfo[4];
+		__cpuid(CPUInfo, 1);
+		if (((uint32)CPUInfo[2] & OSXSAVE_AVX_BITS) != OSXSAVE_AVX_BITS)
+		{
+			return false;
+		}
+
+		// OS must save YMM registers between context switch
+		return (_xgetbv(0) & 6) == 6;
+#else
+		uint32 EAX, EBX, ECX, EDX;
+		if (!__get_cpuid(1, &EAX, &EBX, &ECX, &EDX) || (ECX & OSXSAVE_AVX_BITS) != OSXSAVE_AVX_BITS)
+		{
+			return false;
+		}
+
+		// OS must save YMM registers between context switch
+		uint32 XCR0Low, XCR0High;
+		__asm__ volatile("xgetbv" : "=a"(XCR0Low), "=d"(XCR0High) : "c"(0));
+		return (XCR0Low & 6) == 6;
+#endif
+	}
+#endif
+
+	/** Whether the AVX kernels below can run, checked once. */
+	static bool UseAVXKernels()
+	{
+#if PLATFORM_ALWAYS_HAS_AVX
+		return true;
+#else
+		static const bool bSupportsAVX = CPUSupportsAVX();
+		return bSupportsAVX;
+#endif
+	}
+
+	// The AVX kernels process whole groups of 8 samples and return how many samples they processed. The ramps step the
+	// gain once per 4 samples, like the 4-wide loops they stand in for, so the upper half of a register is one step
+	// ahead of the lower half.
+
+	AUDIO_AVX_TARGET static int32 MultiplyBufferByConstantAVX(const float* InBuffer, float* OutBuffer, int32 NumSamples, float Value)
+	{
+		const __m256 Value8 = _mm256_set1_ps(Value);
+		int32 Index = 0;
+		for (; Index + 8 <= NumSamples; Index += 8)
+		{
+			_mm256_storeu_ps(&OutBuffer[Index], _mm256_mul_ps(_mm256_loadu_ps(&InBuffer[Index]), Value8));
+		}
+		return Index;
+	}
+
+	AUDIO_AVX_TARGET static int32 MultiplyBufferByRampAVX(float* InOutBuffer, int32 NumSamples, float StartValue, float DeltaValue)
+	{
+		__m256 Gain8 = _mm256_setr_ps(StartValue, StartValue, StartValue, StartValue, StartValue + DeltaValue, StartValue + DeltaValue, StartValue + DeltaValue, StartValue + DeltaValue);
+		const __m256 Delta8 = _mm256_set1_ps(2.0f * DeltaValue);
+		int32 Index = 0;
+		for (; Index + 8 <= NumSamples; Index += 8)
+		{
+			_mm256_storeu_ps(&InOutBuffer[Index], _mm256_mul_ps(_mm256_loadu_ps(&InOutBuffer[Index]), Gain8));
+			Gain8 = _mm256_add_ps(Gain8, Delta8);
+		}
+		return Index;
+	}
+
+	AUDIO_AVX_TARGET static int32 MixInBufferAVX(const float* RESTRICT InBuffer, float* RESTRICT BufferToSumTo, int32 NumSamples, float Gain)
+	{
+		const __m256 Gain8 = _mm256_set1_ps(Gain);
+		int32 Index = 0;
+		for (; Index + 8 <= NumSamples; Index += 8)
+		{
+			const __m256 Input = _mm256_mul_ps(_mm256_loadu_ps(&InBuffer[Index]), Gain8);
+			_mm256_storeu_ps(&BufferToSumTo[Index], _mm256_add_ps(_mm256_loadu_ps(&BufferToSumTo[Index]), Input));
+		}
+		return Index;
+	}
+
+	AUDIO_AVX_TARGET static int32 MixInBufferRampAVX(const float* RESTRICT InBuffer, float* RESTRICT BufferToSumTo, int32 NumSamples, float StartGain, float DeltaGain)
+	{
+		__m256 Gain8 = _mm256_setr_ps(StartGain, StartGain, StartGain, StartGain, StartGain + DeltaGain, StartGain + DeltaGain, StartGain + DeltaGain, StartGain + DeltaGain);
+		const __m256 Delta8 = _mm256_set1_ps(2.0f * DeltaGain);
+		int32 Index = 0;
+		for (; Index + 8 <= NumSamples; Index += 8)
+		{
+			const __m256 Input = _mm256_mul_ps(_mm256_loadu_ps(&InBuffer[Index]), Gain8);
+			_mm256_storeu_ps(&BufferToSumTo[Index], _mm256_add_ps(_mm256_loadu_ps(&BufferToSumTo[Index]), Input));
+			Gain8 = _mm256_add_ps(Gain8, Delta8);
+		}
+		return Index;
+	}
+
+	AUDIO_AVX_TARGET static int32 SumBuffersAVX(const float* InBuffer1, const float* InBuffer2, float* OutBuffer, int32 NumSamples)
+	{
+		int32 Index = 0;
+		for (; Index + 8 <= NumSamples; Index += 8)
+		{
+			_mm256_storeu_ps(&OutBuffer[Index], _mm256_add_ps(_mm256_loadu_ps(&InBuffer1[Index]), _mm256_loadu_ps(&InBuffer2[Index])));
+		}
+		return Index;
+	}
+#endif
+
 	static void RestrictedPtrAliasCheck(const float* RESTRICT Ptr1, const float* RESTRICT Ptr2, uint32 NumFloatsInArray)
 	{
 		checkf(static_cast<uint32>(FMath::Abs(Ptr1 - Ptr2)) >= NumFloatsInArray,
@@ -104,9 +241,17 @@ namespace Audio
 		const int32 NumSamplesRemaining = InNumSamples % 4;
 		const int32 NumSamplesToSimd = InNumSamples - NumSamplesRemaining;
 
+		int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+		if (UseAVXKernels())
+		{
+			StartIndex = MultiplyBufferByConstantAVX(InFloatBuffer, OutFloatBuffer, NumSamplesToSimd, InValue);
+		}
+#endif
+
 		// Load the single value we want to multiply all values by into a vector register
 		const VectorRegister MultiplyValue = VectorLoadFloat1(&InValue);
-		for (int32 i = 0; i < NumSamplesToSimd; i += 4)
+		for (int32 i = StartIndex; i < NumSamplesToSimd; i += 4)
 		{
 			// Load the next 4 samples of the input buffer into a register
 			VectorRegister InputBufferRegister = VectorLoadAligned(&InFloatBuffer[i]);
@@ -133,9 +278,17 @@ namespace Audio
 
 	void MultiplyBufferByConstantInPlace(float* RESTRICT InBuffer, int32 NumSamples, float InGain)
 	{
+		int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+		if (UseAVXKernels())
+		{
+			StartIndex = MultiplyBufferByConstantAVX(InBuffer, InBuffer, NumSamples, InGain);
+		}
+#endif
+
 		const VectorRegister Gain = VectorLoadFloat1(&InGain);
 
-		for (int32 i = 0; i < NumSamples; i += 4)
+		for (int32 i = StartIndex; i < NumSamples; i += 4)
 		{
 			VectorRegister Output = VectorLoadAligned(&InBuffer[i]);
 			Output = VectorMultiply(Output, Gain);
@@ -307,24 +460,26 @@ namespace Audio
 			}
 			else
 			{
-				VectorRegister Gain = VectorLoadFloat1(&StartValue);
-
-				for (int32 i = 0; i < NumSamples; i += 4)
-				{
-					VectorRegister Output = VectorLoadAligned(&OutFloatBuffer[i]);
-					Output = VectorMultiply(Output, Gain);
-					VectorStoreAligned(Output, &OutFloatBuffer[i]);
-				}
+				MultiplyBufferByConstantInPlace(OutFloatBuffer, NumSamples, StartValue);
 			}
 		}
 		else
 		{
 			const float DeltaValue = ((EndValue - StartValue) / NumIterations);
 
-			VectorRegister Gain = VectorLoadFloat1(&StartValue);
+			int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+			if (UseAVXKernels())
+			{
+				StartIndex = MultiplyBufferByRampAVX(OutFloatBuffer, NumSamples, StartValue, DeltaValue);
+			}
+#endif
+			const float TailStartValue = StartValue + DeltaValue * (StartIndex / 4);
+
+			VectorRegister Gain = VectorLoadFloat1(&TailStartValue);
 			VectorRegister Delta = VectorLoadFloat1(&DeltaValue);
 
-			for (int32 i = 0; i < NumSamples; i += 4)
+			for (int32 i = StartIndex; i < NumSamples; i += 4)
 			{
 				VectorRegister Output = VectorLoadAligned(&OutFloatBuffer[i]);
 				Output = VectorMultiply(Output, Gain);
@@ -354,9 +509,17 @@ namespace Audio
 			BufferToSumTo[i] += InFloatBuffer[i] * Gain;
 		}
 #else
+		int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+		if (UseAVXKernels())
+		{
+			StartIndex = MixInBufferAVX(InFloatBuffer, BufferToSumTo, NumSamples, Gain);
+		}
+#endif
+
 		VectorRegister GainVector = VectorLoadFloat1(&Gain);
 
-		for (int32 i = 0; i < NumSamples; i += 4)
+		for (int32 i = StartIndex; i < NumSamples; i += 4)
 		{
 			VectorRegister Output = VectorLoadAligned(&BufferToSumTo[i]);
 			VectorRegister Input  = VectorLoadAligned(&InFloatBuffer[i]);
@@ -386,7 +549,15 @@ namespace Audio
 			BufferToSumTo[i] += InFloatBuffer[i];
 		}
 #else
-		for (int32 i = 0; i < NumSamples; i += 4)
+		int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+		if (UseAVXKernels())
+		{
+			StartIndex = SumBuffersAVX(BufferToSumTo, InFloatBuffer, BufferToSumTo, NumSamples);
+		}
+#endif
+
+		for (int32 i = StartIndex; i < NumSamples; i += 4)
 		{
 			VectorRegister Output = VectorLoadAligned(&BufferToSumTo[i]);
 			VectorRegister Input = VectorLoadAligned(&InFloatBuffer[i]);
@@ -420,28 +591,26 @@ namespace Audio
 			}
 			else
 			{
-				VectorRegister Gain = VectorLoadFloat1(&StartGain);
-
-				for (int32 i = 0; i < NumSamples; i += 4)
-				{
-					VectorRegister Input = VectorLoadAligned(&InFloatBuffer[i]);
-					VectorRegister Output = VectorLoadAligned(&BufferToSumTo[i]);
-
-					Input = VectorMultiply(Input, Gain);
-					Output = VectorAdd(Input, Output);
-					
-					VectorStoreAligned(Output, &BufferToSumTo[i]);
-				}
+				MixInBufferFast(InFloatBuffer, BufferToSumTo, NumSamples, StartGain);
 			}
 		}
 		else
 		{
 			const float DeltaValue = ((EndGain - StartGain) / NumIterations);
 
-			VectorRegister Gain = VectorLoadFloat1(&StartGain);
+			int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+			if (UseAVXKernels())
+			{
+				StartIndex = MixInBufferRampAVX(InFloatBuffer, BufferToSumTo, NumSamples, StartGain, DeltaValue);
+			}
+#endif
+			const float TailStartGain = StartGain + DeltaValue * (StartIndex / 4);
+
+			VectorRegister Gain = VectorLoadFloat1(&TailStartGain);
 			VectorRegister Delta = VectorLoadFloat1(&DeltaValue);
 
-			for (int32 i = 0; i < NumSamples; i += 4)
+			for (int32 i = StartIndex; i < NumSamples; i += 4)
 			{
 				VectorRegister Input = VectorLoadAligned(&InFloatBuffer[i]);
 				VectorRegister Output = VectorLoadAligned(&BufferToSumTo[i]);
@@ -568,7 +737,15 @@ namespace Audio
 			OutputBuffer[i] = InFloatBuffer1[i] + InFloatBuffer2[i];
 		}
 #else
-		for (int32 i = 0; i < NumSamples; i += 4)
+		int32 StartIndex = 0;
+#if AUDIO_USE_AVX
+		if (UseAVXKernels())
+		{
+			StartIndex = SumBuffersAVX(InFloatBuffer1, InFloatBuffer2, OutputBuffer, NumSamples);
+		}
+#endif
+
+		for (int32 i = StartIndex; i < NumSamples; i += 4)
 		{
 			VectorRegister Input1 = VectorLoadAligned(&InFloatBuffer1[i]);
 			VectorRegister Input2 = VectorLoadAligned(&InFloatBuffer2[i]);